@@ -50,6 +50,9 @@ typedef struct OpaqueJSClass* JSClassRef;
 /*! @typedef JSPropertyNameArrayRef An array of JavaScript property names. */
 typedef struct OpaqueJSPropertyNameArray* JSPropertyNameArrayRef;
 
+/*! @typedef JSPropertyKeyRef A property name interned in a context group. Used with JSObjectGetPropertyForKey to access properties without looking up their names. */
+typedef struct OpaqueJSPropertyKey* JSPropertyKeyRef;
+
 /*! @typedef JSPropertyNameAccumulatorRef An ordered set used to collect the names of a JavaScript object's properties. */
 typedef struct OpaqueJSPropertyNameAccumulator* JSPropertyNameAccumulatorRef;
 
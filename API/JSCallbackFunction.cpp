@@ -33,6 +33,8 @@
 #include "JSCallbackObject.h"
 #include "JSFunction.h"
 #include "FunctionPrototype.h"
+#include "OpaqueJSString.h"
+#include "ThunkGenerators.h"
 #include <runtime/JSGlobalObject.h>
 #include <runtime/JSLock.h>
 #include <wtf/Vector.h>
@@ -115,5 +117,128 @@ JSValueRef JSCallbackFunction::valueOfCallback(JSContextRef ctx, JSObjectRef, JS
     return 0;
 }
 
+ASSERT_CLASS_FITS_IN_CELL(JSTypedCallbackFunction);
+
+const ClassInfo JSTypedCallbackFunction::s_info = { "Function", &JSFunction::s_info, 0, 0, CREATE_METHOD_TABLE(JSTypedCallbackFunction) };
+
+JSTypedCallbackFunction::JSTypedCallbackFunction(ExecState* exec, JSGlobalObject* globalObject, JSNativeType resultType, const Vector<JSNativeType>& argumentTypes, JSObjectCallAsTypedFunctionCallback callback)
+    : JSFunction(exec, globalObject, globalObject->typedCallbackFunctionStructure())
+    , m_resultType(resultType)
+    , m_argumentTypes(argumentTypes)
+    , m_callback(callback)
+{
+}
+
+JSTypedCallbackFunction* JSTypedCallbackFunction::create(ExecState* exec, JSGlobalObject* globalObject, const Identifier& name, JSNativeType resultType, const Vector<JSNativeType>& argumentTypes, JSObjectCallAsTypedFunctionCallback callback)
+{
+    NativeExecutable* executable = createExecutable(exec, resultType, argumentTypes, callback);
+    JSTypedCallbackFunction* function = new (NotNull, allocateCell<JSTypedCallbackFunction>(*exec->heap())) JSTypedCallbackFunction(exec, globalObject, resultType, argumentTypes, callback);
+    function->finishCreation(exec, executable, argumentTypes.size(), name);
+    return function;
+}
+
+void JSTypedCallbackFunction::destroy(JSCell* cell)
+{
+    jsCast<JSTypedCallbackFunction*>(cell)->JSTypedCallbackFunction::~JSTypedCallbackFunction();
+}
+
+NativeExecutable* JSTypedCallbackFunction::createExecutable(ExecState* exec, JSNativeType resultType, const Vector<JSNativeType>& argumentTypes, JSObjectCallAsTypedFunctionCallback callback)
+{
+    JSGlobalData& globalData = exec->globalData();
+#if ENABLE(JIT) && USE(JSVALUE64) && CPU(X86_64)
+    if (globalData.canUseJIT()) {
+        static const UnboxedType unboxedTypes[] = { UnboxedVoid, UnboxedInt32, UnboxedDouble, UnboxedBoolean };
+        bool canUnbox = resultType <= kJSNativeTypeBoolean;
+        Vector<UnboxedType, 8> unboxedArgumentTypes(argumentTypes.size());
+        for (size_t i = 0; canUnbox && i < argumentTypes.size(); ++i) {
+            canUnbox = argumentTypes[i] <= kJSNativeTypeBoolean;
+            if (canUnbox)
+                unboxedArgumentTypes[i] = unboxedTypes[argumentTypes[i]];
+        }
+        if (canUnbox) {
+            MacroAssemblerCodeRef callThunk = typedNativeCallThunkGenerator(&globalData, FunctionPtr(callback), unboxedTypes[resultType], unboxedArgumentTypes.data(), argumentTypes.size());
+            return NativeExecutable::create(globalData, callThunk, call, MacroAssemblerCodeRef::createSelfManagedCodeRef(globalData.jitStubs->ctiNativeConstruct()), callHostFunctionAsConstructor, NoIntrinsic);
+        }
+    }
+#else
+    UNUSED_PARAM(resultType);
+    UNUSED_PARAM(argumentTypes);
+    UNUSED_PARAM(callback);
+#endif
+    return globalData.getHostFunction(call, callHostFunctionAsConstructor);
+}
+
+EncodedJSValue JSTypedCallbackFunction::call(ExecState* exec)
+{
+    JSTypedCallbackFunction* function = jsCast<JSTypedCallbackFunction*>(exec->callee());
+
+    size_t argumentCount = function->m_argumentTypes.size();
+    Vector<JSNativeValue, 16> arguments(argumentCount);
+    Vector<RefPtr<OpaqueJSString>, 16> strings;
+    MarkedArgumentBuffer objects;
+    for (size_t i = 0; i < argumentCount; i++) {
+        JSValue value = exec->argument(i);
+        switch (function->m_argumentTypes[i]) {
+        case kJSNativeTypeInt32:
+            arguments[i].int32 = value.toInt32(exec);
+            break;
+        case kJSNativeTypeDouble:
+            arguments[i].number = value.toNumber(exec);
+            break;
+        case kJSNativeTypeBoolean:
+            arguments[i].boolean = value.toBoolean(exec);
+            break;
+        case kJSNativeTypeString: {
+            RefPtr<OpaqueJSString> string = OpaqueJSString::create(value.toString(exec)->value(exec));
+            arguments[i].string = string.get();
+            strings.append(string.release());
+            break;
+        }
+        case kJSNativeTypeObject: {
+            JSObject* object = value.toObject(exec);
+            objects.append(object);
+            arguments[i].object = toRef(object);
+            break;
+        }
+        case kJSNativeTypeVoid:
+            ASSERT_NOT_REACHED();
+            break;
+        }
+        if (exec->hadException())
+            return JSValue::encode(jsUndefined());
+    }
+
+    JSValueRef exception = 0;
+    JSNativeValue result;
+    {
+        APICallbackShim callbackShim(exec);
+        result = function->m_callback(toRef(exec), arguments.data(), &exception);
+    }
+    if (exception) {
+        throwError(exec, toJS(exec, exception));
+        return JSValue::encode(jsUndefined());
+    }
+
+    switch (function->m_resultType) {
+    case kJSNativeTypeVoid:
+        break;
+    case kJSNativeTypeInt32:
+        return JSValue::encode(jsNumber(result.int32));
+    case kJSNativeTypeDouble:
+        // Don't let an impure NaN from the callback become a JSValue.
+        return JSValue::encode(result.number == result.number ? jsNumber(result.number) : jsNaN());
+    case kJSNativeTypeBoolean:
+        return JSValue::encode(jsBoolean(result.boolean));
+    case kJSNativeTypeString: {
+        JSValue string = jsString(exec, result.string->ustring());
+        if (result.string)
+            result.string->deref();
+        return JSValue::encode(string);
+    }
+    case kJSNativeTypeObject:
+        return JSValue::encode(result.object ? toJS(result.object) : jsNull());
+    }
+    return JSValue::encode(jsUndefined());
+}
 
 } // namespace JSC
@@ -27,7 +27,9 @@
 #define JSCallbackFunction_h
 
 #include "InternalFunction.h"
+#include "JSFunction.h"
 #include "JSObjectRef.h"
+#include <wtf/Vector.h>
 
 namespace JSC {
 
@@ -66,6 +68,36 @@ private:
     JSObjectCallAsFunctionCallback m_callback;
 };
 
+// Unlike JSCallbackFunction, this is a real JSFunction backed by a NativeExecutable, so
+// JIT code links calls to it directly. When its signature is purely numeric the
+// executable's call thunk unboxes the arguments and calls the callback itself.
+class JSTypedCallbackFunction : public JSFunction {
+protected:
+    JSTypedCallbackFunction(ExecState*, JSGlobalObject*, JSNativeType resultType, const Vector<JSNativeType>& argumentTypes, JSObjectCallAsTypedFunctionCallback);
+
+public:
+    typedef JSFunction Base;
+
+    static JSTypedCallbackFunction* create(ExecState*, JSGlobalObject*, const Identifier& name, JSNativeType resultType, const Vector<JSNativeType>& argumentTypes, JSObjectCallAsTypedFunctionCallback);
+    static void destroy(JSCell*);
+
+    static const ClassInfo s_info;
+
+    static Structure* createStructure(JSGlobalData& globalData, JSGlobalObject* globalObject, JSValue proto)
+    {
+        return Structure::create(globalData, globalObject, proto, TypeInfo(JSFunctionType, StructureFlags), &s_info);
+    }
+
+private:
+    static NativeExecutable* createExecutable(ExecState*, JSNativeType resultType, const Vector<JSNativeType>& argumentTypes, JSObjectCallAsTypedFunctionCallback);
+
+    static EncodedJSValue JSC_HOST_CALL call(ExecState*);
+
+    JSNativeType m_resultType;
+    Vector<JSNativeType> m_argumentTypes;
+    JSObjectCallAsTypedFunctionCallback m_callback;
+};
+
 } // namespace JSC
 
 #endif // JSCallbackFunction_h
@@ -45,6 +45,12 @@ Structure* JSCallbackObject<JSNonFinalObject>::createStructure(JSGlobalData& glo
     return Structure::create(globalData, globalObject, proto, TypeInfo(ObjectType, StructureFlags), &s_info); 
 }
     
+template <>
+Structure* JSCallbackObject<JSNonFinalObject>::createCacheableStructure(JSGlobalData& globalData, JSGlobalObject* globalObject, JSValue proto)
+{ 
+    return Structure::create(globalData, globalObject, proto, TypeInfo(ObjectType, StructureFlags & ~ProhibitsPropertyCaching), &s_info); 
+}
+
 template <>
 Structure* JSCallbackObject<JSGlobalObject>::createStructure(JSGlobalData& globalData, JSGlobalObject* globalObject, JSValue proto)
 { 
@@ -149,6 +149,9 @@ public:
     bool inherits(JSClassRef) const;
 
     static Structure* createStructure(JSGlobalData&, JSGlobalObject*, JSValue);
+    // For objects whose class has no hasProperty, getProperty or setProperty callbacks,
+    // and whose structure is used by no other class.
+    static Structure* createCacheableStructure(JSGlobalData&, JSGlobalObject*, JSValue);
     
     JSValue getPrivateProperty(const Identifier& propertyName) const
     {
@@ -208,6 +211,7 @@ private:
     static EncodedJSValue JSC_HOST_CALL construct(ExecState*);
    
     JSValue getStaticValue(ExecState*, const Identifier&);
+    static JSValue staticValueGetter(ExecState*, JSValue, const Identifier&);
     static JSValue staticFunctionGetter(ExecState*, JSValue, const Identifier&);
     static JSValue callbackGetter(ExecState*, JSValue, const Identifier&);
 
@@ -164,6 +164,12 @@ bool JSCallbackObject<Parent>::getOwnPropertySlot(JSCell* cell, ExecState* exec,
         
         if (OpaqueJSClassStaticValuesTable* staticValues = jsClass->staticValues(exec)) {
             if (staticValues->contains(propertyName.impl())) {
+                // A structure that allows caching belongs to a class with no dynamic properties, so
+                // every object with it finds this property here, and the getter can be cached.
+                if (!thisObject->structure()->typeInfo().prohibitsPropertyCaching()) {
+                    slot.setCacheableCustom(thisObject, staticValueGetter);
+                    return true;
+                }
                 JSValue value = thisObject->getStaticValue(exec, propertyName);
                 if (value) {
                     slot.setValue(value);
@@ -174,6 +180,13 @@ bool JSCallbackObject<Parent>::getOwnPropertySlot(JSCell* cell, ExecState* exec,
         
         if (OpaqueJSClassStaticFunctionsTable* staticFunctions = jsClass->staticFunctions(exec)) {
             if (staticFunctions->contains(propertyName.impl())) {
+                if (!thisObject->structure()->typeInfo().prohibitsPropertyCaching()) {
+                    // Once made, the function is an ordinary property, which can be loaded directly.
+                    if (Parent::getOwnPropertySlot(thisObject, exec, propertyName, slot))
+                        return true;
+                    slot.setCacheableCustom(thisObject, staticFunctionGetter);
+                    return true;
+                }
                 slot.setCustom(thisObject, staticFunctionGetter);
                 return true;
             }
@@ -259,7 +272,10 @@ void JSCallbackObject<Parent>::put(JSCell* cell, ExecState* exec, const Identifi
         }
     }
     
-    return Parent::put(thisObject, exec, propertyName, value, slot);
+    // The callbacks above run before every put, even one that turns out to add or
+    // replace an ordinary property, so a cached put must never skip them.
+    PutPropertySlot uncachedSlot(slot.isStrictMode());
+    return Parent::put(thisObject, exec, propertyName, value, uncachedSlot);
 }
 
 template <class Parent>
@@ -511,6 +527,34 @@ JSValue JSCallbackObject<Parent>::getStaticValue(ExecState* exec, const Identifi
     return JSValue();
 }
 
+template <class Parent>
+JSValue JSCallbackObject<Parent>::staticValueGetter(ExecState* exec, JSValue slotParent, const Identifier& propertyName)
+{
+    JSCallbackObject* thisObj = asCallbackObject(slotParent);
+
+    JSValue value = thisObj->getStaticValue(exec, propertyName);
+    if (value)
+        return value;
+
+    // The static value's getter did not answer, so finish the lookup that getOwnPropertySlot
+    // left to this getter.
+    for (JSClassRef jsClass = thisObj->classRef(); jsClass; jsClass = jsClass->parentClass) {
+        if (OpaqueJSClassStaticFunctionsTable* staticFunctions = jsClass->staticFunctions(exec)) {
+            if (staticFunctions->contains(propertyName.impl()))
+                return staticFunctionGetter(exec, slotParent, propertyName);
+        }
+    }
+
+    PropertySlot slot(thisObj);
+    if (Parent::getOwnPropertySlot(thisObj, exec, propertyName, slot))
+        return slot.getValue(exec, propertyName);
+
+    JSValue prototype = thisObj->prototype();
+    if (prototype.isObject() && asObject(prototype)->getPropertySlot(exec, propertyName, slot))
+        return slot.getValue(exec, propertyName);
+    return jsUndefined();
+}
+
 template <class Parent>
 JSValue JSCallbackObject<Parent>::staticFunctionGetter(ExecState* exec, JSValue slotParent, const Identifier& propertyName)
 {
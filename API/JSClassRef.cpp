@@ -186,6 +186,35 @@ OpaqueJSClassStaticFunctionsTable* OpaqueJSClass::staticFunctions(JSC::ExecState
     return contextData(exec).staticFunctions.get();
 }
 
+// Objects of a class share a structure, so the structure identifies the class. When no class in
+// the chain answers for properties dynamically, the structure lets inline caches remember where
+// a property was found.
+Structure* OpaqueJSClass::structure(ExecState* exec, JSObject* prototype)
+{
+    OpaqueJSClassContextData& jsClassData = contextData(exec);
+    JSGlobalObject* globalObject = exec->lexicalGlobalObject();
+
+    Structure* structure = jsClassData.cachedStructure.get();
+    if (structure && structure->globalObject() == globalObject && structure->storedPrototype() == prototype)
+        return structure;
+
+    if (hasOnlyStaticProperties())
+        structure = JSCallbackObject<JSNonFinalObject>::createCacheableStructure(exec->globalData(), globalObject, prototype);
+    else
+        structure = JSCallbackObject<JSNonFinalObject>::createStructure(exec->globalData(), globalObject, prototype);
+    jsClassData.cachedStructure = PassWeak<Structure>(exec->globalData(), structure, 0);
+    return structure;
+}
+
+bool OpaqueJSClass::hasOnlyStaticProperties() const
+{
+    for (const OpaqueJSClass* jsClass = this; jsClass; jsClass = jsClass->parentClass) {
+        if (jsClass->hasProperty || jsClass->getProperty || jsClass->setProperty)
+            return false;
+    }
+    return true;
+}
+
 /*!
 // Doc here in case we make this public. (Hopefully we won't.)
 @function
@@ -222,11 +251,10 @@ JSObject* OpaqueJSClass::prototype(ExecState* exec)
 
     if (!jsClassData.cachedPrototype) {
         // Recursive, but should be good enough for our purposes
-        jsClassData.cachedPrototype = PassWeak<JSObject>(exec->globalData(), JSCallbackObject<JSNonFinalObject>::create(exec, exec->lexicalGlobalObject(), exec->lexicalGlobalObject()->callbackObjectStructure(), prototypeClass, &jsClassData), 0); // set jsClassData as the object's private data, so it can clear our reference on destruction
-        if (parentClass) {
-            if (JSObject* prototype = parentClass->prototype(exec))
-                jsClassData.cachedPrototype->setPrototype(exec->globalData(), prototype);
-        }
+        JSObject* prototype = parentClass ? parentClass->prototype(exec) : 0;
+        if (!prototype)
+            prototype = exec->lexicalGlobalObject()->objectPrototype();
+        jsClassData.cachedPrototype = PassWeak<JSObject>(exec->globalData(), JSCallbackObject<JSNonFinalObject>::create(exec, exec->lexicalGlobalObject(), prototypeClass->structure(exec, prototype), prototypeClass, &jsClassData), 0); // set jsClassData as the object's private data, so it can clear our reference on destruction
     }
     return jsClassData.cachedPrototype.get();
 }
@@ -82,6 +82,7 @@ public:
     OwnPtr<OpaqueJSClassStaticValuesTable> staticValues;
     OwnPtr<OpaqueJSClassStaticFunctionsTable> staticFunctions;
     JSC::Weak<JSC::JSObject> cachedPrototype;
+    JSC::Weak<JSC::Structure> cachedStructure;
 };
 
 struct OpaqueJSClass : public ThreadSafeRefCounted<OpaqueJSClass> {
@@ -93,6 +94,8 @@ struct OpaqueJSClass : public ThreadSafeRefCounted<OpaqueJSClass> {
     OpaqueJSClassStaticValuesTable* staticValues(JSC::ExecState*);
     OpaqueJSClassStaticFunctionsTable* staticFunctions(JSC::ExecState*);
     JSC::JSObject* prototype(JSC::ExecState*);
+    JSC::Structure* structure(JSC::ExecState*, JSC::JSObject* prototype);
+    bool hasOnlyStaticProperties() const;
 
     OpaqueJSClass* parentClass;
     OpaqueJSClass* prototypeClass;
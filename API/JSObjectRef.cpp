@@ -31,6 +31,7 @@
 #include "APICast.h"
 #include "CodeBlock.h"
 #include "DateConstructor.h"
+#include "Error.h"
 #include "ErrorConstructor.h"
 #include "FunctionConstructor.h"
 #include "Identifier.h"
@@ -81,9 +82,10 @@ JSObjectRef JSObjectMake(JSContextRef ctx, JSClassRef jsClass, void* data)
     if (!jsClass)
         return toRef(constructEmptyObject(exec));
 
-    JSCallbackObject<JSNonFinalObject>* object = JSCallbackObject<JSNonFinalObject>::create(exec, exec->lexicalGlobalObject(), exec->lexicalGlobalObject()->callbackObjectStructure(), jsClass, data);
-    if (JSObject* prototype = jsClass->prototype(exec))
-        object->setPrototype(exec->globalData(), prototype);
+    JSObject* prototype = jsClass->prototype(exec);
+    if (!prototype)
+        prototype = exec->lexicalGlobalObject()->objectPrototype();
+    JSCallbackObject<JSNonFinalObject>* object = JSCallbackObject<JSNonFinalObject>::create(exec, exec->lexicalGlobalObject(), jsClass->structure(exec, prototype), jsClass, data);
 
     return toRef(object);
 }
@@ -98,6 +100,26 @@ JSObjectRef JSObjectMakeFunctionWithCallback(JSContextRef ctx, JSStringRef name,
     return toRef(JSCallbackFunction::create(exec, exec->lexicalGlobalObject(), callAsFunction, nameID));
 }
 
+JSObjectRef JSObjectMakeFunctionWithTypedCallback(JSContextRef ctx, JSStringRef name, JSNativeType resultType, size_t argumentCount, const JSNativeType argumentTypes[], JSObjectCallAsTypedFunctionCallback callAsFunction)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    if (static_cast<unsigned>(resultType) > kJSNativeTypeObject)
+        return 0;
+
+    Vector<JSNativeType> types(argumentCount);
+    for (size_t i = 0; i < argumentCount; ++i) {
+        if (argumentTypes[i] == kJSNativeTypeVoid || static_cast<unsigned>(argumentTypes[i]) > kJSNativeTypeObject)
+            return 0;
+        types[i] = argumentTypes[i];
+    }
+
+    Identifier nameID = name ? name->identifier(&exec->globalData()) : Identifier(exec, "anonymous");
+
+    return toRef(JSTypedCallbackFunction::create(exec, exec->lexicalGlobalObject(), nameID, resultType, types, callAsFunction));
+}
+
 JSObjectRef JSObjectMakeConstructor(JSContextRef ctx, JSClassRef jsClass, JSObjectCallAsConstructorCallback callAsConstructor)
 {
     ExecState* exec = toJS(ctx);
@@ -336,6 +358,269 @@ bool JSObjectDeleteProperty(JSContextRef ctx, JSObjectRef object, JSStringRef pr
     return result;
 }
 
+JSObjectRef JSObjectMakeWithProperties(JSContextRef ctx, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef values[], JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    JSObject* jsObject = constructEmptyObject(exec);
+    // Each put is an ordinary assignment, so setters on the Object prototype (including
+    // __proto__) run, and new properties follow the cached transitions from the empty
+    // object's structure.
+    for (size_t i = 0; i < propertyCount; ++i) {
+        PutPropertySlot slot;
+        jsObject->methodTable()->put(jsObject, exec, propertyNames[i]->identifier(&exec->globalData()), toJS(exec, values[i]), slot);
+        if (exec->hadException()) {
+            if (exception)
+                *exception = toRef(exec, exec->exception());
+            exec->clearException();
+            return 0;
+        }
+    }
+
+    return toRef(jsObject);
+}
+
+void JSObjectGetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], JSValueRef values[], JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    JSObject* jsObject = toJS(object);
+
+    size_t i = 0;
+    for (; i < propertyCount; ++i) {
+        JSValue jsValue = jsObject->get(exec, propertyNames[i]->identifier(&exec->globalData()));
+        if (exec->hadException()) {
+            if (exception)
+                *exception = toRef(exec, exec->exception());
+            exec->clearException();
+            break;
+        }
+        values[i] = toRef(exec, jsValue);
+    }
+    for (; i < propertyCount; ++i)
+        values[i] = toRef(exec, jsUndefined());
+}
+
+void JSObjectSetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef values[], JSPropertyAttributes attributes, JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    JSObject* jsObject = toJS(object);
+
+    for (size_t i = 0; i < propertyCount; ++i) {
+        Identifier name(propertyNames[i]->identifier(&exec->globalData()));
+        JSValue jsValue = toJS(exec, values[i]);
+
+        if (attributes && !jsObject->hasProperty(exec, name))
+            jsObject->methodTable()->putDirectVirtual(jsObject, exec, name, jsValue, attributes);
+        else {
+            PutPropertySlot slot;
+            jsObject->methodTable()->put(jsObject, exec, name, jsValue, slot);
+        }
+
+        if (exec->hadException()) {
+            if (exception)
+                *exception = toRef(exec, exec->exception());
+            exec->clearException();
+            return;
+        }
+    }
+}
+
+// The indexes from startIndex must all fit in an unsigned.
+static bool indexesAreInRange(ExecState* exec, unsigned startIndex, size_t count, JSValueRef* exception)
+{
+    if (!count || count - 1 <= UINT_MAX - startIndex)
+        return true;
+    if (exception)
+        *exception = toRef(exec, createRangeError(exec, "Index out of range"));
+    return false;
+}
+
+void JSObjectGetPropertiesAtIndexes(JSContextRef ctx, JSObjectRef object, unsigned startIndex, size_t count, JSValueRef values[], JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    JSObject* jsObject = toJS(object);
+    JSArray* array = isJSArray(jsObject) ? asArray(jsObject) : 0;
+
+    size_t i = 0;
+    if (!indexesAreInRange(exec, startIndex, count, exception))
+        i = count;
+    for (; i < count; ++i) {
+        unsigned index = startIndex + i;
+        if (array && array->canGetIndex(index)) {
+            values[i] = toRef(exec, array->getIndex(index));
+            continue;
+        }
+
+        JSValue jsValue = jsObject->get(exec, index);
+        if (exec->hadException()) {
+            if (exception)
+                *exception = toRef(exec, exec->exception());
+            exec->clearException();
+            break;
+        }
+        values[i] = toRef(exec, jsValue);
+    }
+    for (; i < count; ++i)
+        values[i] = toRef(exec, jsUndefined());
+}
+
+void JSObjectSetPropertiesAtIndexes(JSContextRef ctx, JSObjectRef object, unsigned startIndex, size_t count, const JSValueRef values[], JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    JSObject* jsObject = toJS(object);
+    JSArray* array = isJSArray(jsObject) ? asArray(jsObject) : 0;
+
+    if (!indexesAreInRange(exec, startIndex, count, exception))
+        return;
+    for (size_t i = 0; i < count; ++i) {
+        unsigned index = startIndex + i;
+        JSValue jsValue = toJS(exec, values[i]);
+
+        // Only overwrite elements directly; filling a hole may need to call a setter on the prototype chain.
+        if (array && array->canGetIndex(index)) {
+            array->setIndex(exec->globalData(), index, jsValue);
+            continue;
+        }
+
+        jsObject->methodTable()->putByIndex(jsObject, exec, index, jsValue);
+        if (exec->hadException()) {
+            if (exception)
+                *exception = toRef(exec, exec->exception());
+            exec->clearException();
+            return;
+        }
+    }
+}
+
+struct OpaqueJSPropertyKey {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    OpaqueJSPropertyKey(JSGlobalData* globalData, const Identifier& identifier)
+        : refCount(0)
+        , globalData(globalData)
+        , identifier(identifier)
+    {
+    }
+
+    unsigned refCount;
+    // Retains the group, as JSContextGroupRetain does, so that the identifier table
+    // outlives the identifier.
+    RefPtr<JSGlobalData> globalData;
+    // Interned in globalData's identifier table, so using it as a property name
+    // needs neither hashing nor a table lookup.
+    Identifier identifier;
+};
+
+JSPropertyKeyRef JSPropertyKeyCreate(JSContextGroupRef group, JSStringRef propertyName)
+{
+    JSGlobalData* globalData = toJS(group);
+    APIEntryShim entryShim(globalData);
+
+    JSPropertyKeyRef key = new OpaqueJSPropertyKey(globalData, propertyName->identifier(globalData));
+    return JSPropertyKeyRetain(key);
+}
+
+JSPropertyKeyRef JSPropertyKeyRetain(JSPropertyKeyRef key)
+{
+    ++key->refCount;
+    return key;
+}
+
+void JSPropertyKeyRelease(JSPropertyKeyRef key)
+{
+    if (--key->refCount)
+        return;
+
+    // Dropping the last reference to the name removes it from the identifier table,
+    // so the group must stay alive until the key is gone.
+    RefPtr<JSGlobalData> globalData = key->globalData;
+    APIEntryShim entryShim(globalData.get(), false);
+    delete key;
+}
+
+JSStringRef JSPropertyKeyCopyName(JSPropertyKeyRef key)
+{
+    return OpaqueJSString::create(key->identifier.ustring()).leakRef();
+}
+
+bool JSObjectHasPropertyForKey(JSContextRef ctx, JSObjectRef object, JSPropertyKeyRef key)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+    ASSERT(&exec->globalData() == key->globalData.get());
+
+    JSObject* jsObject = toJS(object);
+
+    return jsObject->hasProperty(exec, key->identifier);
+}
+
+JSValueRef JSObjectGetPropertyForKey(JSContextRef ctx, JSObjectRef object, JSPropertyKeyRef key, JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+    ASSERT(&exec->globalData() == key->globalData.get());
+
+    JSObject* jsObject = toJS(object);
+
+    JSValue jsValue = jsObject->get(exec, key->identifier);
+    if (exec->hadException()) {
+        if (exception)
+            *exception = toRef(exec, exec->exception());
+        exec->clearException();
+    }
+    return toRef(exec, jsValue);
+}
+
+void JSObjectSetPropertyForKey(JSContextRef ctx, JSObjectRef object, JSPropertyKeyRef key, JSValueRef value, JSPropertyAttributes attributes, JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+    ASSERT(&exec->globalData() == key->globalData.get());
+
+    JSObject* jsObject = toJS(object);
+    const Identifier& name = key->identifier;
+    JSValue jsValue = toJS(exec, value);
+
+    if (attributes && !jsObject->hasProperty(exec, name))
+        jsObject->methodTable()->putDirectVirtual(jsObject, exec, name, jsValue, attributes);
+    else {
+        PutPropertySlot slot;
+        jsObject->methodTable()->put(jsObject, exec, name, jsValue, slot);
+    }
+
+    if (exec->hadException()) {
+        if (exception)
+            *exception = toRef(exec, exec->exception());
+        exec->clearException();
+    }
+}
+
+bool JSObjectDeletePropertyForKey(JSContextRef ctx, JSObjectRef object, JSPropertyKeyRef key, JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+    ASSERT(&exec->globalData() == key->globalData.get());
+
+    JSObject* jsObject = toJS(object);
+
+    bool result = jsObject->methodTable()->deleteProperty(jsObject, exec, key->identifier);
+    if (exec->hadException()) {
+        if (exception)
+            *exception = toRef(exec, exec->exception());
+        exec->clearException();
+    }
+    return result;
+}
+
 void* JSObjectGetPrivate(JSObjectRef object)
 {
     JSObject* jsObject = toJS(object);
@@ -219,6 +219,53 @@ If this callback is NULL, calling your object as a function will throw an except
 typedef JSValueRef 
 (*JSObjectCallAsFunctionCallback) (JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);
 
+/*!
+@enum JSNativeType
+@abstract     A constant identifying the C type of an argument to, or the result of, a typed function callback.
+@constant     kJSNativeTypeVoid     No value. Only valid as a result type; the function returns undefined.
+@constant     kJSNativeTypeInt32    A 32-bit signed integer, converted as by ToInt32.
+@constant     kJSNativeTypeDouble   A double, converted as by ToNumber.
+@constant     kJSNativeTypeBoolean  A bool, converted as by ToBoolean.
+@constant     kJSNativeTypeString   A JSString, converted as by ToString.
+@constant     kJSNativeTypeObject   A JSObject, converted as by ToObject.
+*/
+typedef enum {
+    kJSNativeTypeVoid,
+    kJSNativeTypeInt32,
+    kJSNativeTypeDouble,
+    kJSNativeTypeBoolean,
+    kJSNativeTypeString,
+    kJSNativeTypeObject
+} JSNativeType;
+
+/*!
+@typedef JSNativeValue
+@abstract An argument to, or the result of, a typed function callback. The member in use is the one named by the function's JSNativeType for it.
+*/
+typedef union {
+    int int32;
+    double number;
+    bool boolean;
+    JSStringRef string;
+    JSObjectRef object;
+} JSNativeValue;
+
+/*! 
+@typedef JSObjectCallAsTypedFunctionCallback
+@abstract The callback invoked when a function made with JSObjectMakeFunctionWithTypedCallback is called.
+@param ctx The execution context to use.
+@param arguments A JSNativeValue array of the arguments passed to the function, converted to the function's argument types. Arguments that were not passed are converted from undefined.
+@param exception A pointer to a JSValueRef in which to return an exception, if any.
+@result A JSNativeValue of the function's result type. A JSString result is released by the function, following the Create Rule. A NULL JSObject result is returned as null.
+@discussion If you named your function Hypot, you would declare it like this:
+
+JSNativeValue Hypot(JSContextRef ctx, const JSNativeValue arguments[], JSValueRef* exception);
+
+JSStrings and JSObjects in arguments are only valid until the callback returns.
+*/
+typedef JSNativeValue
+(*JSObjectCallAsTypedFunctionCallback) (JSContextRef ctx, const JSNativeValue arguments[], JSValueRef* exception);
+
 /*! 
 @typedef JSObjectCallAsConstructorCallback
 @abstract The callback invoked when an object is used as a constructor in a 'new' expression.
@@ -419,6 +466,20 @@ JS_EXPORT JSObjectRef JSObjectMake(JSContextRef ctx, JSClassRef jsClass, void* d
 */
 JS_EXPORT JSObjectRef JSObjectMakeFunctionWithCallback(JSContextRef ctx, JSStringRef name, JSObjectCallAsFunctionCallback callAsFunction);
 
+/*!
+@function
+@abstract Creates a JavaScript function whose callback takes and returns C values of declared types.
+@param ctx The execution context to use.
+@param name A JSString containing the function's name. This will be used when converting the function to string. Pass NULL to create an anonymous function.
+@param resultType The JSNativeType of the callback's result.
+@param argumentCount An integer count of the callback's arguments.
+@param argumentTypes A JSNativeType array of length argumentCount containing the types of the callback's arguments. kJSNativeTypeVoid is not a valid argument type.
+@param callAsFunction The JSObjectCallAsTypedFunctionCallback to invoke when the function is called.
+@result A JSObject that is a function, or NULL if a type is not valid. The object's prototype will be the default function prototype.
+@discussion The callback does not receive the function or the 'this' object. When the arguments and result are all numbers or booleans, JIT compiled code that passes exactly argumentCount arguments of matching types calls the callback directly, without converting the arguments to JSValues or leaving the JavaScript lock, so such a callback must not block waiting on another thread that uses the context group.
+*/
+JS_EXPORT JSObjectRef JSObjectMakeFunctionWithTypedCallback(JSContextRef ctx, JSStringRef name, JSNativeType resultType, size_t argumentCount, const JSNativeType argumentTypes[], JSObjectCallAsTypedFunctionCallback callAsFunction);
+
 /*!
 @function
 @abstract Convenience method for creating a JavaScript constructor.
@@ -577,6 +638,149 @@ JS_EXPORT JSValueRef JSObjectGetPropertyAtIndex(JSContextRef ctx, JSObjectRef ob
 */
 JS_EXPORT void JSObjectSetPropertyAtIndex(JSContextRef ctx, JSObjectRef object, unsigned propertyIndex, JSValueRef value, JSValueRef* exception);
 
+/*!
+@function
+@abstract Creates a JavaScript object with the given properties.
+@param ctx The execution context to use.
+@param propertyCount An integer count of the properties to create.
+@param propertyNames A JSString array of length propertyCount containing the properties' names.
+@param values A JSValue array of length propertyCount containing the properties' values.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result A JSObject whose prototype is the Object prototype, with the given properties in order, or NULL if setting a property threw an exception.
+@discussion Calling JSObjectMakeWithProperties is equivalent to calling JSObjectMake with a NULL class and then JSObjectSetProperty with no attributes for each property, but it only enters the context once. Setters on the Object prototype are called, so a property named __proto__ sets the object's prototype. Objects made with the same names in the same order share their layout.
+*/
+JS_EXPORT JSObjectRef JSObjectMakeWithProperties(JSContextRef ctx, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef values[], JSValueRef* exception);
+
+/*!
+@function
+@abstract Gets several properties from an object.
+@param ctx The execution context to use.
+@param object The JSObject whose properties you want to get.
+@param propertyCount An integer count of the properties to get.
+@param propertyNames A JSString array of length propertyCount containing the names of the properties to get.
+@param values A JSValue array of length propertyCount in which to store the properties' values. A property the object does not have is stored as the undefined value.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@discussion If getting a property throws an exception, no further properties are got, and their values are stored as the undefined value.
+*/
+JS_EXPORT void JSObjectGetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], JSValueRef values[], JSValueRef* exception);
+
+/*!
+@function
+@abstract Sets several properties on an object.
+@param ctx The execution context to use.
+@param object The JSObject whose properties you want to set.
+@param propertyCount An integer count of the properties to set.
+@param propertyNames A JSString array of length propertyCount containing the names of the properties to set.
+@param values A JSValue array of length propertyCount containing the values to set.
+@param attributes A logically ORed set of JSPropertyAttributes to give to each property.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@discussion If setting a property throws an exception, no further properties are set.
+*/
+JS_EXPORT void JSObjectSetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef values[], JSPropertyAttributes attributes, JSValueRef* exception);
+
+/*!
+@function
+@abstract Gets a run of properties from an object by numeric index.
+@param ctx The execution context to use.
+@param object The JSObject whose properties you want to get.
+@param startIndex The index of the first property to get.
+@param count An integer count of the properties to get.
+@param values A JSValue array of length count in which to store the properties' values.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@discussion Calling JSObjectGetPropertiesAtIndexes is equivalent to calling JSObjectGetPropertyAtIndex for each index from startIndex, but it only enters the context once, and reads array elements directly. If getting a property throws an exception, no further properties are got, and their values are stored as the undefined value. If startIndex + count - 1 does not fit in an unsigned, no properties are got and a RangeError is stored in exception.
+*/
+JS_EXPORT void JSObjectGetPropertiesAtIndexes(JSContextRef ctx, JSObjectRef object, unsigned startIndex, size_t count, JSValueRef values[], JSValueRef* exception);
+
+/*!
+@function
+@abstract Sets a run of properties on an object by numeric index.
+@param ctx The execution context to use.
+@param object The JSObject whose properties you want to set.
+@param startIndex The index of the first property to set.
+@param count An integer count of the properties to set.
+@param values A JSValue array of length count containing the values to set.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@discussion Calling JSObjectSetPropertiesAtIndexes is equivalent to calling JSObjectSetPropertyAtIndex for each index from startIndex, but it only enters the context once, and writes array elements directly. If setting a property throws an exception, no further properties are set. If startIndex + count - 1 does not fit in an unsigned, no properties are set and a RangeError is stored in exception.
+*/
+JS_EXPORT void JSObjectSetPropertiesAtIndexes(JSContextRef ctx, JSObjectRef object, unsigned startIndex, size_t count, const JSValueRef values[], JSValueRef* exception);
+
+/*!
+@function
+@abstract Creates a property key, interning a property name in a context group.
+@param group The context group in whose contexts the key will be used.
+@param propertyName A JSString containing the property's name.
+@result A JSPropertyKey for propertyName. Ownership follows the Create Rule.
+@discussion Accessing a property with a JSPropertyKey skips converting a JSString to a property name on every call. A key may be used with any context in group, and retains group until the key is released.
+*/
+JS_EXPORT JSPropertyKeyRef JSPropertyKeyCreate(JSContextGroupRef group, JSStringRef propertyName);
+
+/*!
+@function
+@abstract Retains a property key.
+@param key The JSPropertyKey to retain.
+@result A JSPropertyKey that is the same as key.
+*/
+JS_EXPORT JSPropertyKeyRef JSPropertyKeyRetain(JSPropertyKeyRef key);
+
+/*!
+@function
+@abstract Releases a property key.
+@param key The JSPropertyKey to release.
+*/
+JS_EXPORT void JSPropertyKeyRelease(JSPropertyKeyRef key);
+
+/*!
+@function
+@abstract Gets the property name of a property key.
+@param key The JSPropertyKey whose name you want to get.
+@result A JSString containing the property name. Ownership follows the Create Rule.
+*/
+JS_EXPORT JSStringRef JSPropertyKeyCopyName(JSPropertyKeyRef key);
+
+/*!
+@function
+@abstract Tests whether an object has a given property, named by a property key.
+@param ctx The execution context to use. It must be in the context group key was created for.
+@param object The JSObject to test.
+@param key The JSPropertyKey naming the property.
+@result true if the object has a property whose name matches key, otherwise false.
+*/
+JS_EXPORT bool JSObjectHasPropertyForKey(JSContextRef ctx, JSObjectRef object, JSPropertyKeyRef key);
+
+/*!
+@function
+@abstract Gets a property from an object, named by a property key.
+@param ctx The execution context to use. It must be in the context group key was created for.
+@param object The JSObject whose property you want to get.
+@param key The JSPropertyKey naming the property.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result The property's value if object has the property, otherwise the undefined value.
+*/
+JS_EXPORT JSValueRef JSObjectGetPropertyForKey(JSContextRef ctx, JSObjectRef object, JSPropertyKeyRef key, JSValueRef* exception);
+
+/*!
+@function
+@abstract Sets a property on an object, named by a property key.
+@param ctx The execution context to use. It must be in the context group key was created for.
+@param object The JSObject whose property you want to set.
+@param key The JSPropertyKey naming the property.
+@param value A JSValue to use as the property's value.
+@param attributes A logically ORed set of JSPropertyAttributes to give to the property.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+*/
+JS_EXPORT void JSObjectSetPropertyForKey(JSContextRef ctx, JSObjectRef object, JSPropertyKeyRef key, JSValueRef value, JSPropertyAttributes attributes, JSValueRef* exception);
+
+/*!
+@function
+@abstract Deletes a property from an object, named by a property key.
+@param ctx The execution context to use. It must be in the context group key was created for.
+@param object The JSObject whose property you want to delete.
+@param key The JSPropertyKey naming the property.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result true if the delete operation succeeds, otherwise false (for example, if the property has the kJSPropertyAttributeDontDelete attribute set).
+*/
+JS_EXPORT bool JSObjectDeletePropertyForKey(JSContextRef ctx, JSObjectRef object, JSPropertyKeyRef key, JSValueRef* exception);
+
 /*!
 @function
 @abstract Gets an object's private data.
@@ -28,6 +28,7 @@
 
 #include "InitializeThreading.h"
 #include "OpaqueJSString.h"
+#include <wtf/ASCIICType.h>
 #include <wtf/unicode/UTF8.h>
 
 using namespace JSC;
@@ -39,21 +40,67 @@ JSStringRef JSStringCreateWithCharacters(const JSChar* chars, size_t numChars)
     return OpaqueJSString::create(chars, numChars).leakRef();
 }
 
+static PassRefPtr<OpaqueJSString> createWithUTF8(const char* string, size_t length)
+{
+    // ASCII is the same in UTF8 and Latin-1, so it can be kept 8-bit.
+    const char* end = string + length;
+    const char* p = string;
+    while (p != end && isASCII(*p))
+        ++p;
+    if (p == end)
+        return OpaqueJSString::create(reinterpret_cast<const LChar*>(string), length);
+
+    Vector<UChar, 1024> buffer(length);
+    UChar* d = buffer.data();
+    if (conversionOK == convertUTF8ToUTF16(&string, end, &d, d + length))
+        return OpaqueJSString::create(buffer.data(), d - buffer.data());
+
+    // Null string.
+    return OpaqueJSString::create();
+}
+
 JSStringRef JSStringCreateWithUTF8CString(const char* string)
 {
     initializeThreading();
-    if (string) {
-        size_t length = strlen(string);
-        Vector<UChar, 1024> buffer(length);
-        UChar* p = buffer.data();
-        if (conversionOK == convertUTF8ToUTF16(&string, string + length, &p, p + length))
-            return OpaqueJSString::create(buffer.data(), p - buffer.data()).leakRef();
-    }
+    if (string)
+        return createWithUTF8(string, strlen(string)).leakRef();
 
     // Null string.
     return OpaqueJSString::create().leakRef();
 }
 
+JSStringRef JSStringCreateWithUTF8Characters(const char* chars, size_t numBytes)
+{
+    initializeThreading();
+    if (chars)
+        return createWithUTF8(chars, numBytes).leakRef();
+
+    // Null string.
+    return OpaqueJSString::create().leakRef();
+}
+
+JSStringRef JSStringCreateWithLatin1Characters(const char* chars, size_t numChars)
+{
+    initializeThreading();
+    return OpaqueJSString::create(reinterpret_cast<const LChar*>(chars), numChars).leakRef();
+}
+
+JSStringRef JSStringCreateWithCharactersNoCopy(const JSChar* chars, size_t numChars, JSStringFinalizeCallback finalize, void* context)
+{
+    initializeThreading();
+    if (!chars)
+        return OpaqueJSString::create(chars, numChars).leakRef();
+    return OpaqueJSString::adopt(StringImpl::createWithoutCopying(chars, numChars, finalize, context)).leakRef();
+}
+
+JSStringRef JSStringCreateWithLatin1CharactersNoCopy(const char* chars, size_t numChars, JSStringFinalizeCallback finalize, void* context)
+{
+    initializeThreading();
+    if (!chars)
+        return OpaqueJSString::create(reinterpret_cast<const LChar*>(chars), numChars).leakRef();
+    return OpaqueJSString::adopt(StringImpl::createWithoutCopying(reinterpret_cast<const LChar*>(chars), numChars, finalize, context)).leakRef();
+}
+
 JSStringRef JSStringRetain(JSStringRef string)
 {
     string->ref();
@@ -75,8 +122,22 @@ const JSChar* JSStringGetCharactersPtr(JSStringRef string)
     return string->characters();
 }
 
+bool JSStringIs8Bit(JSStringRef string)
+{
+    return string->is8Bit();
+}
+
+const char* JSStringGetLatin1CharactersPtr(JSStringRef string)
+{
+    return reinterpret_cast<const char*>(string->characters8());
+}
+
 size_t JSStringGetMaximumUTF8CStringSize(JSStringRef string)
 {
+    // Latin-1 characters take at most 2 bytes in UTF8.
+    if (string->is8Bit())
+        return string->length() * 2 + 1; // + 1 for terminating '\0'
+
     // Any UTF8 character > 3 bytes encodes as a UTF16 surrogate pair.
     return string->length() * 3 + 1; // + 1 for terminating '\0'
 }
@@ -87,8 +148,14 @@ size_t JSStringGetUTF8CString(JSStringRef string, char* buffer, size_t bufferSiz
         return 0;
 
     char* p = buffer;
-    const UChar* d = string->characters();
-    ConversionResult result = convertUTF16ToUTF8(&d, d + string->length(), &p, p + bufferSize - 1, true);
+    ConversionResult result;
+    if (string->is8Bit()) {
+        const LChar* d = string->characters8();
+        result = convertLatin1ToUTF8(&d, d + string->length(), &p, p + bufferSize - 1);
+    } else {
+        const UChar* d = string->characters();
+        result = convertUTF16ToUTF8(&d, d + string->length(), &p, p + bufferSize - 1, true);
+    }
     *p++ = '\0';
     if (result != conversionOK && result != targetExhausted)
         return 0;
@@ -99,7 +166,11 @@ size_t JSStringGetUTF8CString(JSStringRef string, char* buffer, size_t bufferSiz
 bool JSStringIsEqual(JSStringRef a, JSStringRef b)
 {
     unsigned len = a->length();
-    return len == b->length() && 0 == memcmp(a->characters(), b->characters(), len * sizeof(UChar));
+    if (len != b->length())
+        return false;
+    if (a->is8Bit() && b->is8Bit())
+        return !memcmp(a->characters8(), b->characters8(), len * sizeof(LChar));
+    return !memcmp(a->characters(), b->characters(), len * sizeof(UChar));
 }
 
 bool JSStringIsEqualToUTF8CString(JSStringRef a, const char* b)
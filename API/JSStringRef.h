@@ -63,6 +63,61 @@ JS_EXPORT JSStringRef JSStringCreateWithCharacters(const JSChar* chars, size_t n
 @result           A JSString containing string. Ownership follows the Create Rule.
 */
 JS_EXPORT JSStringRef JSStringCreateWithUTF8CString(const char* string);
+/*!
+@function
+@abstract         Creates a JavaScript string from a buffer of UTF8 bytes.
+@param chars      The buffer of UTF8 bytes to copy into the new JSString. Strings that are
+ all ASCII are stored one byte per character.
+@param numBytes   The number of bytes to copy from the buffer pointed to by chars.
+@result           A JSString containing chars. Ownership follows the Create Rule.
+*/
+JS_EXPORT JSStringRef JSStringCreateWithUTF8Characters(const char* chars, size_t numBytes);
+/*!
+@function
+@abstract         Creates a JavaScript string from a buffer of Latin-1 characters.
+@param chars      The buffer of Latin-1 characters to copy into the new JSString. They are
+ stored one byte per character.
+@param numChars   The number of characters to copy from the buffer pointed to by chars.
+@result           A JSString containing chars. Ownership follows the Create Rule.
+*/
+JS_EXPORT JSStringRef JSStringCreateWithLatin1Characters(const char* chars, size_t numChars);
+
+/*!
+@typedef JSStringFinalizeCallback
+@abstract The callback invoked when a JavaScript string no longer needs the buffer it was created with.
+@param context The context passed when the string was created.
+@param chars The buffer the string was created with.
+*/
+typedef void (*JSStringFinalizeCallback)(void* context, const void* chars);
+
+/*!
+@function
+@abstract         Creates a JavaScript string that uses a buffer of Unicode characters in place.
+@param chars      The buffer of Unicode characters that serves as the new JSString's backing
+ store. It must not change until finalize is called.
+@param numChars   The number of characters in the buffer pointed to by chars.
+@param finalize   The callback to invoke when the JSString is deallocated. Values made from
+ the JSString use the buffer in place and keep it alive, so finalize is called once neither
+ the JSString nor any such value is in use, possibly on the thread that runs JavaScript.
+ Pass NULL if the buffer is never freed.
+@param context    A pointer to pass to finalize.
+@result           A JSString containing chars. Ownership follows the Create Rule.
+*/
+JS_EXPORT JSStringRef JSStringCreateWithCharactersNoCopy(const JSChar* chars, size_t numChars, JSStringFinalizeCallback finalize, void* context);
+/*!
+@function
+@abstract         Creates a JavaScript string that uses a buffer of Latin-1 characters in place.
+@param chars      The buffer of Latin-1 characters that serves as the new JSString's backing
+ store. It must not change until finalize is called.
+@param numChars   The number of characters in the buffer pointed to by chars.
+@param finalize   The callback to invoke when the JSString is deallocated. Values made from
+ the JSString use the buffer in place and keep it alive, so finalize is called once neither
+ the JSString nor any such value is in use, possibly on the thread that runs JavaScript.
+ Pass NULL if the buffer is never freed.
+@param context    A pointer to pass to finalize.
+@result           A JSString containing chars. Ownership follows the Create Rule.
+*/
+JS_EXPORT JSStringRef JSStringCreateWithLatin1CharactersNoCopy(const char* chars, size_t numChars, JSStringFinalizeCallback finalize, void* context);
 
 /*!
 @function
@@ -95,6 +150,26 @@ JS_EXPORT size_t JSStringGetLength(JSStringRef string);
 */
 JS_EXPORT const JSChar* JSStringGetCharactersPtr(JSStringRef string);
 
+/*!
+@function
+@abstract         Tests whether a JavaScript string is stored one byte per character.
+@param string     The JSString to test.
+@result           true if every character of string is Latin-1 and it is stored as such,
+ otherwise false.
+*/
+JS_EXPORT bool JSStringIs8Bit(JSStringRef string);
+/*!
+@function
+@abstract         Returns a pointer to the Latin-1 character buffer that 
+ serves as the backing store for a JavaScript string.
+@param string     The JSString whose backing store you want to access.
+@result           A pointer to the Latin-1 character buffer that serves as string's 
+ backing store, which will be deallocated when string is deallocated, or NULL if
+ string is not stored one byte per character. Unlike JSStringGetCharactersPtr, this
+ never makes a copy of the characters.
+*/
+JS_EXPORT const char* JSStringGetLatin1CharactersPtr(JSStringRef string);
+
 /*!
 @function
 @abstract Returns the maximum number of bytes a JavaScript string will 
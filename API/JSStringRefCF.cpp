@@ -47,11 +47,13 @@ JSStringRef JSStringCreateWithCFString(CFStringRef string)
         COMPILE_ASSERT(sizeof(UniChar) == sizeof(UChar), unichar_and_uchar_must_be_same_size);
         return OpaqueJSString::create(reinterpret_cast<UChar*>(buffer.get()), length).leakRef();
     } else {
-        return OpaqueJSString::create(0, 0).leakRef();
+        return OpaqueJSString::create(static_cast<const UChar*>(0), 0).leakRef();
     }
 }
 
 CFStringRef JSStringCopyCFString(CFAllocatorRef alloc, JSStringRef string)
 {
+    if (string->is8Bit())
+        return CFStringCreateWithBytes(alloc, string->characters8(), string->length(), kCFStringEncodingISOLatin1, false);
     return CFStringCreateWithCharacters(alloc, reinterpret_cast<const UniChar*>(string->characters()), string->length());
 }
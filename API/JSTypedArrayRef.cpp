@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSTypedArrayRef.h"
+
+#include "APICast.h"
+#include "APIShims.h"
+#include "Error.h"
+#include "JSArrayBuffer.h"
+#include "JSGlobalObject.h"
+#include "JSTypedArray.h"
+#include <limits>
+
+using namespace JSC;
+
+COMPILE_ASSERT(static_cast<int>(kJSTypedArrayTypeInt8Array) + 1 == static_cast<int>(TypedArrayInt8), kJSTypedArrayTypeInt8Array_matches_TypedArrayInt8);
+COMPILE_ASSERT(static_cast<int>(kJSTypedArrayTypeUint8ClampedArray) + 1 == static_cast<int>(TypedArrayUint8Clamped), kJSTypedArrayTypeUint8ClampedArray_matches_TypedArrayUint8Clamped);
+COMPILE_ASSERT(static_cast<int>(kJSTypedArrayTypeFloat64Array) + 1 == static_cast<int>(TypedArrayFloat64), kJSTypedArrayTypeFloat64Array_matches_TypedArrayFloat64);
+
+static TypedArrayType toTypedArrayType(JSTypedArrayType arrayType)
+{
+    if (arrayType < kJSTypedArrayTypeInt8Array || arrayType > kJSTypedArrayTypeFloat64Array)
+        return TypedArrayNone;
+    return static_cast<TypedArrayType>(arrayType + 1);
+}
+
+static void doNothingDeallocator(void*, void*)
+{
+}
+
+static JSObjectRef throwRangeError(ExecState* exec, const char* message, JSValueRef* exception)
+{
+    if (exception)
+        *exception = toRef(exec, createRangeError(exec, message));
+    return 0;
+}
+
+JSTypedArrayType JSValueGetTypedArrayType(JSContextRef ctx, JSValueRef value, JSValueRef*)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    JSValue jsValue = toJS(exec, value);
+    if (JSArrayBufferView* view = toJSArrayBufferView(jsValue))
+        return static_cast<JSTypedArrayType>(view->typedArrayType() - 1);
+    if (toJSArrayBuffer(jsValue))
+        return kJSTypedArrayTypeArrayBuffer;
+    return kJSTypedArrayTypeNone;
+}
+
+JSObjectRef JSObjectMakeTypedArray(JSContextRef ctx, JSTypedArrayType arrayType, size_t length, JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    TypedArrayType type = toTypedArrayType(arrayType);
+    if (type == TypedArrayNone) {
+        if (exception)
+            *exception = toRef(exec, createTypeError(exec, "Not a typed array type"));
+        return 0;
+    }
+    if (length > std::numeric_limits<unsigned>::max())
+        return throwRangeError(exec, "Typed array length is too large", exception);
+
+    JSArrayBufferView* result = createTypedArray(exec, exec->lexicalGlobalObject(), type, static_cast<unsigned>(length));
+    if (!result)
+        return throwRangeError(exec, "Out of memory allocating typed array", exception);
+    return toRef(result);
+}
+
+JSObjectRef JSObjectMakeTypedArrayWithBytesNoCopy(JSContextRef ctx, JSTypedArrayType arrayType, void* bytes, size_t byteLength, JSTypedArrayBytesDeallocator bytesDeallocator, void* deallocatorContext, JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    TypedArrayType type = toTypedArrayType(arrayType);
+    if (type == TypedArrayNone) {
+        if (exception)
+            *exception = toRef(exec, createTypeError(exec, "Not a typed array type"));
+        return 0;
+    }
+    unsigned elementSize = JSArrayBufferView::elementSizeForTypedArrayType(type);
+    if (byteLength > std::numeric_limits<unsigned>::max())
+        return throwRangeError(exec, "Typed array length is too large", exception);
+    if (byteLength % elementSize)
+        return throwRangeError(exec, "Byte length is not a multiple of the element size", exception);
+
+    ArrayBufferContents contents(bytes, static_cast<unsigned>(byteLength), bytesDeallocator ? bytesDeallocator : doNothingDeallocator, deallocatorContext);
+    RefPtr<ArrayBuffer> buffer = ArrayBuffer::create(contents);
+    return toRef(createTypedArray(exec, exec->lexicalGlobalObject(), type, buffer.release(), 0, static_cast<unsigned>(byteLength / elementSize)));
+}
+
+void* JSObjectGetTypedArrayBytesPtr(JSContextRef ctx, JSObjectRef object, JSValueRef*)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    if (JSArrayBufferView* view = toJSArrayBufferView(toJS(object)))
+        return view->baseAddress();
+    return 0;
+}
+
+size_t JSObjectGetTypedArrayLength(JSContextRef ctx, JSObjectRef object, JSValueRef*)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    if (JSArrayBufferView* view = toJSArrayBufferView(toJS(object)))
+        return view->length();
+    return 0;
+}
+
+size_t JSObjectGetTypedArrayByteLength(JSContextRef ctx, JSObjectRef object, JSValueRef*)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    if (JSArrayBufferView* view = toJSArrayBufferView(toJS(object)))
+        return view->byteLength();
+    return 0;
+}
+
+size_t JSObjectGetTypedArrayByteOffset(JSContextRef ctx, JSObjectRef object, JSValueRef*)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    if (JSArrayBufferView* view = toJSArrayBufferView(toJS(object)))
+        return view->impl()->byteOffset();
+    return 0;
+}
+
+JSObjectRef JSObjectGetTypedArrayBuffer(JSContextRef ctx, JSObjectRef object, JSValueRef*)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    if (JSArrayBufferView* view = toJSArrayBufferView(toJS(object)))
+        return toRef(view->buffer(exec));
+    return 0;
+}
+
+JSObjectRef JSObjectMakeArrayBufferWithBytesNoCopy(JSContextRef ctx, void* bytes, size_t byteLength, JSTypedArrayBytesDeallocator bytesDeallocator, void* deallocatorContext, JSValueRef* exception)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    if (byteLength > std::numeric_limits<unsigned>::max())
+        return throwRangeError(exec, "ArrayBuffer length is too large", exception);
+
+    ArrayBufferContents contents(bytes, static_cast<unsigned>(byteLength), bytesDeallocator ? bytesDeallocator : doNothingDeallocator, deallocatorContext);
+    return toRef(JSArrayBuffer::create(exec, exec->lexicalGlobalObject()->arrayBufferStructure(), ArrayBuffer::create(contents)));
+}
+
+void* JSObjectGetArrayBufferBytesPtr(JSContextRef ctx, JSObjectRef object, JSValueRef*)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    if (JSArrayBuffer* buffer = toJSArrayBuffer(toJS(object)))
+        return buffer->impl()->data();
+    return 0;
+}
+
+size_t JSObjectGetArrayBufferByteLength(JSContextRef ctx, JSObjectRef object, JSValueRef*)
+{
+    ExecState* exec = toJS(ctx);
+    APIEntryShim entryShim(exec);
+
+    if (JSArrayBuffer* buffer = toJSArrayBuffer(toJS(object)))
+        return buffer->impl()->byteLength();
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef JSTypedArrayRef_h
+#define JSTypedArrayRef_h
+
+#include <JavaScriptCore/JSBase.h>
+#include <JavaScriptCore/JSValueRef.h>
+
+#ifndef __cplusplus
+#include <stdbool.h>
+#endif
+#include <stddef.h> /* for size_t */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+@enum JSTypedArrayType
+@abstract     A constant identifying the type of a typed array or ArrayBuffer.
+@constant     kJSTypedArrayTypeInt8Array            Int8Array
+@constant     kJSTypedArrayTypeInt16Array           Int16Array
+@constant     kJSTypedArrayTypeInt32Array           Int32Array
+@constant     kJSTypedArrayTypeUint8Array           Uint8Array
+@constant     kJSTypedArrayTypeUint8ClampedArray    Uint8ClampedArray
+@constant     kJSTypedArrayTypeUint16Array          Uint16Array
+@constant     kJSTypedArrayTypeUint32Array          Uint32Array
+@constant     kJSTypedArrayTypeFloat32Array         Float32Array
+@constant     kJSTypedArrayTypeFloat64Array         Float64Array
+@constant     kJSTypedArrayTypeArrayBuffer          ArrayBuffer
+@constant     kJSTypedArrayTypeNone                 Not a typed array or ArrayBuffer
+*/
+typedef enum {
+    kJSTypedArrayTypeInt8Array,
+    kJSTypedArrayTypeInt16Array,
+    kJSTypedArrayTypeInt32Array,
+    kJSTypedArrayTypeUint8Array,
+    kJSTypedArrayTypeUint8ClampedArray,
+    kJSTypedArrayTypeUint16Array,
+    kJSTypedArrayTypeUint32Array,
+    kJSTypedArrayTypeFloat32Array,
+    kJSTypedArrayTypeFloat64Array,
+    kJSTypedArrayTypeArrayBuffer,
+    kJSTypedArrayTypeNone
+} JSTypedArrayType;
+
+/*! 
+@typedef JSTypedArrayBytesDeallocator
+@abstract A function used to deallocate bytes passed to a typed array or ArrayBuffer constructor.
+@param bytes A pointer to the bytes that were passed to the constructor.
+@param deallocatorContext The context that was passed to the constructor.
+@discussion The function is called once, when the last object using the bytes has been garbage collected.
+*/
+typedef void (*JSTypedArrayBytesDeallocator)(void* bytes, void* deallocatorContext);
+
+/*!
+@function
+@abstract Returns the type of a typed array or ArrayBuffer.
+@param ctx The execution context to use.
+@param value The JSValue whose type you want to obtain.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result The typed array type of value, or kJSTypedArrayTypeNone if value is neither a typed array nor an ArrayBuffer.
+*/
+JS_EXPORT JSTypedArrayType JSValueGetTypedArrayType(JSContextRef ctx, JSValueRef value, JSValueRef* exception);
+
+/*!
+@function
+@abstract Creates a typed array with zero filled elements.
+@param ctx The execution context to use.
+@param arrayType The type of the typed array. This may not be kJSTypedArrayTypeArrayBuffer or kJSTypedArrayTypeNone.
+@param length The number of elements of the typed array.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result A typed array with a new ArrayBuffer, or NULL if there was an exception.
+*/
+JS_EXPORT JSObjectRef JSObjectMakeTypedArray(JSContextRef ctx, JSTypedArrayType arrayType, size_t length, JSValueRef* exception);
+
+/*!
+@function
+@abstract Creates a typed array whose elements are the given bytes, without copying them.
+@param ctx The execution context to use.
+@param arrayType The type of the typed array. This may not be kJSTypedArrayTypeArrayBuffer or kJSTypedArrayTypeNone.
+@param bytes A pointer to the bytes to use. They must stay valid until bytesDeallocator is called, and must be suitably aligned for the element type.
+@param byteLength The number of bytes, which must be a multiple of the element size.
+@param bytesDeallocator The function to call when the bytes are no longer used, or NULL if the caller frees them some other way.
+@param deallocatorContext A pointer to pass back to bytesDeallocator.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result A typed array over an ArrayBuffer whose storage is bytes, or NULL if there was an exception.
+@discussion Scripts read and write the bytes in place, and so does the caller through the pointer it keeps.
+*/
+JS_EXPORT JSObjectRef JSObjectMakeTypedArrayWithBytesNoCopy(JSContextRef ctx, JSTypedArrayType arrayType, void* bytes, size_t byteLength, JSTypedArrayBytesDeallocator bytesDeallocator, void* deallocatorContext, JSValueRef* exception);
+
+/*!
+@function
+@abstract Returns a pointer to the first element of a typed array.
+@param ctx The execution context to use.
+@param object The typed array.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result A pointer to the elements of object, or NULL if object is not a typed array.
+@discussion The pointer stays valid for as long as object, or any other view of its buffer, is alive.
+*/
+JS_EXPORT void* JSObjectGetTypedArrayBytesPtr(JSContextRef ctx, JSObjectRef object, JSValueRef* exception);
+
+/*!
+@function
+@abstract Returns the number of elements of a typed array.
+@param ctx The execution context to use.
+@param object The typed array.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result The length of object, or 0 if object is not a typed array.
+*/
+JS_EXPORT size_t JSObjectGetTypedArrayLength(JSContextRef ctx, JSObjectRef object, JSValueRef* exception);
+
+/*!
+@function
+@abstract Returns the number of bytes of a typed array.
+@param ctx The execution context to use.
+@param object The typed array.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result The byte length of object, or 0 if object is not a typed array.
+*/
+JS_EXPORT size_t JSObjectGetTypedArrayByteLength(JSContextRef ctx, JSObjectRef object, JSValueRef* exception);
+
+/*!
+@function
+@abstract Returns the offset of a typed array's elements within its ArrayBuffer.
+@param ctx The execution context to use.
+@param object The typed array.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result The byte offset of object, or 0 if object is not a typed array.
+*/
+JS_EXPORT size_t JSObjectGetTypedArrayByteOffset(JSContextRef ctx, JSObjectRef object, JSValueRef* exception);
+
+/*!
+@function
+@abstract Returns the ArrayBuffer of a typed array.
+@param ctx The execution context to use.
+@param object The typed array.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result The ArrayBuffer that object views, or NULL if object is not a typed array.
+*/
+JS_EXPORT JSObjectRef JSObjectGetTypedArrayBuffer(JSContextRef ctx, JSObjectRef object, JSValueRef* exception);
+
+/*!
+@function
+@abstract Creates an ArrayBuffer whose storage is the given bytes, without copying them.
+@param ctx The execution context to use.
+@param bytes A pointer to the bytes to use. They must stay valid until bytesDeallocator is called.
+@param byteLength The number of bytes.
+@param bytesDeallocator The function to call when the bytes are no longer used, or NULL if the caller frees them some other way.
+@param deallocatorContext A pointer to pass back to bytesDeallocator.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result An ArrayBuffer, or NULL if there was an exception.
+*/
+JS_EXPORT JSObjectRef JSObjectMakeArrayBufferWithBytesNoCopy(JSContextRef ctx, void* bytes, size_t byteLength, JSTypedArrayBytesDeallocator bytesDeallocator, void* deallocatorContext, JSValueRef* exception);
+
+/*!
+@function
+@abstract Returns a pointer to the storage of an ArrayBuffer.
+@param ctx The execution context to use.
+@param object The ArrayBuffer.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result A pointer to the bytes of object, or NULL if object is not an ArrayBuffer.
+*/
+JS_EXPORT void* JSObjectGetArrayBufferBytesPtr(JSContextRef ctx, JSObjectRef object, JSValueRef* exception);
+
+/*!
+@function
+@abstract Returns the number of bytes of an ArrayBuffer.
+@param ctx The execution context to use.
+@param object The ArrayBuffer.
+@param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+@result The byte length of object, or 0 if object is not an ArrayBuffer.
+*/
+JS_EXPORT size_t JSObjectGetArrayBufferByteLength(JSContextRef ctx, JSObjectRef object, JSValueRef* exception);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JSTypedArrayRef_h */
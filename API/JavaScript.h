@@ -32,5 +32,6 @@
 #include <JavaScriptCore/JSStringRef.h>
 #include <JavaScriptCore/JSObjectRef.h>
 #include <JavaScriptCore/JSValueRef.h>
+#include <JavaScriptCore/JSTypedArrayRef.h>
 
 #endif /* JavaScript_h */
@@ -32,24 +32,43 @@
 
 using namespace JSC;
 
+static void releaseOpaqueJSString(void* context, const void*)
+{
+    static_cast<OpaqueJSString*>(context)->deref();
+}
+
 PassRefPtr<OpaqueJSString> OpaqueJSString::create(const UString& ustring)
 {
-    if (!ustring.isNull())
-        return adoptRef(new OpaqueJSString(ustring.characters(), ustring.length()));
-    return 0;
+    if (ustring.isNull())
+        return 0;
+    if (void* string = ustring.impl()->externalBufferContext(releaseOpaqueJSString))
+        return static_cast<OpaqueJSString*>(string);
+    return adoptRef(new OpaqueJSString(ustring.impl()->isolatedCopy()));
 }
 
 UString OpaqueJSString::ustring() const
 {
-    if (this && m_characters)
-        return UString(m_characters, m_length);
-    return UString();
+    if (!this || m_string.isNull())
+        return UString();
+    if (!m_string.length())
+        return StringImpl::empty();
+
+    // Only the engine's thread ever touches the new StringImpl's reference count.
+    // Destroying it releases this string, which may happen on any thread.
+    const_cast<OpaqueJSString*>(this)->ref();
+    if (m_string.is8Bit())
+        return StringImpl::createWithoutCopying(m_string.characters8(), m_string.length(), releaseOpaqueJSString, const_cast<OpaqueJSString*>(this));
+    return StringImpl::createWithoutCopying(m_string.characters16(), m_string.length(), releaseOpaqueJSString, const_cast<OpaqueJSString*>(this));
 }
 
 Identifier OpaqueJSString::identifier(JSGlobalData* globalData) const
 {
-    if (!this || !m_characters)
+    if (!this || m_string.isNull())
         return Identifier(globalData, static_cast<const char*>(0));
 
-    return Identifier(globalData, m_characters, m_length);
+    // Look the characters up, rather than adding m_string's own StringImpl to this
+    // thread's identifier table.
+    if (m_string.is8Bit())
+        return Identifier(globalData, m_string.characters8(), m_string.length());
+    return Identifier(globalData, m_string.characters16(), m_string.length());
 }
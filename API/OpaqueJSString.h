@@ -34,6 +34,13 @@ namespace JSC {
     class JSGlobalData;
 }
 
+// Keeps the string's 8-bit or 16-bit storage as it crosses the API. A JSStringRef
+// may be used and released on any thread, but a StringImpl's reference count is not
+// thread safe, so the StringImpl it wraps is never shared with the engine. Instead,
+// the engine gets a StringImpl of its own that uses the same characters in place and
+// keeps the OpaqueJSString alive through its thread safe reference count. Strings
+// coming in from the engine are copied, unless they are such a StringImpl, in which
+// case the OpaqueJSString they came from is handed back.
 struct OpaqueJSString : public ThreadSafeRefCounted<OpaqueJSString> {
 
     static PassRefPtr<OpaqueJSString> create() // null
@@ -43,13 +50,28 @@ struct OpaqueJSString : public ThreadSafeRefCounted<OpaqueJSString> {
 
     static PassRefPtr<OpaqueJSString> create(const UChar* characters, unsigned length)
     {
-        return adoptRef(new OpaqueJSString(characters, length));
+        return adoptRef(new OpaqueJSString(characters ? JSC::UString(characters, length) : JSC::UString(StringImpl::empty())));
+    }
+
+    static PassRefPtr<OpaqueJSString> create(const LChar* characters, unsigned length)
+    {
+        return adoptRef(new OpaqueJSString(characters ? JSC::UString(characters, length) : JSC::UString(StringImpl::empty())));
+    }
+
+    // Takes a string that nothing else refers to, such as one wrapping the client's
+    // own buffer, without copying it.
+    static PassRefPtr<OpaqueJSString> adopt(PassRefPtr<StringImpl> impl)
+    {
+        ASSERT(impl->hasOneRef() && !impl->isAtomic());
+        return adoptRef(new OpaqueJSString(impl));
     }
 
     JS_EXPORT_PRIVATE static PassRefPtr<OpaqueJSString> create(const JSC::UString&);
 
-    UChar* characters() { return this ? m_characters : 0; }
-    unsigned length() { return this ? m_length : 0; }
+    bool is8Bit() { return this && !m_string.isNull() && m_string.is8Bit(); }
+    const LChar* characters8() { return is8Bit() ? m_string.characters8() : 0; }
+    const UChar* characters() { return this ? m_string.characters() : 0; }
+    unsigned length() { return this ? m_string.length() : 0; }
 
     JSC::UString ustring() const;
     JSC::Identifier identifier(JSC::JSGlobalData*) const;
@@ -58,25 +80,15 @@ private:
     friend class WTF::ThreadSafeRefCounted<OpaqueJSString>;
 
     OpaqueJSString()
-        : m_characters(0)
-        , m_length(0)
-    {
-    }
-
-    OpaqueJSString(const UChar* characters, unsigned length)
-        : m_length(length)
     {
-        m_characters = new UChar[length];
-        memcpy(m_characters, characters, length * sizeof(UChar));
     }
 
-    ~OpaqueJSString()
+    OpaqueJSString(const JSC::UString& string)
+        : m_string(string)
     {
-        delete[] m_characters;
     }
 
-    UChar* m_characters;
-    unsigned m_length;
+    JSC::UString m_string;
 };
 
 #endif
@@ -27,6 +27,7 @@
 #include "JSBasePrivate.h"
 #include "JSContextRefPrivate.h"
 #include "JSObjectRefPrivate.h"
+#include <limits.h>
 #include <math.h>
 #define ASSERT_DISABLED 0
 #include <wtf/Assertions.h>
@@ -776,6 +777,33 @@ static JSValueRef print_callAsFunction(JSContextRef ctx, JSObjectRef functionObj
     return JSValueMakeUndefined(ctx);
 }
 
+static JSNativeValue typedAdd_callAsFunction(JSContextRef ctx, const JSNativeValue arguments[], JSValueRef* exception)
+{
+    JSNativeValue result;
+    if (arguments[1].int32 < 0) {
+        JSStringRef message = JSStringCreateWithUTF8CString("negative count");
+        *exception = JSValueMakeString(ctx, message);
+        JSStringRelease(message);
+        result.number = 0;
+        return result;
+    }
+    result.number = arguments[2].boolean ? arguments[0].number * arguments[1].int32 : arguments[0].number + arguments[1].int32;
+    return result;
+}
+
+static JSNativeValue typedConcat_callAsFunction(JSContextRef ctx, const JSNativeValue arguments[], JSValueRef* exception)
+{
+    UNUSED_PARAM(ctx);
+    UNUSED_PARAM(exception);
+
+    JSNativeValue result;
+    char buffer[64];
+    size_t length = JSStringGetUTF8CString(arguments[0].string, buffer, sizeof(buffer));
+    sprintf(buffer + length - 1, "%d", arguments[1].int32);
+    result.string = JSStringCreateWithUTF8CString(buffer);
+    return result;
+}
+
 static JSObjectRef myConstructor_callAsConstructor(JSContextRef context, JSObjectRef constructorObject, size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception)
 {
     UNUSED_PARAM(constructorObject);
@@ -937,6 +965,366 @@ static bool checkForCycleInPrototypeChain()
     return result;
 }
 
+static int typedArrayBytesDeallocatorCallCount;
+static void typedArrayBytesDeallocator(void* bytes, void* deallocatorContext)
+{
+    ASSERT(deallocatorContext == &typedArrayBytesDeallocatorCallCount);
+    free(bytes);
+    ++typedArrayBytesDeallocatorCallCount;
+}
+
+typedef struct {
+    int callCount;
+    const void* chars;
+} StringFinalizeRecord;
+
+static void stringFinalize(void* context, const void* chars)
+{
+    StringFinalizeRecord* record = (StringFinalizeRecord*)context;
+    ++record->callCount;
+    record->chars = chars;
+}
+
+static bool stringEqualsValue(JSContextRef context, JSStringRef string, JSValueRef value)
+{
+    JSStringRef valueString = JSValueToStringCopy(context, value, NULL);
+    bool result = JSStringIsEqual(string, valueString);
+    JSStringRelease(valueString);
+    return result;
+}
+
+static bool checkStringCreation()
+{
+    bool result = true;
+    JSGlobalContextRef context = JSGlobalContextCreate(0);
+    JSObjectRef globalObject = JSContextGetGlobalObject(context);
+
+    // Latin-1 characters are kept one byte per character.
+    JSStringRef latin1 = JSStringCreateWithLatin1Characters("caf\xe9", 4);
+    result &= assertTrue(JSStringIs8Bit(latin1), "JSStringCreateWithLatin1Characters makes an 8-bit string");
+    result &= assertTrue(JSStringGetLength(latin1) == 4, "JSStringCreateWithLatin1Characters length");
+    result &= assertTrue(!memcmp(JSStringGetLatin1CharactersPtr(latin1), "caf\xe9", 4), "JSStringGetLatin1CharactersPtr on a Latin-1 string");
+    result &= assertTrue(JSStringGetCharactersPtr(latin1)[3] == 0xe9, "JSStringGetCharactersPtr on a Latin-1 string");
+    result &= assertTrue(stringEqualsValue(context, latin1, JSValueMakeString(context, latin1)), "Latin-1 string round trips through a JSValue");
+
+    // UTF8 is kept 8-bit only if it is all ASCII.
+    JSStringRef ascii = JSStringCreateWithUTF8Characters("abcdef", 3);
+    result &= assertTrue(JSStringIs8Bit(ascii), "JSStringCreateWithUTF8Characters makes an 8-bit string from ASCII");
+    result &= assertTrue(JSStringIsEqualToUTF8CString(ascii, "abc"), "JSStringCreateWithUTF8Characters takes numBytes bytes");
+    JSStringRef utf8 = JSStringCreateWithUTF8Characters("caf\xc3\xa9", 5);
+    result &= assertTrue(!JSStringIs8Bit(utf8), "JSStringCreateWithUTF8Characters makes a 16-bit string from non-ASCII");
+    result &= assertTrue(!JSStringGetLatin1CharactersPtr(utf8), "JSStringGetLatin1CharactersPtr on a 16-bit string");
+    result &= assertTrue(JSStringIsEqual(utf8, latin1), "UTF8 and Latin-1 strings with the same characters are equal");
+    JSStringRef invalidUTF8 = JSStringCreateWithUTF8Characters("\xff", 1);
+    result &= assertTrue(!JSStringGetLength(invalidUTF8), "JSStringCreateWithUTF8Characters on invalid UTF8");
+    JSStringRelease(invalidUTF8);
+    JSStringRelease(utf8);
+    JSStringRelease(ascii);
+    JSStringRelease(latin1);
+
+    // NoCopy strings use the buffer in place, and so do the values made from them,
+    // so the buffer is finalized once the JSString and those values are gone.
+    static const JSChar characters[] = { 'n', 'o', 0x0441, 'o', 'p', 'y' };
+    StringFinalizeRecord charactersRecord = { 0, NULL };
+    JSStringRef noCopy = JSStringCreateWithCharactersNoCopy(characters, 6, stringFinalize, &charactersRecord);
+    result &= assertTrue(JSStringGetCharactersPtr(noCopy) == characters, "JSStringCreateWithCharactersNoCopy uses the buffer in place");
+    result &= assertTrue(!JSStringIs8Bit(noCopy), "JSStringCreateWithCharactersNoCopy makes a 16-bit string");
+    JSValueRef noCopyValue = JSValueMakeString(context, noCopy);
+    JSValueProtect(context, noCopyValue);
+    JSObjectSetProperty(context, globalObject, noCopy, noCopyValue, kJSPropertyAttributeNone, NULL);
+    JSStringRelease(noCopy);
+    result &= assertTrue(!charactersRecord.callCount, "A NoCopy string is not finalized while a value made from it is alive");
+    JSStringRef roundTrip = JSValueToStringCopy(context, noCopyValue, NULL);
+    result &= assertTrue(JSStringGetCharactersPtr(roundTrip) == characters, "A value made from a NoCopy string converts back without a copy");
+    JSStringRelease(roundTrip);
+
+    static const char latin1Characters[] = "no copy \xe9";
+    StringFinalizeRecord latin1Record = { 0, NULL };
+    JSStringRef latin1NoCopy = JSStringCreateWithLatin1CharactersNoCopy(latin1Characters, 9, stringFinalize, &latin1Record);
+    result &= assertTrue(JSStringIs8Bit(latin1NoCopy), "JSStringCreateWithLatin1CharactersNoCopy makes an 8-bit string");
+    result &= assertTrue(JSStringGetLatin1CharactersPtr(latin1NoCopy) == latin1Characters, "JSStringCreateWithLatin1CharactersNoCopy uses the buffer in place");
+    result &= assertTrue(JSStringGetLength(latin1NoCopy) == 9, "JSStringCreateWithLatin1CharactersNoCopy length");
+    JSObjectSetProperty(context, globalObject, latin1NoCopy, noCopyValue, kJSPropertyAttributeNone, NULL);
+    result &= assertTrue(!latin1Record.callCount, "A NoCopy string is not finalized while it is alive");
+    JSStringRelease(latin1NoCopy);
+    result &= assertTrue(latin1Record.callCount == 1 && latin1Record.chars == latin1Characters, "Releasing a Latin-1 NoCopy string finalizes its buffer once");
+
+    JSStringRef withoutFinalize = JSStringCreateWithLatin1CharactersNoCopy(latin1Characters, 2, NULL, NULL);
+    result &= assertTrue(JSStringIsEqualToUTF8CString(withoutFinalize, "no"), "JSStringCreateWithLatin1CharactersNoCopy without a finalize callback");
+    JSStringRelease(withoutFinalize);
+
+    // Properties named by NoCopy strings hold copies of the characters, so they
+    // outlive the Latin-1 buffer.
+    JSStringRef expected = JSStringCreateWithCharacters(characters, 6);
+    result &= assertTrue(stringEqualsValue(context, expected, noCopyValue), "A value made from a NoCopy string outlives the JSString");
+    result &= assertTrue(JSObjectHasProperty(context, globalObject, expected), "A property named by a NoCopy string outlives it");
+    JSStringRelease(expected);
+    expected = JSStringCreateWithLatin1Characters(latin1Characters, 9);
+    result &= assertTrue(JSObjectHasProperty(context, globalObject, expected), "A property named by a Latin-1 NoCopy string outlives it");
+    JSStringRelease(expected);
+
+    JSValueUnprotect(context, noCopyValue);
+    JSGlobalContextRelease(context);
+    result &= assertTrue(charactersRecord.callCount == 1 && charactersRecord.chars == characters, "A NoCopy buffer is finalized once the values made from it are gone");
+    result &= assertTrue(latin1Record.callCount == 1, "NoCopy buffers are finalized only once");
+    return result;
+}
+
+static JSValueRef evaluateScript(JSContextRef context, const char* source)
+{
+    JSStringRef script = JSStringCreateWithUTF8CString(source);
+    JSValueRef result = JSEvaluateScript(context, script, NULL, NULL, 1, NULL);
+    JSStringRelease(script);
+    return result;
+}
+
+static bool valueIsNumber(JSContextRef context, JSValueRef value, double expected)
+{
+    return value && JSValueIsNumber(context, value) && JSValueToNumber(context, value, NULL) == expected;
+}
+
+static bool checkBatchPropertyAccess()
+{
+    bool result = true;
+    JSGlobalContextRef context = JSGlobalContextCreate(0);
+    JSStringRef names[3] = { JSStringCreateWithUTF8CString("a"), JSStringCreateWithUTF8CString("b"), JSStringCreateWithUTF8CString("c") };
+    JSValueRef values[4];
+    JSValueRef exception;
+
+    JSValueRef numbers[3] = { JSValueMakeNumber(context, 1), JSValueMakeNumber(context, 2), JSValueMakeNumber(context, 3) };
+    JSObjectRef object = JSObjectMakeWithProperties(context, 3, names, numbers, NULL);
+    JSObjectGetProperties(context, object, 3, names, values, NULL);
+    result &= assertTrue(valueIsNumber(context, values[0], 1) && valueIsNumber(context, values[1], 2) && valueIsNumber(context, values[2], 3), "JSObjectMakeWithProperties sets every property");
+    JSObjectRef emptyObject = JSObjectMakeWithProperties(context, 0, NULL, NULL, NULL);
+    result &= assertTrue(!JSObjectHasProperty(context, emptyObject, names[0]), "JSObjectMakeWithProperties with no properties");
+    JSObjectRef keys = JSValueToObject(context, evaluateScript(context, "(function (o) { return Object.keys(o).join(); })"), NULL);
+    JSValueRef keysArguments[] = { object };
+    assertEqualsAsUTF8String(JSObjectCallAsFunction(context, keys, NULL, 1, keysArguments, NULL), "a,b,c");
+
+    // Properties are assigned, not defined: __proto__ sets the prototype, index-like
+    // names are ordinary properties, and a throwing setter on the Object prototype
+    // fails the whole call.
+    JSStringRef specialNames[2] = { JSStringCreateWithUTF8CString("__proto__"), JSStringCreateWithUTF8CString("0") };
+    JSValueRef specialValues[2] = { emptyObject, numbers[0] };
+    object = JSObjectMakeWithProperties(context, 2, specialNames, specialValues, NULL);
+    result &= assertTrue(JSObjectGetPrototype(context, object) == emptyObject, "JSObjectMakeWithProperties sets the prototype through __proto__");
+    result &= assertTrue(!JSObjectHasProperty(context, emptyObject, specialNames[1]) && valueIsNumber(context, JSObjectGetPropertyAtIndex(context, object, 0, NULL), 1), "JSObjectMakeWithProperties with an index-like name");
+    JSObjectRef lookUpOwn = JSValueToObject(context, evaluateScript(context, "(function (o) { return Object.getOwnPropertyNames(o).join(); })"), NULL);
+    keysArguments[0] = object;
+    assertEqualsAsUTF8String(JSObjectCallAsFunction(context, lookUpOwn, NULL, 1, keysArguments, NULL), "0");
+    evaluateScript(context, "Object.defineProperty(Object.prototype, 'b', { set: function () { throw 'b throws'; }, configurable: true })");
+    exception = NULL;
+    result &= assertTrue(!JSObjectMakeWithProperties(context, 3, names, numbers, &exception) && !!exception, "JSObjectMakeWithProperties reports an exception from a setter");
+    evaluateScript(context, "delete Object.prototype.b");
+    JSStringRelease(specialNames[0]);
+    JSStringRelease(specialNames[1]);
+
+    // A getter that throws stops the batch, and the rest of the values are undefined.
+    object = JSValueToObject(context, evaluateScript(context, "({ a: 1, get b() { throw 'b throws'; }, c: 3 })"), NULL);
+    exception = NULL;
+    JSObjectGetProperties(context, object, 3, names, values, &exception);
+    result &= assertTrue(valueIsNumber(context, values[0], 1), "JSObjectGetProperties gets properties before an exception");
+    result &= assertTrue(JSValueIsUndefined(context, values[1]) && JSValueIsUndefined(context, values[2]), "JSObjectGetProperties stores undefined from the exception on");
+    result &= assertTrue(!!exception, "JSObjectGetProperties reports an exception");
+    if (exception)
+        assertEqualsAsUTF8String(exception, "b throws");
+    object = JSObjectMake(context, NULL, NULL);
+    JSObjectGetProperties(context, object, 3, names, values, NULL);
+    result &= assertTrue(JSValueIsUndefined(context, values[0]) && JSValueIsUndefined(context, values[2]), "JSObjectGetProperties on missing properties");
+
+    // A setter that throws stops the batch; later properties are not set.
+    object = JSValueToObject(context, evaluateScript(context, "({ set b(value) { throw 'b throws'; } })"), NULL);
+    exception = NULL;
+    JSObjectSetProperties(context, object, 3, names, numbers, kJSPropertyAttributeNone, &exception);
+    result &= assertTrue(!!exception, "JSObjectSetProperties reports an exception");
+    JSObjectGetProperties(context, object, 3, names, values, NULL);
+    result &= assertTrue(valueIsNumber(context, values[0], 1), "JSObjectSetProperties sets properties before an exception");
+    result &= assertTrue(!JSObjectHasProperty(context, object, names[2]), "JSObjectSetProperties stops at an exception");
+
+    // Attributes apply to the properties that the batch adds.
+    object = JSObjectMake(context, NULL, NULL);
+    JSObjectSetProperties(context, object, 3, names, numbers, kJSPropertyAttributeReadOnly, NULL);
+    JSObjectSetProperty(context, object, names[1], JSValueMakeNumber(context, 20), kJSPropertyAttributeNone, NULL);
+    result &= assertTrue(valueIsNumber(context, JSObjectGetProperty(context, object, names[1], NULL), 2), "JSObjectSetProperties applies attributes");
+
+    // Arrays are read and written directly where they have elements, and through
+    // the object otherwise.
+    JSObjectRef array = JSValueToObject(context, evaluateScript(context, "[10, 20, , 40]"), NULL);
+    evaluateScript(context, "Object.defineProperty(Array.prototype, 2, { get: function () { return 30; }, configurable: true })");
+    JSObjectGetPropertiesAtIndexes(context, array, 0, 4, values, NULL);
+    result &= assertTrue(valueIsNumber(context, values[0], 10) && valueIsNumber(context, values[1], 20) && valueIsNumber(context, values[2], 30) && valueIsNumber(context, values[3], 40), "JSObjectGetPropertiesAtIndexes on an array with a hole");
+    JSObjectGetPropertiesAtIndexes(context, array, 3, 2, values, NULL);
+    result &= assertTrue(valueIsNumber(context, values[0], 40) && JSValueIsUndefined(context, values[1]), "JSObjectGetPropertiesAtIndexes past the end of an array");
+    evaluateScript(context, "delete Array.prototype[2]");
+
+    JSObjectSetPropertiesAtIndexes(context, array, 3, 3, numbers, NULL);
+    JSObjectGetPropertiesAtIndexes(context, array, 2, 4, values, NULL);
+    result &= assertTrue(JSValueIsUndefined(context, values[0]) && valueIsNumber(context, values[1], 1) && valueIsNumber(context, values[2], 2) && valueIsNumber(context, values[3], 3), "JSObjectSetPropertiesAtIndexes on and past the end of an array");
+    JSStringRef length = JSStringCreateWithUTF8CString("length");
+    result &= assertTrue(valueIsNumber(context, JSObjectGetProperty(context, array, length, NULL), 6), "JSObjectSetPropertiesAtIndexes extends an array");
+    JSStringRelease(length);
+
+    object = JSValueToObject(context, evaluateScript(context, "({ 0: 'zero', get 1() { throw 'one throws'; }, 2: 'two' })"), NULL);
+    exception = NULL;
+    JSObjectGetPropertiesAtIndexes(context, object, 0, 3, values, &exception);
+    result &= assertTrue(!!exception, "JSObjectGetPropertiesAtIndexes reports an exception");
+    assertEqualsAsUTF8String(values[0], "zero");
+    result &= assertTrue(JSValueIsUndefined(context, values[1]) && JSValueIsUndefined(context, values[2]), "JSObjectGetPropertiesAtIndexes stores undefined from the exception on");
+
+    object = JSValueToObject(context, evaluateScript(context, "({ set 1(value) { throw 'one throws'; } })"), NULL);
+    exception = NULL;
+    JSObjectSetPropertiesAtIndexes(context, object, 0, 3, numbers, &exception);
+    result &= assertTrue(!!exception, "JSObjectSetPropertiesAtIndexes reports an exception");
+    JSObjectGetPropertiesAtIndexes(context, object, 0, 3, values, NULL);
+    result &= assertTrue(valueIsNumber(context, values[0], 1) && JSValueIsUndefined(context, values[2]), "JSObjectSetPropertiesAtIndexes stops at an exception");
+
+    // Runs of indexes that would wrap past UINT_MAX are rejected up front.
+    object = JSObjectMake(context, NULL, NULL);
+    exception = NULL;
+    JSObjectSetPropertiesAtIndexes(context, object, UINT_MAX - 1, 3, numbers, &exception);
+    result &= assertTrue(!!exception && JSValueIsInstanceOfConstructor(context, exception, JSValueToObject(context, evaluateScript(context, "RangeError"), NULL), NULL), "JSObjectSetPropertiesAtIndexes throws a RangeError when the indexes wrap");
+    result &= assertTrue(JSValueIsUndefined(context, JSObjectGetPropertyAtIndex(context, object, 0, NULL)) && JSValueIsUndefined(context, JSObjectGetPropertyAtIndex(context, object, UINT_MAX - 1, NULL)), "JSObjectSetPropertiesAtIndexes sets nothing when the indexes wrap");
+    JSObjectSetPropertiesAtIndexes(context, object, UINT_MAX - 1, 2, numbers, NULL);
+    exception = NULL;
+    JSObjectGetPropertiesAtIndexes(context, object, UINT_MAX - 1, 2, values, &exception);
+    result &= assertTrue(!exception && valueIsNumber(context, values[0], 1) && valueIsNumber(context, values[1], 2), "JSObjectGetPropertiesAtIndexes up to UINT_MAX");
+    JSObjectGetPropertiesAtIndexes(context, object, UINT_MAX - 1, 3, values, &exception);
+    result &= assertTrue(!!exception && JSValueIsUndefined(context, values[0]) && JSValueIsUndefined(context, values[2]), "JSObjectGetPropertiesAtIndexes throws when the indexes wrap");
+
+    JSStringRelease(names[0]);
+    JSStringRelease(names[1]);
+    JSStringRelease(names[2]);
+    JSGlobalContextRelease(context);
+    return result;
+}
+
+static bool checkPropertyKeys()
+{
+    bool result = true;
+    JSContextGroupRef group = JSContextGroupCreate();
+    JSStringRef name = JSStringCreateWithUTF8CString("keyed");
+    JSPropertyKeyRef key = JSPropertyKeyCreate(group, name);
+    JSGlobalContextRef context = JSGlobalContextCreateInGroup(group, 0);
+    // The key and the context both keep the group alive.
+    JSContextGroupRelease(group);
+
+    JSStringRef copiedName = JSPropertyKeyCopyName(key);
+    result &= assertTrue(JSStringIsEqual(copiedName, name), "JSPropertyKeyCopyName returns the name");
+    JSStringRelease(copiedName);
+
+    JSObjectRef object = JSObjectMake(context, NULL, NULL);
+    result &= assertTrue(!JSObjectHasPropertyForKey(context, object, key), "JSObjectHasPropertyForKey before setting the property");
+    result &= assertTrue(JSValueIsUndefined(context, JSObjectGetPropertyForKey(context, object, key, NULL)), "JSObjectGetPropertyForKey before setting the property");
+    JSObjectSetPropertyForKey(context, object, key, JSValueMakeNumber(context, 42), kJSPropertyAttributeNone, NULL);
+    result &= assertTrue(JSObjectHasPropertyForKey(context, object, key), "JSObjectHasPropertyForKey after setting the property");
+    result &= assertTrue(valueIsNumber(context, JSObjectGetPropertyForKey(context, object, key, NULL), 42), "JSObjectGetPropertyForKey after setting the property");
+    result &= assertTrue(valueIsNumber(context, JSObjectGetProperty(context, object, name, NULL), 42), "JSObjectSetPropertyForKey and JSObjectGetProperty agree");
+
+    // A key is the same as the name it was made from.
+    JSObjectSetProperty(context, object, name, JSValueMakeNumber(context, 43), kJSPropertyAttributeDontDelete, NULL);
+    result &= assertTrue(valueIsNumber(context, JSObjectGetPropertyForKey(context, object, key, NULL), 43), "JSObjectSetProperty and JSObjectGetPropertyForKey agree");
+    result &= assertTrue(!JSObjectDeletePropertyForKey(context, object, key, NULL), "JSObjectDeletePropertyForKey on a DontDelete property");
+    object = JSObjectMake(context, NULL, NULL);
+    JSObjectSetPropertyForKey(context, object, key, JSValueMakeNumber(context, 44), kJSPropertyAttributeNone, NULL);
+    result &= assertTrue(JSObjectDeletePropertyForKey(context, object, key, NULL) && !JSObjectHasProperty(context, object, name), "JSObjectDeletePropertyForKey");
+
+    JSObjectRef other = JSValueToObject(context, evaluateScript(context, "({ get keyed() { throw 'keyed throws'; } })"), NULL);
+    JSValueRef exception = NULL;
+    result &= assertTrue(!JSObjectGetPropertyForKey(context, other, key, &exception) && exception, "JSObjectGetPropertyForKey reports an exception");
+
+    JSPropertyKeyRef retained = JSPropertyKeyRetain(key);
+    result &= assertTrue(retained == key, "JSPropertyKeyRetain returns the key");
+    JSPropertyKeyRelease(retained);
+
+    // The key outlives the only context in its group, and takes the group with it.
+    JSGlobalContextRelease(context);
+    copiedName = JSPropertyKeyCopyName(key);
+    result &= assertTrue(JSStringIsEqual(copiedName, name), "JSPropertyKeyCopyName after the context is released");
+    JSStringRelease(copiedName);
+    JSPropertyKeyRelease(key);
+
+    JSStringRelease(name);
+    return result;
+}
+
+static unsigned decliningGetCount;
+static JSValueRef Declining_get(JSContextRef ctx, JSObjectRef object, JSStringRef propertyName, JSValueRef* exception)
+{
+    UNUSED_PARAM(ctx);
+    UNUSED_PARAM(object);
+    UNUSED_PARAM(propertyName);
+    UNUSED_PARAM(exception);
+
+    ++decliningGetCount;
+    return NULL; // look the property up as if there were no static value
+}
+
+static unsigned decliningSetCount;
+static bool Declining_set(JSContextRef ctx, JSObjectRef object, JSStringRef propertyName, JSValueRef value, JSValueRef* exception)
+{
+    UNUSED_PARAM(ctx);
+    UNUSED_PARAM(object);
+    UNUSED_PARAM(propertyName);
+    UNUSED_PARAM(value);
+    UNUSED_PARAM(exception);
+
+    ++decliningSetCount;
+    return false; // set the property as if there were no static value
+}
+
+static JSStaticValue Declining_staticValues[] = {
+    { "declined", Declining_get, Declining_set, kJSPropertyAttributeNone },
+    { "inherited", Declining_get, NULL, kJSPropertyAttributeNone },
+    { 0, 0, 0, 0 }
+};
+
+// Inline caches may remember where a static value of a callback object was found,
+// but every get and put must still go through its callbacks.
+static bool checkDecliningStaticValues()
+{
+    bool result = true;
+    const unsigned objectCount = 100;
+    const unsigned roundCount = 20;
+
+    JSClassDefinition definition = kJSClassDefinitionEmpty;
+    definition.staticValues = Declining_staticValues;
+    JSClassRef jsClass = JSClassCreate(&definition);
+    JSGlobalContextRef context = JSGlobalContextCreate(0);
+
+    evaluateScript(context, "Object.prototype.inherited = 'inherited';");
+    JSObjectRef touch = JSValueToObject(context, evaluateScript(context,
+        "(function (objects, round) {"
+        "    var sum = 0;"
+        "    for (var i = 0; i < objects.length; ++i) {"
+        "        objects[i].declined = round;"
+        "        sum += objects[i].declined;"
+        "        if (objects[i].inherited !== 'inherited')"
+        "            return -1;"
+        "    }"
+        "    return sum;"
+        "})"), NULL);
+
+    decliningGetCount = 0;
+    decliningSetCount = 0;
+    for (unsigned round = 0; round < roundCount; ++round) {
+        // Fresh objects each round, so that a cached transition would skip the setter.
+        JSObjectRef objects = JSObjectMakeArray(context, 0, NULL, NULL);
+        for (unsigned i = 0; i < objectCount; ++i)
+            JSObjectSetPropertyAtIndex(context, objects, i, JSObjectMake(context, jsClass, NULL), NULL);
+        JSValueRef arguments[] = { objects, JSValueMakeNumber(context, round) };
+        JSValueRef sum = JSObjectCallAsFunction(context, touch, NULL, 2, arguments, NULL);
+        result &= assertTrue(valueIsNumber(context, sum, (double)objectCount * round), "A declined static value is set and read as an ordinary property");
+        JSValueRef secondSum = JSObjectCallAsFunction(context, touch, NULL, 2, arguments, NULL);
+        result &= assertTrue(valueIsNumber(context, secondSum, (double)objectCount * round), "A declined static value is replaced as an ordinary property");
+    }
+    result &= assertTrue(decliningSetCount == 2 * objectCount * roundCount, "A declining static setter is called on every put");
+    result &= assertTrue(decliningGetCount == 4 * objectCount * roundCount, "A static getter that returns NULL is called on every get");
+
+    JSGlobalContextRelease(context);
+    JSClassRelease(jsClass);
+    return result;
+}
+
 static void checkConstnessInJSObjectNames()
 {
     JSStaticFunction fun;
@@ -1382,6 +1770,39 @@ int main(int argc, char* argv[])
     ASSERT(!JSObjectSetPrivate(printFunction, (void*)1));
     ASSERT(!JSObjectGetPrivate(printFunction));
 
+    JSNativeType typedAddArgumentTypes[] = { kJSNativeTypeDouble, kJSNativeTypeInt32, kJSNativeTypeBoolean };
+    JSStringRef typedAddIString = JSStringCreateWithUTF8CString("typedAdd");
+    JSObjectRef typedAddFunction = JSObjectMakeFunctionWithTypedCallback(context, typedAddIString, kJSNativeTypeDouble, 3, typedAddArgumentTypes, typedAdd_callAsFunction);
+    JSObjectSetProperty(context, globalObject, typedAddIString, typedAddFunction, kJSPropertyAttributeNone, NULL);
+    JSStringRelease(typedAddIString);
+
+    JSNativeType typedConcatArgumentTypes[] = { kJSNativeTypeString, kJSNativeTypeInt32 };
+    JSStringRef typedConcatIString = JSStringCreateWithUTF8CString("typedConcat");
+    JSObjectRef typedConcatFunction = JSObjectMakeFunctionWithTypedCallback(context, typedConcatIString, kJSNativeTypeString, 2, typedConcatArgumentTypes, typedConcat_callAsFunction);
+    JSObjectSetProperty(context, globalObject, typedConcatIString, typedConcatFunction, kJSPropertyAttributeNone, NULL);
+    JSStringRelease(typedConcatIString);
+
+    JSNativeType voidArgumentTypes[] = { kJSNativeTypeVoid };
+    ASSERT(!JSObjectMakeFunctionWithTypedCallback(context, NULL, kJSNativeTypeVoid, 1, voidArgumentTypes, typedAdd_callAsFunction));
+
+    {
+        JSStringRef script = JSStringCreateWithUTF8CString("var total = 0; for (var i = 0; i < 10000; ++i) total = typedAdd(total, i & 3, false); total");
+        assertEqualsAsNumber(JSEvaluateScript(context, script, NULL, NULL, 1, NULL), 15000);
+        JSStringRelease(script);
+
+        script = JSStringCreateWithUTF8CString("var r = []; for (var i = 0; i < 1000; ++i) r = [typedAdd(1.5, 2, true), typedAdd('1', 2.5, 1), typedAdd(1)]; r.join()");
+        assertEqualsAsUTF8String(JSEvaluateScript(context, script, NULL, NULL, 1, NULL), "3,2,NaN");
+        JSStringRelease(script);
+
+        script = JSStringCreateWithUTF8CString("var caught = 0; for (var i = 0; i < 1000; ++i) { try { typedAdd(1, -1, false); } catch (e) { if (e === 'negative count') ++caught; } } caught");
+        assertEqualsAsNumber(JSEvaluateScript(context, script, NULL, NULL, 1, NULL), 1000);
+        JSStringRelease(script);
+
+        script = JSStringCreateWithUTF8CString("typedConcat('item', 4.7) + ' ' + typedConcat.length");
+        assertEqualsAsUTF8String(JSEvaluateScript(context, script, NULL, NULL, 1, NULL), "item4 2");
+        JSStringRelease(script);
+    }
+
     JSStringRef myConstructorIString = JSStringCreateWithUTF8CString("MyConstructor");
     JSObjectRef myConstructor = JSObjectMakeConstructor(context, NULL, myConstructor_callAsConstructor);
     JSObjectSetProperty(context, globalObject, myConstructorIString, myConstructor, kJSPropertyAttributeNone, NULL);
@@ -1431,6 +1852,45 @@ int main(int argc, char* argv[])
     assertEqualsAsNumber(v, 0);
     JSStringRelease(string);
 
+    o = JSObjectMakeTypedArray(context, kJSTypedArrayTypeInt32Array, 4, NULL);
+    ASSERT(JSValueGetTypedArrayType(context, o, NULL) == kJSTypedArrayTypeInt32Array);
+    ASSERT(JSObjectGetTypedArrayLength(context, o, NULL) == 4);
+    ASSERT(JSObjectGetTypedArrayByteLength(context, o, NULL) == 16);
+    ASSERT(JSObjectGetTypedArrayByteOffset(context, o, NULL) == 0);
+    ((int32_t*)JSObjectGetTypedArrayBytesPtr(context, o, NULL))[2] = 42;
+    assertEqualsAsNumber(JSObjectGetPropertyAtIndex(context, o, 2, NULL), 42);
+    JSObjectSetPropertyAtIndex(context, o, 3, JSValueMakeNumber(context, -7), NULL);
+    ASSERT(((int32_t*)JSObjectGetTypedArrayBytesPtr(context, o, NULL))[3] == -7);
+    v = JSObjectGetTypedArrayBuffer(context, o, NULL);
+    ASSERT(JSValueGetTypedArrayType(context, v, NULL) == kJSTypedArrayTypeArrayBuffer);
+    ASSERT(JSObjectGetArrayBufferByteLength(context, (JSObjectRef)v, NULL) == 16);
+    ASSERT(JSObjectGetArrayBufferBytesPtr(context, (JSObjectRef)v, NULL) == JSObjectGetTypedArrayBytesPtr(context, o, NULL));
+    ASSERT(JSValueGetTypedArrayType(context, JSObjectMakeArray(context, 0, NULL, NULL), NULL) == kJSTypedArrayTypeNone);
+    ASSERT(!JSObjectGetTypedArrayBytesPtr(context, JSObjectMakeArray(context, 0, NULL, NULL), NULL));
+
+    exception = NULL;
+    ASSERT(!JSObjectMakeTypedArray(context, kJSTypedArrayTypeArrayBuffer, 4, &exception));
+    ASSERT(exception);
+
+    double* typedArrayBytes = (double*)malloc(3 * sizeof(double));
+    typedArrayBytes[0] = 1.5;
+    typedArrayBytes[1] = 2.5;
+    typedArrayBytes[2] = 3.5;
+    o = JSObjectMakeTypedArrayWithBytesNoCopy(context, kJSTypedArrayTypeFloat64Array, typedArrayBytes, 3 * sizeof(double), typedArrayBytesDeallocator, &typedArrayBytesDeallocatorCallCount, NULL);
+    ASSERT(JSObjectGetTypedArrayBytesPtr(context, o, NULL) == typedArrayBytes);
+    assertEqualsAsNumber(JSObjectGetPropertyAtIndex(context, o, 1, NULL), 2.5);
+    JSObjectSetPropertyAtIndex(context, o, 0, JSValueMakeNumber(context, 0.25), NULL);
+    ASSERT(typedArrayBytes[0] == 0.25);
+    exception = NULL;
+    ASSERT(!JSObjectMakeTypedArrayWithBytesNoCopy(context, kJSTypedArrayTypeFloat64Array, typedArrayBytes, 3, NULL, NULL, &exception));
+    ASSERT(exception);
+    o = NULL;
+    typedArrayBytes = NULL;
+    JSGarbageCollect(context);
+    // The conservative scan may still find the array on the stack, so it is only
+    // certain to be gone once the heap is destroyed, below.
+    ASSERT(typedArrayBytesDeallocatorCallCount <= 1);
+
     JSValueRef argumentsDateValues[] = { JSValueMakeNumber(context, 0) };
     o = JSObjectMakeDate(context, 1, argumentsDateValues, NULL);
     if (timeZoneIsPST())
@@ -1537,6 +1997,14 @@ int main(int argc, char* argv[])
     JSGlobalContextRelease(context);
     JSClassRelease(globalObjectClass);
 
+    // Releasing the last context in the group destroyed its heap, which must have
+    // freed the bytes of the no-copy typed array exactly once.
+    if (typedArrayBytesDeallocatorCallCount != 1) {
+        printf("FAIL: Typed array bytes deallocator was called %d times.\n", typedArrayBytesDeallocatorCallCount);
+        failed = 1;
+    } else
+        printf("PASS: Typed array bytes deallocator was called once.\n");
+
     // Test for an infinite prototype chain that used to be created. This test
     // passes if the call to JSObjectHasProperty() does not hang.
 
@@ -1553,6 +2021,26 @@ int main(int argc, char* argv[])
 
     printf("PASS: Infinite prototype chain does not occur.\n");
 
+    if (checkStringCreation())
+        printf("PASS: Strings keep their Latin-1 storage and NoCopy buffers are finalized once.\n");
+    else
+        printf("FAIL: Strings do not keep their Latin-1 storage, or NoCopy buffers are not finalized once.\n");
+
+    if (checkBatchPropertyAccess())
+        printf("PASS: Batch property access stops at the first exception.\n");
+    else
+        printf("FAIL: Batch property access does not stop at the first exception.\n");
+
+    if (checkPropertyKeys())
+        printf("PASS: JSPropertyKeys work and outlive their contexts.\n");
+    else
+        printf("FAIL: JSPropertyKeys do not work or do not outlive their contexts.\n");
+
+    if (checkDecliningStaticValues())
+        printf("PASS: Static values whose callbacks decline are looked up every time.\n");
+    else
+        printf("FAIL: Static values whose callbacks decline are not looked up every time.\n");
+
     if (checkForCycleInPrototypeChain())
         printf("PASS: A cycle in a prototype chain can't be created.\n");
     else {
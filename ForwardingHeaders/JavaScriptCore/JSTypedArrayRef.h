@@ -0,0 +1 @@
+#include <JavaScriptCore/API/JSTypedArrayRef.h>
@@ -42,6 +42,7 @@ SOURCES += \
     API/JSClassRef.cpp \
     API/JSContextRef.cpp \
     API/JSObjectRef.cpp \
+    API/JSTypedArrayRef.cpp \
     API/JSStringRef.cpp \
     API/JSValueRef.cpp \
     API/OpaqueJSString.cpp \
@@ -62,6 +63,7 @@ SOURCES += \
     bytecode/PredictedType.cpp \
     bytecode/PutByIdStatus.cpp \
     bytecode/SamplingTool.cpp \
+    bytecode/SharedCodeBlockData.cpp \
     bytecode/StructureStubInfo.cpp \
     bytecode/ValueProfile.cpp \
     bytecompiler/BytecodeGenerator.cpp \
@@ -88,6 +90,8 @@ SOURCES += \
     dfg/DFGCapabilities.cpp \
     dfg/DFGCorrectableJumpPoint.cpp \
     dfg/DFGDriver.cpp \
+    dfg/DFGNaturalLoops.cpp \
+    dfg/DFGDominators.cpp \
     dfg/DFGGraph.cpp \
     dfg/DFGJITCompiler.cpp \
     dfg/DFGOperations.cpp \
@@ -96,12 +100,14 @@ SOURCES += \
     dfg/DFGOSRExitCompiler.cpp \
     dfg/DFGOSRExitCompiler64.cpp \
     dfg/DFGOSRExitCompiler32_64.cpp \
+    dfg/DFGPlan.cpp \
     dfg/DFGPropagator.cpp \
     dfg/DFGRepatch.cpp \
     dfg/DFGSpeculativeJIT.cpp \
     dfg/DFGSpeculativeJIT32_64.cpp \
     dfg/DFGSpeculativeJIT64.cpp \
     dfg/DFGThunks.cpp \
+    dfg/DFGWorklist.cpp \
     interpreter/AbstractPC.cpp \
     interpreter/CallFrame.cpp \
     interpreter/Interpreter.cpp \
@@ -161,6 +167,9 @@ SOURCES += \
     runtime/JSActivation.cpp \
     runtime/JSAPIValueWrapper.cpp \
     runtime/JSArray.cpp \
+    runtime/JSArrayBuffer.cpp \
+    runtime/JSArrayBufferConstructor.cpp \
+    runtime/JSArrayBufferPrototype.cpp \
     runtime/JSByteArray.cpp \
     runtime/JSCell.cpp \
     runtime/JSDateMath.cpp \
@@ -177,6 +186,9 @@ SOURCES += \
     runtime/JSPropertyNameIterator.cpp \
     runtime/JSStaticScopeObject.cpp \
     runtime/JSString.cpp \
+    runtime/JSTypedArray.cpp \
+    runtime/JSTypedArrayConstructor.cpp \
+    runtime/JSTypedArrayPrototype.cpp \
     runtime/JSValue.cpp \
     runtime/JSVariableObject.cpp \
     runtime/JSWrapperObject.cpp \
@@ -213,6 +225,8 @@ SOURCES += \
     runtime/UString.cpp \
     tools/CodeProfile.cpp \
     tools/CodeProfiling.cpp \
+    tools/PerfMap.cpp \
+    tools/SamplingProfiler.cpp \
     yarr/YarrJIT.cpp \
 
 *sh4* {
@@ -35,6 +35,7 @@
 #define REGEXP_CODE_ID reinterpret_cast<void*>(static_cast<intptr_t>(-2))
 
 #include <MacroAssembler.h>
+#include "PerfMap.h"
 #include <wtf/DataLog.h>
 #include <wtf/Noncopyable.h>
 
@@ -181,9 +182,10 @@ public:
     }
 
     // Upon completion of all patching 'finalizeCode()' should be called once to complete generation of the code.
-    CodeRef finalizeCode()
+    // The description names the code in the perf map, if there is one.
+    CodeRef finalizeCode(const PerfMap::Description& description = PerfMap::Description())
     {
-        performFinalization();
+        performFinalization(description);
 
         return CodeRef(m_executableMemory);
     }
@@ -303,7 +305,7 @@ private:
 #endif
     }
 
-    void performFinalization()
+    void performFinalization(const PerfMap::Description& description)
     {
 #ifndef NDEBUG
         ASSERT(!m_completed);
@@ -316,6 +318,9 @@ private:
         ExecutableAllocator::makeExecutable(code(), m_size);
 #endif
         ExecutableAllocator::cacheFlush(code(), m_size);
+
+        if (UNLIKELY(PerfMap::enabled()))
+            PerfMap::codeAdded(code(), m_size, description);
     }
 
 #if DUMP_LINK_STATISTICS
@@ -69,6 +69,16 @@ namespace X86Registers {
         xmm5,
         xmm6,
         xmm7,
+#if CPU(X86_64)
+        xmm8,
+        xmm9,
+        xmm10,
+        xmm11,
+        xmm12,
+        xmm13,
+        xmm14,
+        xmm15,
+#endif
     } XMMRegisterID;
 }
 
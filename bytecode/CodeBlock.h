@@ -54,6 +54,7 @@
 #include "Nodes.h"
 #include "PredictionTracker.h"
 #include "RegExpObject.h"
+#include "SharedCodeBlockData.h"
 #include "StructureStubInfo.h"
 #include "UString.h"
 #include "UnconditionalFinalizer.h"
@@ -103,9 +104,21 @@ namespace JSC {
         int* addressOfNumParameters() { return &m_numParameters; }
         static ptrdiff_t offsetOfNumParameters() { return OBJECT_OFFSETOF(CodeBlock, m_numParameters); }
 
-        CodeBlock* alternative() { return m_alternative.get(); }
+        CodeBlock* alternative() { return m_alternative ? m_alternative.get() : m_borrowedAlternative; }
         PassOwnPtr<CodeBlock> releaseAlternative() { return m_alternative.release(); }
-        void setAlternative(PassOwnPtr<CodeBlock> alternative) { m_alternative = alternative; }
+        void setAlternative(PassOwnPtr<CodeBlock> alternative)
+        {
+            m_alternative = alternative;
+            m_borrowedAlternative = 0;
+        }
+        // A code block that is compiled concurrently refers to the baseline code
+        // block without owning it, since the executable keeps running, and owning,
+        // the baseline code until the new code block is installed.
+        void borrowAlternative(CodeBlock* alternative)
+        {
+            ASSERT(!m_alternative);
+            m_borrowedAlternative = alternative;
+        }
         
         CodeSpecializationKind specializationKind()
         {
@@ -132,6 +145,15 @@ namespace JSC {
 
         void visitAggregate(SlotVisitor&);
 
+        // Visits everything this code block refers to, without registering any
+        // finalizers. This is for code blocks that are owned by a compilation that
+        // has not finished yet, rather than by an executable.
+        void visitStrongly(SlotVisitor& visitor)
+        {
+            stronglyVisitStrongReferences(visitor);
+            stronglyVisitWeakReferences(visitor);
+        }
+
         static void dumpStatistics();
 
         void dump(ExecState*) const;
@@ -451,10 +473,10 @@ namespace JSC {
         SourceProvider* source() const { return m_source.get(); }
         unsigned sourceOffset() const { return m_sourceOffset; }
 
-        size_t numberOfJumpTargets() const { return m_jumpTargets.size(); }
-        void addJumpTarget(unsigned jumpTarget) { m_jumpTargets.append(jumpTarget); }
-        unsigned jumpTarget(int index) const { return m_jumpTargets[index]; }
-        unsigned lastJumpTarget() const { return m_jumpTargets.last(); }
+        size_t numberOfJumpTargets() const { return m_sharedData->m_jumpTargets.size(); }
+        void addJumpTarget(unsigned jumpTarget) { ASSERT(canChangeSharedData()); m_sharedData->m_jumpTargets.append(jumpTarget); }
+        unsigned jumpTarget(int index) const { return m_sharedData->m_jumpTargets[index]; }
+        unsigned lastJumpTarget() const { return m_sharedData->m_jumpTargets.last(); }
 
         void createActivation(CallFrame*);
 
@@ -623,28 +645,28 @@ namespace JSC {
 
         void addExpressionInfo(const ExpressionRangeInfo& expressionInfo)
         {
-            createRareDataIfNecessary();
-            m_rareData->m_expressionInfo.append(expressionInfo);
+            ASSERT(canChangeSharedData());
+            m_sharedData->m_expressionInfo.append(expressionInfo);
         }
 
         void addLineInfo(unsigned bytecodeOffset, int lineNo)
         {
-            createRareDataIfNecessary();
-            Vector<LineInfo>& lineInfo = m_rareData->m_lineInfo;
+            ASSERT(canChangeSharedData());
+            Vector<LineInfo>& lineInfo = m_sharedData->m_lineInfo;
             if (!lineInfo.size() || lineInfo.last().lineNumber != lineNo) {
                 LineInfo info = { bytecodeOffset, lineNo };
                 lineInfo.append(info);
             }
         }
 
-        bool hasExpressionInfo() { return m_rareData && m_rareData->m_expressionInfo.size(); }
-        bool hasLineInfo() { return m_rareData && m_rareData->m_lineInfo.size(); }
+        bool hasExpressionInfo() { return m_sharedData->m_expressionInfo.size(); }
+        bool hasLineInfo() { return m_sharedData->m_lineInfo.size(); }
         //  We only generate exception handling info if the user is debugging
         // (and may want line number info), or if the function contains exception handler.
         bool needsCallReturnIndices()
         {
-            return m_rareData &&
-                (m_rareData->m_expressionInfo.size() || m_rareData->m_lineInfo.size() || m_rareData->m_exceptionHandlers.size());
+            return m_sharedData->m_expressionInfo.size() || m_sharedData->m_lineInfo.size()
+                || (m_rareData && m_rareData->m_exceptionHandlers.size());
         }
 
 #if ENABLE(JIT)
@@ -692,6 +714,43 @@ namespace JSC {
             return m_rareData->m_codeOrigins[index].codeOrigin;
         }
         
+        // Only filled in for code compiled while the sampling profiler was running.
+        Vector<CodeOriginAtMachineCodeOffset>& machineCodeOrigins()
+        {
+            createRareDataIfNecessary();
+            return m_rareData->m_machineCodeOrigins;
+        }
+        
+        // Takes no locks and does not allocate, so that it can be used from a
+        // signal handler.
+        bool codeOriginForMachineCode(void* pc, CodeOrigin& codeOrigin)
+        {
+            if (!m_rareData || m_rareData->m_machineCodeOrigins.isEmpty())
+                return false;
+            JITCode& jitCode = getJITCode();
+            char* start = static_cast<char*>(jitCode.start());
+            if (pc < start || pc >= start + jitCode.size())
+                return false;
+            unsigned offset = static_cast<char*>(pc) - start;
+            Vector<CodeOriginAtMachineCodeOffset>& entries = m_rareData->m_machineCodeOrigins;
+            if (offset < entries[0].machineCodeOffset)
+                return false;
+            // Find the last entry that starts at or before offset.
+            size_t low = 0;
+            size_t high = entries.size();
+            while (high - low > 1) {
+                size_t middle = low + (high - low) / 2;
+                if (entries[middle].machineCodeOffset <= offset)
+                    low = middle;
+                else
+                    high = middle;
+            }
+            if (!entries[low].codeOrigin.isSet())
+                return false;
+            codeOrigin = entries[low].codeOrigin;
+            return true;
+        }
+        
         bool addFrequentExitSite(const DFG::FrequentExitSite& site)
         {
             ASSERT(getJITType() == JITCode::BaselineJIT);
@@ -703,9 +762,25 @@ namespace JSC {
 
         // Constant Pool
 
-        size_t numberOfIdentifiers() const { return m_identifiers.size(); }
-        void addIdentifier(const Identifier& i) { return m_identifiers.append(i); }
-        Identifier& identifier(int index) { return m_identifiers[index]; }
+        bool canChangeSharedData() const { return !m_sharedData->isShared() && m_sharedData->hasOneRef(); }
+
+        size_t numberOfIdentifiers() const { return m_sharedData->m_identifiers.size() + m_additionalIdentifiers.size(); }
+        void addIdentifier(const Identifier& i)
+        {
+            if (canChangeSharedData()) {
+                ASSERT(m_additionalIdentifiers.isEmpty());
+                m_sharedData->m_identifiers.append(i);
+                return;
+            }
+            m_additionalIdentifiers.append(i);
+        }
+        const Identifier& identifier(int index) const
+        {
+            size_t sharedCount = m_sharedData->m_identifiers.size();
+            if (static_cast<size_t>(index) < sharedCount)
+                return m_sharedData->m_identifiers[index];
+            return m_additionalIdentifiers[index - sharedCount];
+        }
 
         size_t numberOfConstantRegisters() const { return m_constantRegisters.size(); }
         unsigned addConstant(JSValue v)
@@ -1139,11 +1214,14 @@ namespace JSC {
         unsigned m_executionEntryCount;
 #endif
 
-        Vector<unsigned> m_jumpTargets;
-        Vector<unsigned> m_loopTargets;
+        // Identifiers, jump targets, and expression and line info. Once the bytecode
+        // has been generated this is shared with copies of this CodeBlock, so any
+        // identifiers added later (for example by DFG inlining) go into
+        // m_additionalIdentifiers, numbered after the shared ones.
+        RefPtr<SharedCodeBlockData> m_sharedData;
+        Vector<Identifier> m_additionalIdentifiers;
 
         // Constant Pool
-        Vector<Identifier> m_identifiers;
         COMPILE_ASSERT(sizeof(Register) == sizeof(WriteBarrier<Unknown>), Register_must_be_same_size_as_WriteBarrier_Unknown);
         Vector<WriteBarrier<Unknown> > m_constantRegisters;
         Vector<WriteBarrier<FunctionExecutable> > m_functionDecls;
@@ -1152,6 +1230,7 @@ namespace JSC {
         SymbolTable* m_symbolTable;
 
         OwnPtr<CodeBlock> m_alternative;
+        CodeBlock* m_borrowedAlternative;
         
         int32_t m_jitExecuteCounter;
         uint32_t m_speculativeSuccessCounter;
@@ -1177,16 +1256,13 @@ namespace JSC {
 
             EvalCodeCache m_evalCodeCache;
 
-            // Expression info - present if debugging.
-            Vector<ExpressionRangeInfo> m_expressionInfo;
-            // Line info - present if profiling or debugging.
-            Vector<LineInfo> m_lineInfo;
 #if ENABLE(JIT)
             Vector<CallReturnOffsetToBytecodeOffset> m_callReturnIndexVector;
 #endif
 #if ENABLE(DFG_JIT)
             SegmentedVector<InlineCallFrame, 4> m_inlineCallFrames;
             Vector<CodeOriginAtCallReturnOffset> m_codeOrigins;
+            Vector<CodeOriginAtMachineCodeOffset> m_machineCodeOrigins;
 #endif
         };
 #if COMPILER(MSVC)
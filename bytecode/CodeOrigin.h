@@ -79,6 +79,10 @@ struct CodeOrigin {
     
     static unsigned inlineDepthForCallFrame(InlineCallFrame*);
     
+    // The bytecode index in the machine code block's own bytecode. For inlined code,
+    // this is the index of the call that was inlined.
+    unsigned bytecodeIndexForMachineCode() const;
+    
     bool operator==(const CodeOrigin& other) const;
     
     bool operator!=(const CodeOrigin& other) const { return !(*this == other); }
@@ -101,6 +105,14 @@ struct CodeOriginAtCallReturnOffset {
     unsigned callReturnOffset;
 };
 
+// The machine code from machineCodeOffset up to the next entry's offset was
+// generated for codeOrigin. An unset code origin marks code, such as OSR exits,
+// that belongs to no node.
+struct CodeOriginAtMachineCodeOffset {
+    CodeOrigin codeOrigin;
+    unsigned machineCodeOffset;
+};
+
 inline unsigned CodeOrigin::inlineDepthForCallFrame(InlineCallFrame* inlineCallFrame)
 {
     unsigned result = 1;
@@ -114,6 +126,14 @@ inline unsigned CodeOrigin::inlineDepth() const
     return inlineDepthForCallFrame(inlineCallFrame);
 }
     
+inline unsigned CodeOrigin::bytecodeIndexForMachineCode() const
+{
+    const CodeOrigin* current = this;
+    while (current->inlineCallFrame)
+        current = &current->inlineCallFrame->caller;
+    return current->bytecodeIndex;
+}
+    
 inline bool CodeOrigin::operator==(const CodeOrigin& other) const
 {
     return bytecodeIndex == other.bytecodeIndex
@@ -55,6 +55,17 @@ bool ExitProfile::add(const FrequentExitSite& site)
     return true;
 }
 
+void ExitProfile::exitSitesFor(ExitKind kind, Vector<unsigned>& bytecodeOffsets) const
+{
+    if (!m_frequentExitSites)
+        return;
+    
+    for (unsigned i = 0; i < m_frequentExitSites->size(); ++i) {
+        if (m_frequentExitSites->at(i).kind() == kind)
+            bytecodeOffsets.append(m_frequentExitSites->at(i).bytecodeOffset());
+    }
+}
+
 QueryableExitProfile::QueryableExitProfile(const ExitProfile& profile)
 {
     if (!profile.m_frequentExitSites)
@@ -38,6 +38,7 @@ enum ExitKind {
     BadCache, // We exited because an inline cache was wrong.
     Overflow, // We exited because of overflow.
     NegativeZero, // We exited because we encountered negative zero.
+    Hoisting, // We exited because a check that was hoisted out of a loop failed.
     Uncountable, // We exited for none of the above reasons, and we should not count it. Most uses of this should be viewed as a FIXME.
 };
 
@@ -54,6 +55,8 @@ inline const char* exitKindToString(ExitKind kind)
         return "Overflow";
     case NegativeZero:
         return "NegativeZero";
+    case Hoisting:
+        return "Hoisting";
     default:
         return "Unknown";
     }
@@ -159,6 +162,10 @@ public:
     // anyway.
     bool add(const FrequentExitSite&);
     
+    // Append the bytecode offsets of all exit sites of the given kind. Must be
+    // called on the main thread, since that is the only thread that adds sites.
+    void exitSitesFor(ExitKind, Vector<unsigned>& bytecodeOffsets) const;
+    
 private:
     friend class QueryableExitProfile;
     
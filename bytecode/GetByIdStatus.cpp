@@ -27,10 +27,58 @@
 #include "GetByIdStatus.h"
 
 #include "CodeBlock.h"
+#include "JSObject.h"
 
 namespace JSC {
 
-GetByIdStatus GetByIdStatus::computeFor(CodeBlock* profiledBlock, unsigned bytecodeIndex, Identifier& ident)
+#if ENABLE(JIT) && ENABLE(VALUE_PROFILER)
+// Figures out where a get_by_id on an object with the given structure finds the property
+// in the heap as it is now. A variant only guards the lookup with the structures of the base
+// and of the prototypes, so give up if the lookup misses in a dictionary, whose structure
+// does not change when properties are added, or in an object that answers for some of its
+// properties without its structure knowing about them.
+static bool computeVariantFor(JSGlobalData& globalData, Structure* structure, const Identifier& ident, GetByIdVariant& variant)
+{
+    unsigned attributes;
+    JSCell* specificValue;
+    
+    variant.offset = structure->get(globalData, ident, attributes, specificValue);
+    if (variant.offset != notFound) {
+        if (attributes & Accessor)
+            return false;
+        variant.structureSet.add(structure);
+        return true;
+    }
+    
+    Structure* currentStructure = structure;
+    while (true) {
+        if (currentStructure->isDictionary() || currentStructure->typeInfo().overridesGetOwnPropertySlot())
+            return false;
+        
+        JSValue prototype = currentStructure->storedPrototype();
+        if (!prototype.isObject())
+            return false;
+        
+        JSObject* object = asObject(prototype);
+        currentStructure = object->structure();
+        if (currentStructure->isDictionary() || currentStructure->typeInfo().prohibitsPropertyCaching())
+            return false;
+        
+        variant.chain.append(object);
+        variant.offset = currentStructure->get(globalData, ident, attributes, specificValue);
+        if (variant.offset != notFound)
+            break;
+    }
+    
+    if (attributes & Accessor)
+        return false;
+    
+    variant.structureSet.add(structure);
+    return true;
+}
+#endif // ENABLE(JIT) && ENABLE(VALUE_PROFILER)
+
+GetByIdStatus GetByIdStatus::computeFor(CodeBlock* profiledBlock, unsigned bytecodeIndex, const Identifier& ident)
 {
     UNUSED_PARAM(profiledBlock);
     UNUSED_PARAM(bytecodeIndex);
@@ -67,67 +115,75 @@ GetByIdStatus GetByIdStatus::computeFor(CodeBlock* profiledBlock, unsigned bytec
     if (profiledBlock->likelyToTakeSlowCase(bytecodeIndex))
         return GetByIdStatus(TakesSlowPath, StructureSet(), notFound);
     
-    // Finally figure out if we can derive an access strategy.
-    GetByIdStatus result;
+    // Finally figure out if we can derive an access strategy. The stub info tells us which
+    // structures the base has had, and we work out where the property is for each of them.
+    Vector<Structure*, POLYMORPHIC_LIST_CACHE_SIZE> structures;
     switch (stubInfo.accessType) {
     case access_unset:
         return GetByIdStatus(NoInformation, StructureSet(), notFound);
         
-    case access_get_by_id_self: {
-        Structure* structure = stubInfo.u.getByIdSelf.baseObjectStructure.get();
-        result.m_offset = structure->get(*profiledBlock->globalData(), ident);
+    case access_get_by_id_self:
+        structures.append(stubInfo.u.getByIdSelf.baseObjectStructure.get());
+        break;
         
-        if (result.m_offset != notFound)
-            result.m_structureSet.add(structure);
+    case access_get_by_id_proto:
+        structures.append(stubInfo.u.getByIdProto.baseObjectStructure.get());
+        break;
         
-        if (result.m_offset != notFound)
-            ASSERT(result.m_structureSet.size());
+    case access_get_by_id_chain:
+        structures.append(stubInfo.u.getByIdChain.baseObjectStructure.get());
+        break;
+        
+    case access_get_by_id_self_list:
+    case access_get_by_id_proto_list:
+        for (int i = 0; i < listSize; ++i)
+            structures.append(list->list[i].base.get());
+        break;
+        
+    default:
         break;
     }
+    
+    GetByIdStatus result;
+    for (size_t i = 0; i < structures.size(); ++i) {
+        Structure* structure = structures[i];
         
-    case access_get_by_id_self_list: {
-        PolymorphicAccessStructureList* list = stubInfo.u.getByIdProtoList.structureList;
-        unsigned size = stubInfo.u.getByIdProtoList.listSize;
-        for (unsigned i = 0; i < size; ++i) {
-            ASSERT(list->list[i].isDirect);
-            
-            Structure* structure = list->list[i].base.get();
-            if (result.m_structureSet.contains(structure))
-                continue;
-            
-            size_t myOffset = structure->get(*profiledBlock->globalData(), ident);
-            
-            if (myOffset == notFound) {
-                result.m_offset = notFound;
+        bool alreadyCovered = false;
+        for (size_t j = 0; j < result.m_variants.size(); ++j) {
+            if (result.m_variants[j].structureSet.contains(structure)) {
+                alreadyCovered = true;
                 break;
             }
-                    
-            if (!i)
-                result.m_offset = myOffset;
-            else if (result.m_offset != myOffset) {
-                result.m_offset = notFound;
+        }
+        if (alreadyCovered)
+            continue;
+        
+        GetByIdVariant variant;
+        if (!computeVariantFor(*profiledBlock->globalData(), structure, ident, variant))
+            return GetByIdStatus(TakesSlowPath, StructureSet(), notFound);
+        
+        // Structures that find the property in the same place share a variant, so that
+        // they can share the code that loads it.
+        bool merged = false;
+        for (size_t j = 0; j < result.m_variants.size(); ++j) {
+            GetByIdVariant& otherVariant = result.m_variants[j];
+            if (otherVariant.offset == variant.offset && otherVariant.chain == variant.chain) {
+                otherVariant.structureSet.add(structure);
+                merged = true;
                 break;
             }
-                    
-            result.m_structureSet.add(structure);
         }
-                    
-        if (result.m_offset != notFound)
-            ASSERT(result.m_structureSet.size());
-        break;
-    }
-        
-    default:
-        ASSERT(result.m_offset == notFound);
-        break;
+        if (!merged)
+            result.m_variants.append(variant);
     }
     
-    if (result.m_offset == notFound) {
-        result.m_state = TakesSlowPath;
-        result.m_structureSet.clear();
-    } else
-        result.m_state = SimpleDirect;
+    if (result.m_variants.isEmpty())
+        return GetByIdStatus(TakesSlowPath, StructureSet(), notFound);
+    
+    if (result.m_variants.size() == 1 && result.m_variants[0].chain.isEmpty())
+        return GetByIdStatus(SimpleDirect, result.m_variants[0].structureSet, result.m_variants[0].offset);
     
+    result.m_state = Polymorphic;
     return result;
 #else // ENABLE(JIT)
     return GetByIdStatus(NoInformation, StructureSet(), notFound);
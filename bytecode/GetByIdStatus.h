@@ -28,17 +28,37 @@
 
 #include "StructureSet.h"
 #include <wtf/NotFound.h>
+#include <wtf/Vector.h>
 
 namespace JSC {
 
 class CodeBlock;
 class Identifier;
+class JSObject;
+
+// One way that a get_by_id finds its property. If the base has one of the structures, the
+// property is at the offset in the last object of the chain, or in the base itself if the
+// chain is empty. The chain lists the prototypes that the lookup walks past, and is only
+// valid for as long as they keep the structures they had when the status was computed.
+struct GetByIdVariant {
+    GetByIdVariant()
+        : offset(notFound)
+    {
+    }
+    
+    JSObject* holder() const { return chain.isEmpty() ? 0 : chain.last(); }
+    
+    StructureSet structureSet;
+    Vector<JSObject*, 2> chain;
+    size_t offset;
+};
 
 class GetByIdStatus {
 public:
     enum State {
         NoInformation,  // It's uncached so we have no information.
         SimpleDirect,   // It's cached for a direct access to a known object property.
+        Polymorphic,    // It's cached for accesses whose holder or offset depend on the structure.
         TakesSlowPath,  // It's known to often take slow path.
         MakesCalls      // It's known to take paths that make calls.
     };
@@ -57,26 +77,33 @@ public:
         ASSERT((state == SimpleDirect) == (offset != notFound));
     }
     
-    static GetByIdStatus computeFor(CodeBlock*, unsigned bytecodeIndex, Identifier&);
+    static GetByIdStatus computeFor(CodeBlock*, unsigned bytecodeIndex, const Identifier&);
     
     State state() const { return m_state; }
     
     bool isSet() const { return m_state != NoInformation; }
     bool operator!() const { return !isSet(); }
     bool isSimpleDirect() const { return m_state == SimpleDirect; }
+    bool isPolymorphic() const { return m_state == Polymorphic; }
     bool takesSlowPath() const { return m_state == TakesSlowPath || m_state == MakesCalls; }
     bool makesCalls() const { return m_state == MakesCalls; }
     
     const StructureSet& structureSet() const { return m_structureSet; }
     size_t offset() const { return m_offset; }
     
+    // The variants are only set for polymorphic accesses. Each structure appears in at
+    // most one of them.
+    size_t numVariants() const { return m_variants.size(); }
+    const GetByIdVariant& variant(size_t i) const { return m_variants[i]; }
+    
 private:
     State m_state;
     StructureSet m_structureSet;
     size_t m_offset;
+    Vector<GetByIdVariant, 2> m_variants;
 };
 
 } // namespace JSC
 
-#endif // PropertyAccessStatus_h
+#endif // GetByIdStatus_h
 
@@ -27,21 +27,61 @@
 #include "PutByIdStatus.h"
 
 #include "CodeBlock.h"
+#include "PolymorphicPutByIdList.h"
 #include "Structure.h"
 #include "StructureChain.h"
 
 namespace JSC {
 
-PutByIdStatus PutByIdStatus::computeFor(CodeBlock* profiledBlock, unsigned bytecodeIndex, Identifier& ident)
+#if ENABLE(JIT) && ENABLE(VALUE_PROFILER)
+PutByIdStatus PutByIdStatus::computeForList(JSGlobalData& globalData, PolymorphicPutByIdList* list, const Identifier& ident)
+{
+    PutByIdStatus result(Polymorphic, 0, 0, 0, notFound);
+    for (unsigned i = 0; i < list->size(); ++i) {
+        const PutByIdAccess& access = list->at(i);
+        switch (access.type()) {
+        case PutByIdAccess::Replace: {
+            size_t offset = access.structure()->get(globalData, ident);
+            if (offset == notFound)
+                return PutByIdStatus(TakesSlowPath, 0, 0, 0, notFound);
+            result.m_variants.append(PutByIdVariant(access.structure(), 0, 0, offset));
+            break;
+        }
+            
+        case PutByIdAccess::Transition: {
+            size_t offset = access.newStructure()->get(globalData, ident);
+            if (offset == notFound)
+                return PutByIdStatus(TakesSlowPath, 0, 0, 0, notFound);
+            result.m_variants.append(
+                PutByIdVariant(access.oldStructure(), access.newStructure(), access.chain(), offset));
+            break;
+        }
+            
+        default:
+            return PutByIdStatus(TakesSlowPath, 0, 0, 0, notFound);
+        }
+    }
+    return result;
+}
+#endif // ENABLE(JIT) && ENABLE(VALUE_PROFILER)
+
+PutByIdStatus PutByIdStatus::computeFor(CodeBlock* profiledBlock, unsigned bytecodeIndex, const Identifier& ident)
 {
     UNUSED_PARAM(profiledBlock);
     UNUSED_PARAM(bytecodeIndex);
     UNUSED_PARAM(ident);
 #if ENABLE(JIT) && ENABLE(VALUE_PROFILER)
+    StructureStubInfo& stubInfo = profiledBlock->getStubInfo(bytecodeIndex);
+    
+    // The baseline JIT takes the slow case for all but the first structure that it cached,
+    // and keeps a list of the others, so a polymorphic put is expected to take the slow case
+    // often. The list is only full if there were more structures than it could hold.
+    if (stubInfo.seen && stubInfo.accessType == access_put_by_id_list && !stubInfo.u.putByIdList.list->isFull())
+        return computeForList(*profiledBlock->globalData(), stubInfo.u.putByIdList.list, ident);
+    
     if (profiledBlock->likelyToTakeSlowCase(bytecodeIndex))
         return PutByIdStatus(TakesSlowPath, 0, 0, 0, notFound);
     
-    StructureStubInfo& stubInfo = profiledBlock->getStubInfo(bytecodeIndex);
     if (!stubInfo.seen)
         return PutByIdStatus(NoInformation, 0, 0, 0, notFound);
     
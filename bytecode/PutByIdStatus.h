@@ -27,14 +27,45 @@
 #define PutByIdStatus_h
 
 #include <wtf/NotFound.h>
+#include <wtf/Vector.h>
 
 namespace JSC {
 
 class CodeBlock;
 class Identifier;
+class JSGlobalData;
+class PolymorphicPutByIdList;
 class Structure;
 class StructureChain;
 
+// One of the accesses of a polymorphic put_by_id. It is a transition if it has a new
+// structure, and a replace otherwise.
+struct PutByIdVariant {
+    PutByIdVariant()
+        : oldStructure(0)
+        , newStructure(0)
+        , structureChain(0)
+        , offset(notFound)
+    {
+    }
+    
+    PutByIdVariant(Structure* oldStructure, Structure* newStructure, StructureChain* structureChain, size_t offset)
+        : oldStructure(oldStructure)
+        , newStructure(newStructure)
+        , structureChain(structureChain)
+        , offset(offset)
+    {
+        ASSERT(!newStructure == !structureChain);
+    }
+    
+    bool isTransition() const { return newStructure; }
+    
+    Structure* oldStructure;
+    Structure* newStructure;
+    StructureChain* structureChain;
+    size_t offset;
+};
+
 class PutByIdStatus {
 public:
     enum State {
@@ -46,6 +77,9 @@ public:
         // It's cached as a transition from one structure that lacks the property to one that
         // includes the property, and a direct store to this new property.
         SimpleTransition,
+        // It's cached as a list of replaces and transitions, selected by the structure of
+        // the object.
+        Polymorphic,
         // It's known to often take slow path.
         TakesSlowPath
     };
@@ -71,13 +105,13 @@ public:
         , m_structureChain(structureChain)
         , m_offset(offset)
     {
-        ASSERT((m_state == NoInformation || m_state == TakesSlowPath) == !m_oldStructure);
+        ASSERT((m_state == SimpleReplace || m_state == SimpleTransition) == !!m_oldStructure);
         ASSERT((m_state != SimpleTransition) == !m_newStructure);
         ASSERT((m_state != SimpleTransition) == !m_structureChain);
-        ASSERT((m_state == NoInformation || m_state == TakesSlowPath) == (m_offset == notFound));
+        ASSERT((m_state == SimpleReplace || m_state == SimpleTransition) == (m_offset != notFound));
     }
     
-    static PutByIdStatus computeFor(CodeBlock*, unsigned bytecodeIndex, Identifier&);
+    static PutByIdStatus computeFor(CodeBlock*, unsigned bytecodeIndex, const Identifier&);
     
     State state() const { return m_state; }
     
@@ -85,6 +119,7 @@ public:
     bool operator!() const { return m_state == NoInformation; }
     bool isSimpleReplace() const { return m_state == SimpleReplace; }
     bool isSimpleTransition() const { return m_state == SimpleTransition; }
+    bool isPolymorphic() const { return m_state == Polymorphic; }
     bool takesSlowPath() const { return m_state == TakesSlowPath; }
     
     Structure* oldStructure() const { return m_oldStructure; }
@@ -92,12 +127,19 @@ public:
     StructureChain* structureChain() const { return m_structureChain; }
     size_t offset() const { return m_offset; }
     
+    // The variants are only set for polymorphic accesses.
+    size_t numVariants() const { return m_variants.size(); }
+    const PutByIdVariant& variant(size_t i) const { return m_variants[i]; }
+    
 private:
+    static PutByIdStatus computeForList(JSGlobalData&, PolymorphicPutByIdList*, const Identifier&);
+    
     State m_state;
     Structure* m_oldStructure;
     Structure* m_newStructure;
     StructureChain* m_structureChain;
     size_t m_offset;
+    Vector<PutByIdVariant, 2> m_variants;
 };
 
 } // namespace JSC
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "SharedCodeBlockData.h"
+
+namespace JSC {
+
+static inline unsigned addToHash(unsigned hash, unsigned value)
+{
+    return WTF::intHash(static_cast<uint64_t>(hash) << 32 | value);
+}
+
+SharedCodeBlockData::~SharedCodeBlockData()
+{
+    if (m_table)
+        m_table->m_set.remove(this);
+}
+
+size_t SharedCodeBlockData::byteSize() const
+{
+    return sizeof(*this)
+        + m_identifiers.capacity() * sizeof(Identifier)
+        + m_jumpTargets.capacity() * sizeof(unsigned)
+        + m_expressionInfo.capacity() * sizeof(ExpressionRangeInfo)
+        + m_lineInfo.capacity() * sizeof(LineInfo);
+}
+
+unsigned SharedCodeBlockData::computeHash() const
+{
+    unsigned hash = addToHash(m_identifiers.size(), m_jumpTargets.size());
+    hash = addToHash(hash, m_expressionInfo.size());
+    hash = addToHash(hash, m_lineInfo.size());
+
+    // Identifiers are unique within a JSGlobalData, so their StringImpls can be
+    // hashed and compared by address.
+    for (size_t i = 0; i < m_identifiers.size(); ++i)
+        hash = addToHash(hash, PtrHash<StringImpl*>::hash(m_identifiers[i].impl()));
+    for (size_t i = 0; i < m_jumpTargets.size(); ++i)
+        hash = addToHash(hash, m_jumpTargets[i]);
+    for (size_t i = 0; i < m_expressionInfo.size(); ++i)
+        hash = addToHash(hash, m_expressionInfo[i].instructionOffset ^ m_expressionInfo[i].divotPoint << 7);
+    for (size_t i = 0; i < m_lineInfo.size(); ++i)
+        hash = addToHash(hash, m_lineInfo[i].instructionOffset ^ m_lineInfo[i].lineNumber << 16);
+    return hash;
+}
+
+bool SharedCodeBlockData::isEqual(const SharedCodeBlockData& other) const
+{
+    if (m_hash != other.m_hash)
+        return false;
+
+    if (m_identifiers.size() != other.m_identifiers.size()
+        || m_jumpTargets != other.m_jumpTargets
+        || m_expressionInfo.size() != other.m_expressionInfo.size()
+        || m_lineInfo.size() != other.m_lineInfo.size())
+        return false;
+
+    for (size_t i = 0; i < m_identifiers.size(); ++i) {
+        if (m_identifiers[i].impl() != other.m_identifiers[i].impl())
+            return false;
+    }
+    for (size_t i = 0; i < m_expressionInfo.size(); ++i) {
+        const ExpressionRangeInfo& a = m_expressionInfo[i];
+        const ExpressionRangeInfo& b = other.m_expressionInfo[i];
+        if (a.instructionOffset != b.instructionOffset || a.divotPoint != b.divotPoint
+            || a.startOffset != b.startOffset || a.endOffset != b.endOffset)
+            return false;
+    }
+    for (size_t i = 0; i < m_lineInfo.size(); ++i) {
+        if (m_lineInfo[i].instructionOffset != other.m_lineInfo[i].instructionOffset
+            || m_lineInfo[i].lineNumber != other.m_lineInfo[i].lineNumber)
+            return false;
+    }
+    return true;
+}
+
+SharedCodeBlockDataTable::~SharedCodeBlockDataTable()
+{
+    // Every CodeBlock should have gone away with the heap, but do not leave any
+    // survivor pointing at a dead table.
+    HashSet<SharedCodeBlockData*, SharedCodeBlockDataHash>::iterator end = m_set.end();
+    for (HashSet<SharedCodeBlockData*, SharedCodeBlockDataHash>::iterator it = m_set.begin(); it != end; ++it)
+        (*it)->m_table = 0;
+}
+
+PassRefPtr<SharedCodeBlockData> SharedCodeBlockDataTable::add(PassRefPtr<SharedCodeBlockData> passedData)
+{
+    RefPtr<SharedCodeBlockData> data = passedData;
+    ASSERT(!data->m_table);
+
+    data->m_identifiers.shrinkToFit();
+    data->m_jumpTargets.shrinkToFit();
+    data->m_expressionInfo.shrinkToFit();
+    data->m_lineInfo.shrinkToFit();
+    data->m_hash = data->computeHash();
+
+    pair<HashSet<SharedCodeBlockData*, SharedCodeBlockDataHash>::iterator, bool> result = m_set.add(data.get());
+    if (!result.second)
+        return *result.first;
+
+    data->m_table = this;
+    return data.release();
+}
+
+} // namespace JSC
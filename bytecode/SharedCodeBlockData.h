@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef SharedCodeBlockData_h
+#define SharedCodeBlockData_h
+
+#include "ExpressionRangeInfo.h"
+#include "Identifier.h"
+#include "LineInfo.h"
+#include <wtf/HashSet.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class SharedCodeBlockDataTable;
+
+// A CodeBlock's identifiers, jump targets, and expression and line info, which do
+// not change once its bytecode has been generated. Copies of a CodeBlock share it,
+// and so do CodeBlocks generated from the same code in other global objects that
+// belong to the same JSGlobalData. Everything else, including the instructions and
+// constants, is still generated and kept per CodeBlock.
+class SharedCodeBlockData : public RefCounted<SharedCodeBlockData> {
+public:
+    static PassRefPtr<SharedCodeBlockData> create() { return adoptRef(new SharedCodeBlockData); }
+    ~SharedCodeBlockData();
+
+    // Only a SharedCodeBlockData that is not yet in a table may be changed.
+    bool isShared() const { return m_table; }
+
+    Vector<Identifier> m_identifiers;
+    Vector<unsigned> m_jumpTargets;
+
+    // Expression info - present if debugging.
+    Vector<ExpressionRangeInfo> m_expressionInfo;
+    // Line info - present if profiling or debugging.
+    Vector<LineInfo> m_lineInfo;
+
+    size_t byteSize() const;
+
+private:
+    friend class SharedCodeBlockDataTable;
+    friend struct SharedCodeBlockDataHash;
+
+    SharedCodeBlockData()
+        : m_table(0)
+        , m_hash(0)
+    {
+    }
+
+    unsigned computeHash() const;
+    bool isEqual(const SharedCodeBlockData&) const;
+
+    SharedCodeBlockDataTable* m_table;
+    unsigned m_hash;
+};
+
+struct SharedCodeBlockDataHash {
+    static unsigned hash(SharedCodeBlockData* data) { return data->m_hash; }
+    static bool equal(SharedCodeBlockData* a, SharedCodeBlockData* b) { return a->isEqual(*b); }
+    static const bool safeToCompareToEmptyOrDeleted = false;
+};
+
+// Keeps one SharedCodeBlockData for each distinct content, so that generating the
+// same code again does not keep a second copy.
+class SharedCodeBlockDataTable {
+    WTF_MAKE_NONCOPYABLE(SharedCodeBlockDataTable);
+public:
+    SharedCodeBlockDataTable() { }
+    ~SharedCodeBlockDataTable();
+
+    // Returns data equal to the given data, which may be the given data. Either way,
+    // the result must not be changed again.
+    PassRefPtr<SharedCodeBlockData> add(PassRefPtr<SharedCodeBlockData>);
+
+private:
+    friend class SharedCodeBlockData;
+
+    HashSet<SharedCodeBlockData*, SharedCodeBlockDataHash> m_set;
+};
+
+} // namespace JSC
+
+#endif // SharedCodeBlockData_h
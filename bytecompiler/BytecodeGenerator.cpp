@@ -1590,13 +1590,14 @@ RegisterID* BytecodeGenerator::emitGetByVal(RegisterID* dst, RegisterID* base, R
     for (size_t i = m_forInContextStack.size(); i > 0; i--) {
         ForInContext& context = m_forInContextStack[i - 1];
         if (context.propertyRegister == property) {
-            emitOpcode(op_get_by_pname);
+            ValueProfile* profile = emitProfiledOpcode(op_get_by_pname);
             instructions().append(dst->index());
             instructions().append(base->index());
             instructions().append(property->index());
             instructions().append(context.expectedSubscriptRegister->index());
             instructions().append(context.iterRegister->index());
             instructions().append(context.indexRegister->index());
+            instructions().append(profile);
             return dst;
         }
     }
@@ -157,6 +157,11 @@ bool AbstractState::endBasicBlock(MergeMode mergeMode)
         return false;
     }
     
+    // Checks hoisted out of loops are done just before the terminal, so they refine
+    // the variables as they are at the tail.
+    for (size_t i = 0; i < block->hoistedChecks.size(); ++i)
+        applyHoistedCheck(block->hoistedChecks[i]);
+    
     bool changed = false;
     
     if (mergeMode != DontMerge || !ASSERT_DISABLED) {
@@ -608,6 +613,16 @@ bool AbstractState::execute(NodeIndex nodeIndex)
             forNode(node.child1()).filter(PredictNumber);
         break;
     }
+        
+    case Switch: {
+        Node& child = m_graph[node.child1()];
+        if (m_graph.m_switchData[node.switchDataIndex()].kind == SwitchImm) {
+            if (child.shouldSpeculateInteger())
+                forNode(node.child1()).filter(PredictInt32);
+        } else if (isStringPrediction(child.prediction()))
+            forNode(node.child1()).filter(PredictString);
+        break;
+    }
             
     case Return:
     case Throw:
@@ -650,6 +665,57 @@ bool AbstractState::execute(NodeIndex nodeIndex)
         m_haveStructures = true;
         break;
             
+    case CreateActivation:
+        forNode(nodeIndex).set(PredictObjectOther);
+        break;
+            
+    case TearOffActivation:
+        break;
+            
+    case NewFunction: {
+        AbstractValue& destination = forNode(nodeIndex);
+        destination = forNode(node.child1());
+        destination.merge(PredictFunction);
+        break;
+    }
+            
+    case NewFunctionNoCheck:
+    case NewFunctionExpression:
+        forNode(nodeIndex).set(PredictFunction);
+        break;
+            
+    case TypeOf:
+        forNode(nodeIndex).set(PredictString);
+        break;
+            
+    case GetPropertyNameIterator:
+        forNode(node.child1()).filter(PredictObjectMask);
+        clobberStructures(nodeIndex);
+        forNode(nodeIndex).set(PredictCellOther);
+        break;
+            
+    case GetPropertyNameIteratorSize:
+        forNode(node.child1()).filter(PredictCell);
+        forNode(nodeIndex).set(PredictInt32);
+        break;
+            
+    case NextPropertyNameIndex:
+        forNode(node.child1()).filter(PredictCell);
+        forNode(node.child2()).filter(PredictCell);
+        forNode(node.child3()).filter(PredictInt32);
+        clobberStructures(nodeIndex);
+        forNode(nodeIndex).set(PredictInt32);
+        break;
+            
+    case GetPropertyNameIteratorKey: {
+        forNode(node.child1()).filter(PredictCell);
+        forNode(node.child2()).filter(PredictInt32);
+        AbstractValue& destination = forNode(nodeIndex);
+        destination = forNode(node.child3());
+        destination.merge(PredictString);
+        break;
+    }
+            
     case ConvertThis: {
         Node& child = m_graph[node.child1()];
         AbstractValue& source = forNode(node.child1());
@@ -866,6 +932,28 @@ bool AbstractState::execute(NodeIndex nodeIndex)
         forNode(node.child1()).filter(PredictCell);
         break;
             
+    case MultiGetByOffset:
+        forNode(node.child1()).filter(m_graph.m_multiGetByOffsetData[node.multiGetByOffsetDataIndex()].structureSet);
+        forNode(nodeIndex).makeTop();
+        m_haveStructures = true;
+        break;
+            
+    case MultiPutByOffset: {
+        MultiPutByOffsetData& data = m_graph.m_multiPutByOffsetData[node.multiPutByOffsetDataIndex()];
+        StructureSet oldStructures;
+        bool hasTransition = false;
+        for (size_t i = 0; i < data.cases.size(); ++i) {
+            oldStructures.add(data.cases[i].oldStructure);
+            if (data.cases[i].newStructure)
+                hasTransition = true;
+        }
+        forNode(node.child1()).filter(oldStructures);
+        if (hasTransition)
+            clobberStructures(nodeIndex);
+        m_haveStructures = true;
+        break;
+    }
+            
     case CheckFunction:
         forNode(node.child1()).filter(PredictFunction);
         // FIXME: Should be able to propagate the fact that we know what the function is.
@@ -884,6 +972,14 @@ bool AbstractState::execute(NodeIndex nodeIndex)
     case PutGlobalVar:
         break;
             
+    case GetCapturedVar:
+        forNode(nodeIndex).makeTop();
+        break;
+            
+    case PutCapturedVar:
+    case ClearCapturedVar:
+        break;
+            
     case CheckHasInstance:
         forNode(node.child1()).filter(PredictCell);
         // Sadly, we don't propagate the fact that we've done CheckHasInstance
@@ -941,6 +1037,35 @@ inline void AbstractState::clobberStructures(NodeIndex nodeIndex)
     m_haveStructures = false;
 }
 
+static void filterForHoistedCheck(AbstractValue& value, const HoistedCheck& check)
+{
+    if (check.structureSet)
+        value.filter(*check.structureSet);
+    else
+        value.filter(check.prediction);
+}
+
+void AbstractState::applyHoistedCheck(const HoistedCheck& check)
+{
+    filterForHoistedCheck(m_variables.operand(check.operand), check);
+    
+    NodeIndex nodeIndex = m_block->variablesAtTail.operand(check.operand);
+    if (nodeIndex == NoNode)
+        return;
+    
+    Node& node = m_graph[nodeIndex];
+    switch (node.op) {
+    case GetLocal:
+        filterForHoistedCheck(forNode(nodeIndex), check);
+        break;
+    case SetLocal:
+        filterForHoistedCheck(forNode(node.child1()), check);
+        break;
+    default:
+        break;
+    }
+}
+
 inline bool AbstractState::mergeStateAtTail(AbstractValue& destination, AbstractValue& inVariable, NodeIndex nodeIndex)
 {
     if (nodeIndex == NoNode)
@@ -1046,6 +1171,14 @@ inline bool AbstractState::mergeToSuccessors(Graph& graph, BasicBlock* basicBloc
         return merge(basicBlock, graph.m_blocks[terminal.takenBlockIndex()].get())
             | merge(basicBlock, graph.m_blocks[terminal.notTakenBlockIndex()].get());
         
+    case Switch: {
+        SwitchData& data = graph.m_switchData[terminal.switchDataIndex()];
+        bool changed = merge(basicBlock, graph.m_blocks[data.fallThrough].get());
+        for (unsigned i = 0; i < data.cases.size(); ++i)
+            changed |= merge(basicBlock, graph.m_blocks[data.cases[i].target].get());
+        return changed;
+    }
+        
     case Return:
     case Throw:
     case ThrowReferenceError:
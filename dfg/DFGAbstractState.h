@@ -178,6 +178,8 @@ public:
 private:
     void clobberStructures(NodeIndex);
     
+    void applyHoistedCheck(const HoistedCheck&);
+    
     bool mergeStateAtTail(AbstractValue& destination, AbstractValue& inVariable, NodeIndex);
     
     static bool mergeVariableBetweenBlocks(AbstractValue& destination, AbstractValue& source, NodeIndex destinationNodeIndex, NodeIndex sourceNodeIndex);
@@ -29,15 +29,53 @@
 #if ENABLE(DFG_JIT)
 
 #include "DFGAbstractValue.h"
+#include "DFGIntegerRange.h"
 #include "DFGNode.h"
 #include "DFGOperands.h"
+#include "StructureSet.h"
 #include <wtf/OwnPtr.h>
 #include <wtf/Vector.h>
 
-namespace JSC { namespace DFG {
+namespace JSC {
+
+struct ClassInfo;
+
+namespace DFG {
 
 typedef Vector <BlockIndex, 2> PredecessorList;
 
+static const unsigned NoRegisterAllocatedLoop = UINT_MAX;
+
+// A speculation about a variable that was hoisted out of a loop. It is checked at the
+// end of the loop's preheader, against the variable's slot in the register file, and
+// the CFA then proves the checks it was hoisted from inside the loop.
+struct HoistedCheck {
+    HoistedCheck() { }
+    
+    HoistedCheck(int operand, const StructureSet* structureSet)
+        : operand(operand)
+        , structureSet(structureSet)
+        , prediction(PredictNone)
+        , classInfo(0)
+    {
+    }
+    
+    HoistedCheck(int operand, PredictedType prediction, const ClassInfo* classInfo)
+        : operand(operand)
+        , structureSet(0)
+        , prediction(prediction)
+        , classInfo(classInfo)
+    {
+    }
+    
+    int operand;
+    
+    // Either the variable's structure is checked, or the class of the cell it holds is.
+    const StructureSet* structureSet;
+    PredictedType prediction;
+    const ClassInfo* classInfo;
+};
+
 struct BasicBlock {
     BasicBlock(unsigned bytecodeBegin, NodeIndex begin, unsigned numArguments, unsigned numLocals)
         : bytecodeBegin(bytecodeBegin)
@@ -50,10 +88,12 @@ struct BasicBlock {
         , isLinked(false)
 #endif
         , isReachable(false)
+        , registerAllocatedLoop(NoRegisterAllocatedLoop)
         , variablesAtHead(numArguments, numLocals)
         , variablesAtTail(numArguments, numLocals)
         , valuesAtHead(numArguments, numLocals)
         , valuesAtTail(numArguments, numLocals)
+        , rangesAtHead(numArguments, numLocals)
     {
     }
     
@@ -63,6 +103,7 @@ struct BasicBlock {
         variablesAtTail.ensureLocals(newNumLocals);
         valuesAtHead.ensureLocals(newNumLocals);
         valuesAtTail.ensureLocals(newNumLocals);
+        rangesAtHead.ensureLocals(newNumLocals);
     }
 
     // This value is used internally for block linking and OSR entry. It is mostly meaningless
@@ -81,11 +122,21 @@ struct BasicBlock {
     
     PredecessorList m_predecessors;
     
+    Vector<HoistedCheck> hoistedChecks;
+    
+    // Index into Graph::m_registerAllocatedLoops of the inner loop that this block
+    // belongs to, if that loop keeps any variables in loop registers.
+    unsigned registerAllocatedLoop;
+    
     Operands<NodeIndex, NodeIndexTraits> variablesAtHead;
     Operands<NodeIndex, NodeIndexTraits> variablesAtTail;
     
     Operands<AbstractValue> valuesAtHead;
     Operands<AbstractValue> valuesAtTail;
+    
+    // What the range analysis knows about the variables on entry to the block.
+    Operands<IntegerRange> rangesAtHead;
+    Vector<LengthRelation> relationsAtHead;
 };
 
 struct UnlinkedBlock {
@@ -61,6 +61,7 @@ public:
         , m_numArguments(codeBlock->numParameters())
         , m_numLocals(codeBlock->m_numCalleeRegisters)
         , m_preservedVars(codeBlock->m_numVars)
+        , m_argumentsAreCaptured(false)
         , m_parameterSlots(0)
         , m_numPassedVarArgs(0)
         , m_globalResolveNumber(0)
@@ -138,6 +139,8 @@ private:
     }
     NodeIndex get(int operand)
     {
+        if (isCaptured(operand))
+            return addToGraph(GetCapturedVar, OpInfo(operand));
         return getDirect(m_inlineStackTop->remapOperand(operand));
     }
     void setDirect(int operand, NodeIndex value)
@@ -153,8 +156,26 @@ private:
     }
     void set(int operand, NodeIndex value)
     {
+        if (isCaptured(operand)) {
+            addToGraph(PutCapturedVar, OpInfo(operand), value);
+            return;
+        }
         setDirect(m_inlineStackTop->remapOperand(operand), value);
     }
+    
+    // Captured variables are those that an activation may alias, plus the registers
+    // that are initialized lazily (the activation, the arguments and lazily created
+    // functions), which hold the empty value until created. Neither can be kept in
+    // SSA form, so they are read and written directly in the register file.
+    bool isCaptured(int operand)
+    {
+        if (m_inlineStackTop->m_inlineCallFrame || operand >= FirstConstantRegisterIndex)
+            return false;
+        if (operandIsArgument(operand))
+            return m_argumentsAreCaptured && operandToArgument(operand);
+        return m_capturedLocals.get(operand);
+    }
+    void findCapturedVariables();
 
     // Used in implementing get/set, above, where the operand is a local variable.
     NodeIndex getLocal(unsigned operand)
@@ -265,6 +286,9 @@ private:
         // FIXME: This should check if the same operand had already been flushed to
         // some other local variable.
         
+        if (isCaptured(operand))
+            return;
+        
         operand = m_inlineStackTop->remapOperand(operand);
         
         ASSERT(operand < FirstConstantRegisterIndex);
@@ -727,6 +751,106 @@ private:
         return true;
     }
     
+    // MultiPutByOffset can only do transitions that need no more property storage, and
+    // that are still valid.
+    bool polymorphicPutIsStillValid(bool direct, const PutByIdStatus& putByIdStatus)
+    {
+        for (size_t i = 0; i < putByIdStatus.numVariants(); ++i) {
+            const PutByIdVariant& variant = putByIdStatus.variant(i);
+            if (!variant.isTransition())
+                continue;
+            if (variant.oldStructure->propertyStorageCapacity() != variant.newStructure->propertyStorageCapacity())
+                return false;
+            if (!structureChainIsStillValid(direct, variant.oldStructure, variant.structureChain))
+                return false;
+        }
+        return true;
+    }
+    
+    // Checks that the prototypes that a transition was cached for still have the structures
+    // they had, so that none of them has gained a setter for the property.
+    void addStructureChainChecks(Structure* previousStructure, StructureChain* chain)
+    {
+        if (!previousStructure->storedPrototype().isNull())
+            addToGraph(
+                CheckStructure,
+                OpInfo(m_graph.addStructureSet(previousStructure->storedPrototype().asCell()->structure())),
+                cellConstant(previousStructure->storedPrototype().asCell()));
+        
+        for (WriteBarrier<Structure>* it = chain->head(); *it; ++it) {
+            JSValue prototype = (*it)->storedPrototype();
+            if (prototype.isNull())
+                continue;
+            ASSERT(prototype.isCell());
+            addToGraph(
+                CheckStructure,
+                OpInfo(m_graph.addStructureSet(prototype.asCell()->structure())),
+                cellConstant(prototype.asCell()));
+        }
+    }
+    
+    // Checks that the prototypes that a get_by_id walks past, and the one it loads from,
+    // still have the structures they had when the variant was computed.
+    void addPrototypeChecks(const GetByIdVariant& variant)
+    {
+        for (size_t i = 0; i < variant.chain.size(); ++i) {
+            JSObject* prototype = variant.chain[i];
+            addToGraph(CheckStructure, OpInfo(m_graph.addStructureSet(prototype->structure())), cellConstant(prototype));
+        }
+    }
+    
+    NodeIndex handleGetByOffset(PredictedType prediction, NodeIndex storageOwner, unsigned identifierNumber, size_t offset)
+    {
+        NodeIndex getByOffset = addToGraph(GetByOffset, OpInfo(m_graph.m_storageAccessData.size()), OpInfo(prediction), addToGraph(GetPropertyStorage, storageOwner));
+        
+        StorageAccessData storageAccessData;
+        storageAccessData.offset = offset;
+        storageAccessData.identifierNumber = identifierNumber;
+        m_graph.m_storageAccessData.append(storageAccessData);
+        
+        return getByOffset;
+    }
+    
+    NodeIndex handleGetById(PredictedType prediction, NodeIndex base, unsigned identifierNumber, const GetByIdStatus& getByIdStatus)
+    {
+        if ((!getByIdStatus.isSimpleDirect() && !getByIdStatus.isPolymorphic())
+            || m_inlineStackTop->m_exitProfile.hasExitSite(m_currentIndex, BadCache))
+            return addToGraph(getByIdStatus.makesCalls() ? GetByIdFlush : GetById, OpInfo(identifierNumber), OpInfo(prediction), base);
+        
+        // The implementation of GetByOffset does not know to terminate speculative
+        // execution if it doesn't have a prediction, so we do it manually.
+        if (prediction == PredictNone)
+            addToGraph(ForceOSRExit);
+        
+        if (getByIdStatus.isSimpleDirect()) {
+            ASSERT(getByIdStatus.structureSet().size());
+            addToGraph(CheckStructure, OpInfo(m_graph.addStructureSet(getByIdStatus.structureSet())), base);
+            return handleGetByOffset(prediction, base, identifierNumber, getByIdStatus.offset());
+        }
+        
+        if (getByIdStatus.numVariants() == 1) {
+            const GetByIdVariant& variant = getByIdStatus.variant(0);
+            addToGraph(CheckStructure, OpInfo(m_graph.addStructureSet(variant.structureSet)), base);
+            addPrototypeChecks(variant);
+            return handleGetByOffset(prediction, cellConstant(variant.holder()), identifierNumber, variant.offset);
+        }
+        
+        // The prototypes of all of the variants are checked, whichever one the base
+        // turns out to need. They are constants, so the checks are cheap to hoist and
+        // to eliminate.
+        MultiGetByOffsetData data;
+        data.identifierNumber = identifierNumber;
+        for (size_t i = 0; i < getByIdStatus.numVariants(); ++i) {
+            const GetByIdVariant& variant = getByIdStatus.variant(i);
+            addPrototypeChecks(variant);
+            data.cases.append(MultiGetByOffsetCase(variant.structureSet, variant.holder(), variant.offset));
+            data.structureSet.addAll(variant.structureSet);
+        }
+        m_graph.m_multiGetByOffsetData.append(data);
+        
+        return addToGraph(MultiGetByOffset, OpInfo(m_graph.m_multiGetByOffsetData.size() - 1), OpInfo(prediction), base);
+    }
+    
     void buildOperandMapsIfNecessary();
     
     JSGlobalData* m_globalData;
@@ -780,6 +904,11 @@ private:
     // typically equal to the set of vars, but we expand this to cover all
     // temporaries that persist across blocks (dues to ?:, &&, ||, etc).
     BitVector m_preservedVars;
+    // The set of locals that are accessed through the register file, and whether
+    // the arguments (other than 'this') are too. See isCaptured().
+    BitVector m_capturedLocals;
+    BitVector m_lazyLocals;
+    bool m_argumentsAreCaptured;
     // The number of slots (in units of sizeof(Register)) that we need to
     // preallocate for calls emanating from this frame. This includes the
     // size of the CallFrame, only if this is not a leaf function.  (I.e.
@@ -1270,7 +1399,7 @@ bool ByteCodeParser::handleIntrinsic(bool usesResult, int resultOperand, Intrins
         
         int indexOperand = registerOffset + argumentToOperand(1);
         NodeIndex storage = addToGraph(GetIndexedPropertyStorage, get(thisOperand), getToInt32(indexOperand));
-        NodeIndex charCode = addToGraph(StringCharCodeAt, get(thisOperand), getToInt32(indexOperand), storage);
+        NodeIndex charCode = addToGraph(StringCharCodeAt, OpInfo(0), get(thisOperand), getToInt32(indexOperand), storage);
 
         if (usesResult)
             set(resultOperand, charCode);
@@ -1287,7 +1416,7 @@ bool ByteCodeParser::handleIntrinsic(bool usesResult, int resultOperand, Intrins
 
         int indexOperand = registerOffset + argumentToOperand(1);
         NodeIndex storage = addToGraph(GetIndexedPropertyStorage, get(thisOperand), getToInt32(indexOperand));
-        NodeIndex charCode = addToGraph(StringCharAt, get(thisOperand), getToInt32(indexOperand), storage);
+        NodeIndex charCode = addToGraph(StringCharAt, OpInfo(0), get(thisOperand), getToInt32(indexOperand), storage);
 
         if (usesResult)
             set(resultOperand, charCode);
@@ -1357,9 +1486,14 @@ bool ByteCodeParser::parseBlock(unsigned limit)
         // === Function entry opcodes ===
 
         case op_enter:
-            // Initialize all locals to undefined.
-            for (int i = 0; i < m_inlineStackTop->m_codeBlock->m_numVars; ++i)
+            // Initialize all locals to undefined. Lazily initialized registers are
+            // cleared by op_init_lazy_reg before anything can read them, so storing
+            // undefined to them would only pollute their predictions.
+            for (int i = 0; i < m_inlineStackTop->m_codeBlock->m_numVars; ++i) {
+                if (!m_inlineStackTop->m_inlineCallFrame && m_lazyLocals.get(i))
+                    continue;
                 set(i, constantUndefined());
+            }
             NEXT_OPCODE(op_enter);
 
         case op_convert_this: {
@@ -1411,6 +1545,38 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             NEXT_OPCODE(op_get_callee);
         }
 
+        case op_init_lazy_reg:
+            ASSERT(isCaptured(currentInstruction[1].u.operand));
+            addToGraph(ClearCapturedVar, OpInfo(currentInstruction[1].u.operand));
+            NEXT_OPCODE(op_init_lazy_reg);
+
+        case op_create_activation: {
+            NodeIndex activation = get(currentInstruction[1].u.operand);
+            set(currentInstruction[1].u.operand, addToGraph(CreateActivation, activation));
+            NEXT_OPCODE(op_create_activation);
+        }
+
+        case op_tear_off_activation: {
+            // The arguments register is never written by DFG code, since op_create_arguments
+            // is not supported; TearOffActivation loads it itself, like the old JIT's stub does.
+            addToGraph(TearOffActivation, get(currentInstruction[1].u.operand));
+            NEXT_OPCODE(op_tear_off_activation);
+        }
+
+        case op_new_func: {
+            if (!currentInstruction[3].u.operand) {
+                set(currentInstruction[1].u.operand, addToGraph(NewFunctionNoCheck, OpInfo(currentInstruction[2].u.operand)));
+                NEXT_OPCODE(op_new_func);
+            }
+            NodeIndex function = get(currentInstruction[1].u.operand);
+            set(currentInstruction[1].u.operand, addToGraph(NewFunction, OpInfo(currentInstruction[2].u.operand), function));
+            NEXT_OPCODE(op_new_func);
+        }
+
+        case op_new_func_exp:
+            set(currentInstruction[1].u.operand, addToGraph(NewFunctionExpression, OpInfo(currentInstruction[2].u.operand)));
+            NEXT_OPCODE(op_new_func_exp);
+
         // === Bitwise operations ===
 
         case op_bitand: {
@@ -1599,6 +1765,12 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             set(currentInstruction[1].u.operand, addToGraph(ToPrimitive, value));
             NEXT_OPCODE(op_to_primitive);
         }
+
+        case op_typeof: {
+            NodeIndex value = get(currentInstruction[2].u.operand);
+            set(currentInstruction[1].u.operand, addToGraph(TypeOf, value));
+            NEXT_OPCODE(op_typeof);
+        }
             
         case op_strcat: {
             int startOperand = currentInstruction[2].u.operand;
@@ -1691,12 +1863,26 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             NEXT_OPCODE(op_get_by_val);
         }
 
+        case op_get_by_pname: {
+            // The property name came from the enumeration we're in the middle of, so
+            // this is a string-keyed lookup; treat it as a generic GetByVal.
+            PredictedType prediction = getPrediction();
+            
+            NodeIndex base = get(currentInstruction[2].u.operand);
+            NodeIndex property = get(currentInstruction[3].u.operand);
+            NodeIndex propertyStorage = addToGraph(GetIndexedPropertyStorage, base, property);
+            NodeIndex getByVal = addToGraph(GetByVal, OpInfo(0), OpInfo(prediction), base, property, propertyStorage);
+            set(currentInstruction[1].u.operand, getByVal);
+
+            NEXT_OPCODE(op_get_by_pname);
+        }
+
         case op_put_by_val: {
             NodeIndex base = get(currentInstruction[1].u.operand);
             NodeIndex property = get(currentInstruction[2].u.operand);
             NodeIndex value = get(currentInstruction[3].u.operand);
 
-            addToGraph(PutByVal, base, property, value);
+            addToGraph(PutByVal, OpInfo(0), base, property, value);
 
             NEXT_OPCODE(op_put_by_val);
         }
@@ -1733,7 +1919,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
                 
                 set(getInstruction[1].u.operand, cellConstant(methodCallStatus.function()));
             } else
-                set(getInstruction[1].u.operand, addToGraph(getByIdStatus.makesCalls() ? GetByIdFlush : GetById, OpInfo(identifier), OpInfo(prediction), base));
+                set(getInstruction[1].u.operand, handleGetById(prediction, base, identifier, getByIdStatus));
             
             m_currentIndex += OPCODE_LENGTH(op_method_check) + OPCODE_LENGTH(op_get_by_id);
             continue;
@@ -1770,24 +1956,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             dataLog("Slow case count for GetById @%zu bc#%u: %u; exit profile: %d\n", m_graph.size(), m_currentIndex, m_inlineStackTop->m_profiledBlock->rareCaseProfileForBytecodeOffset(m_currentIndex)->m_counter, m_inlineStackTop->m_exitProfile.hasExitSite(m_currentIndex, BadCache));
 #endif
             
-            if (getByIdStatus.isSimpleDirect()
-                && !m_inlineStackTop->m_exitProfile.hasExitSite(m_currentIndex, BadCache)) {
-                ASSERT(getByIdStatus.structureSet().size());
-                
-                // The implementation of GetByOffset does not know to terminate speculative
-                // execution if it doesn't have a prediction, so we do it manually.
-                if (prediction == PredictNone)
-                    addToGraph(ForceOSRExit);
-                
-                addToGraph(CheckStructure, OpInfo(m_graph.addStructureSet(getByIdStatus.structureSet())), base);
-                set(currentInstruction[1].u.operand, addToGraph(GetByOffset, OpInfo(m_graph.m_storageAccessData.size()), OpInfo(prediction), addToGraph(GetPropertyStorage, base)));
-                
-                StorageAccessData storageAccessData;
-                storageAccessData.offset = getByIdStatus.offset();
-                storageAccessData.identifierNumber = identifierNumber;
-                m_graph.m_storageAccessData.append(storageAccessData);
-            } else
-                set(currentInstruction[1].u.operand, addToGraph(getByIdStatus.makesCalls() ? GetByIdFlush : GetById, OpInfo(identifierNumber), OpInfo(prediction), base));
+            set(currentInstruction[1].u.operand, handleGetById(prediction, base, identifierNumber, getByIdStatus));
 
             NEXT_OPCODE(op_get_by_id);
         }
@@ -1827,24 +1996,8 @@ bool ByteCodeParser::parseBlock(unsigned limit)
                            putByIdStatus.structureChain())) {
 
                 addToGraph(CheckStructure, OpInfo(m_graph.addStructureSet(putByIdStatus.oldStructure())), base);
-                if (!direct) {
-                    if (!putByIdStatus.oldStructure()->storedPrototype().isNull())
-                        addToGraph(
-                            CheckStructure,
-                            OpInfo(m_graph.addStructureSet(putByIdStatus.oldStructure()->storedPrototype().asCell()->structure())),
-                            cellConstant(putByIdStatus.oldStructure()->storedPrototype().asCell()));
-                    
-                    for (WriteBarrier<Structure>* it = putByIdStatus.structureChain()->head(); *it; ++it) {
-                        JSValue prototype = (*it)->storedPrototype();
-                        if (prototype.isNull())
-                            continue;
-                        ASSERT(prototype.isCell());
-                        addToGraph(
-                            CheckStructure,
-                            OpInfo(m_graph.addStructureSet(prototype.asCell()->structure())),
-                            cellConstant(prototype.asCell()));
-                    }
-                }
+                if (!direct)
+                    addStructureChainChecks(putByIdStatus.oldStructure(), putByIdStatus.structureChain());
                 addToGraph(
                     PutStructure,
                     OpInfo(
@@ -1865,6 +2018,20 @@ bool ByteCodeParser::parseBlock(unsigned limit)
                 storageAccessData.offset = putByIdStatus.offset();
                 storageAccessData.identifierNumber = identifierNumber;
                 m_graph.m_storageAccessData.append(storageAccessData);
+            } else if (!hasExitSite
+                       && putByIdStatus.isPolymorphic()
+                       && polymorphicPutIsStillValid(direct, putByIdStatus)) {
+                MultiPutByOffsetData data;
+                data.identifierNumber = identifierNumber;
+                for (size_t i = 0; i < putByIdStatus.numVariants(); ++i) {
+                    const PutByIdVariant& variant = putByIdStatus.variant(i);
+                    if (variant.isTransition() && !direct)
+                        addStructureChainChecks(variant.oldStructure, variant.structureChain);
+                    data.cases.append(MultiPutByOffsetCase(variant.oldStructure, variant.newStructure, variant.offset));
+                }
+                m_graph.m_multiPutByOffsetData.append(data);
+                
+                addToGraph(MultiPutByOffset, OpInfo(m_graph.m_multiPutByOffsetData.size() - 1), base, value);
             } else {
                 if (direct)
                     addToGraph(PutByIdDirect, OpInfo(identifierNumber), base, value);
@@ -2055,6 +2222,62 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             addToGraph(Branch, OpInfo(m_currentIndex + relativeOffset), OpInfo(m_currentIndex + OPCODE_LENGTH(op_loop_if_greatereq)), condition);
             LAST_OPCODE(op_loop_if_greatereq);
         }
+            
+        case op_switch_imm: {
+            SwitchData data;
+            data.kind = SwitchImm;
+            data.switchTableIndex = currentInstruction[1].u.operand;
+            data.fallThroughBytecodeOffset = m_currentIndex + currentInstruction[2].u.operand;
+            SimpleJumpTable& table = m_codeBlock->immediateSwitchJumpTable(data.switchTableIndex);
+            for (unsigned i = 0; i < table.branchOffsets.size(); ++i) {
+                if (!table.branchOffsets[i])
+                    continue;
+                unsigned target = m_currentIndex + table.branchOffsets[i];
+                if (target == data.fallThroughBytecodeOffset)
+                    continue;
+                data.cases.append(SwitchCase(static_cast<int32_t>(table.min + i), target));
+            }
+            m_graph.m_switchData.append(data);
+            addToGraph(Switch, OpInfo(m_graph.m_switchData.size() - 1), get(currentInstruction[3].u.operand));
+            LAST_OPCODE(op_switch_imm);
+        }
+            
+        case op_switch_char: {
+            SwitchData data;
+            data.kind = SwitchChar;
+            data.switchTableIndex = currentInstruction[1].u.operand;
+            data.fallThroughBytecodeOffset = m_currentIndex + currentInstruction[2].u.operand;
+            SimpleJumpTable& table = m_codeBlock->characterSwitchJumpTable(data.switchTableIndex);
+            for (unsigned i = 0; i < table.branchOffsets.size(); ++i) {
+                if (!table.branchOffsets[i])
+                    continue;
+                unsigned target = m_currentIndex + table.branchOffsets[i];
+                if (target == data.fallThroughBytecodeOffset)
+                    continue;
+                data.cases.append(SwitchCase(static_cast<int32_t>(table.min + i), target));
+            }
+            m_graph.m_switchData.append(data);
+            addToGraph(Switch, OpInfo(m_graph.m_switchData.size() - 1), get(currentInstruction[3].u.operand));
+            LAST_OPCODE(op_switch_char);
+        }
+            
+        case op_switch_string: {
+            SwitchData data;
+            data.kind = SwitchString;
+            data.switchTableIndex = currentInstruction[1].u.operand;
+            data.fallThroughBytecodeOffset = m_currentIndex + currentInstruction[2].u.operand;
+            StringJumpTable& table = m_codeBlock->stringSwitchJumpTable(data.switchTableIndex);
+            StringJumpTable::StringOffsetTable::iterator end = table.offsetTable.end();
+            for (StringJumpTable::StringOffsetTable::iterator iter = table.offsetTable.begin(); iter != end; ++iter) {
+                unsigned target = m_currentIndex + iter->second.branchOffset;
+                if (target == data.fallThroughBytecodeOffset)
+                    continue;
+                data.cases.append(SwitchCase(iter->first.get(), target));
+            }
+            m_graph.m_switchData.append(data);
+            addToGraph(Switch, OpInfo(m_graph.m_switchData.size() - 1), get(currentInstruction[3].u.operand));
+            LAST_OPCODE(op_switch_string);
+        }
 
         case op_ret:
             if (m_inlineStackTop->m_inlineCallFrame) {
@@ -2142,6 +2365,32 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             NEXT_OPCODE(op_resolve_global);
         }
 
+        // === For-in enumeration. ===
+
+        case op_get_pnames: {
+            // A base that is undefined or null would skip the loop, and any other primitive
+            // would need ToObject. GetPropertyNameIterator speculates that the base is
+            // already an object, so we never take the break target.
+            NodeIndex base = get(currentInstruction[2].u.operand);
+            NodeIndex iterator = addToGraph(GetPropertyNameIterator, base);
+            set(currentInstruction[1].u.operand, iterator);
+            set(currentInstruction[3].u.operand, getJSConstantForValue(jsNumber(0)));
+            set(currentInstruction[4].u.operand, addToGraph(GetPropertyNameIteratorSize, iterator));
+            NEXT_OPCODE(op_get_pnames);
+        }
+
+        case op_next_pname: {
+            unsigned relativeOffset = currentInstruction[6].u.operand;
+            NodeIndex iterator = get(currentInstruction[5].u.operand);
+            NodeIndex index = addToGraph(NextPropertyNameIndex, get(currentInstruction[2].u.operand), iterator, get(currentInstruction[3].u.operand));
+            NodeIndex key = addToGraph(GetPropertyNameIteratorKey, iterator, index, get(currentInstruction[1].u.operand));
+            set(currentInstruction[1].u.operand, key);
+            set(currentInstruction[3].u.operand, addToGraph(ArithAdd, OpInfo(NodeUseBottom), index, one()));
+            NodeIndex condition = addToGraph(CompareLess, index, get(currentInstruction[4].u.operand));
+            addToGraph(Branch, OpInfo(m_currentIndex + relativeOffset), OpInfo(m_currentIndex + OPCODE_LENGTH(op_next_pname)), condition);
+            LAST_OPCODE(op_next_pname);
+        }
+
         case op_loop_hint: {
             // Baseline->DFG OSR jumps between loop hints. The DFG assumes that Baseline->DFG
             // OSR can only happen at basic block boundaries. Assert that these two statements
@@ -2336,6 +2585,17 @@ void ByteCodeParser::linkBlock(BasicBlock* block, Vector<BlockIndex>& possibleTa
 #endif
         break;
         
+    case Switch: {
+        SwitchData& data = m_graph.m_switchData[node.switchDataIndex()];
+        for (unsigned i = 0; i < data.cases.size(); ++i)
+            data.cases[i].target = m_graph.blockIndexForBytecodeOffset(possibleTargets, data.cases[i].targetBytecodeOffset);
+        data.fallThrough = m_graph.blockIndexForBytecodeOffset(possibleTargets, data.fallThroughBytecodeOffset);
+#if DFG_ENABLE(DEBUG_VERBOSE)
+        dataLog("Linked basic block %p to %u cases and #%u.\n", block, data.cases.size(), data.fallThrough);
+#endif
+        break;
+    }
+        
     default:
 #if DFG_ENABLE(DEBUG_VERBOSE)
         dataLog("Marking basic block %p as linked.\n", block);
@@ -2389,6 +2649,18 @@ void ByteCodeParser::determineReachability()
         else if (node.isBranch()) {
             handleSuccessor(worklist, index, node.takenBlockIndex());
             handleSuccessor(worklist, index, node.notTakenBlockIndex());
+        } else if (node.op == Switch) {
+            // Many cases usually share a target, but each successor should only
+            // have this block as a predecessor once.
+            SwitchData& data = m_graph.m_switchData[node.switchDataIndex()];
+            Vector<BlockIndex, 16> successors;
+            successors.append(data.fallThrough);
+            for (unsigned i = 0; i < data.cases.size(); ++i) {
+                if (!successors.contains(data.cases[i].target))
+                    successors.append(data.cases[i].target);
+            }
+            for (unsigned i = 0; i < successors.size(); ++i)
+                handleSuccessor(worklist, index, successors[i]);
         }
     }
 }
@@ -2559,6 +2831,32 @@ void ByteCodeParser::parseCodeBlock()
     ASSERT(m_currentIndex == codeBlock->instructions().size());
 }
 
+void ByteCodeParser::findCapturedVariables()
+{
+    // Everything an activation can see is captured: the vars it copies on tear-off,
+    // which come first, and all of the arguments.
+    if (m_codeBlock->codeType() == FunctionCode && m_codeBlock->needsFullScopeChain()) {
+        for (int i = 0; i < m_codeBlock->m_numCapturedVars; ++i)
+            m_capturedLocals.set(i);
+        m_argumentsAreCaptured = true;
+        m_graph.m_capturedVarPredictions = Operands<PredictedType>(m_numArguments, 0);
+    }
+    
+    // Lazily initialized registers must be able to hold the empty value, which only
+    // the register file can represent.
+    Interpreter* interpreter = m_globalData->interpreter;
+    Vector<Instruction>& instructions = m_codeBlock->instructions();
+    for (unsigned bytecodeOffset = 0; bytecodeOffset < instructions.size();) {
+        OpcodeID opcodeID = interpreter->getOpcodeID(instructions[bytecodeOffset].u.opcode);
+        if (opcodeID == op_init_lazy_reg) {
+            int operand = instructions[bytecodeOffset + 1].u.operand;
+            m_capturedLocals.set(operand);
+            m_lazyLocals.set(operand);
+        }
+        bytecodeOffset += opcodeLengths[opcodeID];
+    }
+}
+
 bool ByteCodeParser::parse()
 {
     // Set during construction.
@@ -2566,6 +2864,7 @@ bool ByteCodeParser::parse()
     
     InlineStackEntry inlineStackEntry(this, m_codeBlock, m_profiledBlock, NoBlock, InvalidVirtualRegister, 0, InvalidVirtualRegister, InvalidVirtualRegister, CodeForCall);
     
+    findCapturedVariables();
     parseCodeBlock();
 
     linkBlocks(inlineStackEntry.m_unlinkedBlocks, inlineStackEntry.m_blockLinkingTargets);
@@ -72,6 +72,11 @@ inline bool canCompileOpcode(OpcodeID opcodeID)
     case op_convert_this:
     case op_create_this:
     case op_get_callee:
+    case op_init_lazy_reg:
+    case op_create_activation:
+    case op_tear_off_activation:
+    case op_new_func:
+    case op_new_func_exp:
     case op_bitand:
     case op_bitor:
     case op_bitxor:
@@ -105,6 +110,7 @@ inline bool canCompileOpcode(OpcodeID opcodeID)
     case op_neq_null:
     case op_nstricteq:
     case op_get_by_val:
+    case op_get_by_pname:
     case op_put_by_val:
     case op_method_check:
     case op_get_scoped_var:
@@ -134,6 +140,9 @@ inline bool canCompileOpcode(OpcodeID opcodeID)
     case op_loop_if_lesseq:
     case op_loop_if_greater:
     case op_loop_if_greatereq:
+    case op_switch_imm:
+    case op_switch_char:
+    case op_switch_string:
     case op_ret:
     case op_end:
     case op_call_put_result:
@@ -145,6 +154,9 @@ inline bool canCompileOpcode(OpcodeID opcodeID)
     case op_new_array_buffer:
     case op_strcat:
     case op_to_primitive:
+    case op_typeof:
+    case op_get_pnames:
+    case op_next_pname:
     case op_throw:
     case op_throw_reference_error:
     case op_call:
@@ -187,6 +199,20 @@ inline bool canInlineOpcode(OpcodeID opcodeID)
         
     // Inlining doesn't correctly remap regular expression operands.
     case op_new_regexp:
+        
+    // Lazily initialized registers and captured variables are only supported in the
+    // machine code block, since an inlined activation would need its own call frame.
+    case op_init_lazy_reg:
+    case op_create_activation:
+    case op_tear_off_activation:
+    case op_new_func:
+    case op_new_func_exp:
+        
+    // Switch jump tables are looked up in the machine code block, and the tables of
+    // an inlined code block would need to be copied into it.
+    case op_switch_imm:
+    case op_switch_char:
+    case op_switch_string:
         return false;
         
     default:
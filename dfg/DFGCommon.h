@@ -76,6 +76,8 @@
 
 namespace JSC { namespace DFG {
 
+enum CompileMode { CompileFunction, CompileOther };
+
 // Type for a reference to another node in the graph.
 typedef uint32_t NodeIndex;
 static const NodeIndex NoNode = UINT_MAX;
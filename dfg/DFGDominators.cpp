@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "DFGDominators.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGGraph.h"
+#include <wtf/BitVector.h>
+
+namespace JSC { namespace DFG {
+
+Dominators::Dominators()
+    : m_valid(false)
+{
+}
+
+Dominators::~Dominators()
+{
+}
+
+void Dominators::compute(Graph& graph)
+{
+    size_t numBlocks = graph.m_blocks.size();
+    
+    m_idoms.fill(NoBlock, numBlocks);
+    m_postOrderNumbers.fill(0, numBlocks);
+    
+    // Number the reachable blocks in post order with an explicit depth first search,
+    // since functions with many blocks could overflow the machine stack.
+    Vector<BlockIndex, 16> postOrder;
+    Vector<std::pair<BlockIndex, unsigned>, 16> stack;
+    BitVector visited(numBlocks);
+    stack.append(std::make_pair(0, 0));
+    visited.set(0);
+    while (!stack.isEmpty()) {
+        BlockIndex blockIndex = stack.last().first;
+        BasicBlock& block = *graph.m_blocks[blockIndex];
+        if (stack.last().second < graph.numSuccessors(block)) {
+            BlockIndex successor = graph.successor(block, stack.last().second++);
+            if (visited.get(successor))
+                continue;
+            visited.set(successor);
+            stack.append(std::make_pair(successor, 0));
+            continue;
+        }
+        m_postOrderNumbers[blockIndex] = postOrder.size();
+        postOrder.append(blockIndex);
+        stack.removeLast();
+    }
+    
+    // Walk the blocks in reverse post order, so that on the first pass all but the
+    // back edges have been visited before the blocks they lead to.
+    m_idoms[0] = 0;
+    bool changed;
+    do {
+        changed = false;
+        for (size_t i = postOrder.size() - 1; i--;) {
+            BlockIndex blockIndex = postOrder[i];
+            PredecessorList& predecessors = graph.m_blocks[blockIndex]->m_predecessors;
+            BlockIndex newIdom = NoBlock;
+            for (size_t j = 0; j < predecessors.size(); ++j) {
+                BlockIndex predecessor = predecessors[j];
+                if (m_idoms[predecessor] == NoBlock)
+                    continue;
+                newIdom = newIdom == NoBlock ? predecessor : intersect(predecessor, newIdom);
+            }
+            ASSERT(newIdom != NoBlock);
+            if (m_idoms[blockIndex] == newIdom)
+                continue;
+            m_idoms[blockIndex] = newIdom;
+            changed = true;
+        }
+    } while (changed);
+    
+    m_valid = true;
+}
+
+BlockIndex Dominators::intersect(BlockIndex left, BlockIndex right) const
+{
+    while (left != right) {
+        while (m_postOrderNumbers[left] < m_postOrderNumbers[right])
+            left = m_idoms[left];
+        while (m_postOrderNumbers[right] < m_postOrderNumbers[left])
+            right = m_idoms[right];
+    }
+    return left;
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef DFGDominators_h
+#define DFGDominators_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGCommon.h"
+#include <wtf/Vector.h>
+
+namespace JSC { namespace DFG {
+
+class Graph;
+
+// Computes the dominator tree of the graph's reachable blocks, using the iterative
+// algorithm of Cooper, Harvey and Kennedy. Blocks are numbered in post order and each
+// block records its immediate dominator; dominance queries walk up that tree.
+class Dominators {
+public:
+    Dominators();
+    ~Dominators();
+    
+    void compute(Graph&);
+    
+    bool isValid() const { return m_valid; }
+    
+    // Returns true if every path from the root to "to" goes through "from". Every
+    // block dominates itself. Unreachable blocks neither dominate nor are dominated.
+    bool dominates(BlockIndex from, BlockIndex to) const
+    {
+        ASSERT(m_valid);
+        if (m_idoms[from] == NoBlock || m_idoms[to] == NoBlock)
+            return false;
+        while (m_postOrderNumbers[to] < m_postOrderNumbers[from])
+            to = m_idoms[to];
+        return from == to;
+    }
+    
+    // The root is its own immediate dominator. Unreachable blocks have none.
+    BlockIndex immediateDominatorOf(BlockIndex blockIndex) const
+    {
+        ASSERT(m_valid);
+        return m_idoms[blockIndex];
+    }
+    
+private:
+    BlockIndex intersect(BlockIndex, BlockIndex) const;
+    
+    Vector<BlockIndex> m_idoms;
+    Vector<unsigned> m_postOrderNumbers;
+    bool m_valid;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGDominators_h
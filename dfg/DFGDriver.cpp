@@ -30,11 +30,12 @@
 
 #include "DFGByteCodeParser.h"
 #include "DFGJITCompiler.h"
+#include "DFGPlan.h"
 #include "DFGPropagator.h"
+#include "DFGWorklist.h"
 
 namespace JSC { namespace DFG {
 
-enum CompileMode { CompileFunction, CompileOther };
 inline bool compile(CompileMode compileMode, JSGlobalData& globalData, CodeBlock* codeBlock, JITCode& jitCode, MacroAssemblerCodePtr* jitCodeWithArityCheck)
 {
     SamplingRegion samplingRegion("DFG Compilation (Driver)");
@@ -54,7 +55,9 @@ inline bool compile(CompileMode compileMode, JSGlobalData& globalData, CodeBlock
     if (compileMode == CompileFunction)
         dfg.predictArgumentTypes(codeBlock);
     
-    propagate(dfg, &globalData, codeBlock);
+    HoistingExitSites hoistingExitSites;
+    snapshotHoistingExitSites(codeBlock, hoistingExitSites);
+    propagate(dfg, &globalData, codeBlock, hoistingExitSites);
     
     JITCompiler dataFlowJIT(&globalData, dfg, codeBlock);
     if (compileMode == CompileFunction) {
@@ -81,6 +84,18 @@ bool tryCompileFunction(JSGlobalData& globalData, CodeBlock* codeBlock, JITCode&
     return compile(CompileFunction, globalData, codeBlock, jitCode, &jitCodeWithArityCheck);
 }
 
+bool tryCompileFunctionConcurrently(JSGlobalData& globalData, PassOwnPtr<CodeBlock> codeBlock, CodeBlock* profiledBlock)
+{
+    SamplingRegion samplingRegion("DFG Compilation (Driver)");
+
+    RefPtr<Plan> plan = Plan::create(CompileFunction, globalData, codeBlock, profiledBlock);
+    if (!plan->parse())
+        return false;
+
+    ensureWorklistFor(globalData).enqueue(plan.release());
+    return true;
+}
+
 } } // namespace JSC::DFG
 
 #endif // ENABLE(DFG_JIT)
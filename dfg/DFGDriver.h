@@ -26,6 +26,7 @@
 #ifndef DFGDriver_h
 #define DFGDriver_h
 
+#include <wtf/PassOwnPtr.h>
 #include <wtf/Platform.h>
 
 namespace JSC {
@@ -40,9 +41,15 @@ namespace DFG {
 #if ENABLE(DFG_JIT)
 bool tryCompile(JSGlobalData&, CodeBlock*, JITCode&);
 bool tryCompileFunction(JSGlobalData&, CodeBlock*, JITCode&, MacroAssemblerCodePtr& jitCodeWithArityCheck);
+
+// Parses the function and hands the rest of the compilation off to the DFG
+// worklist. Returns false if the function cannot be compiled, in which case
+// the code block has already been thrown away.
+bool tryCompileFunctionConcurrently(JSGlobalData&, PassOwnPtr<CodeBlock>, CodeBlock* profiledBlock);
 #else
 inline bool tryCompile(JSGlobalData&, CodeBlock*, JITCode&) { return false; }
 inline bool tryCompileFunction(JSGlobalData&, CodeBlock*, JITCode&, MacroAssemblerCodePtr&) { return false; }
+inline bool tryCompileFunctionConcurrently(JSGlobalData&, PassOwnPtr<CodeBlock>, CodeBlock*) { return false; }
 #endif
 
 } } // namespace JSC::DFG
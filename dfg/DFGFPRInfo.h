@@ -78,6 +78,30 @@ public:
         return (unsigned)reg;
     }
 
+    // Loop registers are never handed out by the register bank. Instead, the DFG
+    // assigns them to double variables for the whole of an inner loop, so that
+    // those variables do not have to go through the register file on every
+    // iteration. Only caller-save registers may be used, so that nothing has to be
+    // done to preserve them for the code that calls into the DFG. xmm6-xmm15 are
+    // caller-save on x86-64 SysV, but callee-save in the Windows x64 ABI, so we use
+    // none there. xmm6 and xmm7 are caller-save in every x86 convention.
+#if CPU(X86_64) && !OS(WINDOWS)
+    static const unsigned numberOfLoopRegisters = 10;
+#elif CPU(X86_64)
+    static const unsigned numberOfLoopRegisters = 0;
+#else
+    static const unsigned numberOfLoopRegisters = 2;
+#endif
+    static FPRReg toLoopRegister(unsigned index)
+    {
+        ASSERT(index < numberOfLoopRegisters);
+        return (FPRReg)(X86Registers::xmm6 + index);
+    }
+    static bool isLoopRegister(FPRReg reg)
+    {
+        return toIndex(reg) >= numberOfRegisters;
+    }
+
     static const char* debugName(FPRReg reg)
     {
         ASSERT(reg != InvalidFPRReg);
@@ -139,6 +163,18 @@ public:
         return (unsigned)reg;
     }
 
+    // d8-d15 are callee-save, so we do not use any of them as loop registers.
+    static const unsigned numberOfLoopRegisters = 0;
+    static FPRReg toLoopRegister(unsigned)
+    {
+        ASSERT_NOT_REACHED();
+        return InvalidFPRReg;
+    }
+    static bool isLoopRegister(FPRReg)
+    {
+        return false;
+    }
+
     static const char* debugName(FPRReg reg)
     {
         ASSERT(reg != InvalidFPRReg);
@@ -27,6 +27,7 @@
 #include "DFGGraph.h"
 
 #include "CodeBlock.h"
+#include "SlotVisitor.h"
 
 #if ENABLE(DFG_JIT)
 
@@ -150,6 +151,7 @@ void Graph::dump(NodeIndex nodeIndex, CodeBlock* codeBlock)
     //         $#   - the index in the CodeBlock of a constant { for numeric constants the value is displayed | for integers, in both decimal and hex }.
     //         id#  - the index in the CodeBlock of an identifier { if codeBlock is passed to dump(), the string representation is displayed }.
     //         var# - the index of a var on the global object, used by GetGlobalVar/PutGlobalVar operations.
+    //         f#   - the index in the CodeBlock of a function declaration or expression.
     dataLog("% 4d:%s<%c%u:", (int)nodeIndex, skipped ? "  skipped  " : "           ", mustGenerate ? '!' : ' ', refCount);
     if (node.hasResult() && !skipped && node.hasVirtualRegister())
         dataLog("%u", node.virtualRegister());
@@ -179,10 +181,30 @@ void Graph::dump(NodeIndex nodeIndex, CodeBlock* codeBlock)
         dataLog("%s%s", hasPrinted ? ", " : "", arithNodeFlagsAsString(node.rawArithNodeFlags()));
         hasPrinted = true;
     }
+    if (node.hasIndexBoundsInfo() && node.indexIsInBounds()) {
+        dataLog("%sInBounds", hasPrinted ? ", " : "");
+        hasPrinted = true;
+    }
     if (node.hasVarNumber()) {
         dataLog("%svar%u", hasPrinted ? ", " : "", node.varNumber());
         hasPrinted = true;
     }
+    if (node.hasCapturedOperand()) {
+        int operand = node.capturedOperand();
+        if (operandIsArgument(operand))
+            dataLog("%sarg%u", hasPrinted ? ", " : "", operandToArgument(operand));
+        else
+            dataLog("%sr%u", hasPrinted ? ", " : "", operand);
+        hasPrinted = true;
+    }
+    if (node.hasFunctionDeclIndex()) {
+        dataLog("%sf%u", hasPrinted ? ", " : "", node.functionDeclIndex());
+        hasPrinted = true;
+    }
+    if (node.hasFunctionExprIndex()) {
+        dataLog("%sf%u", hasPrinted ? ", " : "", node.functionExprIndex());
+        hasPrinted = true;
+    }
     if (node.hasIdentifier()) {
         if (codeBlock)
             dataLog("%sid%u{%s}", hasPrinted ? ", " : "", node.identifierNumber(), codeBlock->identifier(node.identifierNumber()).ustring().utf8().data());
@@ -210,6 +232,36 @@ void Graph::dump(NodeIndex nodeIndex, CodeBlock* codeBlock)
         dataLog(", %lu", static_cast<unsigned long>(storageAccessData.offset));
         hasPrinted = true;
     }
+    if (node.hasMultiGetByOffsetData()) {
+        MultiGetByOffsetData& data = m_multiGetByOffsetData[node.multiGetByOffsetDataIndex()];
+        if (codeBlock)
+            dataLog("%sid%u{%s}", hasPrinted ? ", " : "", data.identifierNumber, codeBlock->identifier(data.identifierNumber).ustring().utf8().data());
+        else
+            dataLog("%sid%u", hasPrinted ? ", " : "", data.identifierNumber);
+        for (size_t i = 0; i < data.cases.size(); ++i) {
+            MultiGetByOffsetCase& getCase = data.cases[i];
+            dataLog(", [");
+            for (size_t j = 0; j < getCase.structureSet.size(); ++j)
+                dataLog("%sstruct(%p)", j ? ", " : "", getCase.structureSet[j]);
+            dataLog("] -> %p:%lu", getCase.holder, static_cast<unsigned long>(getCase.offset));
+        }
+        hasPrinted = true;
+    }
+    if (node.hasMultiPutByOffsetData()) {
+        MultiPutByOffsetData& data = m_multiPutByOffsetData[node.multiPutByOffsetDataIndex()];
+        if (codeBlock)
+            dataLog("%sid%u{%s}", hasPrinted ? ", " : "", data.identifierNumber, codeBlock->identifier(data.identifierNumber).ustring().utf8().data());
+        else
+            dataLog("%sid%u", hasPrinted ? ", " : "", data.identifierNumber);
+        for (size_t i = 0; i < data.cases.size(); ++i) {
+            MultiPutByOffsetCase& putCase = data.cases[i];
+            if (putCase.newStructure)
+                dataLog(", struct(%p -> %p):%lu", putCase.oldStructure, putCase.newStructure, static_cast<unsigned long>(putCase.offset));
+            else
+                dataLog(", struct(%p):%lu", putCase.oldStructure, static_cast<unsigned long>(putCase.offset));
+        }
+        hasPrinted = true;
+    }
     ASSERT(node.hasVariableAccessData() == node.hasLocal());
     if (node.hasVariableAccessData()) {
         VariableAccessData* variableAccessData = node.variableAccessData();
@@ -252,6 +304,18 @@ void Graph::dump(NodeIndex nodeIndex, CodeBlock* codeBlock)
         dataLog("%sF:#%u", hasPrinted ? ", " : "", node.notTakenBlockIndex());
         hasPrinted = true;
     }
+    if (node.hasSwitchData()) {
+        SwitchData& data = m_switchData[node.switchDataIndex()];
+        for (unsigned i = 0; i < data.cases.size(); ++i) {
+            if (data.kind == SwitchString)
+                dataLog("%s\"%s\":#%u", hasPrinted ? ", " : "", UString(data.cases[i].string).utf8().data(), data.cases[i].target);
+            else
+                dataLog("%s%d:#%u", hasPrinted ? ", " : "", data.cases[i].value, data.cases[i].target);
+            hasPrinted = true;
+        }
+        dataLog("%sdefault:#%u", hasPrinted ? ", " : "", data.fallThrough);
+        hasPrinted = true;
+    }
     (void)hasPrinted;
     
     dataLog(")");
@@ -263,6 +327,8 @@ void Graph::dump(NodeIndex nodeIndex, CodeBlock* codeBlock)
             dataLog("  predicting %s", predictionToString(node.getHeapPrediction()));
         else if (node.hasVarNumber())
             dataLog("  predicting %s", predictionToString(getGlobalVarPrediction(node.varNumber())));
+        else if (node.hasCapturedOperand())
+            dataLog("  predicting %s", predictionToString(getCapturedVarPrediction(node.capturedOperand())));
     }
     
     dataLog("\n");
@@ -282,6 +348,13 @@ void Graph::dump(CodeBlock* codeBlock)
         dataLog("  var links: ");
         dumpOperands(block->variablesAtHead, WTF::dataFile());
         dataLog("\n");
+        if (block->registerAllocatedLoop != NoRegisterAllocatedLoop) {
+            RegisterAllocatedLoop& loop = m_registerAllocatedLoops[block->registerAllocatedLoop];
+            dataLog("  loop registers (header #%u):", loop.header);
+            for (unsigned i = 0; i < loop.variables.size(); ++i)
+                dataLog(" r%d:%s%s", loop.variables[i].local, FPRInfo::debugName(loop.variables[i].fpr), loop.variables[i].isWritten ? "" : "(ro)");
+            dataLog("\n");
+        }
         for (size_t i = block->begin; i < block->end; ++i)
             dump(i, codeBlock);
         dataLog("  vars after: ");
@@ -346,7 +419,10 @@ void Graph::predictArgumentTypes(CodeBlock* codeBlock)
         if (!profile)
             continue;
         
-        at(m_arguments[arg]).variableAccessData()->predict(profile->computeUpdatedPrediction());
+        PredictedType prediction = profile->computeUpdatedPrediction();
+        at(m_arguments[arg]).variableAccessData()->predict(prediction);
+        if (arg < m_capturedVarPredictions.numberOfArguments())
+            predictCapturedVar(argumentToOperand(arg), prediction);
         
 #if DFG_ENABLE(DEBUG_VERBOSE)
         dataLog("Argument [%zu] prediction: %s\n", arg, predictionToString(at(m_arguments[arg]).variableAccessData()->prediction()));
@@ -354,6 +430,35 @@ void Graph::predictArgumentTypes(CodeBlock* codeBlock)
     }
 }
 
+void Graph::visitChildren(SlotVisitor& visitor)
+{
+    for (size_t i = 0; i < size(); ++i) {
+        Node& node = at(i);
+        if (node.isWeakConstant()) {
+            JSCell* cell = node.weakConstant();
+            visitor.appendUnbarrieredPointer(&cell);
+        }
+        if (node.hasFunctionCheckData()) {
+            JSFunction* function = node.function();
+            visitor.appendUnbarrieredPointer(&function);
+        }
+    }
+    
+    for (size_t i = 0; i < m_structureSet.size(); ++i) {
+        StructureSet& set = m_structureSet[i];
+        for (size_t j = 0; j < set.size(); ++j) {
+            Structure* structure = set[j];
+            visitor.appendUnbarrieredPointer(&structure);
+        }
+    }
+    
+    for (size_t i = 0; i < m_structureTransitionData.size(); ++i) {
+        StructureTransitionData& data = m_structureTransitionData[i];
+        visitor.appendUnbarrieredPointer(&data.previousStructure);
+        visitor.appendUnbarrieredPointer(&data.newStructure);
+    }
+}
+
 } } // namespace JSC::DFG
 
 #endif
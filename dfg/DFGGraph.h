@@ -30,6 +30,9 @@
 
 #include "CodeBlock.h"
 #include "DFGBasicBlock.h"
+#include "DFGDominators.h"
+#include "DFGFPRInfo.h"
+#include "DFGNaturalLoops.h"
 #include "DFGNode.h"
 #include "PredictionTracker.h"
 #include "RegisterFile.h"
@@ -42,6 +45,7 @@ namespace JSC {
 
 class CodeBlock;
 class ExecState;
+class SlotVisitor;
 
 namespace DFG {
 
@@ -58,11 +62,147 @@ struct StorageAccessData {
     // Structure*.
 };
 
+// A case of a MultiGetByOffset. If the base has one of the structures, the property is
+// loaded from the storage of the holder, or from the base's own storage if there is no
+// holder. The structures of the holder and of the other prototypes on the way to it are
+// checked by separate CheckStructure nodes.
+struct MultiGetByOffsetCase {
+    MultiGetByOffsetCase() { }
+    
+    MultiGetByOffsetCase(const StructureSet& structureSet, JSObject* holder, size_t offset)
+        : structureSet(structureSet)
+        , holder(holder)
+        , offset(offset)
+    {
+    }
+    
+    StructureSet structureSet;
+    JSObject* holder;
+    size_t offset;
+};
+
+struct MultiGetByOffsetData {
+    unsigned identifierNumber;
+    Vector<MultiGetByOffsetCase, 2> cases;
+    
+    // The union of the structure sets of the cases.
+    StructureSet structureSet;
+};
+
+// A case of a MultiPutByOffset. If the base has the old structure, the value is stored
+// at the offset, after switching the base to the new structure if there is one. A
+// transition never needs to grow the property storage.
+struct MultiPutByOffsetCase {
+    MultiPutByOffsetCase() { }
+    
+    MultiPutByOffsetCase(Structure* oldStructure, Structure* newStructure, size_t offset)
+        : oldStructure(oldStructure)
+        , newStructure(newStructure)
+        , offset(offset)
+    {
+    }
+    
+    Structure* oldStructure;
+    Structure* newStructure;
+    size_t offset;
+};
+
+struct MultiPutByOffsetData {
+    unsigned identifierNumber;
+    Vector<MultiPutByOffsetCase, 2> cases;
+};
+
 struct ResolveGlobalData {
     unsigned identifierNumber;
     unsigned resolveInfoIndex;
 };
 
+enum SwitchKind {
+    SwitchImm,
+    SwitchChar,
+    SwitchString
+};
+
+struct SwitchCase {
+    SwitchCase() { }
+    
+    SwitchCase(int32_t value, unsigned targetBytecodeOffset)
+        : value(value)
+        , string(0)
+        , targetBytecodeOffset(targetBytecodeOffset)
+        , target(NoBlock)
+    {
+    }
+    
+    SwitchCase(StringImpl* string, unsigned targetBytecodeOffset)
+        : value(0)
+        , string(string)
+        , targetBytecodeOffset(targetBytecodeOffset)
+        , target(NoBlock)
+    {
+    }
+    
+    // SwitchImm and SwitchChar cases match an int32 or a character code. SwitchString
+    // cases match a string, which is kept alive by the code block's jump table.
+    int32_t value;
+    StringImpl* string;
+    unsigned targetBytecodeOffset;
+    BlockIndex target;
+};
+
+// Switch nodes refer to one of these. The cases only list the table entries that
+// do not go to the fall through block, which is where everything else goes.
+struct SwitchData {
+    SwitchData()
+        : fallThrough(NoBlock)
+        , didUseJumpTable(false)
+    {
+    }
+    
+    SwitchKind kind;
+    unsigned switchTableIndex;
+    Vector<SwitchCase> cases;
+    unsigned fallThroughBytecodeOffset;
+    BlockIndex fallThrough;
+    bool didUseJumpTable;
+};
+
+// A double variable that lives in a loop register for the whole of an inner loop.
+// Its slot in the register file is only brought up to date on the edges that leave
+// the loop, and around calls.
+struct RegisterAllocatedVariable {
+    RegisterAllocatedVariable() { }
+    
+    RegisterAllocatedVariable(int local, FPRReg fpr, bool isWritten)
+        : local(local)
+        , fpr(fpr)
+        , isWritten(isWritten)
+    {
+    }
+    
+    int local;
+    FPRReg fpr;
+    bool isWritten;
+};
+
+// The blocks of the loop refer to this through BasicBlock::registerAllocatedLoop.
+// The variables are loaded into their registers on the edges that enter the loop,
+// all of which go to the header, and on OSR entry into any block of the loop.
+struct RegisterAllocatedLoop {
+    RegisterAllocatedLoop()
+        : header(NoBlock)
+    {
+    }
+    
+    explicit RegisterAllocatedLoop(BlockIndex header)
+        : header(header)
+    {
+    }
+    
+    BlockIndex header;
+    Vector<RegisterAllocatedVariable, 4> variables;
+};
+
 // 
 // === Graph ===
 //
@@ -137,6 +277,39 @@ public:
 
     BlockIndex blockIndexForBytecodeOffset(Vector<BlockIndex>& blocks, unsigned bytecodeBegin);
 
+    // The successors of a block, as given by its terminal. A switch may list the
+    // same successor more than once.
+    unsigned numSuccessors(BasicBlock& block)
+    {
+        Node& terminal = at(block.end - 1);
+        ASSERT(terminal.isTerminal());
+        if (terminal.isJump())
+            return 1;
+        if (terminal.isBranch())
+            return 2;
+        if (terminal.op == Switch)
+            return m_switchData[terminal.switchDataIndex()].cases.size() + 1;
+        return 0;
+    }
+
+    BlockIndex successor(BasicBlock& block, unsigned index)
+    {
+        Node& terminal = at(block.end - 1);
+        if (terminal.isJump()) {
+            ASSERT(!index);
+            return terminal.takenBlockIndex();
+        }
+        if (terminal.isBranch()) {
+            ASSERT(index < 2);
+            return index ? terminal.notTakenBlockIndex() : terminal.takenBlockIndex();
+        }
+        ASSERT(terminal.op == Switch);
+        SwitchData& data = m_switchData[terminal.switchDataIndex()];
+        if (!index)
+            return data.fallThrough;
+        return data.cases[index - 1].target;
+    }
+
     bool predictGlobalVar(unsigned varNumber, PredictedType prediction)
     {
         return m_predictions.predictGlobalVar(varNumber, prediction);
@@ -147,6 +320,22 @@ public:
         return m_predictions.getGlobalVarPrediction(varNumber);
     }
     
+    // Captured variables are only ever accessed through the register file, so they
+    // are predicted like global variables: by merging everything stored to them.
+    bool predictCapturedVar(int operand, PredictedType prediction)
+    {
+        if (!operandIsArgument(operand))
+            m_capturedVarPredictions.ensureLocals(operand + 1);
+        return mergePrediction(m_capturedVarPredictions.operand(operand), prediction);
+    }
+    
+    PredictedType getCapturedVarPrediction(int operand)
+    {
+        if (operandIsArgument(operand))
+            return m_capturedVarPredictions.operand(operand);
+        return m_capturedVarPredictions.getLocal(operand);
+    }
+    
     PredictedType getJSConstantPrediction(Node& node, CodeBlock* codeBlock)
     {
         return predictionFromValue(node.valueOfJSConstant(codeBlock));
@@ -236,6 +425,11 @@ public:
 
     void predictArgumentTypes(CodeBlock*);
     
+    // Marks the cells that the graph refers to but that are not yet recorded
+    // as weak references in the code block, for compilations that are still
+    // in flight when a collection happens.
+    void visitChildren(SlotVisitor&);
+    
     StructureSet* addStructureSet(const StructureSet& structureSet)
     {
         ASSERT(structureSet.size());
@@ -274,12 +468,19 @@ public:
     Vector< OwnPtr<BasicBlock> , 8> m_blocks;
     Vector<NodeUse, 16> m_varArgChildren;
     Vector<StorageAccessData> m_storageAccessData;
+    Vector<MultiGetByOffsetData> m_multiGetByOffsetData;
+    Vector<MultiPutByOffsetData> m_multiPutByOffsetData;
     Vector<ResolveGlobalData> m_resolveGlobalData;
+    Vector<SwitchData> m_switchData;
+    Vector<RegisterAllocatedLoop> m_registerAllocatedLoops;
     Vector<NodeIndex, 8> m_arguments;
     SegmentedVector<VariableAccessData, 16> m_variableAccessData;
     SegmentedVector<StructureSet, 16> m_structureSet;
     SegmentedVector<StructureTransitionData, 8> m_structureTransitionData;
     BitVector m_preservedVars;
+    Operands<PredictedType> m_capturedVarPredictions;
+    Dominators m_dominators;
+    NaturalLoops m_naturalLoops;
     unsigned m_localVars;
     unsigned m_parameterSlots;
 private:
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef DFGIntegerRange_h
+#define DFGIntegerRange_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(DFG_JIT)
+
+#include <limits.h>
+#include <stdio.h>
+
+namespace JSC { namespace DFG {
+
+// An interval of int32 values that a variable or a node may hold. The range only
+// speaks of int32s: a variable whose range is [0, 10] may still hold a double or a
+// string, but if it holds an int32 then that int32 is between 0 and 10.
+class IntegerRange {
+public:
+    IntegerRange()
+        : m_min(INT_MIN)
+        , m_max(INT_MAX)
+    {
+    }
+    
+    IntegerRange(int32_t min, int32_t max)
+        : m_min(min)
+        , m_max(max)
+    {
+    }
+    
+    // Returns the range of the int32 values in [min, max], or the full range if some
+    // values in [min, max] are not int32s.
+    static IntegerRange fromInt64(int64_t min, int64_t max)
+    {
+        if (min < INT_MIN || max > INT_MAX)
+            return IntegerRange();
+        return IntegerRange(static_cast<int32_t>(min), static_cast<int32_t>(max));
+    }
+    
+    int32_t min() const { return m_min; }
+    int32_t max() const { return m_max; }
+    
+    bool isTop() const { return m_min == INT_MIN && m_max == INT_MAX; }
+    bool isEmpty() const { return m_min > m_max; }
+    
+    bool contains(int32_t value) const { return value >= m_min && value <= m_max; }
+    
+    // Removes the values below min, or above max, from the range.
+    void filterMin(int64_t min)
+    {
+        if (min > m_max)
+            makeEmpty();
+        else if (min > m_min)
+            m_min = static_cast<int32_t>(min);
+    }
+    
+    void filterMax(int64_t max)
+    {
+        if (max < m_min)
+            makeEmpty();
+        else if (max < m_max)
+            m_max = static_cast<int32_t>(max);
+    }
+    
+    // Widens this range to include the other one. If widen is true, then any bound
+    // that has to move goes straight to the end of the int32 range, so that loops
+    // that grow a range on every iteration reach a fixpoint.
+    bool merge(const IntegerRange& other, bool widen)
+    {
+        bool changed = false;
+        if (other.m_min < m_min) {
+            m_min = widen ? INT_MIN : other.m_min;
+            changed = true;
+        }
+        if (other.m_max > m_max) {
+            m_max = widen ? INT_MAX : other.m_max;
+            changed = true;
+        }
+        return changed;
+    }
+    
+    bool operator==(const IntegerRange& other) const
+    {
+        return m_min == other.m_min && m_max == other.m_max;
+    }
+    
+    bool operator!=(const IntegerRange& other) const
+    {
+        return !(*this == other);
+    }
+    
+    void dump(FILE* out) const
+    {
+        if (isTop())
+            fprintf(out, "[top]");
+        else
+            fprintf(out, "[%d, %d]", m_min, m_max);
+    }
+    
+private:
+    void makeEmpty()
+    {
+        m_min = INT_MAX;
+        m_max = INT_MIN;
+    }
+    
+    int32_t m_min;
+    int32_t m_max;
+};
+
+// A relation between two variables, tracked by the range analysis alongside the ranges.
+// The variable at operand is either less than, or equal to, the length of the array
+// held by the variable at baseOperand. The length is the one that lengthOp loads, which
+// is also the one that indexed accesses to arrays of that kind are checked against.
+// lengthOp is a NodeType; this header is included by headers that DFGNode.h cannot be.
+struct LengthRelation {
+    enum Kind { LessThanLength, EqualsLength };
+    
+    LengthRelation() { }
+    
+    LengthRelation(Kind kind, int operand, int baseOperand, unsigned lengthOp)
+        : kind(kind)
+        , operand(operand)
+        , baseOperand(baseOperand)
+        , lengthOp(lengthOp)
+    {
+    }
+    
+    bool operator==(const LengthRelation& other) const
+    {
+        return kind == other.kind
+            && operand == other.operand
+            && baseOperand == other.baseOperand
+            && lengthOp == other.lengthOp;
+    }
+    
+    Kind kind;
+    int operand;
+    int baseOperand;
+    unsigned lengthOp;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGIntegerRange_h
@@ -36,6 +36,7 @@
 #include "DFGThunks.h"
 #include "JSGlobalData.h"
 #include "LinkBuffer.h"
+#include "SamplingProfiler.h"
 
 namespace JSC { namespace DFG {
 
@@ -51,6 +52,32 @@ void JITCompiler::linkOSRExits()
     }
 }
 
+void JITCompiler::linkCodeOrigins(LinkBuffer& linkBuffer, Vector<PerfMap::BytecodeLocation>& bytecodeLocations)
+{
+    if (PerfMap::wantsBytecodeLocations()) {
+        // The perf map only knows about the machine code block's own bytecode.
+        bytecodeLocations.reserveCapacity(m_codeOriginLabels.size());
+        for (unsigned i = 0; i < m_codeOriginLabels.size(); ++i) {
+            CodeOrigin codeOrigin = m_codeOriginLabels[i].second;
+            if (!codeOrigin.isSet())
+                continue;
+            unsigned bytecodeIndex = codeOrigin.bytecodeIndexForMachineCode();
+            if (!bytecodeLocations.isEmpty() && bytecodeLocations.last().bytecodeOffset == bytecodeIndex)
+                continue;
+            bytecodeLocations.append(PerfMap::BytecodeLocation(linkBuffer.offsetOf(m_codeOriginLabels[i].first), bytecodeIndex));
+        }
+    }
+
+    if (m_shouldRecordMachineCodeOrigins) {
+        Vector<CodeOriginAtMachineCodeOffset>& machineCodeOrigins = m_codeBlock->machineCodeOrigins();
+        machineCodeOrigins.resize(m_codeOriginLabels.size());
+        for (unsigned i = 0; i < m_codeOriginLabels.size(); ++i) {
+            machineCodeOrigins[i].codeOrigin = m_codeOriginLabels[i].second;
+            machineCodeOrigins[i].machineCodeOffset = linkBuffer.offsetOf(m_codeOriginLabels[i].first);
+        }
+    }
+}
+
 void JITCompiler::compileEntry()
 {
     // This code currently matches the old JIT. In the function header we need to
@@ -79,6 +106,9 @@ void JITCompiler::compileBody(SpeculativeJIT& speculative)
 
     bool compiledSpeculative = speculative.compile();
     ASSERT_UNUSED(compiledSpeculative, compiledSpeculative);
+    // Nothing after this point belongs to a node.
+    if (m_shouldNoteCodeOrigins)
+        noteCodeOrigin(CodeOrigin());
 
     linkOSRExits();
 
@@ -195,23 +225,61 @@ void JITCompiler::link(LinkBuffer& linkBuffer)
     codeBlock()->shrinkWeakReferenceTransitionsToFit();
 }
 
+JITCompiler::JITCompiler(JSGlobalData* globalData, Graph& dfg, CodeBlock* codeBlock)
+    : CCallHelpers(globalData, codeBlock)
+    , m_graph(dfg)
+    , m_currentCodeOriginIndex(0)
+    , m_shouldRecordMachineCodeOrigins(false)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    // Lets samples taken in the middle of this code be attributed to the
+    // function that was inlined there.
+    m_shouldRecordMachineCodeOrigins = globalData->samplingProfiler->isSampling();
+#endif
+    m_shouldNoteCodeOrigins = PerfMap::wantsBytecodeLocations() || m_shouldRecordMachineCodeOrigins;
+}
+
+JITCompiler::~JITCompiler()
+{
+}
+
 void JITCompiler::compile(JITCode& entry)
+{
+    generate();
+    link(entry);
+}
+
+void JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck)
+{
+    generateFunction();
+    linkFunction(entry, entryWithArityCheck);
+}
+
+void JITCompiler::generate()
 {
     compileEntry();
-    SpeculativeJIT speculative(*this);
-    compileBody(speculative);
+    m_speculative = adoptPtr(new SpeculativeJIT(*this));
+    compileBody(*m_speculative);
 
     // Create OSR entry trampolines if necessary.
-    speculative.createOSREntries();
+    m_speculative->createOSREntries();
+}
+
+void JITCompiler::link(JITCode& entry)
+{
+    ASSERT(m_speculative);
 
     LinkBuffer linkBuffer(*m_globalData, this, m_codeBlock);
     link(linkBuffer);
-    speculative.linkOSREntries(linkBuffer);
+    m_speculative->linkOSREntries(linkBuffer);
+    m_speculative->linkSwitches(linkBuffer);
 
-    entry = JITCode(linkBuffer.finalizeCode(), JITCode::DFGJIT);
+    Vector<PerfMap::BytecodeLocation> bytecodeLocations;
+    linkCodeOrigins(linkBuffer, bytecodeLocations);
+    entry = JITCode(linkBuffer.finalizeCode(PerfMap::Description(PerfMap::DFG, m_codeBlock, &bytecodeLocations)), JITCode::DFGJIT);
 }
 
-void JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck)
+void JITCompiler::generateFunction()
 {
     compileEntry();
 
@@ -229,8 +297,8 @@ void JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWi
 
 
     // === Function body code generation ===
-    SpeculativeJIT speculative(*this);
-    compileBody(speculative);
+    m_speculative = adoptPtr(new SpeculativeJIT(*this));
+    compileBody(*m_speculative);
 
     // === Function footer code generation ===
     //
@@ -245,8 +313,8 @@ void JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWi
     poke(GPRInfo::callFrameRegister, OBJECT_OFFSETOF(struct JITStackFrame, callFrame) / sizeof(void*));
 
     CallBeginToken token = beginCall();
-    Call callRegisterFileCheck = call();
-    notifyCall(callRegisterFileCheck, CodeOrigin(0), token);
+    m_callRegisterFileCheck = call();
+    notifyCall(m_callRegisterFileCheck, CodeOrigin(0), token);
     jump(fromRegisterFileCheck);
     
     // The fast entry point into a function does not check the correct number of arguments
@@ -254,7 +322,7 @@ void JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWi
     // determine the correct number of arguments have been passed, or have already checked).
     // In cases where an arity check is necessary, we enter here.
     // FIXME: change this from a cti call to a DFG style operation (normal C calling conventions).
-    Label arityCheck = label();
+    m_arityCheck = label();
     compileEntry();
 
     load32(AssemblyHelpers::payloadFor((VirtualRegister)RegisterFile::ArgumentCount), GPRInfo::regT1);
@@ -262,26 +330,33 @@ void JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWi
     move(stackPointerRegister, GPRInfo::argumentGPR0);
     poke(GPRInfo::callFrameRegister, OBJECT_OFFSETOF(struct JITStackFrame, callFrame) / sizeof(void*));
     token = beginCall();
-    Call callArityCheck = call();
-    notifyCall(callArityCheck, CodeOrigin(0), token);
+    m_callArityCheck = call();
+    notifyCall(m_callArityCheck, CodeOrigin(0), token);
     move(GPRInfo::regT0, GPRInfo::callFrameRegister);
     jump(fromArityCheck);
     
     // Create OSR entry trampolines if necessary.
-    speculative.createOSREntries();
+    m_speculative->createOSREntries();
+}
 
+void JITCompiler::linkFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck)
+{
+    ASSERT(m_speculative);
 
     // === Link ===
     LinkBuffer linkBuffer(*m_globalData, this, m_codeBlock);
     link(linkBuffer);
-    speculative.linkOSREntries(linkBuffer);
+    m_speculative->linkOSREntries(linkBuffer);
+    m_speculative->linkSwitches(linkBuffer);
     
     // FIXME: switch the register file check & arity check over to DFGOpertaion style calls, not JIT stubs.
-    linkBuffer.link(callRegisterFileCheck, cti_register_file_check);
-    linkBuffer.link(callArityCheck, m_codeBlock->m_isConstructor ? cti_op_construct_arityCheck : cti_op_call_arityCheck);
+    linkBuffer.link(m_callRegisterFileCheck, cti_register_file_check);
+    linkBuffer.link(m_callArityCheck, m_codeBlock->m_isConstructor ? cti_op_construct_arityCheck : cti_op_call_arityCheck);
 
-    entryWithArityCheck = linkBuffer.locationOf(arityCheck);
-    entry = JITCode(linkBuffer.finalizeCode(), JITCode::DFGJIT);
+    entryWithArityCheck = linkBuffer.locationOf(m_arityCheck);
+    Vector<PerfMap::BytecodeLocation> bytecodeLocations;
+    linkCodeOrigins(linkBuffer, bytecodeLocations);
+    entry = JITCode(linkBuffer.finalizeCode(PerfMap::Description(PerfMap::DFG, m_codeBlock, &bytecodeLocations)), JITCode::DFGJIT);
 }
 
 } } // namespace JSC::DFG
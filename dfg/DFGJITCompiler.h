@@ -187,19 +187,36 @@ struct PropertyAccessRecord {
 // call to be linked).
 class JITCompiler : public CCallHelpers {
 public:
-    JITCompiler(JSGlobalData* globalData, Graph& dfg, CodeBlock* codeBlock)
-        : CCallHelpers(globalData, codeBlock)
-        , m_graph(dfg)
-        , m_currentCodeOriginIndex(0)
-    {
-    }
+    JITCompiler(JSGlobalData*, Graph& dfg, CodeBlock*);
+    ~JITCompiler();
 
     void compile(JITCode& entry);
     void compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck);
 
+    // Compilation may also be split into two halves. Code generation only writes to the
+    // assembler buffer and to the CodeBlock being compiled, so it may run on a compiler
+    // thread. Linking allocates executable memory and fills in the CodeBlock's inline
+    // cache data, and must run on the thread that owns the JSGlobalData.
+    void generate();
+    void generateFunction();
+    void link(JITCode& entry);
+    void linkFunction(JITCode& entry, MacroAssemblerCodePtr& entryWithArityCheck);
+
     // Accessors for properties.
     Graph& graph() { return m_graph; }
     
+    // Whether compileBody() should note where the code for each node starts. This
+    // is needed for the perf map and the sampling profiler.
+    bool shouldNoteCodeOrigins() const { return m_shouldNoteCodeOrigins; }
+    
+    // Notes that the code for the node at codeOrigin starts here.
+    void noteCodeOrigin(CodeOrigin codeOrigin)
+    {
+        if (!m_codeOriginLabels.isEmpty() && m_codeOriginLabels.last().second == codeOrigin)
+            return;
+        m_codeOriginLabels.append(std::make_pair(label(), codeOrigin));
+    }
+    
     // Just get a token for beginning a call.
     CallBeginToken beginJSCall()
     {
@@ -322,6 +339,24 @@ public:
             else if (m_graph[nodeIndex].variableAccessData()->shouldUseDoubleFormat())
                 entry->m_localsForcedDouble.set(local);
         }
+        
+        // Likewise, the ranges and relations of dead variables do not matter.
+        entry->m_expectedRanges = basicBlock.rangesAtHead;
+        for (size_t argument = 0; argument < basicBlock.variablesAtHead.numberOfArguments(); ++argument) {
+            if (basicBlock.variablesAtHead.argument(argument) == NoNode)
+                entry->m_expectedRanges.argument(argument) = IntegerRange();
+        }
+        for (size_t local = 0; local < basicBlock.variablesAtHead.numberOfLocals(); ++local) {
+            if (basicBlock.variablesAtHead.local(local) == NoNode)
+                entry->m_expectedRanges.local(local) = IntegerRange();
+        }
+        for (size_t i = 0; i < basicBlock.relationsAtHead.size(); ++i) {
+            const LengthRelation& relation = basicBlock.relationsAtHead[i];
+            if (basicBlock.variablesAtHead.operand(relation.operand) == NoNode
+                || basicBlock.variablesAtHead.operand(relation.baseOperand) == NoNode)
+                continue;
+            entry->m_expectedRelations.append(relation);
+        }
 #else
         UNUSED_PARAM(basicBlock);
         UNUSED_PARAM(blockHead);
@@ -342,6 +377,7 @@ private:
     void compileEntry();
     void compileBody(SpeculativeJIT&);
     void link(LinkBuffer&);
+    void linkCodeOrigins(LinkBuffer&, Vector<PerfMap::BytecodeLocation>&);
 
     void exitSpeculativeWithOSR(const OSRExit&, SpeculationRecovery*);
     void linkOSRExits();
@@ -373,7 +409,16 @@ private:
     
     Vector<PropertyAccessRecord, 4> m_propertyAccesses;
     Vector<JSCallRecord, 4> m_jsCalls;
+    Vector<std::pair<Label, CodeOrigin> > m_codeOriginLabels;
     unsigned m_currentCodeOriginIndex;
+    bool m_shouldNoteCodeOrigins;
+    bool m_shouldRecordMachineCodeOrigins;
+
+    // State carried from generation to linking.
+    OwnPtr<SpeculativeJIT> m_speculative;
+    Label m_arityCheck;
+    Call m_callRegisterFileCheck;
+    Call m_callArityCheck;
 };
 
 } } // namespace JSC::DFG
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "DFGNaturalLoops.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGDominators.h"
+#include "DFGGraph.h"
+
+namespace JSC { namespace DFG {
+
+NaturalLoops::NaturalLoops() { }
+NaturalLoops::~NaturalLoops() { }
+
+void NaturalLoops::compute(Graph& graph, const Dominators& dominators)
+{
+    ASSERT(dominators.isValid());
+    
+    m_loops.clear();
+    
+    for (BlockIndex blockIndex = 0; blockIndex < graph.m_blocks.size(); ++blockIndex) {
+        BasicBlock& block = *graph.m_blocks[blockIndex];
+        if (!block.isReachable)
+            continue;
+        
+        for (unsigned i = 0; i < graph.numSuccessors(block); ++i) {
+            BlockIndex header = graph.successor(block, i);
+            if (!dominators.dominates(header, blockIndex))
+                continue;
+            
+            // This is a back edge. Loops that share a header are treated as one loop.
+            NaturalLoop* loop = 0;
+            for (unsigned j = 0; j < m_loops.size(); ++j) {
+                if (m_loops[j].header() == header) {
+                    loop = &m_loops[j];
+                    break;
+                }
+            }
+            if (!loop) {
+                m_loops.append(NaturalLoop(header));
+                loop = &m_loops.last();
+            }
+            
+            bool isNewLatch = true;
+            for (unsigned j = 0; j < loop->numLatches(); ++j) {
+                if (loop->latch(j) == blockIndex) {
+                    isNewLatch = false;
+                    break;
+                }
+            }
+            if (!isNewLatch)
+                continue;
+            loop->m_latches.append(blockIndex);
+            
+            // The loop body is everything that reaches the latch without going through
+            // the header.
+            Vector<BlockIndex, 16> worklist;
+            if (!loop->contains(blockIndex)) {
+                loop->addBlock(blockIndex);
+                worklist.append(blockIndex);
+            }
+            while (!worklist.isEmpty()) {
+                BlockIndex bodyIndex = worklist.last();
+                worklist.removeLast();
+                PredecessorList& predecessors = graph.m_blocks[bodyIndex]->m_predecessors;
+                for (unsigned j = 0; j < predecessors.size(); ++j) {
+                    if (loop->contains(predecessors[j]))
+                        continue;
+                    loop->addBlock(predecessors[j]);
+                    worklist.append(predecessors[j]);
+                }
+            }
+        }
+    }
+    
+    for (unsigned i = 0; i < m_loops.size(); ++i) {
+        NaturalLoop& loop = m_loops[i];
+        PredecessorList& predecessors = graph.m_blocks[loop.header()]->m_predecessors;
+        BlockIndex preheader = NoBlock;
+        for (unsigned j = 0; j < predecessors.size(); ++j) {
+            if (loop.contains(predecessors[j]))
+                continue;
+            if (preheader != NoBlock) {
+                preheader = NoBlock;
+                break;
+            }
+            preheader = predecessors[j];
+        }
+        if (preheader != NoBlock && graph.numSuccessors(*graph.m_blocks[preheader]) == 1)
+            loop.m_preheader = preheader;
+    }
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef DFGNaturalLoops_h
+#define DFGNaturalLoops_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGCommon.h"
+#include <wtf/BitVector.h>
+#include <wtf/Vector.h>
+
+namespace JSC { namespace DFG {
+
+class Dominators;
+class Graph;
+
+// A loop is identified by its header, which dominates every block in the loop. The
+// latches are the blocks with back edges to the header.
+class NaturalLoop {
+public:
+    NaturalLoop()
+        : m_header(NoBlock)
+        , m_preheader(NoBlock)
+    {
+    }
+    
+    explicit NaturalLoop(BlockIndex header)
+        : m_header(header)
+        , m_preheader(NoBlock)
+    {
+        addBlock(header);
+    }
+    
+    BlockIndex header() const { return m_header; }
+    
+    // The only block outside of the loop that jumps to the header, if that block has no
+    // other successors. Code placed at its end runs exactly once before the loop is
+    // entered. Loops without a preheader are left as they are, since we cannot yet
+    // insert new blocks into the graph.
+    BlockIndex preheader() const { return m_preheader; }
+    
+    unsigned size() const { return m_body.size(); }
+    BlockIndex at(unsigned i) const { return m_body[i]; }
+    BlockIndex operator[](unsigned i) const { return at(i); }
+    
+    bool contains(BlockIndex blockIndex) const { return m_bodySet.get(blockIndex); }
+    
+    unsigned numLatches() const { return m_latches.size(); }
+    BlockIndex latch(unsigned i) const { return m_latches[i]; }
+    
+private:
+    friend class NaturalLoops;
+    
+    void addBlock(BlockIndex blockIndex)
+    {
+        m_bodySet.ensureSize(blockIndex + 1);
+        m_bodySet.set(blockIndex);
+        m_body.append(blockIndex);
+    }
+    
+    BlockIndex m_header;
+    BlockIndex m_preheader;
+    Vector<BlockIndex, 4> m_body;
+    Vector<BlockIndex, 1> m_latches;
+    BitVector m_bodySet;
+};
+
+class NaturalLoops {
+public:
+    NaturalLoops();
+    ~NaturalLoops();
+    
+    // Requires the dominators to have been computed.
+    void compute(Graph&, const Dominators&);
+    
+    unsigned numLoops() const { return m_loops.size(); }
+    const NaturalLoop& loop(unsigned i) const { return m_loops[i]; }
+    
+private:
+    Vector<NaturalLoop, 4> m_loops;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGNaturalLoops_h
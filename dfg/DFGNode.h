@@ -65,6 +65,7 @@ typedef unsigned ArithNodeFlags;
 #define NodeMayOverflow    0x04
 #define NodeMayNegZero     0x08
 #define NodeBehaviorMask   0x0c
+#define NodeCannotOverflow 0x10 // set by the range analysis, once it has proven that the result fits in an int32.
 
 static inline bool nodeUsedAsNumber(ArithNodeFlags flags)
 {
@@ -86,6 +87,11 @@ static inline bool nodeMayOverflow(ArithNodeFlags flags)
     return !!(flags & NodeMayOverflow);
 }
 
+static inline bool nodeCanOmitOverflowCheck(ArithNodeFlags flags)
+{
+    return nodeCanTruncateInteger(flags) || (flags & NodeCannotOverflow);
+}
+
 static inline bool nodeCanSpeculateInteger(ArithNodeFlags flags)
 {
     if (flags & NodeMayOverflow)
@@ -134,6 +140,13 @@ static inline const char* arithNodeFlagsAsString(ArithNodeFlags flags)
         hasPrinted = true;
     }
     
+    if (flags & NodeCannotOverflow) {
+        if (hasPrinted)
+            ptr.strcat("|");
+        ptr.strcat("CannotOverflow");
+        hasPrinted = true;
+    }
+    
     *ptr++ = 0;
     
     return description;
@@ -181,6 +194,13 @@ static inline const char* arithNodeFlagsAsString(ArithNodeFlags flags)
     macro(Phi, 0) \
     macro(Flush, NodeMustGenerate) \
     \
+    /* Nodes for variables that may be captured by an activation or created lazily. These */\
+    /* never live in SSA form: they are always loaded from and stored to the register file, */\
+    /* which is where the activation, a torn-off activation or the old JIT expects them. */\
+    macro(GetCapturedVar, NodeResultJS) \
+    macro(PutCapturedVar, NodeMustGenerate) \
+    macro(ClearCapturedVar, NodeMustGenerate) \
+    \
     /* Marker for arguments being set. */\
     macro(SetArgument, 0) \
     \
@@ -232,6 +252,9 @@ static inline const char* arithNodeFlagsAsString(ArithNodeFlags flags)
     macro(GetIndexedPropertyStorage, NodeMustGenerate | NodeResultStorage) \
     macro(GetByOffset, NodeResultJS) \
     macro(PutByOffset, NodeMustGenerate | NodeClobbersWorld) \
+    /* Polymorphic versions of the above, which switch on the structure of the base. */\
+    macro(MultiGetByOffset, NodeResultJS) \
+    macro(MultiPutByOffset, NodeMustGenerate | NodeClobbersWorld) \
     macro(GetArrayLength, NodeResultInt32) \
     macro(GetStringLength, NodeResultInt32) \
     macro(GetByteArrayLength, NodeResultInt32) \
@@ -277,6 +300,21 @@ static inline const char* arithNodeFlagsAsString(ArithNodeFlags flags)
     macro(NewArrayBuffer, NodeResultJS) \
     macro(NewRegexp, NodeResultJS) \
     \
+    /* Closures. CreateActivation and NewFunction take the register's current value and */\
+    /* only allocate if it is still empty. */\
+    macro(CreateActivation, NodeResultJS | NodeMustGenerate) \
+    macro(TearOffActivation, NodeMustGenerate) \
+    macro(NewFunction, NodeResultJS | NodeMustGenerate) \
+    macro(NewFunctionNoCheck, NodeResultJS) \
+    macro(NewFunctionExpression, NodeResultJS) \
+    \
+    /* Nodes for for-in loops. NextPropertyNameIndex returns the index of the next property */\
+    /* that is still present on the base, or the iterator's size if there are none left. */\
+    macro(GetPropertyNameIterator, NodeResultJS | NodeMustGenerate | NodeClobbersWorld) \
+    macro(GetPropertyNameIteratorSize, NodeResultInt32) \
+    macro(NextPropertyNameIndex, NodeResultInt32 | NodeMustGenerate | NodeClobbersWorld) \
+    macro(GetPropertyNameIteratorKey, NodeResultJS) \
+    \
     /* Resolve nodes. */\
     macro(Resolve, NodeResultJS | NodeMustGenerate | NodeClobbersWorld) \
     macro(ResolveBase, NodeResultJS | NodeMustGenerate | NodeClobbersWorld) \
@@ -289,11 +327,13 @@ static inline const char* arithNodeFlagsAsString(ArithNodeFlags flags)
     macro(InstanceOf, NodeResultBoolean) \
     macro(LogicalNot, NodeResultBoolean | NodeMightClobber) \
     macro(ToPrimitive, NodeResultJS | NodeMustGenerate | NodeClobbersWorld) \
+    macro(TypeOf, NodeResultJS) \
     macro(StrCat, NodeResultJS | NodeMustGenerate | NodeHasVarArgs | NodeClobbersWorld) \
     \
     /* Block terminals. */\
     macro(Jump, NodeMustGenerate | NodeIsTerminal | NodeIsJump) \
     macro(Branch, NodeMustGenerate | NodeIsTerminal | NodeIsBranch) \
+    macro(Switch, NodeMustGenerate | NodeIsTerminal) \
     macro(Return, NodeMustGenerate | NodeIsTerminal) \
     macro(Throw, NodeMustGenerate | NodeIsTerminal) \
     macro(ThrowReferenceError, NodeMustGenerate | NodeIsTerminal) \
@@ -574,6 +614,34 @@ struct Node {
         return true;
     }
     
+    bool hasIndexBoundsInfo()
+    {
+        switch (op) {
+        case GetByVal:
+        case PutByVal:
+        case PutByValAlias:
+        case StringCharAt:
+        case StringCharCodeAt:
+            return true;
+        default:
+            return false;
+        }
+    }
+    
+    // Set by the range analysis if the index is known to be within the bounds of the
+    // base, so that the access needs no bounds check.
+    bool indexIsInBounds()
+    {
+        ASSERT(hasIndexBoundsInfo());
+        return m_opInfo;
+    }
+    
+    void setIndexIsInBounds()
+    {
+        ASSERT(hasIndexBoundsInfo());
+        m_opInfo = true;
+    }
+    
     bool hasConstantBuffer()
     {
         return op == NewArrayBuffer;
@@ -613,6 +681,39 @@ struct Node {
         return m_opInfo;
     }
 
+    bool hasCapturedOperand()
+    {
+        return op == GetCapturedVar || op == PutCapturedVar || op == ClearCapturedVar;
+    }
+
+    int capturedOperand()
+    {
+        ASSERT(hasCapturedOperand());
+        return m_opInfo;
+    }
+
+    bool hasFunctionDeclIndex()
+    {
+        return op == NewFunction || op == NewFunctionNoCheck;
+    }
+
+    unsigned functionDeclIndex()
+    {
+        ASSERT(hasFunctionDeclIndex());
+        return m_opInfo;
+    }
+
+    bool hasFunctionExprIndex()
+    {
+        return op == NewFunctionExpression;
+    }
+
+    unsigned functionExprIndex()
+    {
+        ASSERT(hasFunctionExprIndex());
+        return m_opInfo;
+    }
+
     bool hasScopeChainDepth()
     {
         return op == GetScopeChain;
@@ -700,6 +801,17 @@ struct Node {
         return m_opInfo2;
     }
     
+    bool hasSwitchData()
+    {
+        return op == Switch;
+    }
+    
+    unsigned switchDataIndex()
+    {
+        ASSERT(hasSwitchData());
+        return m_opInfo;
+    }
+    
     bool hasHeapPrediction()
     {
         switch (op) {
@@ -709,6 +821,7 @@ struct Node {
         case Call:
         case Construct:
         case GetByOffset:
+        case MultiGetByOffset:
         case GetScopedVar:
         case Resolve:
         case ResolveBase:
@@ -778,6 +891,28 @@ struct Node {
         return m_opInfo;
     }
     
+    bool hasMultiGetByOffsetData()
+    {
+        return op == MultiGetByOffset;
+    }
+    
+    unsigned multiGetByOffsetDataIndex()
+    {
+        ASSERT(hasMultiGetByOffsetData());
+        return m_opInfo;
+    }
+    
+    bool hasMultiPutByOffsetData()
+    {
+        return op == MultiPutByOffset;
+    }
+    
+    unsigned multiPutByOffsetDataIndex()
+    {
+        ASSERT(hasMultiPutByOffsetData());
+        return m_opInfo;
+    }
+    
     bool hasVirtualRegister()
     {
         return m_virtualRegister != InvalidVirtualRegister;
@@ -32,9 +32,84 @@
 #include "CodeBlock.h"
 #include "DFGNode.h"
 #include "JIT.h"
+#include "JSByteArray.h"
+#include "JSString.h"
 
 namespace JSC { namespace DFG {
 
+#if DFG_ENABLE(OSR_ENTRY)
+// Loads the length that lengthOp would load from base, if base is of the kind of
+// array that lengthOp expects.
+static bool lengthForOSREntry(JSGlobalData* globalData, NodeType lengthOp, JSValue base, int32_t& length)
+{
+    if (!base.isCell())
+        return false;
+    JSCell* cell = base.asCell();
+    
+    const TypedArrayDescriptor* descriptor;
+    switch (lengthOp) {
+    case GetStringLength:
+        if (!cell->isString())
+            return false;
+        length = asString(cell)->length();
+        return true;
+    case GetByteArrayLength:
+        if (!isJSByteArray(base))
+            return false;
+        length = asByteArray(base)->length();
+        return true;
+    case GetInt8ArrayLength:
+        descriptor = &globalData->int8ArrayDescriptor();
+        break;
+    case GetInt16ArrayLength:
+        descriptor = &globalData->int16ArrayDescriptor();
+        break;
+    case GetInt32ArrayLength:
+        descriptor = &globalData->int32ArrayDescriptor();
+        break;
+    case GetUint8ArrayLength:
+        descriptor = &globalData->uint8ArrayDescriptor();
+        break;
+    case GetUint8ClampedArrayLength:
+        descriptor = &globalData->uint8ClampedArrayDescriptor();
+        break;
+    case GetUint16ArrayLength:
+        descriptor = &globalData->uint16ArrayDescriptor();
+        break;
+    case GetUint32ArrayLength:
+        descriptor = &globalData->uint32ArrayDescriptor();
+        break;
+    case GetFloat32ArrayLength:
+        descriptor = &globalData->float32ArrayDescriptor();
+        break;
+    case GetFloat64ArrayLength:
+        descriptor = &globalData->float64ArrayDescriptor();
+        break;
+    default:
+        return false;
+    }
+    
+    if (!descriptor->m_classInfo || cell->classInfo() != descriptor->m_classInfo)
+        return false;
+    length = *reinterpret_cast<int32_t*>(reinterpret_cast<char*>(cell) + descriptor->m_lengthOffset);
+    return true;
+}
+
+static bool lengthRelationHolds(ExecState* exec, const LengthRelation& relation)
+{
+    JSValue value = exec->registers()[relation.operand].jsValue();
+    // Like ranges, relations only speak of int32s.
+    if (!value.isInt32())
+        return true;
+    int32_t length;
+    if (!lengthForOSREntry(&exec->globalData(), static_cast<NodeType>(relation.lengthOp), exec->registers()[relation.baseOperand].jsValue(), length))
+        return false;
+    if (relation.kind == LengthRelation::LessThanLength)
+        return value.asInt32() < length;
+    return value.asInt32() == length;
+}
+#endif
+
 void* prepareOSREntry(ExecState* exec, CodeBlock* codeBlock, unsigned bytecodeIndex)
 {
 #if DFG_ENABLE(OSR_ENTRY)
@@ -123,7 +198,48 @@ void* prepareOSREntry(ExecState* exec, CodeBlock* codeBlock, unsigned bytecodeIn
         }
     }
 
-    // 2) Check the stack height. The DFG JIT may require a taller stack than the
+    // 2) Verify the integer ranges and the length relations that the range analysis
+    //    inferred for the head of the block. These follow from the code that leads to
+    //    the block, so the values that the old JIT computed almost always satisfy them.
+    //    But the old JIT may have taken paths that the DFG speculated away, and the
+    //    DFG relies on the ranges to skip overflow and bounds checks.
+    
+    for (size_t argument = 0; argument < entry->m_expectedRanges.numberOfArguments(); ++argument) {
+        const IntegerRange& range = entry->m_expectedRanges.argument(argument);
+        JSValue value = exec->registers()[argumentToOperand(argument)].jsValue();
+        if (value.isInt32() && !range.contains(value.asInt32())) {
+#if ENABLE(JIT_VERBOSE_OSR)
+            dataLog("    OSR failed because argument %zu is %s, expected range ", argument, value.description());
+            range.dump(WTF::dataFile());
+            dataLog(".\n");
+#endif
+            return 0;
+        }
+    }
+    
+    for (size_t local = 0; local < entry->m_expectedRanges.numberOfLocals(); ++local) {
+        const IntegerRange& range = entry->m_expectedRanges.local(local);
+        JSValue value = exec->registers()[local].jsValue();
+        if (value.isInt32() && !range.contains(value.asInt32())) {
+#if ENABLE(JIT_VERBOSE_OSR)
+            dataLog("    OSR failed because variable %zu is %s, expected range ", local, value.description());
+            range.dump(WTF::dataFile());
+            dataLog(".\n");
+#endif
+            return 0;
+        }
+    }
+    
+    for (size_t i = 0; i < entry->m_expectedRelations.size(); ++i) {
+        if (!lengthRelationHolds(exec, entry->m_expectedRelations[i])) {
+#if ENABLE(JIT_VERBOSE_OSR)
+            dataLog("    OSR failed because r%d is not related to the length of r%d.\n", entry->m_expectedRelations[i].operand, entry->m_expectedRelations[i].baseOperand);
+#endif
+            return 0;
+        }
+    }
+    
+    // 3) Check the stack height. The DFG JIT may require a taller stack than the
     //    baseline JIT, in some cases. If we can't grow the stack, then don't do
     //    OSR right now. That's the only option we have unless we want basic block
     //    boundaries to start throwing RangeErrors. Although that would be possible,
@@ -142,18 +258,18 @@ void* prepareOSREntry(ExecState* exec, CodeBlock* codeBlock, unsigned bytecodeIn
 #endif
     
 #if USE(JSVALUE64)
-    // 3) Perform data format conversions.
+    // 4) Perform data format conversions.
     for (size_t local = 0; local < entry->m_expectedValues.numberOfLocals(); ++local) {
         if (entry->m_localsForcedDouble.get(local))
             *bitwise_cast<double*>(exec->registers() + local) = exec->registers()[local].jsValue().asNumber();
     }
 #endif
     
-    // 4) Fix the call frame.
+    // 5) Fix the call frame.
     
     exec->setCodeBlock(codeBlock);
     
-    // 5) Find and return the destination machine code address.
+    // 6) Find and return the destination machine code address.
     
     void* result = codeBlock->getJITCode().executableAddressAtOffset(entry->m_machineCodeOffset);
     
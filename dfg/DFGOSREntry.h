@@ -27,6 +27,7 @@
 #define DFGOSREntry_h
 
 #include "DFGAbstractValue.h"
+#include "DFGIntegerRange.h"
 #include "DFGOperands.h"
 #include <wtf/BitVector.h>
 
@@ -43,6 +44,8 @@ struct OSREntryData {
     unsigned m_machineCodeOffset;
     Operands<AbstractValue> m_expectedValues;
     BitVector m_localsForcedDouble;
+    Operands<IntegerRange> m_expectedRanges;
+    Vector<LengthRelation> m_expectedRelations;
 };
 
 inline unsigned getOSREntryDataBytecodeIndex(OSREntryData* osrEntryData)
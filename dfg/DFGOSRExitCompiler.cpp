@@ -63,7 +63,7 @@ void compileOSRExit(ExecState* exec)
         exitCompiler.compileExit(exit, recovery);
         
         LinkBuffer patchBuffer(*globalData, &jit, codeBlock);
-        exit.m_code = patchBuffer.finalizeCode();
+        exit.m_code = patchBuffer.finalizeCode(PerfMap::Description(PerfMap::DFG, codeBlock, "OSR exit", exit.m_codeOrigin.bytecodeIndexForMachineCode()));
 
 #if DFG_ENABLE(DEBUG_VERBOSE)
         dataLog("OSR exit code at [%p, %p).\n", patchBuffer.debugAddress(), static_cast<char*>(patchBuffer.debugAddress()) + patchBuffer.debugSize());
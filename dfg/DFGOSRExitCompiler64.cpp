@@ -297,13 +297,20 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, SpeculationRecovery* reco
     // At this point all GPRs are available for scratch use.
     
     if (haveFPRs) {
-        // 7) Box all doubles (relies on there being more GPRs than FPRs)
+        // 7) Box all doubles (relies on there being more GPRs than FPRs). Loop
+        //    registers have no GPR of their own, so they are boxed one at a time
+        //    into a GPR that no other FPR maps to.
+        
+        COMPILE_ASSERT(FPRInfo::numberOfRegisters < GPRInfo::numberOfRegisters, there_is_a_gpr_for_boxing_loop_registers);
+        GPRReg loopRegisterGPR = GPRInfo::toRegister(FPRInfo::numberOfRegisters);
         
         for (int index = 0; index < exit.numberOfRecoveries(); ++index) {
             const ValueRecovery& recovery = exit.valueRecovery(index);
             if (recovery.technique() != InFPR)
                 continue;
             FPRReg fpr = recovery.fpr();
+            if (FPRInfo::isLoopRegister(fpr))
+                continue;
             GPRReg gpr = GPRInfo::toRegister(FPRInfo::toIndex(fpr));
             m_jit.boxDouble(fpr, gpr);
         }
@@ -315,7 +322,12 @@ void OSRExitCompiler::compileExit(const OSRExit& exit, SpeculationRecovery* reco
             const ValueRecovery& recovery = exit.valueRecovery(index);
             if (recovery.technique() != InFPR)
                 continue;
-            GPRReg gpr = GPRInfo::toRegister(FPRInfo::toIndex(recovery.fpr()));
+            GPRReg gpr;
+            if (FPRInfo::isLoopRegister(recovery.fpr())) {
+                gpr = loopRegisterGPR;
+                m_jit.boxDouble(recovery.fpr(), gpr);
+            } else
+                gpr = GPRInfo::toRegister(FPRInfo::toIndex(recovery.fpr()));
             if (exit.isVariable(index) && poisonedVirtualRegisters[exit.variableForIndex(index)]) {
                 m_jit.storePtr(gpr, scratchBuffer + currentPoisonIndex);
                 m_poisonScratchIndices[exit.variableForIndex(index)] = currentPoisonIndex;
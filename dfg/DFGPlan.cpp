@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "DFGPlan.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "CodeBlock.h"
+#include "DFGByteCodeParser.h"
+#include "DFGJITCompiler.h"
+#include "DFGPropagator.h"
+#include "Executable.h"
+
+namespace JSC { namespace DFG {
+
+Plan::Plan(CompileMode compileMode, JSGlobalData& globalData, PassOwnPtr<CodeBlock> codeBlock, CodeBlock* profiledBlock)
+    : m_compileMode(compileMode)
+    , m_globalData(globalData)
+    , m_codeBlock(codeBlock)
+    , m_profiledBlock(profiledBlock)
+    , m_didCompileInThread(false)
+{
+    ASSERT(m_profiledBlock->getJITType() == JITCode::BaselineJIT);
+    ASSERT(!m_codeBlock->alternative());
+    m_codeBlock->borrowAlternative(m_profiledBlock);
+}
+
+bool Plan::parse()
+{
+    SamplingRegion samplingRegion("DFG Compilation (Parser)");
+
+#if DFG_ENABLE(DEBUG_VERBOSE)
+    dataLog("DFG compiling code block %p(%p) concurrently, number of instructions = %u.\n", m_codeBlock.get(), m_profiledBlock, m_codeBlock->instructionCount());
+#endif
+
+    if (!DFG::parse(m_graph, &m_globalData, m_codeBlock.get()))
+        return false;
+
+    if (m_compileMode == CompileFunction)
+        m_graph.predictArgumentTypes(m_codeBlock.get());
+
+    snapshotHoistingExitSites(m_codeBlock.get(), m_hoistingExitSites);
+
+    SegmentedVector<InlineCallFrame, 4>& inlineCallFrames = m_codeBlock->inlineCallFrames();
+    for (unsigned i = 0; i < inlineCallFrames.size(); ++i)
+        m_inlinedExecutables.add(inlineCallFrames[i].executable.get());
+
+    return true;
+}
+
+void Plan::compileInThread()
+{
+    propagate(m_graph, &m_globalData, m_codeBlock.get(), m_hoistingExitSites);
+    m_didCompileInThread = true;
+}
+
+void Plan::finalize()
+{
+    ASSERT(m_didCompileInThread);
+    ASSERT(m_compileMode == CompileFunction);
+
+    // The executable may have moved on while we were compiling, in which case
+    // there is nothing to install the code into.
+    if (m_profiledBlock->replacement() != m_profiledBlock)
+        return;
+
+    SamplingRegion samplingRegion("DFG Compilation (Finalize)");
+
+    JITCode jitCode;
+    MacroAssemblerCodePtr jitCodeWithArityCheck;
+    JITCompiler dataFlowJIT(&m_globalData, m_graph, m_codeBlock.get());
+    dataFlowJIT.compileFunction(jitCode, jitCodeWithArityCheck);
+
+    FunctionExecutable* executable = static_cast<FunctionExecutable*>(m_profiledBlock->ownerExecutable());
+    CodeSpecializationKind kind = m_profiledBlock->specializationKind();
+    executable->installOptimizedCodeFor(kind, static_pointer_cast<FunctionCodeBlock>(m_codeBlock.release()), jitCode, jitCodeWithArityCheck);
+}
+
+bool Plan::refersTo(ExecutableBase* executable) const
+{
+    return m_profiledBlock->ownerExecutable() == executable || m_inlinedExecutables.contains(executable);
+}
+
+void Plan::visitChildren(SlotVisitor& visitor)
+{
+    if (!m_codeBlock)
+        return;
+    m_codeBlock->visitStrongly(visitor);
+    m_graph.visitChildren(visitor);
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef DFGPlan_h
+#define DFGPlan_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGCommon.h"
+#include "DFGGraph.h"
+#include "DFGPropagator.h"
+#include <wtf/HashSet.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
+
+namespace JSC {
+
+class CodeBlock;
+class ExecutableBase;
+class JSGlobalData;
+class SlotVisitor;
+
+namespace DFG {
+
+// === Plan ===
+//
+// A Plan carries one optimizing compilation from the main thread, through a
+// compiler thread, and back to the main thread:
+//
+// - The main thread creates the plan and calls parse(). Parsing consults the
+//   profiling data of the baseline CodeBlock, which is being mutated by the code
+//   that is still running, so it is the snapshot that the rest of the compile sees.
+//   That includes the hoisting exit sites of every baseline block it inlined.
+// - A compiler thread calls compileInThread(), which runs the propagation and
+//   optimization phases. These only read the Graph and the constants of the
+//   CodeBlock being compiled, both of which belong to the plan, plus structures
+//   that the global object never replaces. Anything they learn about a constant's
+//   structure is only a prediction, which the generated code checks.
+// - The main thread calls finalize() at a safe point. Code generation reads value
+//   profiles, structure transitions and the JSGlobalData, all of which the running
+//   program mutates, so it happens there, right before the code is linked and
+//   installed as the executable's replacement.
+//
+// The executable owns the baseline CodeBlock until the new one is installed; the
+// plan's CodeBlock only borrows it as its alternative().
+//
+// Plans must only be destroyed on the main thread.
+class Plan : public ThreadSafeRefCounted<Plan> {
+public:
+    static PassRefPtr<Plan> create(CompileMode compileMode, JSGlobalData& globalData, PassOwnPtr<CodeBlock> codeBlock, CodeBlock* profiledBlock)
+    {
+        return adoptRef(new Plan(compileMode, globalData, codeBlock, profiledBlock));
+    }
+    bool parse();
+    void compileInThread();
+    void finalize();
+
+    CodeBlock* profiledBlock() const { return m_profiledBlock; }
+    CodeBlock* codeBlock() const { return m_codeBlock.get(); }
+
+    // Whether the plan compiles or inlines code of the given executable.
+    bool refersTo(ExecutableBase*) const;
+
+    void visitChildren(SlotVisitor&);
+
+private:
+    Plan(CompileMode, JSGlobalData&, PassOwnPtr<CodeBlock>, CodeBlock* profiledBlock);
+
+    CompileMode m_compileMode;
+    JSGlobalData& m_globalData;
+    OwnPtr<CodeBlock> m_codeBlock;
+    CodeBlock* m_profiledBlock;
+    Graph m_graph;
+    HoistingExitSites m_hoistingExitSites;
+    HashSet<ExecutableBase*> m_inlinedExecutables;
+    bool m_didCompileInThread;
+};
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGPlan_h
@@ -29,6 +29,7 @@
 #if ENABLE(DFG_JIT)
 
 #include "DFGAbstractState.h"
+#include "DFGAssemblyHelpers.h"
 #include "DFGGraph.h"
 #include "DFGScoreBoard.h"
 #include <wtf/FixedArray.h>
@@ -37,11 +38,12 @@ namespace JSC { namespace DFG {
 
 class Propagator {
 public:
-    Propagator(Graph& graph, JSGlobalData& globalData, CodeBlock* codeBlock, CodeBlock* profiledBlock)
+    Propagator(Graph& graph, JSGlobalData& globalData, CodeBlock* codeBlock, CodeBlock* profiledBlock, const HoistingExitSites& hoistingExitSites)
         : m_graph(graph)
         , m_globalData(globalData)
         , m_codeBlock(codeBlock)
         , m_profiledBlock(profiledBlock)
+        , m_hoistingExitSites(hoistingExitSites)
     {
         // Replacements are used to implement local common subexpression elimination.
         m_replacements.resize(m_graph.size());
@@ -75,7 +77,11 @@ public:
         m_graph.dump(m_codeBlock);
 #endif
 
+        hoistLoopInvariantChecks();
+
         allocateVirtualRegisters();
+        
+        allocateLoopRegisters();
 
 #if DFG_ENABLE(DEBUG_PROPAGATION_VERBOSE)
         dataLog("Graph after virtual register allocation:\n");
@@ -83,6 +89,8 @@ public:
 #endif
 
         globalCFA();
+        
+        analyzeIntegerRanges();
 
 #if DFG_ENABLE(DEBUG_VERBOSE)
         dataLog("Graph after propagation:\n");
@@ -481,7 +489,8 @@ private:
             break;
         }
 
-        case GetByOffset: {
+        case GetByOffset:
+        case MultiGetByOffset: {
             if (node.getHeapPrediction())
                 changed |= mergePrediction(node.getHeapPrediction());
             break;
@@ -518,6 +527,18 @@ private:
             break;
         }
             
+        case GetCapturedVar: {
+            PredictedType prediction = m_graph.getCapturedVarPrediction(node.capturedOperand());
+            if (prediction)
+                changed |= mergePrediction(prediction);
+            break;
+        }
+            
+        case PutCapturedVar: {
+            changed |= m_graph.predictCapturedVar(node.capturedOperand(), m_graph[node.child1()].prediction());
+            break;
+        }
+            
         case GetScopedVar:
         case Resolve:
         case ResolveBase:
@@ -551,13 +572,50 @@ private:
             break;
         }
             
-        case NewRegexp: {
+        case NewRegexp:
+        case CreateActivation: {
             changed |= setPrediction(PredictObjectOther);
             break;
         }
+            
+        case NewFunction: {
+            // The register may already hold the function, or whatever the program has
+            // since assigned to it.
+            PredictedType child = m_graph[node.child1()].prediction();
+            if (child)
+                changed |= mergePrediction(child);
+            changed |= mergePrediction(PredictFunction);
+            break;
+        }
+            
+        case NewFunctionNoCheck:
+        case NewFunctionExpression: {
+            changed |= setPrediction(PredictFunction);
+            break;
+        }
+            
+        case GetPropertyNameIterator: {
+            changed |= setPrediction(PredictCellOther);
+            break;
+        }
+            
+        case GetPropertyNameIteratorSize:
+        case NextPropertyNameIndex: {
+            changed |= setPrediction(PredictInt32);
+            break;
+        }
+            
+        case GetPropertyNameIteratorKey: {
+            PredictedType child = m_graph[node.child3()].prediction();
+            if (child)
+                changed |= mergePrediction(child);
+            changed |= mergePrediction(PredictString);
+            break;
+        }
         
         case StringCharAt:
-        case StrCat: {
+        case StrCat:
+        case TypeOf: {
             changed |= setPrediction(PredictString);
             break;
         }
@@ -602,9 +660,12 @@ private:
         
 #ifndef NDEBUG
         // These get ignored because they don't return anything.
+        case ClearCapturedVar:
+        case TearOffActivation:
         case PutScopedVar:
         case DFG::Jump:
         case Branch:
+        case Switch:
         case Breakpoint:
         case Return:
         case CheckHasInstance:
@@ -622,6 +683,7 @@ private:
         case CheckFunction:
         case PutStructure:
         case PutByOffset:
+        case MultiPutByOffset:
             break;
             
         // These gets ignored because it doesn't do anything.
@@ -1135,6 +1197,35 @@ private:
         return NoNode;
     }
     
+    NodeIndex capturedVarLoadElimination(int operand)
+    {
+        NodeIndex start = startIndexForChildren();
+        for (NodeIndex index = m_compileIndex; index-- > start;) {
+            Node& node = m_graph[index];
+            switch (node.op) {
+            case GetCapturedVar:
+                if (node.capturedOperand() == operand)
+                    return index;
+                break;
+            case PutCapturedVar:
+                if (node.capturedOperand() == operand)
+                    return node.child1().index();
+                break;
+            case ClearCapturedVar:
+                if (node.capturedOperand() == operand)
+                    return NoNode;
+                break;
+            default:
+                break;
+            }
+            // Anything that may call out to JS code could write to the variable through
+            // the activation.
+            if (clobbersWorld(index))
+                break;
+        }
+        return NoNode;
+    }
+    
     NodeIndex getByValLoadElimination(NodeIndex child1, NodeIndex child2)
     {
         NodeIndex start = startIndexForChildren(child1, child2);
@@ -1517,6 +1608,10 @@ private:
             setReplacement(globalVarLoadElimination(node.varNumber(), m_codeBlock->globalObjectFor(node.codeOrigin)));
             break;
             
+        case GetCapturedVar:
+            setReplacement(capturedVarLoadElimination(node.capturedOperand()));
+            break;
+            
         case GetByVal:
             if (byValIsPure(node))
                 setReplacement(getByValLoadElimination(node.child1().index(), node.child2().index()));
@@ -1580,6 +1675,326 @@ private:
             performBlockCSE(*m_graph.m_blocks[block]);
     }
     
+    bool mightClobberStructures(NodeIndex nodeIndex)
+    {
+        Node& node = m_graph[nodeIndex];
+        switch (node.op) {
+        case PutByVal:
+        case PutByValAlias:
+            return !byValIsPure(node);
+        default:
+            return clobbersWorld(nodeIndex);
+        }
+    }
+    
+    // Returns the variable that the node gets, if the node is a GetLocal of a cell
+    // variable that the loop does not assign, and that is live at the end of the
+    // preheader.
+    VariableAccessData* loopInvariantCellVariable(NodeIndex nodeIndex, Operands<bool>& isAssigned, BasicBlock& preheader)
+    {
+        Node& node = m_graph[nodeIndex];
+        if (node.op != GetLocal)
+            return 0;
+        
+        VariableAccessData* variable = node.variableAccessData();
+        if (variable->shouldUseDoubleFormat() || !isCellPrediction(variable->prediction()))
+            return 0;
+        if (isAssigned.operand(variable->local()))
+            return 0;
+        
+        NodeIndex tailIndex = preheader.variablesAtTail.operand(variable->local());
+        if (tailIndex == NoNode || m_graph[tailIndex].variableAccessData() != variable)
+            return 0;
+        
+        return variable;
+    }
+    
+    const ClassInfo* classInfoForTypedArray(Node& node)
+    {
+        if (node.shouldSpeculateInt8Array())
+            return m_globalData.int8ArrayDescriptor().m_classInfo;
+        if (node.shouldSpeculateInt16Array())
+            return m_globalData.int16ArrayDescriptor().m_classInfo;
+        if (node.shouldSpeculateInt32Array())
+            return m_globalData.int32ArrayDescriptor().m_classInfo;
+        if (node.shouldSpeculateUint8Array())
+            return m_globalData.uint8ArrayDescriptor().m_classInfo;
+        if (node.shouldSpeculateUint8ClampedArray())
+            return m_globalData.uint8ClampedArrayDescriptor().m_classInfo;
+        if (node.shouldSpeculateUint16Array())
+            return m_globalData.uint16ArrayDescriptor().m_classInfo;
+        if (node.shouldSpeculateUint32Array())
+            return m_globalData.uint32ArrayDescriptor().m_classInfo;
+        if (node.shouldSpeculateFloat32Array())
+            return m_globalData.float32ArrayDescriptor().m_classInfo;
+        if (node.shouldSpeculateFloat64Array())
+            return m_globalData.float64ArrayDescriptor().m_classInfo;
+        return 0;
+    }
+    
+    void addHoistedCheck(BasicBlock& preheader, const HoistedCheck& check)
+    {
+        for (size_t i = 0; i < preheader.hoistedChecks.size(); ++i) {
+            HoistedCheck& other = preheader.hoistedChecks[i];
+            if (other.operand == check.operand && !other.structureSet == !check.structureSet)
+                return;
+        }
+#if DFG_ENABLE(DEBUG_PROPAGATION_VERBOSE)
+        dataLog("   Hoisting a check on r%d.\n", check.operand);
+#endif
+        preheader.hoistedChecks.append(check);
+    }
+    
+    void hoistChecksOutOfLoop(const NaturalLoop& loop)
+    {
+        if (loop.preheader() == NoBlock)
+            return;
+        BasicBlock& preheader = *m_graph.m_blocks[loop.preheader()];
+        
+        // If hoisted checks have failed here before, then some of the values that the
+        // loop checks do change between entering the loop and executing the checks.
+        CodeOrigin codeOrigin = m_graph[preheader.end - 1].codeOrigin;
+        CodeBlock* baselineCodeBlock = AssemblyHelpers::baselineCodeBlockForOriginAndBaselineCodeBlock(codeOrigin, m_profiledBlock);
+        if (m_hoistingExitSites.contains(std::make_pair(baselineCodeBlock, codeOrigin.bytecodeIndex)))
+            return;
+        
+        Operands<bool> isAssigned(m_codeBlock->numParameters(), m_graph.m_localVars);
+        bool loopMightClobberStructures = false;
+        for (unsigned i = 0; i < loop.size(); ++i) {
+            BasicBlock& block = *m_graph.m_blocks[loop[i]];
+            for (NodeIndex nodeIndex = block.begin; nodeIndex < block.end; ++nodeIndex) {
+                Node& node = m_graph[nodeIndex];
+                if (node.op == SetLocal)
+                    isAssigned.operand(node.local()) = true;
+                else if (node.shouldGenerate() && mightClobberStructures(nodeIndex))
+                    loopMightClobberStructures = true;
+            }
+        }
+        
+        for (unsigned i = 0; i < loop.size(); ++i) {
+            // Only hoist the checks that are done on every iteration. Other checks may
+            // guard paths that are only taken when the speculation would fail.
+            bool runsOnEveryIteration = true;
+            for (unsigned j = 0; j < loop.numLatches(); ++j) {
+                if (!m_graph.m_dominators.dominates(loop[i], loop.latch(j))) {
+                    runsOnEveryIteration = false;
+                    break;
+                }
+            }
+            if (!runsOnEveryIteration)
+                continue;
+            
+            BasicBlock& block = *m_graph.m_blocks[loop[i]];
+            for (NodeIndex nodeIndex = block.begin; nodeIndex < block.end; ++nodeIndex) {
+                Node& node = m_graph[nodeIndex];
+                if (!node.shouldGenerate())
+                    continue;
+                
+                switch (node.op) {
+                case CheckStructure: {
+                    // The CFA can only prove a single structure, and it forgets it when
+                    // anything in the loop might change structures.
+                    if (loopMightClobberStructures || node.structureSet().size() != 1)
+                        break;
+                    VariableAccessData* variable = loopInvariantCellVariable(node.child1().index(), isAssigned, preheader);
+                    if (!variable)
+                        break;
+                    addHoistedCheck(preheader, HoistedCheck(variable->local(), &node.structureSet()));
+                    break;
+                }
+                    
+                case GetByVal:
+                case PutByVal:
+                case PutByValAlias:
+                case GetIndexedPropertyStorage:
+                case GetInt8ArrayLength:
+                case GetInt16ArrayLength:
+                case GetInt32ArrayLength:
+                case GetUint8ArrayLength:
+                case GetUint8ClampedArrayLength:
+                case GetUint16ArrayLength:
+                case GetUint32ArrayLength:
+                case GetFloat32ArrayLength:
+                case GetFloat64ArrayLength: {
+                    // SetLocal does not check typed arrays, so unlike arrays, the CFA
+                    // does not know that typed array variables hold typed arrays.
+                    if ((node.op == GetByVal || node.op == PutByVal || node.op == PutByValAlias) && !byValIsPure(node))
+                        break;
+                    VariableAccessData* variable = loopInvariantCellVariable(node.child1().index(), isAssigned, preheader);
+                    if (!variable)
+                        break;
+                    Node& base = m_graph[node.child1()];
+                    const ClassInfo* classInfo = classInfoForTypedArray(base);
+                    if (!classInfo)
+                        break;
+                    addHoistedCheck(preheader, HoistedCheck(variable->local(), base.prediction(), classInfo));
+                    break;
+                }
+                    
+                default:
+                    break;
+                }
+            }
+        }
+    }
+    
+    void hoistLoopInvariantChecks()
+    {
+#if DFG_ENABLE(DEBUG_PROPAGATION_VERBOSE)
+        dataLog("Hoisting loop invariant checks:\n");
+#endif
+        m_graph.m_dominators.compute(m_graph);
+        m_graph.m_naturalLoops.compute(m_graph, m_graph.m_dominators);
+        
+        for (unsigned i = 0; i < m_graph.m_naturalLoops.numLoops(); ++i)
+            hoistChecksOutOfLoop(m_graph.m_naturalLoops.loop(i));
+    }
+    
+    // How an inner loop uses a local, as far as giving it a loop register goes.
+    struct LoopRegisterCandidate {
+        LoopRegisterCandidate()
+            : uses(0)
+            , isWritten(false)
+            , isRejected(false)
+        {
+        }
+        
+        unsigned uses;
+        bool isWritten;
+        bool isRejected;
+    };
+    
+    void rejectUnlessDouble(NodeIndex nodeIndex, LoopRegisterCandidate& candidate)
+    {
+        if (nodeIndex == NoNode)
+            return;
+        if (!m_graph[nodeIndex].variableAccessData()->shouldUseDoubleFormat())
+            candidate.isRejected = true;
+    }
+    
+    bool isInnerLoop(const NaturalLoop& loop)
+    {
+        for (unsigned i = 0; i < m_graph.m_naturalLoops.numLoops(); ++i) {
+            BlockIndex otherHeader = m_graph.m_naturalLoops.loop(i).header();
+            if (otherHeader != loop.header() && loop.contains(otherHeader))
+                return false;
+        }
+        return true;
+    }
+    
+    void allocateRegistersForLoop(const NaturalLoop& loop)
+    {
+        // Nothing loads the loop registers when the prologue falls into block 0.
+        if (!loop.header())
+            return;
+        
+        // The loop registers are loaded and stored by edge code, which the switch jump
+        // tables have no room for.
+        PredecessorList& predecessors = m_graph.m_blocks[loop.header()]->m_predecessors;
+        for (unsigned i = 0; i < predecessors.size(); ++i) {
+            if (m_graph[m_graph.m_blocks[predecessors[i]]->end - 1].op == Switch)
+                return;
+        }
+        
+        Vector<LoopRegisterCandidate> candidates(m_graph.m_localVars);
+        for (unsigned i = 0; i < loop.size(); ++i) {
+            BasicBlock& block = *m_graph.m_blocks[loop[i]];
+            if (m_graph[block.end - 1].op == Switch)
+                return;
+            
+            // A variable can only live in an FPR if every value it holds in the loop
+            // is a double.
+            for (unsigned local = 0; local < candidates.size(); ++local) {
+                rejectUnlessDouble(block.variablesAtHead.local(local), candidates[local]);
+                rejectUnlessDouble(block.variablesAtTail.local(local), candidates[local]);
+            }
+            
+            for (NodeIndex nodeIndex = block.begin; nodeIndex < block.end; ++nodeIndex) {
+                Node& node = m_graph[nodeIndex];
+                switch (node.op) {
+                case GetLocal:
+                case SetLocal:
+                case Flush: {
+                    if (operandIsArgument(node.local()))
+                        break;
+                    LoopRegisterCandidate& candidate = candidates[node.local()];
+                    // A Flush wants the variable to be in the register file.
+                    if (node.op == Flush || !node.variableAccessData()->shouldUseDoubleFormat()) {
+                        candidate.isRejected = true;
+                        break;
+                    }
+                    if (node.op == SetLocal)
+                        candidate.isWritten = true;
+                    if (node.shouldGenerate())
+                        candidate.uses++;
+                    break;
+                }
+                    
+                case InlineStart: {
+                    // The arguments of an inlined call frame are recovered from the
+                    // register file when the frame is reified.
+                    InlineCallFrame* inlineCallFrame = node.codeOrigin.inlineCallFrame;
+                    for (unsigned argument = 0; argument < inlineCallFrame->arguments.size(); ++argument) {
+                        int operand = inlineCallFrame->stackOffset + CallFrame::argumentOffsetIncludingThis(argument);
+                        if (operand >= 0 && static_cast<unsigned>(operand) < candidates.size())
+                            candidates[operand].isRejected = true;
+                    }
+                    break;
+                }
+                    
+                default:
+                    break;
+                }
+            }
+        }
+        
+        // Hand out the registers to the variables that the loop uses the most.
+        RegisterAllocatedLoop allocation(loop.header());
+        while (allocation.variables.size() < FPRInfo::numberOfLoopRegisters) {
+            int best = -1;
+            for (unsigned local = 0; local < candidates.size(); ++local) {
+                LoopRegisterCandidate& candidate = candidates[local];
+                if (candidate.isRejected || !candidate.uses)
+                    continue;
+                if (best < 0 || candidate.uses > candidates[best].uses)
+                    best = local;
+            }
+            if (best < 0)
+                break;
+            
+            FPRReg fpr = FPRInfo::toLoopRegister(allocation.variables.size());
+#if DFG_ENABLE(DEBUG_PROPAGATION_VERBOSE)
+            dataLog("   Giving r%d to %s in the loop at #%u.\n", best, FPRInfo::debugName(fpr), loop.header());
+#endif
+            allocation.variables.append(RegisterAllocatedVariable(best, fpr, candidates[best].isWritten));
+            candidates[best].isRejected = true;
+        }
+        if (allocation.variables.isEmpty())
+            return;
+        
+        for (unsigned i = 0; i < loop.size(); ++i)
+            m_graph.m_blocks[loop[i]]->registerAllocatedLoop = m_graph.m_registerAllocatedLoops.size();
+        m_graph.m_registerAllocatedLoops.append(allocation);
+    }
+    
+    // Keeps the double variables of inner loops in registers across the loop's edges,
+    // rather than storing them at every SetLocal and loading them at every GetLocal.
+    void allocateLoopRegisters()
+    {
+#if DFG_ENABLE(DEBUG_PROPAGATION_VERBOSE)
+        dataLog("Allocating loop registers:\n");
+#endif
+        if (!FPRInfo::numberOfLoopRegisters)
+            return;
+        
+        ASSERT(m_graph.m_dominators.isValid());
+        for (unsigned i = 0; i < m_graph.m_naturalLoops.numLoops(); ++i) {
+            const NaturalLoop& loop = m_graph.m_naturalLoops.loop(i);
+            if (isInnerLoop(loop))
+                allocateRegistersForLoop(loop);
+        }
+    }
+    
     void allocateVirtualRegisters()
     {
 #if DFG_ENABLE(DEBUG_VERBOSE)
@@ -1708,10 +2123,521 @@ private:
         } while (m_changed);
     }
     
+    // What the range analysis knows about a node, while it visits the node's block.
+    struct RangeNodeData {
+        RangeNodeData()
+            : hasOperand(false)
+            , hasLengthBase(false)
+        {
+        }
+        
+        IntegerRange range;
+        
+        // The variable that currently holds the node's value, if any. The node stops
+        // being held by the variable once the variable's version changes.
+        bool hasOperand;
+        int operand;
+        unsigned version;
+        
+        // If the node loads a length, the variable that holds the array it was loaded from.
+        bool hasLengthBase;
+        int lengthBaseOperand;
+        unsigned lengthBaseVersion;
+    };
+    
+    bool nodeOperandForRanges(NodeIndex nodeIndex, int& operand)
+    {
+        RangeNodeData& data = m_rangeNodeData[nodeIndex];
+        if (!data.hasOperand || m_rangeOperandVersions.operand(data.operand) != data.version)
+            return false;
+        operand = data.operand;
+        return true;
+    }
+    
+    bool lengthBaseForRanges(NodeIndex nodeIndex, int& baseOperand)
+    {
+        RangeNodeData& data = m_rangeNodeData[nodeIndex];
+        if (!data.hasLengthBase || m_rangeOperandVersions.operand(data.lengthBaseOperand) != data.lengthBaseVersion)
+            return false;
+        baseOperand = data.lengthBaseOperand;
+        return true;
+    }
+    
+    void setNodeOperandForRanges(NodeIndex nodeIndex, int operand)
+    {
+        RangeNodeData& data = m_rangeNodeData[nodeIndex];
+        data.hasOperand = true;
+        data.operand = operand;
+        data.version = m_rangeOperandVersions.operand(operand);
+    }
+    
+    // Returns the op that loads the length that the access's index is checked against,
+    // or false if the access is not bounds checked against a length that we track.
+    bool lengthOpForIndexedAccess(Node& node, NodeType& lengthOp)
+    {
+        switch (node.op) {
+        case StringCharAt:
+        case StringCharCodeAt:
+            lengthOp = GetStringLength;
+            return true;
+            
+        case GetByVal:
+        case PutByVal:
+        case PutByValAlias: {
+            if (!byValIsPure(node))
+                return false;
+            Node& base = m_graph[node.child1()];
+            if (node.op == GetByVal && base.prediction() == PredictString)
+                lengthOp = GetStringLength;
+            else if (base.shouldSpeculateByteArray())
+                lengthOp = GetByteArrayLength;
+            else if (base.shouldSpeculateInt8Array())
+                lengthOp = GetInt8ArrayLength;
+            else if (base.shouldSpeculateInt16Array())
+                lengthOp = GetInt16ArrayLength;
+            else if (base.shouldSpeculateInt32Array())
+                lengthOp = GetInt32ArrayLength;
+            else if (base.shouldSpeculateUint8Array())
+                lengthOp = GetUint8ArrayLength;
+            else if (base.shouldSpeculateUint8ClampedArray())
+                lengthOp = GetUint8ClampedArrayLength;
+            else if (base.shouldSpeculateUint16Array())
+                lengthOp = GetUint16ArrayLength;
+            else if (base.shouldSpeculateUint32Array())
+                lengthOp = GetUint32ArrayLength;
+            else if (base.shouldSpeculateFloat32Array())
+                lengthOp = GetFloat32ArrayLength;
+            else if (base.shouldSpeculateFloat64Array())
+                lengthOp = GetFloat64ArrayLength;
+            else {
+                // Arrays are checked against their vector length, which is not the
+                // length that the program sees.
+                return false;
+            }
+            return true;
+        }
+            
+        default:
+            return false;
+        }
+    }
+    
+    static bool isTypedArrayLength(NodeType op)
+    {
+        switch (op) {
+        case GetInt8ArrayLength:
+        case GetInt16ArrayLength:
+        case GetInt32ArrayLength:
+        case GetUint8ArrayLength:
+        case GetUint8ClampedArrayLength:
+        case GetUint16ArrayLength:
+        case GetUint32ArrayLength:
+        case GetFloat32ArrayLength:
+        case GetFloat64ArrayLength:
+            return true;
+        default:
+            return false;
+        }
+    }
+    
+    bool indexIsKnownToBeInBounds(Node& node, Vector<LengthRelation>& relations)
+    {
+        NodeType lengthOp;
+        if (!lengthOpForIndexedAccess(node, lengthOp))
+            return false;
+        int baseOperand;
+        int indexOperand;
+        if (!nodeOperandForRanges(node.child1().index(), baseOperand)
+            || !nodeOperandForRanges(node.child2().index(), indexOperand))
+            return false;
+        if (m_rangeNodeData[node.child2().index()].range.min() < 0)
+            return false;
+        return relations.contains(LengthRelation(LengthRelation::LessThanLength, indexOperand, baseOperand, lengthOp));
+    }
+    
+    // Whether the node may run code that we did not compile: a callee, a getter or
+    // setter, or a valueOf or toString called by a conversion.
+    bool mightCallOut(NodeIndex nodeIndex)
+    {
+        Node& node = m_graph[nodeIndex];
+        switch (node.op) {
+        case ValueToInt32: {
+            // Mirrors SpeculativeJIT::compileValueToInt32: anything that is neither
+            // speculated integer nor double goes through the generic conversion,
+            // which calls valueOf on objects.
+            Node& child = m_graph[node.child1()];
+            return child.shouldNotSpeculateInteger() && !child.shouldSpeculateDouble();
+        }
+        default:
+            return clobbersWorld(nodeIndex);
+        }
+    }
+    
+    static void killRelations(Vector<LengthRelation>& relations, int operand)
+    {
+        for (size_t i = 0; i < relations.size();) {
+            if (relations[i].operand == operand || relations[i].baseOperand == operand) {
+                relations[i] = relations.last();
+                relations.removeLast();
+                continue;
+            }
+            ++i;
+        }
+    }
+    
+    void executeRanges(NodeIndex nodeIndex, Operands<IntegerRange>& ranges, Vector<LengthRelation>& relations, bool markNodes)
+    {
+        Node& node = m_graph[nodeIndex];
+        RangeNodeData& data = m_rangeNodeData[nodeIndex];
+        data = RangeNodeData();
+        
+        switch (node.op) {
+        case JSConstant:
+            if (m_graph.isInt32Constant(m_codeBlock, nodeIndex)) {
+                int32_t value = m_graph.valueOfInt32Constant(m_codeBlock, nodeIndex);
+                data.range = IntegerRange(value, value);
+            }
+            break;
+            
+        case GetLocal:
+            data.range = ranges.operand(node.local());
+            setNodeOperandForRanges(nodeIndex, node.local());
+            break;
+            
+        case SetLocal: {
+            int operand = node.local();
+            NodeIndex childIndex = node.child1().index();
+            ranges.operand(operand) = m_rangeNodeData[childIndex].range;
+            
+            int oldOperand;
+            bool hadOperand = nodeOperandForRanges(childIndex, oldOperand);
+            int baseOperand;
+            bool hasLengthBase = lengthBaseForRanges(childIndex, baseOperand);
+            
+            killRelations(relations, operand);
+            ++m_rangeOperandVersions.operand(operand);
+            
+            // The variable now holds the same value as the one the child came from,
+            // so it inherits that variable's relations.
+            if (hadOperand && oldOperand != operand) {
+                size_t size = relations.size();
+                for (size_t i = 0; i < size; ++i) {
+                    LengthRelation relation = relations[i];
+                    if (relation.operand != oldOperand)
+                        continue;
+                    relation.operand = operand;
+                    relations.append(relation);
+                }
+            }
+            if (hasLengthBase && baseOperand != operand)
+                relations.append(LengthRelation(LengthRelation::EqualsLength, operand, baseOperand, m_graph[childIndex].op));
+            
+            setNodeOperandForRanges(childIndex, operand);
+            break;
+        }
+            
+        case SetArgument:
+            killRelations(relations, node.local());
+            ranges.operand(node.local()) = IntegerRange();
+            ++m_rangeOperandVersions.operand(node.local());
+            break;
+            
+        case ValueAdd:
+        case ArithAdd:
+        case ArithSub: {
+            if (!m_graph.addShouldSpeculateInteger(node, m_codeBlock))
+                break;
+            IntegerRange left = m_rangeNodeData[node.child1().index()].range;
+            IntegerRange right = m_rangeNodeData[node.child2().index()].range;
+            int64_t min;
+            int64_t max;
+            if (node.op == ArithSub) {
+                min = static_cast<int64_t>(left.min()) - right.max();
+                max = static_cast<int64_t>(left.max()) - right.min();
+            } else {
+                min = static_cast<int64_t>(left.min()) + right.min();
+                max = static_cast<int64_t>(left.max()) + right.max();
+            }
+            if (min < INT_MIN || max > INT_MAX)
+                break;
+            data.range = IntegerRange::fromInt64(min, max);
+            if (markNodes)
+                node.mergeArithNodeFlags(NodeCannotOverflow);
+            break;
+        }
+            
+        case BitAnd: {
+            // Anding with a non-negative constant yields a value between zero and
+            // that constant.
+            for (unsigned i = 0; i < 2; ++i) {
+                NodeIndex childIndex = i ? node.child2().index() : node.child1().index();
+                if (!m_graph.isInt32Constant(m_codeBlock, childIndex))
+                    continue;
+                int32_t mask = m_graph.valueOfInt32Constant(m_codeBlock, childIndex);
+                if (mask < 0)
+                    continue;
+                data.range = IntegerRange(0, mask);
+                break;
+            }
+            break;
+        }
+            
+        case GetArrayLength:
+        case GetStringLength:
+            data.range = IntegerRange(0, INT_MAX);
+            // Fall through.
+        case GetByteArrayLength:
+        case GetInt8ArrayLength:
+        case GetInt16ArrayLength:
+        case GetInt32ArrayLength:
+        case GetUint8ArrayLength:
+        case GetUint8ClampedArrayLength:
+        case GetUint16ArrayLength:
+        case GetUint32ArrayLength:
+        case GetFloat32ArrayLength:
+        case GetFloat64ArrayLength: {
+            // Array lengths change when the array is written to, so they are not
+            // tracked by relations.
+            int baseOperand;
+            if (node.op == GetArrayLength || !nodeOperandForRanges(node.child1().index(), baseOperand))
+                break;
+            data.hasLengthBase = true;
+            data.lengthBaseOperand = baseOperand;
+            data.lengthBaseVersion = m_rangeOperandVersions.operand(baseOperand);
+            break;
+        }
+            
+        case GetByVal:
+        case PutByVal:
+        case PutByValAlias:
+        case StringCharAt:
+        case StringCharCodeAt:
+            if (markNodes && indexIsKnownToBeInBounds(node, relations))
+                node.setIndexIsInBounds();
+            break;
+            
+        default:
+            break;
+        }
+        
+        // The lengths of strings and byte arrays never change, but a typed array's
+        // length drops to zero if its buffer is transferred away, which any code
+        // that we call out to may do.
+        if (mightCallOut(nodeIndex)) {
+            for (size_t i = 0; i < relations.size();) {
+                if (isTypedArrayLength(static_cast<NodeType>(relations[i].lengthOp))) {
+                    relations[i] = relations.last();
+                    relations.removeLast();
+                    continue;
+                }
+                ++i;
+            }
+        }
+    }
+    
+    // Narrows the ranges, given that the value of the node at lesserIndex is less than
+    // (or equal to, if orEqual is set) the value of the node at greaterIndex. Returns
+    // false if no int32s can satisfy that.
+    bool refineRangesForComparison(NodeIndex lesserIndex, NodeIndex greaterIndex, bool orEqual, Operands<IntegerRange>& ranges, Vector<LengthRelation>& relations)
+    {
+        int64_t offset = orEqual ? 0 : 1;
+        IntegerRange lesser = m_rangeNodeData[lesserIndex].range;
+        IntegerRange greater = m_rangeNodeData[greaterIndex].range;
+        
+        int lesserOperand;
+        bool lesserHasOperand = nodeOperandForRanges(lesserIndex, lesserOperand);
+        if (lesserHasOperand) {
+            IntegerRange& range = ranges.operand(lesserOperand);
+            range.filterMax(static_cast<int64_t>(greater.max()) - offset);
+            if (range.isEmpty())
+                return false;
+        }
+        
+        int greaterOperand;
+        bool greaterHasOperand = nodeOperandForRanges(greaterIndex, greaterOperand);
+        if (greaterHasOperand) {
+            IntegerRange& range = ranges.operand(greaterOperand);
+            range.filterMin(static_cast<int64_t>(lesser.min()) + offset);
+            if (range.isEmpty())
+                return false;
+        }
+        
+        if (orEqual || !lesserHasOperand)
+            return true;
+        
+        int baseOperand;
+        if (lengthBaseForRanges(greaterIndex, baseOperand)) {
+            if (baseOperand != lesserOperand)
+                relations.append(LengthRelation(LengthRelation::LessThanLength, lesserOperand, baseOperand, m_graph[greaterIndex].op));
+            return true;
+        }
+        
+        if (!greaterHasOperand)
+            return true;
+        size_t size = relations.size();
+        for (size_t i = 0; i < size; ++i) {
+            LengthRelation relation = relations[i];
+            if (relation.kind != LengthRelation::EqualsLength || relation.operand != greaterOperand || relation.baseOperand == lesserOperand)
+                continue;
+            relations.append(LengthRelation(LengthRelation::LessThanLength, lesserOperand, relation.baseOperand, relation.lengthOp));
+        }
+        return true;
+    }
+    
+    bool refineRangesForBranch(Node& branch, bool taken, Operands<IntegerRange>& ranges, Vector<LengthRelation>& relations)
+    {
+        Node& condition = m_graph[branch.child1()];
+        switch (condition.op) {
+        case CompareLess:
+        case CompareLessEq:
+        case CompareGreater:
+        case CompareGreaterEq:
+            break;
+        default:
+            return true;
+        }
+        
+        // Only integer comparisons tell us something about int32s; a comparison
+        // against a double may succeed for an int32 outside of the range of the
+        // other operand.
+        NodeIndex left = condition.child1().index();
+        NodeIndex right = condition.child2().index();
+        if (!Node::shouldSpeculateInteger(m_graph[left], m_graph[right]))
+            return true;
+        
+        switch (condition.op) {
+        case CompareLess:
+            return taken ? refineRangesForComparison(left, right, false, ranges, relations) : refineRangesForComparison(right, left, true, ranges, relations);
+        case CompareLessEq:
+            return taken ? refineRangesForComparison(left, right, true, ranges, relations) : refineRangesForComparison(right, left, false, ranges, relations);
+        case CompareGreater:
+            return taken ? refineRangesForComparison(right, left, false, ranges, relations) : refineRangesForComparison(left, right, true, ranges, relations);
+        case CompareGreaterEq:
+            return taken ? refineRangesForComparison(right, left, true, ranges, relations) : refineRangesForComparison(left, right, false, ranges, relations);
+        default:
+            ASSERT_NOT_REACHED();
+            return true;
+        }
+    }
+    
+    void mergeRangesInto(BlockIndex blockIndex, Operands<IntegerRange>& ranges, Vector<LengthRelation>& relations)
+    {
+        BasicBlock& block = *m_graph.m_blocks[blockIndex];
+        if (!m_rangesReached[blockIndex]) {
+            m_rangesReached[blockIndex] = true;
+            m_rangesShouldRevisit[blockIndex] = true;
+            block.rangesAtHead = ranges;
+            block.relationsAtHead = relations;
+            m_changed = true;
+            return;
+        }
+        
+        // Widen at loop headers, after giving the loop a couple of iterations to
+        // settle, so that the bounds that do not move on every iteration are kept.
+        // Every cycle in a reducible graph goes through a loop header; blocks in
+        // irreducible cycles are widened too, if they change for long enough.
+        bool widen = m_rangeMergeCounts[blockIndex] >= (m_isLoopHeader[blockIndex] ? 2 : 16);
+        bool changed = false;
+        for (size_t argument = 0; argument < block.rangesAtHead.numberOfArguments(); ++argument)
+            changed |= block.rangesAtHead.argument(argument).merge(ranges.argument(argument), widen);
+        for (size_t local = 0; local < block.rangesAtHead.numberOfLocals(); ++local)
+            changed |= block.rangesAtHead.local(local).merge(ranges.local(local), widen);
+        
+        Vector<LengthRelation>& relationsAtHead = block.relationsAtHead;
+        for (size_t i = 0; i < relationsAtHead.size();) {
+            if (!relations.contains(relationsAtHead[i])) {
+                relationsAtHead[i] = relationsAtHead.last();
+                relationsAtHead.removeLast();
+                changed = true;
+                continue;
+            }
+            ++i;
+        }
+        
+        if (!changed)
+            return;
+        m_rangeMergeCounts[blockIndex]++;
+        m_rangesShouldRevisit[blockIndex] = true;
+        m_changed = true;
+    }
+    
+    void performBlockRangeAnalysis(BlockIndex blockIndex, bool markNodes)
+    {
+        BasicBlock& block = *m_graph.m_blocks[blockIndex];
+        m_rangesShouldRevisit[blockIndex] = false;
+        
+        Operands<IntegerRange> ranges = block.rangesAtHead;
+        Vector<LengthRelation> relations = block.relationsAtHead;
+        for (NodeIndex nodeIndex = block.begin; nodeIndex < block.end; ++nodeIndex) {
+            if (!m_graph[nodeIndex].shouldGenerate())
+                continue;
+            executeRanges(nodeIndex, ranges, relations, markNodes);
+        }
+        
+        if (markNodes)
+            return;
+        
+        Node& terminal = m_graph[block.end - 1];
+        for (unsigned i = 0; i < m_graph.numSuccessors(block); ++i) {
+            BlockIndex successor = m_graph.successor(block, i);
+            if (!terminal.isBranch() || terminal.takenBlockIndex() == terminal.notTakenBlockIndex()) {
+                mergeRangesInto(successor, ranges, relations);
+                continue;
+            }
+            Operands<IntegerRange> refinedRanges = ranges;
+            Vector<LengthRelation> refinedRelations = relations;
+            if (refineRangesForBranch(terminal, !i, refinedRanges, refinedRelations))
+                mergeRangesInto(successor, refinedRanges, refinedRelations);
+        }
+    }
+    
+    void analyzeIntegerRanges()
+    {
+#if DFG_ENABLE(DEBUG_PROPAGATION_VERBOSE)
+        dataLog("Analyzing integer ranges:\n");
+#endif
+        // This is a forward analysis over the same int32 speculations that the code
+        // generator makes. For every variable, it tracks the range of int32s that the
+        // variable may hold, narrowing the ranges along the edges of branches on integer
+        // comparisons. Alongside, it tracks which variables are less than, or equal to,
+        // the length of an array held in another variable. Once it has reached a
+        // fixpoint, it marks the additions that cannot overflow and the indexed accesses
+        // that cannot be out of bounds, so that the code generator can skip their checks.
+        // OSR entry checks the ranges and relations at the head of the entry block.
+        
+        unsigned numBlocks = m_graph.m_blocks.size();
+        m_rangeNodeData.resize(m_graph.size());
+        m_rangeOperandVersions = Operands<unsigned>(m_codeBlock->numParameters(), m_graph.m_localVars);
+        m_rangesReached.fill(false, numBlocks);
+        m_rangesShouldRevisit.fill(false, numBlocks);
+        m_rangeMergeCounts.fill(0, numBlocks);
+        m_isLoopHeader.fill(false, numBlocks);
+        ASSERT(m_graph.m_dominators.isValid());
+        for (unsigned i = 0; i < m_graph.m_naturalLoops.numLoops(); ++i)
+            m_isLoopHeader[m_graph.m_naturalLoops.loop(i).header()] = true;
+        
+        m_rangesReached[0] = true;
+        m_rangesShouldRevisit[0] = true;
+        
+        do {
+            m_changed = false;
+            for (BlockIndex block = 0; block < numBlocks; ++block) {
+                if (m_rangesShouldRevisit[block])
+                    performBlockRangeAnalysis(block, false);
+            }
+        } while (m_changed);
+        
+        for (BlockIndex block = 0; block < numBlocks; ++block) {
+            if (m_rangesReached[block])
+                performBlockRangeAnalysis(block, true);
+        }
+    }
+    
     Graph& m_graph;
     JSGlobalData& m_globalData;
     CodeBlock* m_codeBlock;
     CodeBlock* m_profiledBlock;
+    const HoistingExitSites& m_hoistingExitSites;
     
     NodeIndex m_start;
     NodeIndex m_compileIndex;
@@ -1724,15 +2650,45 @@ private:
 
     Vector<NodeIndex, 16> m_replacements;
     FixedArray<NodeIndex, LastNodeId> m_lastSeen;
+    
+    Vector<RangeNodeData> m_rangeNodeData;
+    Operands<unsigned> m_rangeOperandVersions;
+    Vector<bool> m_rangesReached;
+    Vector<bool> m_rangesShouldRevisit;
+    Vector<unsigned> m_rangeMergeCounts;
+    Vector<bool> m_isLoopHeader;
 };
 
-void propagate(Graph& graph, JSGlobalData* globalData, CodeBlock* codeBlock)
+static void addHoistingExitSites(CodeBlock* baselineCodeBlock, HoistingExitSites& sites)
+{
+    Vector<unsigned> bytecodeOffsets;
+    baselineCodeBlock->exitProfile().exitSitesFor(Hoisting, bytecodeOffsets);
+    for (unsigned i = 0; i < bytecodeOffsets.size(); ++i)
+        sites.add(std::make_pair(baselineCodeBlock, bytecodeOffsets[i]));
+}
+
+void snapshotHoistingExitSites(CodeBlock* codeBlock, HoistingExitSites& sites)
+{
+    ASSERT(codeBlock);
+    CodeBlock* profiledBlock = codeBlock->alternative();
+    ASSERT(profiledBlock);
+    
+    addHoistingExitSites(profiledBlock, sites);
+    
+    SegmentedVector<InlineCallFrame, 4>& inlineCallFrames = codeBlock->inlineCallFrames();
+    for (unsigned i = 0; i < inlineCallFrames.size(); ++i) {
+        CodeOrigin codeOrigin(0, &inlineCallFrames[i]);
+        addHoistingExitSites(AssemblyHelpers::baselineCodeBlockForOriginAndBaselineCodeBlock(codeOrigin, profiledBlock), sites);
+    }
+}
+
+void propagate(Graph& graph, JSGlobalData* globalData, CodeBlock* codeBlock, const HoistingExitSites& hoistingExitSites)
 {
     ASSERT(codeBlock);
     CodeBlock* profiledBlock = codeBlock->alternative();
     ASSERT(profiledBlock);
     
-    Propagator propagator(graph, *globalData, codeBlock, profiledBlock);
+    Propagator propagator(graph, *globalData, codeBlock, profiledBlock, hoistingExitSites);
     propagator.fixpoint();
     
 }
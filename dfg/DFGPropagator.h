@@ -29,6 +29,7 @@
 #if ENABLE(DFG_JIT)
 
 #include <dfg/DFGGraph.h>
+#include <wtf/HashSet.h>
 
 namespace JSC {
 
@@ -37,8 +38,15 @@ class JSGlobalData;
 
 namespace DFG {
 
+// The (baseline CodeBlock, bytecode index) pairs at which checks hoisted out of a
+// loop have failed before. The baseline blocks' exit profiles keep growing while
+// the mutator runs, so they are copied on the main thread, after parsing has
+// decided what to inline, and propagation only ever looks at the copy.
+typedef HashSet<std::pair<CodeBlock*, unsigned> > HoistingExitSites;
+void snapshotHoistingExitSites(CodeBlock*, HoistingExitSites&);
+
 // Propagate dynamic predictions from value sources to variables.
-void propagate(Graph&, JSGlobalData*, CodeBlock*);
+void propagate(Graph&, JSGlobalData*, CodeBlock*, const HoistingExitSites&);
 
 } } // namespace JSC::DFG
 
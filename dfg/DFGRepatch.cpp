@@ -155,7 +155,7 @@ static void generateProtoChainAccessStub(ExecState* exec, StructureStubInfo& stu
     
     linkRestoreScratch(patchBuffer, needToRestoreScratch, success, fail, failureCases, successLabel, slowCaseLabel);
     
-    stubRoutine = patchBuffer.finalizeCode();
+    stubRoutine = patchBuffer.finalizeCode(PerfMap::Description(PerfMap::DFG, exec->codeBlock(), "get_by_id proto chain stub", stubInfo.codeOrigin.bytecodeIndexForMachineCode()));
 }
 
 static bool tryCacheGetByID(ExecState* exec, JSValue baseValue, const Identifier& propertyName, const PropertySlot& slot, StructureStubInfo& stubInfo)
@@ -206,7 +206,7 @@ static bool tryCacheGetByID(ExecState* exec, JSValue baseValue, const Identifier
         
         linkRestoreScratch(patchBuffer, needToRestoreScratch, stubInfo, success, fail, failureCases);
         
-        stubInfo.stubRoutine = patchBuffer.finalizeCode();
+        stubInfo.stubRoutine = patchBuffer.finalizeCode(PerfMap::Description(PerfMap::DFG, codeBlock, "get_by_id array length stub", stubInfo.codeOrigin.bytecodeIndexForMachineCode()));
         
         RepatchBuffer repatchBuffer(codeBlock);
         repatchBuffer.relink(stubInfo.callReturnLocation.jumpAtOffset(stubInfo.deltaCallToStructCheck), CodeLocationLabel(stubInfo.stubRoutine.code()));
@@ -354,7 +354,7 @@ static bool tryBuildGetByIDList(ExecState* exec, JSValue baseValue, const Identi
                 stubJit.setupArgumentsWithExecState(
                     baseGPR,
                     MacroAssembler::TrustedImmPtr(FunctionPtr(slot.customGetter()).executableAddress()),
-                    MacroAssembler::TrustedImmPtr(const_cast<Identifier*>(&ident)));
+                    MacroAssembler::TrustedImmPtr(&ident));
                 operationFunction = operationCallCustomGetter;
             }
             
@@ -405,7 +405,7 @@ static bool tryBuildGetByIDList(ExecState* exec, JSValue baseValue, const Identi
             patchBuffer.link(handlerCall, lookupExceptionHandlerInStub);
         }
         
-        MacroAssemblerCodeRef stubRoutine = patchBuffer.finalizeCode();
+        MacroAssemblerCodeRef stubRoutine = patchBuffer.finalizeCode(PerfMap::Description(PerfMap::DFG, codeBlock, "get_by_id list stub", stubInfo.codeOrigin.bytecodeIndexForMachineCode()));
         
         polymorphicStructureList->list[listIndex].set(*globalData, codeBlock->ownerExecutable(), stubRoutine, structure, isDirect);
         
@@ -611,7 +611,7 @@ static void emitPutReplaceStub(
     patchBuffer.link(success, stubInfo.callReturnLocation.labelAtOffset(stubInfo.deltaCallToDone));
     patchBuffer.link(failure, failureLabel);
             
-    stubRoutine = patchBuffer.finalizeCode();
+    stubRoutine = patchBuffer.finalizeCode(PerfMap::Description(PerfMap::DFG, exec->codeBlock(), "put_by_id replace stub", stubInfo.codeOrigin.bytecodeIndexForMachineCode()));
 }
 
 static void emitPutTransitionStub(
@@ -705,7 +705,7 @@ static void emitPutTransitionStub(
     else
         patchBuffer.link(failureCases, failureLabel);
             
-    stubRoutine = patchBuffer.finalizeCode();
+    stubRoutine = patchBuffer.finalizeCode(PerfMap::Description(PerfMap::DFG, exec->codeBlock(), "put_by_id transition stub", stubInfo.codeOrigin.bytecodeIndexForMachineCode()));
 }
 
 static bool tryCachePutByID(ExecState* exec, JSValue baseValue, const Identifier& ident, const PutPropertySlot& slot, StructureStubInfo& stubInfo, PutKind putKind)
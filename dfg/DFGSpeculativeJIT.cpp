@@ -237,9 +237,11 @@ void SpeculativeJIT::markCellCard(MacroAssembler& jit, GPRReg owner, GPRReg scra
     jit.move(owner, scratch1);
     jit.andPtr(TrustedImm32(static_cast<int32_t>(MarkedBlock::blockMask)), scratch1);
     jit.move(owner, scratch2);
-    // consume additional 8 bits as we're using an approximate filter
-    jit.rshift32(TrustedImm32(MarkedBlock::atomShift + 8), scratch2);
-    jit.andPtr(TrustedImm32(MarkedBlock::atomMask >> 8), scratch2);
+    // Test the byte of the mark bitmap that covers the owner. This is an
+    // approximate filter: it may let through unmarked owners that share a
+    // byte with a marked cell, which only costs a spurious card.
+    jit.rshift32(TrustedImm32(MarkedBlock::atomShift + 3), scratch2);
+    jit.andPtr(TrustedImm32(MarkedBlock::atomMask >> 3), scratch2);
     MacroAssembler::Jump filter = jit.branchTest8(MacroAssembler::Zero, MacroAssembler::BaseIndex(scratch1, scratch2, MacroAssembler::TimesOne, MarkedBlock::offsetOfMarks()));
     jit.move(owner, scratch2);
     jit.rshift32(TrustedImm32(MarkedBlock::cardShift), scratch2);
@@ -300,7 +302,10 @@ void SpeculativeJIT::writeBarrier(GPRReg ownerGPR, JSCell* value, WriteBarrierUs
     UNUSED_PARAM(scratch2);
     UNUSED_PARAM(useKind);
     
-    if (Heap::isMarked(value))
+    // A young collection does not need to find a value that is already marked,
+    // since that value survives it anyway. Incremental marking starts from
+    // cleared marks, so it needs the card whenever marking is enabled.
+    if (!Options::minimumIncrementalMarkingStepSize && Heap::isMarked(value))
         return;
 
 #if ENABLE(WRITE_BARRIER_PROFILING)
@@ -787,6 +792,9 @@ void ValueSource::dump(FILE* out) const
     case DoubleInRegisterFile:
         fprintf(out, "Double");
         break;
+    case DoubleInLoopRegister:
+        fprintf(out, "Double(%s)", FPRInfo::debugName(m_fpr));
+        break;
     case HaveNode:
         fprintf(out, "Node(%d)", m_nodeIndex);
         break;
@@ -930,7 +938,10 @@ void SpeculativeJIT::compile(BasicBlock& block)
     ASSERT(m_arguments.size() == block.variablesAtHead.numberOfArguments());
     for (size_t i = 0; i < m_arguments.size(); ++i) {
         NodeIndex nodeIndex = block.variablesAtHead.argument(i);
-        if (nodeIndex == NoNode)
+        // A dead SetArgument was never checked, so the register file still holds whatever
+        // was passed. This is always the case for captured arguments, which are only
+        // accessed with GetCapturedVar and PutCapturedVar.
+        if (nodeIndex == NoNode || (at(nodeIndex).op == SetArgument && !at(nodeIndex).shouldGenerate()))
             m_arguments[i] = ValueSource(ValueInRegisterFile);
         else
             m_arguments[i] = ValueSource::forPrediction(at(nodeIndex).variableAccessData()->prediction());
@@ -950,6 +961,19 @@ void SpeculativeJIT::compile(BasicBlock& block)
             m_variables[i] = ValueSource::forPrediction(at(nodeIndex).variableAccessData()->prediction());
     }
     
+    // The edges into this block have already loaded the loop registers.
+    m_loopRegistersNeedReload = false;
+    if (block.registerAllocatedLoop == NoRegisterAllocatedLoop)
+        m_registerAllocatedLoop = 0;
+    else {
+        m_registerAllocatedLoop = &m_jit.graph().m_registerAllocatedLoops[block.registerAllocatedLoop];
+        for (unsigned i = 0; i < m_registerAllocatedLoop->variables.size(); ++i) {
+            RegisterAllocatedVariable& variable = m_registerAllocatedLoop->variables[i];
+            if (block.variablesAtHead.local(variable.local) != NoNode)
+                m_variables[variable.local] = ValueSource::inLoopRegister(variable.fpr);
+        }
+    }
+    
     m_lastSetOperand = std::numeric_limits<int>::max();
     m_codeOriginForOSR = CodeOrigin();
     
@@ -1002,6 +1026,10 @@ void SpeculativeJIT::compile(BasicBlock& block)
             m_jit.xorPtr(JITCompiler::TrustedImm32(m_compileIndex), GPRInfo::regT0);
 #endif
             checkConsistency();
+            if (UNLIKELY(m_jit.shouldNoteCodeOrigins()))
+                m_jit.noteCodeOrigin(node.codeOrigin);
+            if (m_compileIndex == block.end - 1 && !block.hoistedChecks.isEmpty())
+                compileHoistedChecks(block);
             compile(node);
             if (!m_compileOkay) {
                 m_compileOkay = true;
@@ -1010,6 +1038,11 @@ void SpeculativeJIT::compile(BasicBlock& block)
                 return;
             }
             
+            // A terminal has already reloaded the loop registers on its edges. Note that
+            // a fused compare and branch leaves m_compileIndex at the branch.
+            if (m_loopRegistersNeedReload && !at(m_compileIndex).isTerminal())
+                reloadLoopRegisters();
+            
 #if DFG_ENABLE(DEBUG_VERBOSE)
             if (node.hasResult()) {
                 GenerationInfo& info = m_generationInfo[node.virtualRegister()];
@@ -1060,6 +1093,32 @@ void SpeculativeJIT::compile(BasicBlock& block)
 #endif
 }
 
+// Checks hoisted out of a loop are done at the end of its preheader, right before the
+// terminal, so they exit to the terminal's code origin. The variables are read from
+// the register file, in the format that GetLocal would expect them to be in.
+void SpeculativeJIT::compileHoistedChecks(BasicBlock& block)
+{
+    for (size_t i = 0; i < block.hoistedChecks.size(); ++i) {
+        HoistedCheck& check = block.hoistedChecks[i];
+        VirtualRegister virtualRegister = static_cast<VirtualRegister>(check.operand);
+        GPRTemporary temp(this);
+#if USE(JSVALUE64)
+        m_jit.loadPtr(JITCompiler::addressFor(virtualRegister), temp.gpr());
+        speculationCheck(Hoisting, JSValueRegs(), NoNode, m_jit.branchTestPtr(MacroAssembler::NonZero, temp.gpr(), GPRInfo::tagMaskRegister));
+#else
+        PredictedType prediction = at(block.variablesAtTail.operand(check.operand)).variableAccessData()->prediction();
+        if (!isArrayPrediction(prediction) && !isByteArrayPrediction(prediction))
+            speculationCheck(Hoisting, JSValueRegs(), NoNode, m_jit.branch32(MacroAssembler::NotEqual, JITCompiler::tagFor(virtualRegister), TrustedImm32(JSValue::CellTag)));
+        m_jit.load32(JITCompiler::payloadFor(virtualRegister), temp.gpr());
+#endif
+        if (check.structureSet) {
+            ASSERT(check.structureSet->size() == 1);
+            speculationCheck(Hoisting, JSValueRegs(), NoNode, m_jit.branchWeakPtr(JITCompiler::NotEqual, JITCompiler::Address(temp.gpr(), JSCell::structureOffset()), (*check.structureSet)[0]));
+        } else
+            speculationCheck(Hoisting, JSValueRegs(), NoNode, m_jit.branchPtr(MacroAssembler::NotEqual, MacroAssembler::Address(temp.gpr(), JSCell::classInfoOffset()), MacroAssembler::TrustedImmPtr(check.classInfo)));
+    }
+}
+
 // If we are making type predictions about our arguments then
 // we need to check that they are correct on function entry.
 void SpeculativeJIT::checkArgumentTypes()
@@ -1244,17 +1303,19 @@ void SpeculativeJIT::createOSREntries()
         if (!block.isOSRTarget)
             continue;
 
-        // Currently we only need to create OSR entry trampolines when using edge code
-        // verification. But in the future, we'll need this for other things as well (like
-        // when we have global reg alloc).
+        // We need OSR entry trampolines when using edge code verification, and to load
+        // the loop registers when entering a block of a loop that has them.
         // If we don't need OSR entry trampolin
-        if (!DFG_ENABLE_EDGE_CODE_VERIFICATION) {
+        if (!DFG_ENABLE_EDGE_CODE_VERIFICATION && block.registerAllocatedLoop == NoRegisterAllocatedLoop) {
             m_osrEntryHeads.append(m_blockHeads[blockIndex]);
             continue;
         }
         
         m_osrEntryHeads.append(m_jit.label());
-        m_jit.move(Imm32(blockIndex), GPRInfo::regT0);
+        if (DFG_ENABLE_EDGE_CODE_VERIFICATION)
+            m_jit.move(Imm32(blockIndex), GPRInfo::regT0);
+        if (block.registerAllocatedLoop != NoRegisterAllocatedLoop)
+            loadLoopRegisters(m_jit.graph().m_registerAllocatedLoops[block.registerAllocatedLoop]);
         m_jit.jump().linkTo(m_blockHeads[blockIndex], &m_jit);
     }
 }
@@ -1287,6 +1348,9 @@ ValueRecovery SpeculativeJIT::computeValueRecoveryFor(const ValueSource& valueSo
         
     case DoubleInRegisterFile:
         return ValueRecovery::alreadyInRegisterFileAsUnboxedDouble();
+        
+    case DoubleInLoopRegister:
+        return ValueRecovery::inFPR(valueSource.fpr());
 
     case HaveNode: {
         if (m_jit.isConstant(valueSource.nodeIndex()))
@@ -1413,7 +1477,8 @@ void SpeculativeJIT::compileGetCharCodeAt(Node& node)
     }
 
     // unsigned comparison so we can filter out negative indices and indices that are too large
-    speculationCheck(Uncountable, JSValueRegs(), NoNode, m_jit.branch32(MacroAssembler::AboveOrEqual, indexReg, MacroAssembler::Address(stringReg, JSString::offsetOfLength())));
+    if (!node.indexIsInBounds())
+        speculationCheck(Uncountable, JSValueRegs(), NoNode, m_jit.branch32(MacroAssembler::AboveOrEqual, indexReg, MacroAssembler::Address(stringReg, JSString::offsetOfLength())));
 
     GPRTemporary scratch(this);
     GPRReg scratchReg = scratch.gpr();
@@ -1452,7 +1517,8 @@ void SpeculativeJIT::compileGetByValOnString(Node& node)
     }
 
     // unsigned comparison so we can filter out negative indices and indices that are too large
-    speculationCheck(Uncountable, JSValueRegs(), NoNode, m_jit.branch32(MacroAssembler::AboveOrEqual, propertyReg, MacroAssembler::Address(baseReg, JSString::offsetOfLength())));
+    if (!node.indexIsInBounds())
+        speculationCheck(Uncountable, JSValueRegs(), NoNode, m_jit.branch32(MacroAssembler::AboveOrEqual, propertyReg, MacroAssembler::Address(baseReg, JSString::offsetOfLength())));
 
     GPRTemporary scratch(this);
     GPRReg scratchReg = scratch.gpr();
@@ -1661,9 +1727,12 @@ void SpeculativeJIT::compilePutByValForByteArray(GPRReg base, GPRReg property, N
     GPRReg storageReg = storage.gpr();
     ASSERT(valueGPR != storageReg);
     m_jit.loadPtr(MacroAssembler::Address(base, JSByteArray::offsetOfStorage()), storageReg);
-    MacroAssembler::Jump outOfBounds = m_jit.branch32(MacroAssembler::AboveOrEqual, property, MacroAssembler::Address(storageReg, ByteArray::offsetOfSize()));
+    MacroAssembler::Jump outOfBounds;
+    if (!node.indexIsInBounds())
+        outOfBounds = m_jit.branch32(MacroAssembler::AboveOrEqual, property, MacroAssembler::Address(storageReg, ByteArray::offsetOfSize()));
     m_jit.store8(value.gpr(), MacroAssembler::BaseIndex(storageReg, property, MacroAssembler::TimesOne, ByteArray::offsetOfData()));
-    outOfBounds.link(&m_jit);
+    if (outOfBounds.isSet())
+        outOfBounds.link(&m_jit);
     noResult(m_compileIndex);
 }
 
@@ -1687,7 +1756,8 @@ void SpeculativeJIT::compileGetByValOnByteArray(Node& node)
     m_jit.loadPtr(MacroAssembler::Address(baseReg, JSByteArray::offsetOfStorage()), storageReg);
     
     // unsigned comparison so we can filter out negative indices and indices that are too large
-    speculationCheck(Uncountable, JSValueRegs(), NoNode, m_jit.branch32(MacroAssembler::AboveOrEqual, propertyReg, MacroAssembler::Address(storageReg, ByteArray::offsetOfSize())));
+    if (!node.indexIsInBounds())
+        speculationCheck(Uncountable, JSValueRegs(), NoNode, m_jit.branch32(MacroAssembler::AboveOrEqual, propertyReg, MacroAssembler::Address(storageReg, ByteArray::offsetOfSize())));
 
     m_jit.load8(MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::TimesOne, ByteArray::offsetOfData()), storageReg);
     integerResult(storageReg, m_compileIndex);
@@ -1729,10 +1799,13 @@ void SpeculativeJIT::compileGetByValOnIntTypedArray(const TypedArrayDescriptor&
         return;
     }
 
-    MacroAssembler::Jump inBounds = m_jit.branch32(MacroAssembler::Below, propertyReg, MacroAssembler::Address(baseReg, descriptor.m_lengthOffset));
-    m_jit.xorPtr(resultReg, resultReg);
-    MacroAssembler::Jump outOfBounds = m_jit.jump();
-    inBounds.link(&m_jit);
+    MacroAssembler::Jump outOfBounds;
+    if (!node.indexIsInBounds()) {
+        MacroAssembler::Jump inBounds = m_jit.branch32(MacroAssembler::Below, propertyReg, MacroAssembler::Address(baseReg, descriptor.m_lengthOffset));
+        m_jit.xorPtr(resultReg, resultReg);
+        outOfBounds = m_jit.jump();
+        inBounds.link(&m_jit);
+    }
     switch (elementSize) {
     case 1:
         if (signedness == SignedTypedArray)
@@ -1752,7 +1825,8 @@ void SpeculativeJIT::compileGetByValOnIntTypedArray(const TypedArrayDescriptor&
     default:
         ASSERT_NOT_REACHED();
     }
-    outOfBounds.link(&m_jit);
+    if (outOfBounds.isSet())
+        outOfBounds.link(&m_jit);
     if (elementSize < 4 || signedness == SignedTypedArray)
         integerResult(resultReg, m_compileIndex);
     else {
@@ -1845,7 +1919,7 @@ void SpeculativeJIT::compilePutByValForIntTypedArray(const TypedArrayDescriptor&
     ASSERT(valueGPR != storageReg);
     m_jit.loadPtr(MacroAssembler::Address(base, descriptor.m_storageOffset), storageReg);
     MacroAssembler::Jump outOfBounds;
-    if (speculationRequirements != NoTypedArraySpecCheck)
+    if (speculationRequirements != NoTypedArraySpecCheck && !node.indexIsInBounds())
         outOfBounds = m_jit.branch32(MacroAssembler::AboveOrEqual, property, MacroAssembler::Address(base, descriptor.m_lengthOffset));
 
     switch (elementSize) {
@@ -1861,7 +1935,7 @@ void SpeculativeJIT::compilePutByValForIntTypedArray(const TypedArrayDescriptor&
     default:
         ASSERT_NOT_REACHED();
     }
-    if (speculationRequirements != NoTypedArraySpecCheck)
+    if (outOfBounds.isSet())
         outOfBounds.link(&m_jit);
     noResult(m_compileIndex);
 }
@@ -1886,11 +1960,14 @@ void SpeculativeJIT::compileGetByValOnFloatTypedArray(const TypedArrayDescriptor
     FPRTemporary result(this);
     FPRReg resultReg = result.fpr();
     ASSERT(speculationRequirements != NoTypedArraySpecCheck);
-    MacroAssembler::Jump inBounds = m_jit.branch32(MacroAssembler::Below, propertyReg, MacroAssembler::Address(baseReg, descriptor.m_lengthOffset));
-    static const double zero = 0;
-    m_jit.loadDouble(&zero, resultReg);
-    MacroAssembler::Jump outOfBounds = m_jit.jump();
-    inBounds.link(&m_jit);
+    MacroAssembler::Jump outOfBounds;
+    if (!node.indexIsInBounds()) {
+        MacroAssembler::Jump inBounds = m_jit.branch32(MacroAssembler::Below, propertyReg, MacroAssembler::Address(baseReg, descriptor.m_lengthOffset));
+        static const double zero = 0;
+        m_jit.loadDouble(&zero, resultReg);
+        outOfBounds = m_jit.jump();
+        inBounds.link(&m_jit);
+    }
     switch (elementSize) {
     case 4:
         m_jit.loadFloat(MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::TimesFour), resultReg);
@@ -1907,7 +1984,8 @@ void SpeculativeJIT::compileGetByValOnFloatTypedArray(const TypedArrayDescriptor
     default:
         ASSERT_NOT_REACHED();
     }
-    outOfBounds.link(&m_jit);
+    if (outOfBounds.isSet())
+        outOfBounds.link(&m_jit);
     doubleResult(resultReg, m_compileIndex);
 }
 
@@ -1928,7 +2006,7 @@ void SpeculativeJIT::compilePutByValForFloatTypedArray(const TypedArrayDescripto
     
     m_jit.loadPtr(MacroAssembler::Address(base, descriptor.m_storageOffset), storageReg);
     MacroAssembler::Jump outOfBounds;
-    if (speculationRequirements != NoTypedArraySpecCheck)
+    if (speculationRequirements != NoTypedArraySpecCheck && !node.indexIsInBounds())
         outOfBounds = m_jit.branch32(MacroAssembler::AboveOrEqual, property, MacroAssembler::Address(base, descriptor.m_lengthOffset));
     
     switch (elementSize) {
@@ -1945,7 +2023,7 @@ void SpeculativeJIT::compilePutByValForFloatTypedArray(const TypedArrayDescripto
     default:
         ASSERT_NOT_REACHED();
     }
-    if (speculationRequirements != NoTypedArraySpecCheck)
+    if (outOfBounds.isSet())
         outOfBounds.link(&m_jit);
     noResult(m_compileIndex);
 }
@@ -2226,7 +2304,7 @@ void SpeculativeJIT::compileAdd(Node& node)
             SpeculateIntegerOperand op2(this, node.child2());
             GPRTemporary result(this);
 
-            if (nodeCanTruncateInteger(node.arithNodeFlags())) {
+            if (nodeCanOmitOverflowCheck(node.arithNodeFlags())) {
                 m_jit.move(op2.gpr(), result.gpr());
                 m_jit.add32(Imm32(imm1), result.gpr());
             } else
@@ -2241,7 +2319,7 @@ void SpeculativeJIT::compileAdd(Node& node)
             int32_t imm2 = valueOfNumberConstantAsInt32(node.child2().index());
             GPRTemporary result(this);
                 
-            if (nodeCanTruncateInteger(node.arithNodeFlags())) {
+            if (nodeCanOmitOverflowCheck(node.arithNodeFlags())) {
                 m_jit.move(op1.gpr(), result.gpr());
                 m_jit.add32(Imm32(imm2), result.gpr());
             } else
@@ -2259,7 +2337,7 @@ void SpeculativeJIT::compileAdd(Node& node)
         GPRReg gpr2 = op2.gpr();
         GPRReg gprResult = result.gpr();
 
-        if (nodeCanTruncateInteger(node.arithNodeFlags())) {
+        if (nodeCanOmitOverflowCheck(node.arithNodeFlags())) {
             if (gpr1 == gprResult)
                 m_jit.add32(gpr2, gprResult);
             else {
@@ -2311,7 +2389,7 @@ void SpeculativeJIT::compileArithSub(Node& node)
             int32_t imm2 = valueOfNumberConstantAsInt32(node.child2().index());
             GPRTemporary result(this);
 
-            if (nodeCanTruncateInteger(node.arithNodeFlags())) {
+            if (nodeCanOmitOverflowCheck(node.arithNodeFlags())) {
                 m_jit.move(op1.gpr(), result.gpr());
                 m_jit.sub32(Imm32(imm2), result.gpr());
             } else
@@ -2327,7 +2405,7 @@ void SpeculativeJIT::compileArithSub(Node& node)
             GPRTemporary result(this);
                 
             m_jit.move(Imm32(imm1), result.gpr());
-            if (nodeCanTruncateInteger(node.arithNodeFlags()))
+            if (nodeCanOmitOverflowCheck(node.arithNodeFlags()))
                 m_jit.sub32(op2.gpr(), result.gpr());
             else
                 speculationCheck(Overflow, JSValueRegs(), NoNode, m_jit.branchSub32(MacroAssembler::Overflow, op2.gpr(), result.gpr()));
@@ -2340,7 +2418,7 @@ void SpeculativeJIT::compileArithSub(Node& node)
         SpeculateIntegerOperand op2(this, node.child2());
         GPRTemporary result(this);
 
-        if (nodeCanTruncateInteger(node.arithNodeFlags())) {
+        if (nodeCanOmitOverflowCheck(node.arithNodeFlags())) {
             m_jit.move(op1.gpr(), result.gpr());
             m_jit.sub32(op2.gpr(), result.gpr());
         } else
@@ -2687,6 +2765,241 @@ void SpeculativeJIT::compileGetIndexedPropertyStorage(Node& node)
     storageResult(storageReg, m_compileIndex);
 }
 
+// Jump tables cost a load and an indirect jump, so small or sparse switches are
+// better off comparing against their cases with a binary search.
+static const unsigned minimumCasesForSwitchJumpTable = 4;
+
+void SpeculativeJIT::emitBinarySwitchSearch(GPRReg valueGPR, SwitchData& data, unsigned begin, unsigned end)
+{
+    if (end - begin <= 3) {
+        for (unsigned i = begin; i < end; ++i)
+            addBranch(m_jit.branch32(MacroAssembler::Equal, valueGPR, MacroAssembler::Imm32(data.cases[i].value)), data.cases[i].target);
+        addBranch(m_jit.jump(), data.fallThrough);
+        return;
+    }
+    
+    unsigned middle = begin + (end - begin) / 2;
+    MacroAssembler::Jump lower = m_jit.branch32(MacroAssembler::LessThan, valueGPR, MacroAssembler::Imm32(data.cases[middle].value));
+    emitBinarySwitchSearch(valueGPR, data, middle, end);
+    lower.link(&m_jit);
+    emitBinarySwitchSearch(valueGPR, data, begin, middle);
+}
+
+void SpeculativeJIT::emitSwitchIntJump(SwitchData& data, SimpleJumpTable& table, GPRReg valueGPR, GPRReg scratchGPR)
+{
+    // The cases of SwitchImm and SwitchChar are sorted by value, since they were
+    // created by walking the jump table.
+    if (data.cases.size() < minimumCasesForSwitchJumpTable || data.cases.size() * 4 < table.branchOffsets.size()) {
+        emitBinarySwitchSearch(valueGPR, data, 0, data.cases.size());
+        return;
+    }
+    
+    // The table is filled in by linkSwitches() once we know where the blocks are.
+    data.didUseJumpTable = true;
+    table.ctiOffsets.clear();
+    table.ctiOffsets.grow(table.branchOffsets.size());
+    
+    m_jit.sub32(MacroAssembler::Imm32(table.min), valueGPR);
+    addBranch(m_jit.branch32(MacroAssembler::AboveOrEqual, valueGPR, MacroAssembler::Imm32(table.ctiOffsets.size())), data.fallThrough);
+    m_jit.zeroExtend32ToPtr(valueGPR, valueGPR);
+    m_jit.move(MacroAssembler::TrustedImmPtr(table.ctiOffsets.data()), scratchGPR);
+    m_jit.loadPtr(MacroAssembler::BaseIndex(scratchGPR, valueGPR, MacroAssembler::ScalePtr), scratchGPR);
+    m_jit.jump(scratchGPR);
+}
+
+void SpeculativeJIT::emitSwitchImm(Node& node, SwitchData& data)
+{
+    SimpleJumpTable& table = m_jit.codeBlock()->immediateSwitchJumpTable(data.switchTableIndex);
+    
+    if (at(node.child1()).shouldSpeculateInteger()) {
+        SpeculateIntegerOperand value(this, node.child1());
+        GPRTemporary temp(this);
+        GPRTemporary scratch(this);
+        
+        m_jit.move(value.gpr(), temp.gpr());
+        emitSwitchIntJump(data, table, temp.gpr(), scratch.gpr());
+        
+        noResult(m_compileIndex);
+        return;
+    }
+    
+    JSValueOperand value(this, node.child1());
+    GPRTemporary temp(this);
+    GPRTemporary scratch(this);
+    FPRTemporary valueFPR(this);
+    FPRTemporary tempFPR(this);
+    
+    GPRReg tempGPR = temp.gpr();
+    
+    // Doubles that hold an int32 go through the table as well, so that 1.0 and -0
+    // match case 1 and case 0. Anything else that is not an int32 falls through.
+#if USE(JSVALUE64)
+    GPRReg valueGPR = value.gpr();
+    m_jit.move(valueGPR, tempGPR);
+    MacroAssembler::Jump isInt = m_jit.branchPtr(MacroAssembler::AboveOrEqual, valueGPR, GPRInfo::tagTypeNumberRegister);
+    addBranch(m_jit.branchTestPtr(MacroAssembler::Zero, valueGPR, GPRInfo::tagTypeNumberRegister), data.fallThrough);
+    m_jit.unboxDouble(tempGPR, valueFPR.fpr());
+#else
+    GPRReg valueTagGPR = value.tagGPR();
+    GPRReg valuePayloadGPR = value.payloadGPR();
+    m_jit.move(valuePayloadGPR, tempGPR);
+    MacroAssembler::Jump isInt = m_jit.branch32(MacroAssembler::Equal, valueTagGPR, TrustedImm32(JSValue::Int32Tag));
+    addBranch(m_jit.branch32(MacroAssembler::AboveOrEqual, valueTagGPR, TrustedImm32(JSValue::LowestTag)), data.fallThrough);
+    m_jit.unboxDouble(valueTagGPR, valuePayloadGPR, valueFPR.fpr(), tempFPR.fpr());
+#endif
+    m_jit.truncateDoubleToInt32(valueFPR.fpr(), tempGPR);
+    m_jit.convertInt32ToDouble(tempGPR, tempFPR.fpr());
+    addBranch(m_jit.branchDouble(MacroAssembler::DoubleNotEqualOrUnordered, valueFPR.fpr(), tempFPR.fpr()), data.fallThrough);
+    
+    isInt.link(&m_jit);
+    emitSwitchIntJump(data, table, tempGPR, scratch.gpr());
+    
+    noResult(m_compileIndex);
+}
+
+void SpeculativeJIT::emitSwitchCharStringJump(SwitchData& data, GPRReg stringGPR, GPRReg tempGPR, GPRReg scratchGPR)
+{
+    SimpleJumpTable& table = m_jit.codeBlock()->characterSwitchJumpTable(data.switchTableIndex);
+    
+    addBranch(m_jit.branch32(MacroAssembler::NotEqual, MacroAssembler::Address(stringGPR, JSString::offsetOfLength()), TrustedImm32(1)), data.fallThrough);
+    
+    m_jit.loadPtr(MacroAssembler::Address(stringGPR, JSString::offsetOfValue()), tempGPR);
+    
+    // Speculate that we're not switching on a rope
+    speculationCheck(Uncountable, JSValueRegs(), NoNode, m_jit.branchTestPtr(MacroAssembler::Zero, tempGPR));
+    
+    m_jit.loadPtr(MacroAssembler::Address(tempGPR, StringImpl::dataOffset()), scratchGPR);
+    MacroAssembler::Jump is8Bit = m_jit.branchTest32(MacroAssembler::NonZero, MacroAssembler::Address(tempGPR, StringImpl::flagsOffset()), TrustedImm32(StringImpl::flagIs8Bit()));
+    m_jit.load16(MacroAssembler::Address(scratchGPR), tempGPR);
+    MacroAssembler::Jump haveCharacter = m_jit.jump();
+    is8Bit.link(&m_jit);
+    m_jit.load8(MacroAssembler::Address(scratchGPR), tempGPR);
+    haveCharacter.link(&m_jit);
+    
+    emitSwitchIntJump(data, table, tempGPR, scratchGPR);
+}
+
+void SpeculativeJIT::emitSwitchChar(Node& node, SwitchData& data)
+{
+    if (isStringPrediction(at(node.child1()).prediction())) {
+        SpeculateCellOperand value(this, node.child1());
+        GPRTemporary temp(this);
+        GPRTemporary scratch(this);
+        
+        GPRReg valueGPR = value.gpr();
+        
+        if (!isStringPrediction(m_state.forNode(node.child1()).m_type))
+            speculationCheck(BadType, JSValueSource::unboxedCell(valueGPR), node.child1(), m_jit.branchPtr(MacroAssembler::NotEqual, MacroAssembler::Address(valueGPR, JSCell::classInfoOffset()), MacroAssembler::TrustedImmPtr(&JSString::s_info)));
+        
+        emitSwitchCharStringJump(data, valueGPR, temp.gpr(), scratch.gpr());
+        
+        noResult(m_compileIndex);
+        return;
+    }
+    
+    JSValueOperand value(this, node.child1());
+    GPRTemporary temp(this);
+    GPRTemporary scratch(this);
+    
+#if USE(JSVALUE64)
+    GPRReg cellGPR = value.gpr();
+    addBranch(m_jit.branchTestPtr(MacroAssembler::NonZero, cellGPR, GPRInfo::tagMaskRegister), data.fallThrough);
+#else
+    GPRReg cellGPR = value.payloadGPR();
+    addBranch(m_jit.branch32(MacroAssembler::NotEqual, value.tagGPR(), TrustedImm32(JSValue::CellTag)), data.fallThrough);
+#endif
+    addBranch(m_jit.branchPtr(MacroAssembler::NotEqual, MacroAssembler::Address(cellGPR, JSCell::classInfoOffset()), MacroAssembler::TrustedImmPtr(&JSString::s_info)), data.fallThrough);
+    
+    emitSwitchCharStringJump(data, cellGPR, temp.gpr(), scratch.gpr());
+    
+    noResult(m_compileIndex);
+}
+
+void SpeculativeJIT::emitSwitchString(Node& node, SwitchData& data)
+{
+    // String switches look the string up in the jump table's hash map, which maps it
+    // straight to the machine code for its case.
+    data.didUseJumpTable = true;
+    
+    GPRReg cellGPR;
+    if (isStringPrediction(at(node.child1()).prediction())) {
+        SpeculateCellOperand value(this, node.child1());
+        cellGPR = value.gpr();
+        
+        if (!isStringPrediction(m_state.forNode(node.child1()).m_type))
+            speculationCheck(BadType, JSValueSource::unboxedCell(cellGPR), node.child1(), m_jit.branchPtr(MacroAssembler::NotEqual, MacroAssembler::Address(cellGPR, JSCell::classInfoOffset()), MacroAssembler::TrustedImmPtr(&JSString::s_info)));
+        
+        value.use();
+    } else {
+        JSValueOperand value(this, node.child1());
+#if USE(JSVALUE64)
+        cellGPR = value.gpr();
+        addBranch(m_jit.branchTestPtr(MacroAssembler::NonZero, cellGPR, GPRInfo::tagMaskRegister), data.fallThrough);
+#else
+        cellGPR = value.payloadGPR();
+        addBranch(m_jit.branch32(MacroAssembler::NotEqual, value.tagGPR(), TrustedImm32(JSValue::CellTag)), data.fallThrough);
+#endif
+        addBranch(m_jit.branchPtr(MacroAssembler::NotEqual, MacroAssembler::Address(cellGPR, JSCell::classInfoOffset()), MacroAssembler::TrustedImmPtr(&JSString::s_info)), data.fallThrough);
+        
+        value.use();
+    }
+    
+    flushRegisters();
+    GPRResult result(this);
+    callOperation(operationSwitchString, result.gpr(), cellGPR, data.switchTableIndex);
+    m_jit.jump(result.gpr());
+    
+    noResult(m_compileIndex, UseChildrenCalledExplicitly);
+}
+
+void SpeculativeJIT::compileSwitch(Node& node)
+{
+    SwitchData& data = m_jit.graph().m_switchData[node.switchDataIndex()];
+    switch (data.kind) {
+    case SwitchImm:
+        emitSwitchImm(node, data);
+        return;
+    case SwitchChar:
+        emitSwitchChar(node, data);
+        return;
+    case SwitchString:
+        emitSwitchString(node, data);
+        return;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+void SpeculativeJIT::linkSwitches(LinkBuffer& linkBuffer)
+{
+    for (unsigned i = 0; i < m_jit.graph().m_switchData.size(); ++i) {
+        SwitchData& data = m_jit.graph().m_switchData[i];
+        if (!data.didUseJumpTable)
+            continue;
+        
+        // The tables were copied from the old JIT's code block, so every entry has to
+        // be pointed at our code, including the ones that go to the fall through.
+        CodeLocationLabel fallThrough = linkBuffer.locationOf(m_blockHeads[data.fallThrough]);
+        
+        if (data.kind == SwitchString) {
+            StringJumpTable& table = m_jit.codeBlock()->stringSwitchJumpTable(data.switchTableIndex);
+            table.ctiDefault = fallThrough;
+            StringJumpTable::StringOffsetTable::iterator end = table.offsetTable.end();
+            for (StringJumpTable::StringOffsetTable::iterator iter = table.offsetTable.begin(); iter != end; ++iter)
+                iter->second.ctiOffset = fallThrough;
+            for (unsigned j = 0; j < data.cases.size(); ++j)
+                table.offsetTable.find(data.cases[j].string)->second.ctiOffset = linkBuffer.locationOf(m_blockHeads[data.cases[j].target]);
+            continue;
+        }
+        
+        SimpleJumpTable& table = data.kind == SwitchImm ? m_jit.codeBlock()->immediateSwitchJumpTable(data.switchTableIndex) : m_jit.codeBlock()->characterSwitchJumpTable(data.switchTableIndex);
+        table.ctiDefault = fallThrough;
+        for (unsigned j = 0; j < table.ctiOffsets.size(); ++j)
+            table.ctiOffsets[j] = fallThrough;
+        for (unsigned j = 0; j < data.cases.size(); ++j)
+            table.ctiOffsets[data.cases[j].value - table.min] = linkBuffer.locationOf(m_blockHeads[data.cases[j].target]);
+    }
+}
+
 } } // namespace JSC::DFG
 
 #endif
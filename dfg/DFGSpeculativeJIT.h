@@ -54,6 +54,7 @@ enum ValueSourceKind {
     CellInRegisterFile,
     BooleanInRegisterFile,
     DoubleInRegisterFile,
+    DoubleInLoopRegister,
     HaveNode
 };
 
@@ -61,22 +62,34 @@ class ValueSource {
 public:
     ValueSource()
         : m_nodeIndex(nodeIndexFromKind(SourceNotSet))
+        , m_fpr(InvalidFPRReg)
     {
     }
     
     explicit ValueSource(ValueSourceKind valueSourceKind)
         : m_nodeIndex(nodeIndexFromKind(valueSourceKind))
+        , m_fpr(InvalidFPRReg)
     {
         ASSERT(kind() != SourceNotSet);
+        ASSERT(kind() != DoubleInLoopRegister);
         ASSERT(kind() != HaveNode);
     }
     
     explicit ValueSource(NodeIndex nodeIndex)
         : m_nodeIndex(nodeIndex)
+        , m_fpr(InvalidFPRReg)
     {
         ASSERT(kind() == HaveNode);
     }
     
+    static ValueSource inLoopRegister(FPRReg fpr)
+    {
+        ValueSource result;
+        result.m_nodeIndex = nodeIndexFromKind(DoubleInLoopRegister);
+        result.m_fpr = fpr;
+        return result;
+    }
+    
     static ValueSource forPrediction(PredictedType prediction)
     {
         if (isInt32Prediction(prediction))
@@ -104,6 +117,12 @@ public:
         return m_nodeIndex;
     }
     
+    FPRReg fpr() const
+    {
+        ASSERT(kind() == DoubleInLoopRegister);
+        return m_fpr;
+    }
+    
 #ifndef NDEBUG
     void dump(FILE* out) const;
 #endif
@@ -124,6 +143,7 @@ private:
     }
     
     NodeIndex m_nodeIndex;
+    FPRReg m_fpr;
 };
     
 // === SpeculativeJIT ===
@@ -178,6 +198,7 @@ public:
     bool compile();
     void createOSREntries();
     void linkOSREntries(LinkBuffer&);
+    void linkSwitches(LinkBuffer&);
 
     Node& at(NodeIndex nodeIndex)
     {
@@ -339,6 +360,15 @@ public:
     void writeBarrier(GPRReg ownerGPR, JSCell* value, WriteBarrierUseKind, GPRReg scratchGPR1 = InvalidGPRReg, GPRReg scratchGPR2 = InvalidGPRReg);
     void writeBarrier(JSCell* owner, GPRReg valueGPR, NodeUse valueUse, WriteBarrierUseKind, GPRReg scratchGPR1 = InvalidGPRReg);
 
+    // A store to the vector of a JSArray has to account for the value in the array's
+    // indexing shape, unless the value is known to be an int32. On JSVALUE32_64 the
+    // value register is the value's tag.
+    bool needsIndexingShapeUpdate(NodeUse valueUse)
+    {
+        return !isKnownInteger(valueUse.index()) && !isInt32Prediction(m_state.forNode(valueUse).m_type);
+    }
+    void updateIndexingShape(GPRReg baseGPR, GPRReg valueGPR, GPRReg scratchGPR);
+
     static GPRReg selectScratchGPR(GPRReg preserve1 = InvalidGPRReg, GPRReg preserve2 = InvalidGPRReg, GPRReg preserve3 = InvalidGPRReg, GPRReg preserve4 = InvalidGPRReg)
     {
         if (preserve1 != GPRInfo::regT0 && preserve2 != GPRInfo::regT0 && preserve3 != GPRInfo::regT0 && preserve4 != GPRInfo::regT0)
@@ -368,6 +398,7 @@ private:
     void compile(Node&);
     void compileMovHint(Node&);
     void compile(BasicBlock&);
+    void compileHoistedChecks(BasicBlock&);
 
     void checkArgumentTypes();
 
@@ -570,6 +601,7 @@ private:
             if (iter.name() != InvalidVirtualRegister)
                 silentSpillFPR(iter.name(), iter.regID());
         }
+        silentSpillLoopRegisters();
     }
     void silentSpillAllRegisters(FPRReg exclude)
     {
@@ -582,6 +614,7 @@ private:
             if (iter.name() != InvalidVirtualRegister && fpr != exclude)
                 silentSpillFPR(iter.name(), fpr);
         }
+        silentSpillLoopRegisters();
     }
 
     void silentFillAllRegisters(GPRReg exclude, GPRReg exclude2 = InvalidGPRReg)
@@ -590,6 +623,7 @@ private:
         if (exclude == GPRInfo::regT0)
             canTrample = GPRInfo::regT1;
         
+        silentFillLoopRegisters();
         for (fpr_iterator iter = m_fprs.begin(); iter != m_fprs.end(); ++iter) {
             if (iter.name() != InvalidVirtualRegister)
                 silentFillFPR(iter.name(), canTrample, iter.regID());
@@ -604,6 +638,7 @@ private:
     {
         GPRReg canTrample = GPRInfo::regT0;
         
+        silentFillLoopRegisters();
         for (fpr_iterator iter = m_fprs.begin(); iter != m_fprs.end(); ++iter) {
             FPRReg fpr = iter.regID();
             if (iter.name() != InvalidVirtualRegister && fpr != exclude)
@@ -763,7 +798,7 @@ private:
         return valueOfJSConstant(nodeIndex).isNull();
     }
 
-    Identifier* identifier(unsigned index)
+    const Identifier* identifier(unsigned index)
     {
         return &m_jit.codeBlock()->identifier(index);
     }
@@ -783,6 +818,80 @@ private:
                 iter.release();
             }
         }
+        flushLoopRegisters();
+    }
+    
+    FPRReg loopRegisterFor(int operand)
+    {
+        if (!m_registerAllocatedLoop)
+            return InvalidFPRReg;
+        for (unsigned i = 0; i < m_registerAllocatedLoop->variables.size(); ++i) {
+            RegisterAllocatedVariable& variable = m_registerAllocatedLoop->variables[i];
+            if (variable.local == operand)
+                return variable.fpr;
+        }
+        return InvalidFPRReg;
+    }
+    
+    // Brings the register file up to date with the loop registers. The variables that
+    // the loop never writes to are already up to date.
+    void storeLoopRegisters()
+    {
+        ASSERT(!m_loopRegistersNeedReload);
+        for (unsigned i = 0; i < m_registerAllocatedLoop->variables.size(); ++i) {
+            RegisterAllocatedVariable& variable = m_registerAllocatedLoop->variables[i];
+            if (variable.isWritten)
+                m_jit.storeDouble(variable.fpr, JITCompiler::addressFor(static_cast<VirtualRegister>(variable.local)));
+        }
+    }
+    void loadLoopRegisters(RegisterAllocatedLoop& loop)
+    {
+        for (unsigned i = 0; i < loop.variables.size(); ++i) {
+            RegisterAllocatedVariable& variable = loop.variables[i];
+            m_jit.loadDouble(JITCompiler::addressFor(static_cast<VirtualRegister>(variable.local)), variable.fpr);
+        }
+    }
+    
+    // The loop registers are all caller-save, so they are spilled and filled around
+    // C calls along with the rest of the registers.
+    void silentSpillLoopRegisters()
+    {
+        if (m_registerAllocatedLoop && !m_loopRegistersNeedReload)
+            storeLoopRegisters();
+    }
+    void silentFillLoopRegisters()
+    {
+        if (m_registerAllocatedLoop && !m_loopRegistersNeedReload)
+            loadLoopRegisters(*m_registerAllocatedLoop);
+    }
+    
+    // After flushRegisters(), anything up to the end of the node may clobber the loop
+    // registers, and calls may look at the variables in the register file. So the
+    // variables are stored, OSR exits recover them from the register file, and the
+    // registers are loaded again at the end of the node or on its edges.
+    void flushLoopRegisters()
+    {
+        if (!m_registerAllocatedLoop || m_loopRegistersNeedReload)
+            return;
+        storeLoopRegisters();
+        for (unsigned i = 0; i < m_registerAllocatedLoop->variables.size(); ++i) {
+            ValueSource& valueSource = m_variables[m_registerAllocatedLoop->variables[i].local];
+            if (valueSource.kind() == DoubleInLoopRegister)
+                valueSource = ValueSource(DoubleInRegisterFile);
+        }
+        m_loopRegistersNeedReload = true;
+    }
+    void reloadLoopRegisters()
+    {
+        ASSERT(m_loopRegistersNeedReload);
+        loadLoopRegisters(*m_registerAllocatedLoop);
+        for (unsigned i = 0; i < m_registerAllocatedLoop->variables.size(); ++i) {
+            RegisterAllocatedVariable& variable = m_registerAllocatedLoop->variables[i];
+            ValueSource& valueSource = m_variables[variable.local];
+            if (valueSource.kind() == DoubleInRegisterFile)
+                valueSource = ValueSource::inLoopRegister(variable.fpr);
+        }
+        m_loopRegistersNeedReload = false;
     }
 
 #ifndef NDEBUG
@@ -1102,12 +1211,12 @@ private:
         m_jit.zeroExtend32ToPtr(GPRInfo::returnValueGPR, result);
         return call;
     }
-    JITCompiler::Call callOperation(J_DFGOperation_EGI operation, GPRReg result, GPRReg arg1, Identifier* identifier)
+    JITCompiler::Call callOperation(J_DFGOperation_EGI operation, GPRReg result, GPRReg arg1, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(arg1, TrustedImmPtr(identifier));
         return appendCallWithExceptionCheckSetResult(operation, result);
     }
-    JITCompiler::Call callOperation(J_DFGOperation_EI operation, GPRReg result, Identifier* identifier)
+    JITCompiler::Call callOperation(J_DFGOperation_EI operation, GPRReg result, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(TrustedImmPtr(identifier));
         return appendCallWithExceptionCheckSetResult(operation, result);
@@ -1132,12 +1241,12 @@ private:
         m_jit.setupArgumentsWithExecState(arg1, TrustedImmPtr(pointer));
         return appendCallWithExceptionCheckSetResult(operation, result);
     }
-    JITCompiler::Call callOperation(J_DFGOperation_ECI operation, GPRReg result, GPRReg arg1, Identifier* identifier)
+    JITCompiler::Call callOperation(J_DFGOperation_ECI operation, GPRReg result, GPRReg arg1, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(arg1, TrustedImmPtr(identifier));
         return appendCallWithExceptionCheckSetResult(operation, result);
     }
-    JITCompiler::Call callOperation(J_DFGOperation_EJI operation, GPRReg result, GPRReg arg1, Identifier* identifier)
+    JITCompiler::Call callOperation(J_DFGOperation_EJI operation, GPRReg result, GPRReg arg1, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(arg1, TrustedImmPtr(identifier));
         return appendCallWithExceptionCheckSetResult(operation, result);
@@ -1197,12 +1306,29 @@ private:
         m_jit.setupArgumentsWithExecState(arg1, arg2);
         return appendCallWithExceptionCheckSetResult(operation, result);
     }
+    JITCompiler::Call callOperation(Z_DFGOperation_ECCZ operation, GPRReg result, GPRReg arg1, GPRReg arg2, GPRReg arg3)
+    {
+        m_jit.setupArgumentsWithExecState(arg1, arg2, arg3);
+        JITCompiler::Call call = appendCallWithExceptionCheck(operation);
+        m_jit.zeroExtend32ToPtr(GPRInfo::returnValueGPR, result);
+        return call;
+    }
+    JITCompiler::Call callOperation(V_DFGOperation_EC operation, GPRReg arg1)
+    {
+        m_jit.setupArgumentsWithExecState(arg1);
+        return appendCallWithExceptionCheck(operation);
+    }
+    JITCompiler::Call callOperation(P_DFGOperation_ECS operation, GPRReg result, GPRReg arg1, size_t arg2)
+    {
+        m_jit.setupArgumentsWithExecState(arg1, TrustedImmPtr(arg2));
+        return appendCallWithExceptionCheckSetResult(operation, result);
+    }
     JITCompiler::Call callOperation(V_DFGOperation_EJPP operation, GPRReg arg1, GPRReg arg2, void* pointer)
     {
         m_jit.setupArgumentsWithExecState(arg1, arg2, TrustedImmPtr(pointer));
         return appendCallWithExceptionCheck(operation);
     }
-    JITCompiler::Call callOperation(V_DFGOperation_EJCI operation, GPRReg arg1, GPRReg arg2, Identifier* identifier)
+    JITCompiler::Call callOperation(V_DFGOperation_EJCI operation, GPRReg arg1, GPRReg arg2, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(arg1, arg2, TrustedImmPtr(identifier));
         return appendCallWithExceptionCheck(operation);
@@ -1255,7 +1381,7 @@ private:
         m_jit.setupArgumentsWithExecState(arg1, TrustedImmPtr(pointer));
         return appendCallWithExceptionCheckSetResult(operation, resultPayload, resultTag);
     }
-    JITCompiler::Call callOperation(J_DFGOperation_EGI operation, GPRReg resultTag, GPRReg resultPayload, GPRReg arg1, Identifier* identifier)
+    JITCompiler::Call callOperation(J_DFGOperation_EGI operation, GPRReg resultTag, GPRReg resultPayload, GPRReg arg1, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(arg1, TrustedImmPtr(identifier));
         return appendCallWithExceptionCheckSetResult(operation, resultPayload, resultTag);
@@ -1265,7 +1391,7 @@ private:
         m_jit.setupArgumentsWithExecState(arg1);
         return appendCallWithExceptionCheckSetResult(operation, resultPayload, resultTag);
     }
-    JITCompiler::Call callOperation(J_DFGOperation_EI operation, GPRReg resultTag, GPRReg resultPayload, Identifier* identifier)
+    JITCompiler::Call callOperation(J_DFGOperation_EI operation, GPRReg resultTag, GPRReg resultPayload, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(TrustedImmPtr(identifier));
         return appendCallWithExceptionCheckSetResult(operation, resultPayload, resultTag);
@@ -1295,17 +1421,17 @@ private:
         m_jit.setupArgumentsWithExecState(arg1Payload, arg1Tag, arg2);
         return appendCallWithExceptionCheckSetResult(operation, resultPayload, resultTag);
     }
-    JITCompiler::Call callOperation(J_DFGOperation_ECI operation, GPRReg resultTag, GPRReg resultPayload, GPRReg arg1, Identifier* identifier)
+    JITCompiler::Call callOperation(J_DFGOperation_ECI operation, GPRReg resultTag, GPRReg resultPayload, GPRReg arg1, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(arg1, TrustedImmPtr(identifier));
         return appendCallWithExceptionCheckSetResult(operation, resultPayload, resultTag);
     }
-    JITCompiler::Call callOperation(J_DFGOperation_EJI operation, GPRReg resultTag, GPRReg resultPayload, GPRReg arg1Tag, GPRReg arg1Payload, Identifier* identifier)
+    JITCompiler::Call callOperation(J_DFGOperation_EJI operation, GPRReg resultTag, GPRReg resultPayload, GPRReg arg1Tag, GPRReg arg1Payload, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(arg1Payload, arg1Tag, TrustedImmPtr(identifier));
         return appendCallWithExceptionCheckSetResult(operation, resultPayload, resultTag);
     }
-    JITCompiler::Call callOperation(J_DFGOperation_EJI operation, GPRReg resultTag, GPRReg resultPayload, int32_t arg1Tag, GPRReg arg1Payload, Identifier* identifier)
+    JITCompiler::Call callOperation(J_DFGOperation_EJI operation, GPRReg resultTag, GPRReg resultPayload, int32_t arg1Tag, GPRReg arg1Payload, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(arg1Payload, TrustedImm32(arg1Tag), TrustedImmPtr(identifier));
         return appendCallWithExceptionCheckSetResult(operation, resultPayload, resultTag);
@@ -1365,12 +1491,27 @@ private:
         m_jit.setupArgumentsWithExecState(arg1, arg2Payload, arg2Tag);
         return appendCallWithExceptionCheckSetResult(operation, resultPayload, resultTag);
     }
+    JITCompiler::Call callOperation(Z_DFGOperation_ECCZ operation, GPRReg result, GPRReg arg1, GPRReg arg2, GPRReg arg3)
+    {
+        m_jit.setupArgumentsWithExecState(arg1, arg2, arg3);
+        return appendCallWithExceptionCheckSetResult(operation, result);
+    }
+    JITCompiler::Call callOperation(V_DFGOperation_EC operation, GPRReg arg1)
+    {
+        m_jit.setupArgumentsWithExecState(arg1);
+        return appendCallWithExceptionCheck(operation);
+    }
+    JITCompiler::Call callOperation(P_DFGOperation_ECS operation, GPRReg result, GPRReg arg1, size_t arg2)
+    {
+        m_jit.setupArgumentsWithExecState(arg1, TrustedImmPtr(arg2));
+        return appendCallWithExceptionCheckSetResult(operation, result);
+    }
     JITCompiler::Call callOperation(V_DFGOperation_EJPP operation, GPRReg arg1Tag, GPRReg arg1Payload, GPRReg arg2, void* pointer)
     {
         m_jit.setupArgumentsWithExecState(arg1Payload, arg1Tag, arg2, TrustedImmPtr(pointer));
         return appendCallWithExceptionCheck(operation);
     }
-    JITCompiler::Call callOperation(V_DFGOperation_EJCI operation, GPRReg arg1Tag, GPRReg arg1Payload, GPRReg arg2, Identifier* identifier)
+    JITCompiler::Call callOperation(V_DFGOperation_EJCI operation, GPRReg arg1Tag, GPRReg arg1Payload, GPRReg arg2, const Identifier* identifier)
     {
         m_jit.setupArgumentsWithExecState(arg1Payload, arg1Tag, arg2, TrustedImmPtr(identifier));
         return appendCallWithExceptionCheck(operation);
@@ -1612,15 +1753,37 @@ private:
         addBranch(m_jit.jump(), destination);
     }
     
-    inline bool haveEdgeCodeToEmit(BlockIndex)
+    inline bool haveEdgeCodeToEmit(BlockIndex destination)
     {
-        return DFG_ENABLE_EDGE_CODE_VERIFICATION;
+        return DFG_ENABLE_EDGE_CODE_VERIFICATION || haveLoopRegisterEdgeCode(destination);
     }
     void emitEdgeCode(BlockIndex destination)
     {
-        if (!DFG_ENABLE_EDGE_CODE_VERIFICATION)
+        if (DFG_ENABLE_EDGE_CODE_VERIFICATION)
+            m_jit.move(Imm32(destination), GPRInfo::regT0);
+        emitLoopRegisterEdgeCode(destination);
+    }
+    
+    // Edges that leave a loop store its loop registers, and edges that enter a loop
+    // load them.
+    bool haveLoopRegisterEdgeCode(BlockIndex destination)
+    {
+        if (m_jit.graph().m_blocks[destination]->registerAllocatedLoop == block()->registerAllocatedLoop)
+            return m_loopRegistersNeedReload;
+        return true;
+    }
+    void emitLoopRegisterEdgeCode(BlockIndex destination)
+    {
+        unsigned destinationLoop = m_jit.graph().m_blocks[destination]->registerAllocatedLoop;
+        if (destinationLoop == block()->registerAllocatedLoop) {
+            if (m_loopRegistersNeedReload)
+                loadLoopRegisters(*m_registerAllocatedLoop);
             return;
-        m_jit.move(Imm32(destination), GPRInfo::regT0);
+        }
+        if (m_registerAllocatedLoop && !m_loopRegistersNeedReload)
+            storeLoopRegisters();
+        if (destinationLoop != NoRegisterAllocatedLoop)
+            loadLoopRegisters(m_jit.graph().m_registerAllocatedLoops[destinationLoop]);
     }
 
     void addBranch(const MacroAssembler::Jump& jump, BlockIndex destination)
@@ -1711,6 +1874,13 @@ private:
         ClampRounding
     };
     void compileGetIndexedPropertyStorage(Node&);
+    void compileSwitch(Node&);
+    void emitSwitchImm(Node&, SwitchData&);
+    void emitSwitchChar(Node&, SwitchData&);
+    void emitSwitchString(Node&, SwitchData&);
+    void emitSwitchCharStringJump(SwitchData&, GPRReg string, GPRReg temp, GPRReg scratch);
+    void emitSwitchIntJump(SwitchData&, SimpleJumpTable&, GPRReg value, GPRReg scratch);
+    void emitBinarySwitchSearch(GPRReg value, SwitchData&, unsigned begin, unsigned end);
     void compileGetByValOnIntTypedArray(const TypedArrayDescriptor&, Node&, size_t elementSize, TypedArraySpeculationRequirements, TypedArraySignedness);
     void compilePutByValForIntTypedArray(const TypedArrayDescriptor&, GPRReg base, GPRReg property, Node&, size_t elementSize, TypedArraySpeculationRequirements, TypedArraySignedness, TypedArrayRounding = TruncateRounding);
     void compileGetByValOnFloatTypedArray(const TypedArrayDescriptor&, Node&, size_t elementSize, TypedArraySpeculationRequirements);
@@ -1872,6 +2042,10 @@ private:
     Vector<ValueSource, 0> m_arguments;
     Vector<ValueSource, 0> m_variables;
     int m_lastSetOperand;
+    
+    // The loop registers of the loop that the current block belongs to, if any.
+    RegisterAllocatedLoop* m_registerAllocatedLoop;
+    bool m_loopRegistersNeedReload;
     CodeOrigin m_codeOriginForOSR;
     
     AbstractState m_state;
@@ -2487,6 +2661,8 @@ inline SpeculativeJIT::SpeculativeJIT(JITCompiler& jit)
     , m_arguments(jit.codeBlock()->numParameters())
     , m_variables(jit.graph().m_localVars)
     , m_lastSetOperand(std::numeric_limits<int>::max())
+    , m_registerAllocatedLoop(0)
+    , m_loopRegistersNeedReload(false)
     , m_state(m_jit.codeBlock(), m_jit.graph())
 {
 }
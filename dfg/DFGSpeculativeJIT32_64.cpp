@@ -30,6 +30,7 @@
 #if ENABLE(DFG_JIT)
 
 #include "JSByteArray.h"
+#include "JSPropertyNameIterator.h"
 
 namespace JSC { namespace DFG {
 
@@ -1635,6 +1636,18 @@ void SpeculativeJIT::emitBranch(Node& node)
     }
 }
 
+void SpeculativeJIT::updateIndexingShape(GPRReg baseGPR, GPRReg valueTagGPR, GPRReg scratchGPR)
+{
+    MacroAssembler::Jump isInt32 = m_jit.branch32(MacroAssembler::Equal, valueTagGPR, TrustedImm32(JSValue::Int32Tag));
+    m_jit.load32(MacroAssembler::Address(baseGPR, JSArray::indexingShapeOffset()), scratchGPR);
+    MacroAssembler::Jump isDouble = m_jit.branch32(MacroAssembler::Below, valueTagGPR, TrustedImm32(JSValue::LowestTag));
+    m_jit.or32(TrustedImm32(JSArray::ContiguousShape), scratchGPR);
+    isDouble.link(&m_jit);
+    m_jit.or32(TrustedImm32(JSArray::DoubleShape), scratchGPR);
+    m_jit.store32(scratchGPR, MacroAssembler::Address(baseGPR, JSArray::indexingShapeOffset()));
+    isInt32.link(&m_jit);
+}
+
 void SpeculativeJIT::compile(Node& node)
 {
     NodeType op = node.op;
@@ -1661,7 +1674,11 @@ void SpeculativeJIT::compile(Node& node)
         
         if (node.variableAccessData()->shouldUseDoubleFormat()) {
             FPRTemporary result(this);
-            m_jit.loadDouble(JITCompiler::addressFor(node.local()), result.fpr());
+            FPRReg loopFPR = loopRegisterFor(node.local());
+            if (loopFPR != InvalidFPRReg)
+                m_jit.moveDouble(loopFPR, result.fpr());
+            else
+                m_jit.loadDouble(JITCompiler::addressFor(node.local()), result.fpr());
             VirtualRegister virtualRegister = node.virtualRegister();
             m_fprs.retain(result.fpr(), virtualRegister, SpillOrderDouble);
             m_generationInfo[virtualRegister].initDouble(m_compileIndex, node.refCount(), result.fpr());
@@ -1735,12 +1752,20 @@ void SpeculativeJIT::compile(Node& node)
         
         if (node.variableAccessData()->shouldUseDoubleFormat()) {
             SpeculateDoubleOperand value(this, node.child1());
-            m_jit.storeDouble(value.fpr(), JITCompiler::addressFor(node.local()));
-            noResult(m_compileIndex);
-            // Indicate that it's no longer necessary to retrieve the value of
-            // this bytecode variable from registers or other locations in the register file,
-            // but that it is stored as a double.
-            valueSourceReferenceForOperand(node.local()) = ValueSource(DoubleInRegisterFile);
+            FPRReg loopFPR = loopRegisterFor(node.local());
+            if (loopFPR != InvalidFPRReg) {
+                // The register file is brought up to date when the loop is left.
+                m_jit.moveDouble(value.fpr(), loopFPR);
+                noResult(m_compileIndex);
+                valueSourceReferenceForOperand(node.local()) = ValueSource::inLoopRegister(loopFPR);
+            } else {
+                m_jit.storeDouble(value.fpr(), JITCompiler::addressFor(node.local()));
+                noResult(m_compileIndex);
+                // Indicate that it's no longer necessary to retrieve the value of
+                // this bytecode variable from registers or other locations in the register file,
+                // but that it is stored as a double.
+                valueSourceReferenceForOperand(node.local()) = ValueSource(DoubleInRegisterFile);
+            }
         } else {
             PredictedType predictedType = node.variableAccessData()->prediction();
             if (m_generationInfo[at(node.child1()).virtualRegister()].registerFormat() == DataFormatDouble) {
@@ -2336,6 +2361,7 @@ void SpeculativeJIT::compile(Node& node)
             return;
         
         writeBarrier(baseReg, valueTagReg, node.child3(), WriteBarrierForPropertyAccess, scratchReg);
+        bool needsShapeUpdate = needsIndexingShapeUpdate(node.child3());
 
         // Check that base is an array, and that property is contained within m_vector (< m_vectorLength).
         // If we have predicted the base to be type array, we can skip the check.
@@ -2376,6 +2402,8 @@ void SpeculativeJIT::compile(Node& node)
         // Store the value to the array.
         m_jit.store32(valueTagReg, MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::TimesEight, OBJECT_OFFSETOF(ArrayStorage, m_vector[0]) + OBJECT_OFFSETOF(JSValue, u.asBits.tag)));
         m_jit.store32(valuePayloadReg, MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::TimesEight, OBJECT_OFFSETOF(ArrayStorage, m_vector[0]) + OBJECT_OFFSETOF(JSValue, u.asBits.payload)));
+        if (needsShapeUpdate)
+            updateIndexingShape(baseReg, valueTagReg, storageReg);
 
         wasBeyondArrayBounds.link(&m_jit);
 
@@ -2466,7 +2494,7 @@ void SpeculativeJIT::compile(Node& node)
         ASSERT(at(node.child1()).shouldSpeculateArray());
 
         JSValueOperand value(this, node.child3());
-        GPRTemporary scratch(this, base);
+        GPRTemporary scratch(this);
         
         GPRReg baseReg = base.gpr();
         GPRReg scratchReg = scratch.gpr();
@@ -2481,6 +2509,8 @@ void SpeculativeJIT::compile(Node& node)
         GPRReg propertyReg = property.gpr();
         m_jit.store32(value.tagGPR(), MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::TimesEight, OBJECT_OFFSETOF(ArrayStorage, m_vector[0]) + OBJECT_OFFSETOF(JSValue, u.asBits.tag)));
         m_jit.store32(value.payloadGPR(), MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::TimesEight, OBJECT_OFFSETOF(ArrayStorage, m_vector[0]) + OBJECT_OFFSETOF(JSValue, u.asBits.payload)));
+        if (needsIndexingShapeUpdate(node.child3()))
+            updateIndexingShape(baseReg, value.tagGPR(), storageReg);
 
         noResult(m_compileIndex);
         break;
@@ -2517,6 +2547,8 @@ void SpeculativeJIT::compile(Node& node)
         m_jit.add32(Imm32(1), storageLengthGPR);
         m_jit.store32(storageLengthGPR, MacroAssembler::Address(storageGPR, OBJECT_OFFSETOF(ArrayStorage, m_length)));
         m_jit.add32(Imm32(1), MacroAssembler::Address(storageGPR, OBJECT_OFFSETOF(ArrayStorage, m_numValuesInVector)));
+        if (needsIndexingShapeUpdate(node.child2()))
+            updateIndexingShape(baseGPR, valueTagGPR, storageGPR);
         m_jit.move(Imm32(JSValue::Int32Tag), storageGPR);
         
         MacroAssembler::Jump done = m_jit.jump();
@@ -2623,6 +2655,10 @@ void SpeculativeJIT::compile(Node& node)
         emitBranch(node);
         break;
 
+    case Switch:
+        compileSwitch(node);
+        break;
+
     case Return: {
         ASSERT(GPRInfo::callFrameRegister != GPRInfo::regT2);
         ASSERT(GPRInfo::regT1 != GPRInfo::returnValueGPR);
@@ -2793,6 +2829,223 @@ void SpeculativeJIT::compile(Node& node)
         break;
     }
         
+    case CreateActivation: {
+        JSValueOperand value(this, node.child1());
+        GPRTemporary result(this, value, false);
+        
+        GPRReg valueTagGPR = value.tagGPR();
+        GPRReg valuePayloadGPR = value.payloadGPR();
+        GPRReg resultGPR = result.gpr();
+        
+        m_jit.move(valuePayloadGPR, resultGPR);
+        
+        JITCompiler::Jump alreadyCreated = m_jit.branch32(JITCompiler::NotEqual, valueTagGPR, TrustedImm32(JSValue::EmptyValueTag));
+        
+        silentSpillAllRegisters(resultGPR);
+        callOperation(operationCreateActivation, resultGPR);
+        silentFillAllRegisters(resultGPR);
+        
+        alreadyCreated.link(&m_jit);
+        
+        cellResult(resultGPR, m_compileIndex);
+        break;
+    }
+        
+    case TearOffActivation: {
+        JSValueOperand activation(this, node.child1());
+        GPRTemporary result(this, activation, false);
+        
+        GPRReg activationTagGPR = activation.tagGPR();
+        GPRReg activationPayloadGPR = activation.payloadGPR();
+        GPRReg resultGPR = result.gpr();
+        
+        // If the activation was never created we still have to tear off an
+        // arguments object that may have been created, just like op_tear_off_activation.
+        m_jit.move(activationPayloadGPR, resultGPR);
+        JITCompiler::Jump activationCreated = m_jit.branch32(JITCompiler::NotEqual, activationTagGPR, TrustedImm32(JSValue::EmptyValueTag));
+        JITCompiler::Jump noArguments = m_jit.branch32(JITCompiler::Equal, JITCompiler::tagFor(static_cast<VirtualRegister>(unmodifiedArgumentsRegister(m_jit.codeBlock()->argumentsRegister()))), TrustedImm32(JSValue::EmptyValueTag));
+        m_jit.move(TrustedImm32(0), resultGPR);
+        activationCreated.link(&m_jit);
+        
+        silentSpillAllRegisters(InvalidGPRReg);
+        callOperation(operationTearOffActivation, resultGPR);
+        silentFillAllRegisters(InvalidGPRReg);
+        
+        noArguments.link(&m_jit);
+        
+        noResult(m_compileIndex);
+        break;
+    }
+        
+    case NewFunction: {
+        JSValueOperand value(this, node.child1());
+        GPRTemporary resultTag(this, value);
+        GPRTemporary resultPayload(this, value, false);
+        
+        GPRReg valueTagGPR = value.tagGPR();
+        GPRReg valuePayloadGPR = value.payloadGPR();
+        GPRReg resultTagGPR = resultTag.gpr();
+        GPRReg resultPayloadGPR = resultPayload.gpr();
+        
+        m_jit.move(valuePayloadGPR, resultPayloadGPR);
+        m_jit.move(valueTagGPR, resultTagGPR);
+        
+        JITCompiler::Jump alreadyCreated = m_jit.branch32(JITCompiler::NotEqual, resultTagGPR, TrustedImm32(JSValue::EmptyValueTag));
+        
+        silentSpillAllRegisters(resultTagGPR, resultPayloadGPR);
+        callOperation(operationNewFunction, resultTagGPR, resultPayloadGPR, m_jit.codeBlock()->functionDecl(node.functionDeclIndex()));
+        silentFillAllRegisters(resultTagGPR, resultPayloadGPR);
+        
+        alreadyCreated.link(&m_jit);
+        
+        cellResult(resultPayloadGPR, m_compileIndex);
+        break;
+    }
+        
+    case NewFunctionNoCheck: {
+        flushRegisters();
+        GPRResult resultPayload(this);
+        GPRResult2 resultTag(this);
+        
+        callOperation(operationNewFunction, resultTag.gpr(), resultPayload.gpr(), m_jit.codeBlock()->functionDecl(node.functionDeclIndex()));
+        
+        cellResult(resultPayload.gpr(), m_compileIndex);
+        break;
+    }
+        
+    case NewFunctionExpression: {
+        flushRegisters();
+        GPRResult resultPayload(this);
+        GPRResult2 resultTag(this);
+        
+        callOperation(operationNewFunctionExpression, resultTag.gpr(), resultPayload.gpr(), m_jit.codeBlock()->functionExpr(node.functionExprIndex()));
+        
+        cellResult(resultPayload.gpr(), m_compileIndex);
+        break;
+    }
+        
+    case TypeOf: {
+        JSValueOperand value(this, node.child1());
+        GPRReg valueTagGPR = value.tagGPR();
+        GPRReg valuePayloadGPR = value.payloadGPR();
+        value.use();
+        
+        flushRegisters();
+        GPRResult resultPayload(this);
+        GPRResult2 resultTag(this);
+        callOperation(operationTypeOf, resultTag.gpr(), resultPayload.gpr(), valueTagGPR, valuePayloadGPR);
+        
+        cellResult(resultPayload.gpr(), m_compileIndex, UseChildrenCalledExplicitly);
+        break;
+    }
+        
+    case GetPropertyNameIterator: {
+        SpeculateCellOperand base(this, node.child1());
+        GPRReg baseGPR = base.gpr();
+        
+        if (!isObjectPrediction(m_state.forNode(node.child1()).m_type)) {
+            GPRTemporary structure(this);
+            GPRReg structureGPR = structure.gpr();
+            m_jit.loadPtr(JITCompiler::Address(baseGPR, JSCell::structureOffset()), structureGPR);
+            speculationCheck(BadType, JSValueSource::unboxedCell(baseGPR), node.child1(), m_jit.branch8(JITCompiler::Below, JITCompiler::Address(structureGPR, Structure::typeInfoTypeOffset()), JITCompiler::TrustedImm32(ObjectType)));
+        }
+        
+        base.use();
+        
+        flushRegisters();
+        GPRResult result(this);
+        callOperation(operationGetPropertyNameIterator, result.gpr(), baseGPR);
+        
+        cellResult(result.gpr(), m_compileIndex, UseChildrenCalledExplicitly);
+        break;
+    }
+        
+    case GetPropertyNameIteratorSize: {
+        SpeculateCellOperand iterator(this, node.child1());
+        GPRTemporary result(this, iterator);
+        
+        m_jit.load32(JITCompiler::Address(iterator.gpr(), JSPropertyNameIterator::offsetOfJSStringsSize()), result.gpr());
+        
+        integerResult(result.gpr(), m_compileIndex);
+        break;
+    }
+        
+    case NextPropertyNameIndex: {
+        SpeculateCellOperand base(this, node.child1());
+        SpeculateCellOperand iterator(this, node.child2());
+        SpeculateIntegerOperand index(this, node.child3());
+        GPRTemporary result(this);
+        GPRTemporary chain(this);
+        
+        GPRReg baseGPR = base.gpr();
+        GPRReg iteratorGPR = iterator.gpr();
+        GPRReg indexGPR = index.gpr();
+        GPRReg resultGPR = result.gpr();
+        GPRReg chainGPR = chain.gpr();
+        
+        JITCompiler::JumpList keyIsValid;
+        keyIsValid.append(m_jit.branch32(JITCompiler::AboveOrEqual, indexGPR, JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfJSStringsSize())));
+        
+        // The key at the current index is known to be valid if the base and its prototype
+        // chain still have the structures the iterator was built from. Otherwise ask the
+        // runtime to find the next key the object still has.
+        JITCompiler::JumpList slowPath;
+        m_jit.loadPtr(JITCompiler::Address(baseGPR, JSCell::structureOffset()), resultGPR);
+        slowPath.append(m_jit.branchPtr(JITCompiler::NotEqual, resultGPR, JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfCachedStructure())));
+        
+        m_jit.loadPtr(JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfCachedPrototypeChain()), chainGPR);
+        m_jit.loadPtr(JITCompiler::Address(chainGPR, StructureChain::offsetOfVector()), chainGPR);
+        keyIsValid.append(m_jit.branchTestPtr(JITCompiler::Zero, JITCompiler::Address(chainGPR)));
+        
+        JITCompiler::Label checkPrototype = m_jit.label();
+        slowPath.append(m_jit.branch32(JITCompiler::NotEqual, JITCompiler::Address(resultGPR, Structure::prototypeOffset() + OBJECT_OFFSETOF(JSValue, u.asBits.tag)), TrustedImm32(JSValue::CellTag)));
+        m_jit.loadPtr(JITCompiler::Address(resultGPR, Structure::prototypeOffset() + OBJECT_OFFSETOF(JSValue, u.asBits.payload)), resultGPR);
+        m_jit.loadPtr(JITCompiler::Address(resultGPR, JSCell::structureOffset()), resultGPR);
+        slowPath.append(m_jit.branchPtr(JITCompiler::NotEqual, resultGPR, JITCompiler::Address(chainGPR)));
+        m_jit.addPtr(JITCompiler::TrustedImm32(sizeof(Structure*)), chainGPR);
+        m_jit.branchTestPtr(JITCompiler::NonZero, JITCompiler::Address(chainGPR)).linkTo(checkPrototype, &m_jit);
+        keyIsValid.append(m_jit.jump());
+        
+        slowPath.link(&m_jit);
+        silentSpillAllRegisters(resultGPR);
+        callOperation(operationNextPropertyNameIndex, resultGPR, baseGPR, iteratorGPR, indexGPR);
+        silentFillAllRegisters(resultGPR);
+        JITCompiler::Jump done = m_jit.jump();
+        
+        keyIsValid.link(&m_jit);
+        m_jit.move(indexGPR, resultGPR);
+        
+        done.link(&m_jit);
+        
+        integerResult(resultGPR, m_compileIndex);
+        break;
+    }
+        
+    case GetPropertyNameIteratorKey: {
+        SpeculateCellOperand iterator(this, node.child1());
+        SpeculateIntegerOperand index(this, node.child2());
+        JSValueOperand oldKey(this, node.child3());
+        GPRTemporary resultTag(this);
+        GPRTemporary resultPayload(this);
+        
+        GPRReg iteratorGPR = iterator.gpr();
+        GPRReg indexGPR = index.gpr();
+        GPRReg resultTagGPR = resultTag.gpr();
+        GPRReg resultPayloadGPR = resultPayload.gpr();
+        
+        // Once the loop is done the key keeps its last value, as in the old JIT.
+        m_jit.move(oldKey.tagGPR(), resultTagGPR);
+        m_jit.move(oldKey.payloadGPR(), resultPayloadGPR);
+        JITCompiler::Jump done = m_jit.branch32(JITCompiler::AboveOrEqual, indexGPR, JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfJSStringsSize()));
+        m_jit.loadPtr(JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfJSStrings()), resultPayloadGPR);
+        m_jit.load32(JITCompiler::BaseIndex(resultPayloadGPR, indexGPR, JITCompiler::TimesEight, OBJECT_OFFSETOF(JSValue, u.asBits.tag)), resultTagGPR);
+        m_jit.load32(JITCompiler::BaseIndex(resultPayloadGPR, indexGPR, JITCompiler::TimesEight, OBJECT_OFFSETOF(JSValue, u.asBits.payload)), resultPayloadGPR);
+        done.link(&m_jit);
+        
+        jsValueResult(resultTagGPR, resultPayloadGPR, m_compileIndex);
+        break;
+    }
+        
     case ConvertThis: {
         if (isObjectPrediction(m_state.forNode(node.child1()).m_type)) {
             SpeculateCellOperand thisValue(this, node.child1());
@@ -3294,6 +3547,119 @@ void SpeculativeJIT::compile(Node& node)
         break;
     }
         
+    case MultiGetByOffset: {
+        SpeculateCellOperand base(this, node.child1());
+        GPRTemporary resultTag(this, base);
+        GPRTemporary resultPayload(this);
+        GPRTemporary structure(this);
+        
+        GPRReg baseGPR = base.gpr();
+        GPRReg resultTagGPR = resultTag.gpr();
+        GPRReg resultPayloadGPR = resultPayload.gpr();
+        GPRReg structureGPR = structure.gpr();
+        
+        MultiGetByOffsetData& data = m_jit.graph().m_multiGetByOffsetData[node.multiGetByOffsetDataIndex()];
+        
+        m_jit.loadPtr(JITCompiler::Address(baseGPR, JSCell::structureOffset()), structureGPR);
+        
+        JITCompiler::JumpList done;
+        for (size_t i = 0; i < data.cases.size(); ++i) {
+            MultiGetByOffsetCase& getCase = data.cases[i];
+            bool isLastCase = i == data.cases.size() - 1;
+            
+            // Branch to the load if the structure matches, except for the last structure
+            // of the last case, which exits if it does not match.
+            JITCompiler::JumpList matched;
+            JITCompiler::Jump notMatched;
+            for (size_t j = 0; j < getCase.structureSet.size() - 1; ++j)
+                matched.append(m_jit.branchWeakPtr(JITCompiler::Equal, structureGPR, getCase.structureSet[j]));
+            if (isLastCase)
+                speculationCheck(BadCache, JSValueRegs(), NoNode, m_jit.branchWeakPtr(JITCompiler::NotEqual, structureGPR, getCase.structureSet.last()));
+            else
+                notMatched = m_jit.branchWeakPtr(JITCompiler::NotEqual, structureGPR, getCase.structureSet.last());
+            matched.link(&m_jit);
+            
+            // The structure is no longer needed on this path, so reuse its register for
+            // the storage pointer.
+            if (getCase.holder) {
+                m_jit.addWeakReference(getCase.holder);
+                m_jit.move(MacroAssembler::TrustedImmPtr(getCase.holder), structureGPR);
+                m_jit.loadPtr(JITCompiler::Address(structureGPR, JSObject::offsetOfPropertyStorage()), structureGPR);
+            } else
+                m_jit.loadPtr(JITCompiler::Address(baseGPR, JSObject::offsetOfPropertyStorage()), structureGPR);
+            m_jit.load32(JITCompiler::Address(structureGPR, getCase.offset * sizeof(EncodedJSValue) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.payload)), resultPayloadGPR);
+            m_jit.load32(JITCompiler::Address(structureGPR, getCase.offset * sizeof(EncodedJSValue) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.tag)), resultTagGPR);
+            
+            if (!isLastCase) {
+                done.append(m_jit.jump());
+                notMatched.link(&m_jit);
+            }
+        }
+        done.link(&m_jit);
+        
+        jsValueResult(resultTagGPR, resultPayloadGPR, m_compileIndex);
+        break;
+    }
+        
+    case MultiPutByOffset: {
+        SpeculateCellOperand base(this, node.child1());
+        JSValueOperand value(this, node.child2());
+        GPRTemporary structure(this);
+        
+        GPRReg baseGPR = base.gpr();
+        GPRReg valueTagGPR = value.tagGPR();
+        GPRReg valuePayloadGPR = value.payloadGPR();
+        GPRReg structureGPR = structure.gpr();
+        
+        MultiPutByOffsetData& data = m_jit.graph().m_multiPutByOffsetData[node.multiPutByOffsetDataIndex()];
+        
+#if ENABLE(GGC) || ENABLE(WRITE_BARRIER_PROFILING)
+        writeBarrier(baseGPR, valueTagGPR, node.child2(), WriteBarrierForPropertyAccess);
+        for (size_t i = 0; i < data.cases.size(); ++i) {
+            // Must always emit this write barrier as the structure transition itself requires it
+            if (data.cases[i].newStructure) {
+                writeBarrier(baseGPR, data.cases[i].newStructure, WriteBarrierForGenericAccess);
+                break;
+            }
+        }
+#endif
+        
+        m_jit.loadPtr(JITCompiler::Address(baseGPR, JSCell::structureOffset()), structureGPR);
+        
+        JITCompiler::JumpList done;
+        for (size_t i = 0; i < data.cases.size(); ++i) {
+            MultiPutByOffsetCase& putCase = data.cases[i];
+            bool isLastCase = i == data.cases.size() - 1;
+            
+            JITCompiler::Jump notMatched;
+            if (isLastCase)
+                speculationCheck(BadCache, JSValueRegs(), NoNode, m_jit.branchWeakPtr(JITCompiler::NotEqual, structureGPR, putCase.oldStructure));
+            else
+                notMatched = m_jit.branchWeakPtr(JITCompiler::NotEqual, structureGPR, putCase.oldStructure);
+            
+            if (putCase.newStructure) {
+                m_jit.addWeakReferenceTransition(
+                    node.codeOrigin.codeOriginOwner(),
+                    putCase.oldStructure,
+                    putCase.newStructure);
+                m_jit.storePtr(MacroAssembler::TrustedImmPtr(putCase.newStructure), MacroAssembler::Address(baseGPR, JSCell::structureOffset()));
+            }
+            
+            m_jit.loadPtr(JITCompiler::Address(baseGPR, JSObject::offsetOfPropertyStorage()), structureGPR);
+            m_jit.storePtr(valueTagGPR, JITCompiler::Address(structureGPR, putCase.offset * sizeof(EncodedJSValue) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.tag)));
+            m_jit.storePtr(valuePayloadGPR, JITCompiler::Address(structureGPR, putCase.offset * sizeof(EncodedJSValue) + OBJECT_OFFSETOF(EncodedValueDescriptor, asBits.payload)));
+            
+            if (!isLastCase) {
+                done.append(m_jit.jump());
+                notMatched.link(&m_jit);
+            }
+        }
+        done.link(&m_jit);
+        
+        noResult(m_compileIndex);
+        break;
+    }
+        
     case PutById: {
         SpeculateCellOperand base(this, node.child1());
         JSValueOperand value(this, node.child2());
@@ -3365,6 +3731,41 @@ void SpeculativeJIT::compile(Node& node)
         break;
     }
 
+    case GetCapturedVar: {
+        GPRTemporary resultTag(this);
+        GPRTemporary resultPayload(this);
+        
+        m_jit.load32(JITCompiler::tagFor(static_cast<VirtualRegister>(node.capturedOperand())), resultTag.gpr());
+        m_jit.load32(JITCompiler::payloadFor(static_cast<VirtualRegister>(node.capturedOperand())), resultPayload.gpr());
+        
+        jsValueResult(resultTag.gpr(), resultPayload.gpr(), m_compileIndex);
+        break;
+    }
+        
+    case PutCapturedVar: {
+        JSValueOperand value(this, node.child1());
+        
+        m_jit.store32(value.tagGPR(), JITCompiler::tagFor(static_cast<VirtualRegister>(node.capturedOperand())));
+        m_jit.store32(value.payloadGPR(), JITCompiler::payloadFor(static_cast<VirtualRegister>(node.capturedOperand())));
+        
+        noResult(m_compileIndex);
+        
+        // The old JIT may expect to find the last assigned value in the cached result
+        // registers when we OSR exit, so treat this like a SetLocal.
+        m_lastSetOperand = node.capturedOperand();
+        break;
+    }
+        
+    case ClearCapturedVar: {
+        m_jit.store32(TrustedImm32(JSValue::EmptyValueTag), JITCompiler::tagFor(static_cast<VirtualRegister>(node.capturedOperand())));
+        m_jit.store32(TrustedImm32(0), JITCompiler::payloadFor(static_cast<VirtualRegister>(node.capturedOperand())));
+        
+        noResult(m_compileIndex);
+        
+        m_lastSetOperand = node.capturedOperand();
+        break;
+    }
+        
     case CheckHasInstance: {
         SpeculateCellOperand base(this, node.child1());
         GPRTemporary structure(this);
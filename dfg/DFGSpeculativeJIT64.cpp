@@ -27,6 +27,7 @@
 #include "DFGSpeculativeJIT.h"
 
 #include "JSByteArray.h"
+#include "JSPropertyNameIterator.h"
 
 #if ENABLE(DFG_JIT)
 
@@ -1727,6 +1728,18 @@ void SpeculativeJIT::emitBranch(Node& node)
     }
 }
 
+void SpeculativeJIT::updateIndexingShape(GPRReg baseGPR, GPRReg valueGPR, GPRReg scratchGPR)
+{
+    MacroAssembler::Jump isInt32 = m_jit.branchPtr(MacroAssembler::AboveOrEqual, valueGPR, GPRInfo::tagTypeNumberRegister);
+    m_jit.load32(MacroAssembler::Address(baseGPR, JSArray::indexingShapeOffset()), scratchGPR);
+    MacroAssembler::Jump isDouble = m_jit.branchTestPtr(MacroAssembler::NonZero, valueGPR, GPRInfo::tagTypeNumberRegister);
+    m_jit.or32(TrustedImm32(JSArray::ContiguousShape), scratchGPR);
+    isDouble.link(&m_jit);
+    m_jit.or32(TrustedImm32(JSArray::DoubleShape), scratchGPR);
+    m_jit.store32(scratchGPR, MacroAssembler::Address(baseGPR, JSArray::indexingShapeOffset()));
+    isInt32.link(&m_jit);
+}
+
 void SpeculativeJIT::compile(Node& node)
 {
     NodeType op = node.op;
@@ -1753,7 +1766,11 @@ void SpeculativeJIT::compile(Node& node)
         
         if (node.variableAccessData()->shouldUseDoubleFormat()) {
             FPRTemporary result(this);
-            m_jit.loadDouble(JITCompiler::addressFor(node.local()), result.fpr());
+            FPRReg loopFPR = loopRegisterFor(node.local());
+            if (loopFPR != InvalidFPRReg)
+                m_jit.moveDouble(loopFPR, result.fpr());
+            else
+                m_jit.loadDouble(JITCompiler::addressFor(node.local()), result.fpr());
             VirtualRegister virtualRegister = node.virtualRegister();
             m_fprs.retain(result.fpr(), virtualRegister, SpillOrderDouble);
             m_generationInfo[virtualRegister].initDouble(m_compileIndex, node.refCount(), result.fpr());
@@ -1819,12 +1836,20 @@ void SpeculativeJIT::compile(Node& node)
         
         if (node.variableAccessData()->shouldUseDoubleFormat()) {
             SpeculateDoubleOperand value(this, node.child1());
-            m_jit.storeDouble(value.fpr(), JITCompiler::addressFor(node.local()));
-            noResult(m_compileIndex);
-            // Indicate that it's no longer necessary to retrieve the value of
-            // this bytecode variable from registers or other locations in the register file,
-            // but that it is stored as a double.
-            valueSourceReferenceForOperand(node.local()) = ValueSource(DoubleInRegisterFile);
+            FPRReg loopFPR = loopRegisterFor(node.local());
+            if (loopFPR != InvalidFPRReg) {
+                // The register file is brought up to date when the loop is left.
+                m_jit.moveDouble(value.fpr(), loopFPR);
+                noResult(m_compileIndex);
+                valueSourceReferenceForOperand(node.local()) = ValueSource::inLoopRegister(loopFPR);
+            } else {
+                m_jit.storeDouble(value.fpr(), JITCompiler::addressFor(node.local()));
+                noResult(m_compileIndex);
+                // Indicate that it's no longer necessary to retrieve the value of
+                // this bytecode variable from registers or other locations in the register file,
+                // but that it is stored as a double.
+                valueSourceReferenceForOperand(node.local()) = ValueSource(DoubleInRegisterFile);
+            }
         } else {
             PredictedType predictedType = node.variableAccessData()->prediction();
             if (isInt32Prediction(predictedType)) {
@@ -2375,6 +2400,7 @@ void SpeculativeJIT::compile(Node& node)
             return;
         
         writeBarrier(baseReg, value.gpr(), node.child3(), WriteBarrierForPropertyAccess, scratchReg);
+        bool needsShapeUpdate = needsIndexingShapeUpdate(node.child3());
 
         // Check that base is an array, and that property is contained within m_vector (< m_vectorLength).
         // If we have predicted the base to be type array, we can skip the check.
@@ -2414,6 +2440,8 @@ void SpeculativeJIT::compile(Node& node)
 
         // Store the value to the array.
         m_jit.storePtr(valueReg, MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::ScalePtr, OBJECT_OFFSETOF(ArrayStorage, m_vector[0])));
+        if (needsShapeUpdate)
+            updateIndexingShape(baseReg, valueReg, storageReg);
 
         wasBeyondArrayBounds.link(&m_jit);
 
@@ -2518,6 +2546,8 @@ void SpeculativeJIT::compile(Node& node)
         GPRReg propertyReg = property.gpr();
         GPRReg valueReg = value.gpr();
         m_jit.storePtr(valueReg, MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::ScalePtr, OBJECT_OFFSETOF(ArrayStorage, m_vector[0])));
+        if (needsIndexingShapeUpdate(node.child3()))
+            updateIndexingShape(baseReg, valueReg, storageReg);
 
         noResult(m_compileIndex);
         break;
@@ -2552,6 +2582,8 @@ void SpeculativeJIT::compile(Node& node)
         m_jit.add32(Imm32(1), storageLengthGPR);
         m_jit.store32(storageLengthGPR, MacroAssembler::Address(storageGPR, OBJECT_OFFSETOF(ArrayStorage, m_length)));
         m_jit.add32(Imm32(1), MacroAssembler::Address(storageGPR, OBJECT_OFFSETOF(ArrayStorage, m_numValuesInVector)));
+        if (needsIndexingShapeUpdate(node.child2()))
+            updateIndexingShape(baseGPR, valueGPR, storageGPR);
         m_jit.orPtr(GPRInfo::tagTypeNumberRegister, storageLengthGPR);
         
         MacroAssembler::Jump done = m_jit.jump();
@@ -2653,6 +2685,10 @@ void SpeculativeJIT::compile(Node& node)
         emitBranch(node);
         break;
 
+    case Switch:
+        compileSwitch(node);
+        break;
+
     case Return: {
         ASSERT(GPRInfo::callFrameRegister != GPRInfo::regT1);
         ASSERT(GPRInfo::regT1 != GPRInfo::returnValueGPR);
@@ -2798,6 +2834,204 @@ void SpeculativeJIT::compile(Node& node)
         break;
     }
         
+    case CreateActivation: {
+        JSValueOperand value(this, node.child1());
+        GPRTemporary result(this, value);
+        
+        GPRReg valueGPR = value.gpr();
+        GPRReg resultGPR = result.gpr();
+        
+        m_jit.move(valueGPR, resultGPR);
+        
+        JITCompiler::Jump alreadyCreated = m_jit.branchTestPtr(JITCompiler::NonZero, resultGPR);
+        
+        silentSpillAllRegisters(resultGPR);
+        callOperation(operationCreateActivation, resultGPR);
+        silentFillAllRegisters(resultGPR);
+        
+        alreadyCreated.link(&m_jit);
+        
+        cellResult(resultGPR, m_compileIndex);
+        break;
+    }
+        
+    case TearOffActivation: {
+        JSValueOperand activation(this, node.child1());
+        GPRReg activationGPR = activation.gpr();
+        
+        // If the activation was never created we still have to tear off an
+        // arguments object that may have been created, just like op_tear_off_activation.
+        JITCompiler::Jump activationCreated = m_jit.branchTestPtr(JITCompiler::NonZero, activationGPR);
+        JITCompiler::Jump noArguments = m_jit.branchTestPtr(JITCompiler::Zero, JITCompiler::addressFor(static_cast<VirtualRegister>(unmodifiedArgumentsRegister(m_jit.codeBlock()->argumentsRegister()))));
+        activationCreated.link(&m_jit);
+        
+        silentSpillAllRegisters(InvalidGPRReg);
+        callOperation(operationTearOffActivation, activationGPR);
+        silentFillAllRegisters(InvalidGPRReg);
+        
+        noArguments.link(&m_jit);
+        
+        noResult(m_compileIndex);
+        break;
+    }
+        
+    case NewFunction: {
+        JSValueOperand value(this, node.child1());
+        GPRTemporary result(this, value);
+        
+        GPRReg valueGPR = value.gpr();
+        GPRReg resultGPR = result.gpr();
+        
+        m_jit.move(valueGPR, resultGPR);
+        
+        JITCompiler::Jump alreadyCreated = m_jit.branchTestPtr(JITCompiler::NonZero, resultGPR);
+        
+        silentSpillAllRegisters(resultGPR);
+        callOperation(operationNewFunction, resultGPR, m_jit.codeBlock()->functionDecl(node.functionDeclIndex()));
+        silentFillAllRegisters(resultGPR);
+        
+        alreadyCreated.link(&m_jit);
+        
+        cellResult(resultGPR, m_compileIndex);
+        break;
+    }
+        
+    case NewFunctionNoCheck: {
+        flushRegisters();
+        GPRResult result(this);
+        
+        callOperation(operationNewFunction, result.gpr(), m_jit.codeBlock()->functionDecl(node.functionDeclIndex()));
+        
+        cellResult(result.gpr(), m_compileIndex);
+        break;
+    }
+        
+    case NewFunctionExpression: {
+        flushRegisters();
+        GPRResult result(this);
+        
+        callOperation(operationNewFunctionExpression, result.gpr(), m_jit.codeBlock()->functionExpr(node.functionExprIndex()));
+        
+        cellResult(result.gpr(), m_compileIndex);
+        break;
+    }
+        
+    case TypeOf: {
+        JSValueOperand value(this, node.child1());
+        GPRReg valueGPR = value.gpr();
+        value.use();
+        
+        flushRegisters();
+        GPRResult result(this);
+        callOperation(operationTypeOf, result.gpr(), valueGPR);
+        
+        cellResult(result.gpr(), m_compileIndex, UseChildrenCalledExplicitly);
+        break;
+    }
+        
+    case GetPropertyNameIterator: {
+        SpeculateCellOperand base(this, node.child1());
+        GPRReg baseGPR = base.gpr();
+        
+        if (!isObjectPrediction(m_state.forNode(node.child1()).m_type)) {
+            GPRTemporary structure(this);
+            GPRReg structureGPR = structure.gpr();
+            m_jit.loadPtr(JITCompiler::Address(baseGPR, JSCell::structureOffset()), structureGPR);
+            speculationCheck(BadType, JSValueRegs(baseGPR), node.child1(), m_jit.branch8(JITCompiler::Below, JITCompiler::Address(structureGPR, Structure::typeInfoTypeOffset()), JITCompiler::TrustedImm32(ObjectType)));
+        }
+        
+        base.use();
+        
+        flushRegisters();
+        GPRResult result(this);
+        callOperation(operationGetPropertyNameIterator, result.gpr(), baseGPR);
+        
+        cellResult(result.gpr(), m_compileIndex, UseChildrenCalledExplicitly);
+        break;
+    }
+        
+    case GetPropertyNameIteratorSize: {
+        SpeculateCellOperand iterator(this, node.child1());
+        GPRTemporary result(this, iterator);
+        
+        m_jit.load32(JITCompiler::Address(iterator.gpr(), JSPropertyNameIterator::offsetOfJSStringsSize()), result.gpr());
+        
+        integerResult(result.gpr(), m_compileIndex);
+        break;
+    }
+        
+    case NextPropertyNameIndex: {
+        SpeculateCellOperand base(this, node.child1());
+        SpeculateCellOperand iterator(this, node.child2());
+        SpeculateIntegerOperand index(this, node.child3());
+        GPRTemporary result(this);
+        GPRTemporary chain(this);
+        
+        GPRReg baseGPR = base.gpr();
+        GPRReg iteratorGPR = iterator.gpr();
+        GPRReg indexGPR = index.gpr();
+        GPRReg resultGPR = result.gpr();
+        GPRReg chainGPR = chain.gpr();
+        
+        JITCompiler::JumpList keyIsValid;
+        keyIsValid.append(m_jit.branch32(JITCompiler::AboveOrEqual, indexGPR, JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfJSStringsSize())));
+        
+        // The key at the current index is known to be valid if the base and its prototype
+        // chain still have the structures the iterator was built from. Otherwise ask the
+        // runtime to find the next key the object still has.
+        JITCompiler::JumpList slowPath;
+        m_jit.loadPtr(JITCompiler::Address(baseGPR, JSCell::structureOffset()), resultGPR);
+        slowPath.append(m_jit.branchPtr(JITCompiler::NotEqual, resultGPR, JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfCachedStructure())));
+        
+        m_jit.loadPtr(JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfCachedPrototypeChain()), chainGPR);
+        m_jit.loadPtr(JITCompiler::Address(chainGPR, StructureChain::offsetOfVector()), chainGPR);
+        keyIsValid.append(m_jit.branchTestPtr(JITCompiler::Zero, JITCompiler::Address(chainGPR)));
+        
+        JITCompiler::Label checkPrototype = m_jit.label();
+        m_jit.loadPtr(JITCompiler::Address(resultGPR, Structure::prototypeOffset()), resultGPR);
+        slowPath.append(m_jit.branchTestPtr(JITCompiler::NonZero, resultGPR, GPRInfo::tagMaskRegister));
+        m_jit.loadPtr(JITCompiler::Address(resultGPR, JSCell::structureOffset()), resultGPR);
+        slowPath.append(m_jit.branchPtr(JITCompiler::NotEqual, resultGPR, JITCompiler::Address(chainGPR)));
+        m_jit.addPtr(JITCompiler::TrustedImm32(sizeof(Structure*)), chainGPR);
+        m_jit.branchTestPtr(JITCompiler::NonZero, JITCompiler::Address(chainGPR)).linkTo(checkPrototype, &m_jit);
+        keyIsValid.append(m_jit.jump());
+        
+        slowPath.link(&m_jit);
+        silentSpillAllRegisters(resultGPR);
+        callOperation(operationNextPropertyNameIndex, resultGPR, baseGPR, iteratorGPR, indexGPR);
+        silentFillAllRegisters(resultGPR);
+        JITCompiler::Jump done = m_jit.jump();
+        
+        keyIsValid.link(&m_jit);
+        m_jit.move(indexGPR, resultGPR);
+        
+        done.link(&m_jit);
+        
+        integerResult(resultGPR, m_compileIndex);
+        break;
+    }
+        
+    case GetPropertyNameIteratorKey: {
+        SpeculateCellOperand iterator(this, node.child1());
+        SpeculateIntegerOperand index(this, node.child2());
+        JSValueOperand oldKey(this, node.child3());
+        GPRTemporary result(this);
+        
+        GPRReg iteratorGPR = iterator.gpr();
+        GPRReg indexGPR = index.gpr();
+        GPRReg resultGPR = result.gpr();
+        
+        // Once the loop is done the key keeps its last value, as in the old JIT.
+        m_jit.move(oldKey.gpr(), resultGPR);
+        JITCompiler::Jump done = m_jit.branch32(JITCompiler::AboveOrEqual, indexGPR, JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfJSStringsSize()));
+        m_jit.loadPtr(JITCompiler::Address(iteratorGPR, JSPropertyNameIterator::offsetOfJSStrings()), resultGPR);
+        m_jit.loadPtr(JITCompiler::BaseIndex(resultGPR, indexGPR, JITCompiler::TimesEight), resultGPR);
+        done.link(&m_jit);
+        
+        jsValueResult(resultGPR, m_compileIndex);
+        break;
+    }
+        
     case ConvertThis: {
         if (isObjectPrediction(m_state.forNode(node.child1()).m_type)) {
             SpeculateCellOperand thisValue(this, node.child1());
@@ -3275,6 +3509,112 @@ void SpeculativeJIT::compile(Node& node)
         break;
     }
         
+    case MultiGetByOffset: {
+        SpeculateCellOperand base(this, node.child1());
+        GPRTemporary result(this, base);
+        GPRTemporary structure(this);
+        
+        GPRReg baseGPR = base.gpr();
+        GPRReg resultGPR = result.gpr();
+        GPRReg structureGPR = structure.gpr();
+        
+        MultiGetByOffsetData& data = m_jit.graph().m_multiGetByOffsetData[node.multiGetByOffsetDataIndex()];
+        
+        m_jit.loadPtr(JITCompiler::Address(baseGPR, JSCell::structureOffset()), structureGPR);
+        
+        JITCompiler::JumpList done;
+        for (size_t i = 0; i < data.cases.size(); ++i) {
+            MultiGetByOffsetCase& getCase = data.cases[i];
+            bool isLastCase = i == data.cases.size() - 1;
+            
+            // Branch to the load if the structure matches, except for the last structure
+            // of the last case, which exits if it does not match.
+            JITCompiler::JumpList matched;
+            JITCompiler::Jump notMatched;
+            for (size_t j = 0; j < getCase.structureSet.size() - 1; ++j)
+                matched.append(m_jit.branchWeakPtr(JITCompiler::Equal, structureGPR, getCase.structureSet[j]));
+            if (isLastCase)
+                speculationCheck(BadCache, JSValueRegs(), NoNode, m_jit.branchWeakPtr(JITCompiler::NotEqual, structureGPR, getCase.structureSet.last()));
+            else
+                notMatched = m_jit.branchWeakPtr(JITCompiler::NotEqual, structureGPR, getCase.structureSet.last());
+            matched.link(&m_jit);
+            
+            if (getCase.holder) {
+                m_jit.addWeakReference(getCase.holder);
+                m_jit.move(MacroAssembler::TrustedImmPtr(getCase.holder), resultGPR);
+                m_jit.loadPtr(JITCompiler::Address(resultGPR, JSObject::offsetOfPropertyStorage()), resultGPR);
+            } else
+                m_jit.loadPtr(JITCompiler::Address(baseGPR, JSObject::offsetOfPropertyStorage()), resultGPR);
+            m_jit.loadPtr(JITCompiler::Address(resultGPR, getCase.offset * sizeof(EncodedJSValue)), resultGPR);
+            
+            if (!isLastCase) {
+                done.append(m_jit.jump());
+                notMatched.link(&m_jit);
+            }
+        }
+        done.link(&m_jit);
+        
+        jsValueResult(resultGPR, m_compileIndex);
+        break;
+    }
+        
+    case MultiPutByOffset: {
+        SpeculateCellOperand base(this, node.child1());
+        JSValueOperand value(this, node.child2());
+        GPRTemporary structure(this);
+        
+        GPRReg baseGPR = base.gpr();
+        GPRReg valueGPR = value.gpr();
+        GPRReg structureGPR = structure.gpr();
+        
+        MultiPutByOffsetData& data = m_jit.graph().m_multiPutByOffsetData[node.multiPutByOffsetDataIndex()];
+        
+#if ENABLE(GGC) || ENABLE(WRITE_BARRIER_PROFILING)
+        writeBarrier(baseGPR, valueGPR, node.child2(), WriteBarrierForPropertyAccess);
+        for (size_t i = 0; i < data.cases.size(); ++i) {
+            // Must always emit this write barrier as the structure transition itself requires it
+            if (data.cases[i].newStructure) {
+                writeBarrier(baseGPR, data.cases[i].newStructure, WriteBarrierForGenericAccess);
+                break;
+            }
+        }
+#endif
+        
+        m_jit.loadPtr(JITCompiler::Address(baseGPR, JSCell::structureOffset()), structureGPR);
+        
+        JITCompiler::JumpList done;
+        for (size_t i = 0; i < data.cases.size(); ++i) {
+            MultiPutByOffsetCase& putCase = data.cases[i];
+            bool isLastCase = i == data.cases.size() - 1;
+            
+            JITCompiler::Jump notMatched;
+            if (isLastCase)
+                speculationCheck(BadCache, JSValueRegs(), NoNode, m_jit.branchWeakPtr(JITCompiler::NotEqual, structureGPR, putCase.oldStructure));
+            else
+                notMatched = m_jit.branchWeakPtr(JITCompiler::NotEqual, structureGPR, putCase.oldStructure);
+            
+            if (putCase.newStructure) {
+                m_jit.addWeakReferenceTransition(
+                    node.codeOrigin.codeOriginOwner(),
+                    putCase.oldStructure,
+                    putCase.newStructure);
+                m_jit.storePtr(MacroAssembler::TrustedImmPtr(putCase.newStructure), MacroAssembler::Address(baseGPR, JSCell::structureOffset()));
+            }
+            
+            m_jit.loadPtr(JITCompiler::Address(baseGPR, JSObject::offsetOfPropertyStorage()), structureGPR);
+            m_jit.storePtr(valueGPR, JITCompiler::Address(structureGPR, putCase.offset * sizeof(EncodedJSValue)));
+            
+            if (!isLastCase) {
+                done.append(m_jit.jump());
+                notMatched.link(&m_jit);
+            }
+        }
+        done.link(&m_jit);
+        
+        noResult(m_compileIndex);
+        break;
+    }
+        
     case PutById: {
         SpeculateCellOperand base(this, node.child1());
         JSValueOperand value(this, node.child2());
@@ -3341,6 +3681,37 @@ void SpeculativeJIT::compile(Node& node)
         break;
     }
 
+    case GetCapturedVar: {
+        GPRTemporary result(this);
+        
+        m_jit.loadPtr(JITCompiler::addressFor(static_cast<VirtualRegister>(node.capturedOperand())), result.gpr());
+        
+        jsValueResult(result.gpr(), m_compileIndex);
+        break;
+    }
+        
+    case PutCapturedVar: {
+        JSValueOperand value(this, node.child1());
+        
+        m_jit.storePtr(value.gpr(), JITCompiler::addressFor(static_cast<VirtualRegister>(node.capturedOperand())));
+        
+        noResult(m_compileIndex);
+        
+        // The old JIT may expect to find the last assigned value in the cached result
+        // register when we OSR exit, so treat this like a SetLocal.
+        m_lastSetOperand = node.capturedOperand();
+        break;
+    }
+        
+    case ClearCapturedVar: {
+        m_jit.storePtr(JITCompiler::TrustedImmPtr(0), JITCompiler::addressFor(static_cast<VirtualRegister>(node.capturedOperand())));
+        
+        noResult(m_compileIndex);
+        
+        m_lastSetOperand = node.capturedOperand();
+        break;
+    }
+        
     case CheckHasInstance: {
         SpeculateCellOperand base(this, node.child1());
         GPRTemporary structure(this);
@@ -70,7 +70,7 @@ MacroAssemblerCodeRef osrExitGenerationThunkGenerator(JSGlobalData* globalData)
     
     patchBuffer.link(functionCall, compileOSRExit);
     
-    return patchBuffer.finalizeCode();
+    return patchBuffer.finalizeCode(PerfMap::Description(PerfMap::Stub, "DFG OSR exit generation thunk"));
 }
 
 } } // namespace JSC::DFG
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "DFGWorklist.h"
+
+#if ENABLE(DFG_JIT)
+
+#include "CodeBlock.h"
+#include "JSGlobalData.h"
+#include "Options.h"
+
+namespace JSC { namespace DFG {
+
+Worklist::Worklist()
+    : m_shouldQuit(false)
+    , m_suspensionCount(0)
+{
+}
+
+Worklist::~Worklist()
+{
+    ASSERT(!m_suspensionCount);
+    {
+        MutexLocker locker(m_lock);
+        m_shouldQuit = true;
+        m_planEnqueued.broadcast();
+    }
+    for (unsigned i = 0; i < m_threads.size(); ++i)
+        waitForThreadCompletion(m_threads[i]->m_identifier, 0);
+
+    // Any plans left over were never picked up by a thread, so it is safe to
+    // destroy them here.
+    m_queue.clear();
+    m_plans.clear();
+    m_readyPlans.clear();
+}
+
+PassOwnPtr<Worklist> Worklist::create(unsigned numberOfThreads)
+{
+    OwnPtr<Worklist> result = adoptPtr(new Worklist());
+    result->finishCreation(numberOfThreads);
+    return result.release();
+}
+
+void Worklist::finishCreation(unsigned numberOfThreads)
+{
+    ASSERT(numberOfThreads);
+    for (unsigned i = 0; i < numberOfThreads; ++i) {
+        OwnPtr<ThreadData> data = adoptPtr(new ThreadData(this));
+        data->m_identifier = createThread(threadFunction, data.get(), "JavaScriptCore::DFG");
+        ASSERT(data->m_identifier);
+        m_threads.append(data.release());
+    }
+}
+
+void Worklist::enqueue(PassRefPtr<Plan> passedPlan)
+{
+    RefPtr<Plan> plan = passedPlan;
+    MutexLocker locker(m_lock);
+    ASSERT(!m_plans.contains(plan->profiledBlock()));
+    m_plans.add(plan->profiledBlock(), plan);
+    m_queue.append(plan);
+    m_planEnqueued.signal();
+}
+
+bool Worklist::isCompiling(CodeBlock* profiledBlock)
+{
+    MutexLocker locker(m_lock);
+    return m_plans.contains(profiledBlock);
+}
+
+void Worklist::completeAllReadyPlans()
+{
+    // Installing a plan may allocate, and so may trigger a collection. Take the
+    // plans out one at a time so that the ones that are still waiting continue
+    // to be visited.
+    while (true) {
+        RefPtr<Plan> plan;
+        {
+            MutexLocker locker(m_lock);
+            if (m_readyPlans.isEmpty())
+                return;
+            plan = m_readyPlans.last();
+            m_readyPlans.removeLast();
+            m_plans.remove(plan->profiledBlock());
+        }
+        plan->finalize();
+    }
+}
+
+void Worklist::cancelAllPlans()
+{
+    {
+        // Only the main thread adds plans, so if there are none now, none can
+        // show up while we look. This keeps discarding code cheap in the common case.
+        MutexLocker locker(m_lock);
+        if (m_plans.isEmpty())
+            return;
+    }
+    suspendAllThreads();
+    {
+        MutexLocker locker(m_lock);
+        m_queue.clear();
+        m_plans.clear();
+        m_readyPlans.clear();
+    }
+    resumeAllThreads();
+}
+
+void Worklist::cancelPlansFor(ExecutableBase* executable)
+{
+    {
+        MutexLocker locker(m_lock);
+        if (m_plans.isEmpty())
+            return;
+    }
+    suspendAllThreads();
+    {
+        MutexLocker locker(m_lock);
+        Vector<CodeBlock*, 4> cancelled;
+        HashMap<CodeBlock*, RefPtr<Plan> >::iterator end = m_plans.end();
+        for (HashMap<CodeBlock*, RefPtr<Plan> >::iterator iter = m_plans.begin(); iter != end; ++iter) {
+            if (iter->second->refersTo(executable))
+                cancelled.append(iter->first);
+        }
+        if (!cancelled.isEmpty()) {
+            for (unsigned i = 0; i < cancelled.size(); ++i)
+                m_plans.remove(cancelled[i]);
+
+            for (size_t i = m_queue.size(); i--;) {
+                RefPtr<Plan> plan = m_queue.takeFirst();
+                if (m_plans.contains(plan->profiledBlock()))
+                    m_queue.append(plan);
+            }
+            for (size_t i = m_readyPlans.size(); i--;) {
+                if (!m_plans.contains(m_readyPlans[i]->profiledBlock()))
+                    m_readyPlans.remove(i);
+            }
+        }
+    }
+    resumeAllThreads();
+}
+
+void Worklist::suspendAllThreads()
+{
+    if (m_suspensionCount++)
+        return;
+    for (unsigned i = 0; i < m_threads.size(); ++i)
+        m_threads[i]->m_rightToRun.lock();
+}
+
+void Worklist::resumeAllThreads()
+{
+    ASSERT(m_suspensionCount);
+    if (--m_suspensionCount)
+        return;
+    for (unsigned i = 0; i < m_threads.size(); ++i)
+        m_threads[i]->m_rightToRun.unlock();
+}
+
+void Worklist::visitChildren(SlotVisitor& visitor)
+{
+    ASSERT(m_suspensionCount);
+    MutexLocker locker(m_lock);
+    HashMap<CodeBlock*, RefPtr<Plan> >::iterator end = m_plans.end();
+    for (HashMap<CodeBlock*, RefPtr<Plan> >::iterator iter = m_plans.begin(); iter != end; ++iter)
+        iter->second->visitChildren(visitor);
+}
+
+void* Worklist::threadFunction(void* argument)
+{
+    ThreadData* data = static_cast<ThreadData*>(argument);
+    data->m_worklist->runThread(*data);
+    return 0;
+}
+
+void Worklist::runThread(ThreadData& data)
+{
+    while (true) {
+        {
+            MutexLocker locker(m_lock);
+            while (m_queue.isEmpty() && !m_shouldQuit)
+                m_planEnqueued.wait(m_lock);
+            if (m_shouldQuit)
+                return;
+        }
+
+        // A thread only ever holds a reference to a plan while it has the right
+        // to run. This guarantees that a suspended worklist can drop its plans
+        // knowing that they will be destroyed on the main thread.
+        MutexLocker rightToRunLocker(data.m_rightToRun);
+
+        RefPtr<Plan> plan;
+        {
+            MutexLocker locker(m_lock);
+            if (m_queue.isEmpty())
+                continue;
+            plan = m_queue.takeFirst();
+        }
+
+        plan->compileInThread();
+
+        {
+            MutexLocker locker(m_lock);
+            m_readyPlans.append(plan.release());
+        }
+    }
+}
+
+Worklist& ensureWorklistFor(JSGlobalData& globalData)
+{
+    if (!globalData.dfgWorklist)
+        globalData.dfgWorklist = Worklist::create(Options::numberOfDFGCompilerThreads);
+    return *globalData.dfgWorklist;
+}
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2011 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef DFGWorklist_h
+#define DFGWorklist_h
+
+#include <wtf/Platform.h>
+
+#if ENABLE(DFG_JIT)
+
+#include "DFGPlan.h"
+#include <wtf/Deque.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class CodeBlock;
+class ExecutableBase;
+class JSGlobalData;
+class SlotVisitor;
+
+namespace DFG {
+
+// === Worklist ===
+//
+// The queue of optimizing compilations that are waiting for, or running on, the
+// compiler threads of a JSGlobalData. Everything except the thread loop itself
+// is called on the main thread, with the JSLock held.
+//
+// Compiled plans are not installed by the compiler threads; they sit in the
+// worklist until the main thread calls completeAllReadyPlans() at a point where
+// it is safe to swap code blocks.
+class Worklist {
+    WTF_MAKE_NONCOPYABLE(Worklist);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<Worklist> create(unsigned numberOfThreads);
+    ~Worklist();
+
+    void enqueue(PassRefPtr<Plan>);
+
+    // Returns true if there is a compilation in flight, or waiting to be
+    // installed, for the given baseline code block.
+    bool isCompiling(CodeBlock* profiledBlock);
+
+    void completeAllReadyPlans();
+    void cancelAllPlans();
+    // Cancels the plans that compile, or inline, code of the given executable.
+    void cancelPlansFor(ExecutableBase*);
+
+    // While the threads are suspended, no plan is being worked on. This is
+    // what allows the collector to visit plans, and the main thread to throw
+    // them away.
+    void suspendAllThreads();
+    void resumeAllThreads();
+
+    void visitChildren(SlotVisitor&);
+
+private:
+    struct ThreadData {
+        ThreadData(Worklist* worklist)
+            : m_worklist(worklist)
+            , m_identifier(0)
+        {
+        }
+
+        Worklist* m_worklist;
+        ThreadIdentifier m_identifier;
+        Mutex m_rightToRun;
+    };
+
+    Worklist();
+    void finishCreation(unsigned numberOfThreads);
+
+    static void* threadFunction(void* argument);
+    void runThread(ThreadData&);
+
+    Mutex m_lock;
+    ThreadCondition m_planEnqueued;
+    Deque<RefPtr<Plan> > m_queue;
+    HashMap<CodeBlock*, RefPtr<Plan> > m_plans;
+    Vector<RefPtr<Plan> > m_readyPlans;
+    bool m_shouldQuit;
+
+    Vector<OwnPtr<ThreadData> > m_threads;
+    unsigned m_suspensionCount;
+};
+
+// Creates the worklist for the given global data, if it does not exist yet.
+Worklist& ensureWorklistFor(JSGlobalData&);
+
+} } // namespace JSC::DFG
+
+#endif // ENABLE(DFG_JIT)
+
+#endif // DFGWorklist_h
@@ -27,6 +27,7 @@
 #define CardSet_h
 
 #include <stdint.h>
+#include <string.h>
 #include <wtf/Assertions.h>
 #include <wtf/Noncopyable.h>
 
@@ -73,7 +73,7 @@ inline void ConservativeRoots::genericAddPointer(void* p, TinyBloomFilter filter
     markHook.mark(p);
     
     CopiedBlock* block;
-    if (m_copiedSpace->contains(p, block))
+    if (m_copiedSpace && m_copiedSpace->contains(p, block))
         m_copiedSpace->pin(block);
     
     MarkedBlock* candidate = MarkedBlock::blockFor(p);
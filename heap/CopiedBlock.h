@@ -27,12 +27,13 @@
 #define CopiedBlock_h
 
 #include "HeapBlock.h"
+#include <wtf/RedBlackTree.h>
 
 namespace JSC {
 
 class CopiedSpace;
 
-class CopiedBlock : public HeapBlock {
+class CopiedBlock : public HeapBlock, public WTF::RedBlackTree<CopiedBlock, void*>::Node {
     friend class CopiedSpace;
 public:
     CopiedBlock(PageAllocationAligned& allocation)
@@ -42,6 +43,10 @@ public:
     {
     }
 
+    // Oversize blocks are kept in a tree ordered by address, so that a pointer
+    // into the middle of one can be mapped back to it.
+    void* key() { return this; }
+
 private:
     void* m_offset;
     uintptr_t m_isPinned;
@@ -30,6 +30,16 @@
 
 namespace JSC {
 
+CopiedSpace::~CopiedSpace()
+{
+    releaseOversizeBlockCache();
+    while (!m_oversizeBlocks.isEmpty()) {
+        CopiedBlock* block = static_cast<CopiedBlock*>(m_oversizeBlocks.removeHead());
+        m_oversizeBlockTree.remove(block);
+        block->m_allocation.deallocate();
+    }
+}
+
 CheckedBoolean CopiedSpace::tryAllocateSlowCase(size_t bytes, void** outPtr)
 {
     if (isOversize(bytes))
@@ -31,9 +31,11 @@
 #include <wtf/Assertions.h>
 #include <wtf/CheckedBoolean.h>
 #include <wtf/DoublyLinkedList.h>
+#include <wtf/FixedArray.h>
 #include <wtf/HashSet.h>
 #include <wtf/OSAllocator.h>
 #include <wtf/PageAllocationAligned.h>
+#include <wtf/RedBlackTree.h>
 #include <wtf/StdLibExtras.h>
 #include <wtf/ThreadingPrimitives.h>
 
@@ -47,6 +49,7 @@ class CopiedSpace {
     friend class SlotVisitor;
 public:
     CopiedSpace(Heap*);
+    ~CopiedSpace();
     void init();
 
     CheckedBoolean tryAllocate(size_t, void**);
@@ -61,6 +64,8 @@ public:
 
     bool contains(void*, CopiedBlock*&);
 
+    void releaseOversizeBlockCache();
+
     size_t totalMemoryAllocated() { return m_totalMemoryAllocated; }
     size_t totalMemoryUtilized() { return m_totalMemoryUtilized; }
 
@@ -75,6 +80,8 @@ private:
     static void* allocateFromBlock(CopiedBlock*, size_t);
     CheckedBoolean tryAllocateOversize(size_t, void**);
     CheckedBoolean tryReallocateOversize(void**, size_t, size_t);
+    PageAllocationAligned allocateOversizePages(size_t);
+    void freeOversizeBlock(CopiedBlock*);
     
     static bool isOversize(size_t);
     
@@ -84,6 +91,8 @@ private:
     void recycleBlock(CopiedBlock*);
     static bool fitsInBlock(CopiedBlock*, size_t);
     static CopiedBlock* oversizeBlockFor(void* ptr);
+    CopiedBlock* oversizeBlockContaining(void* ptr);
+    void addToOversizeFilter(CopiedBlock*);
 
     Heap* m_heap;
 
@@ -102,6 +111,16 @@ private:
     DoublyLinkedList<HeapBlock> m_blocks1;
     DoublyLinkedList<HeapBlock> m_blocks2;
     DoublyLinkedList<HeapBlock> m_oversizeBlocks;
+    // Live oversize blocks by address, so that a conservative root that points
+    // anywhere into one, not just into its first page, pins it. m_oversizeFilter
+    // holds every 64KB region such a block overlaps, which rules out most other
+    // pointers before the tree is searched.
+    WTF::RedBlackTree<CopiedBlock, void*> m_oversizeBlockTree;
+
+    // Dead oversize blocks, indexed by their size in pages, kept until the next
+    // collection so that new arrays do not have to go back to the OS each time.
+    static const size_t s_maxCachedOversizePages = 16;
+    FixedArray<DoublyLinkedList<HeapBlock>, s_maxCachedOversizePages + 1> m_oversizeBlockCache;
    
     size_t m_totalMemoryAllocated;
     size_t m_totalMemoryUtilized;
@@ -113,7 +132,14 @@ private:
     size_t m_numberOfLoanedBlocks;
 
     static const size_t s_blockSize = 64 * KB;
-    static const size_t s_maxAllocationSize = 32 * KB;
+    // Anything bigger than this gets its own page-granular block that is pinned
+    // when marked and never copied. This is two pages rather than the 2KB
+    // MarkedSpace::maxCellSize: rounding up to whole pages wastes up to
+    // (s_maxAllocationSize + s_pageSize) / s_maxAllocationSize of the request,
+    // which is at most 1.5x here but would be 2x for a 2KB threshold, where a
+    // 2.1KB vector takes a whole 4KB page. tests/perf/bench-oversize-storage.js
+    // times full collections on both sides of the threshold.
+    static const size_t s_maxAllocationSize = 8 * KB;
     static const size_t s_pageSize = 4 * KB;
     static const size_t s_pageMask = ~(s_pageSize - 1);
     static const size_t s_initialBlockNum = 16;
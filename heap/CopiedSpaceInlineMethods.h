@@ -61,8 +61,29 @@ inline void CopiedSpace::init()
 inline bool CopiedSpace::contains(void* ptr, CopiedBlock*& result)
 {
     CopiedBlock* block = blockFor(ptr);
-    result = block;
-    return !m_toSpaceFilter.ruleOut(reinterpret_cast<Bits>(block)) && m_toSpaceSet.contains(block);
+    if (!m_toSpaceFilter.ruleOut(reinterpret_cast<Bits>(block)) && m_toSpaceSet.contains(block)) {
+        result = block;
+        return true;
+    }
+    result = oversizeBlockContaining(ptr);
+    return result;
+}
+
+inline CopiedBlock* CopiedSpace::oversizeBlockContaining(void* ptr)
+{
+    if (m_oversizeFilter.ruleOut(reinterpret_cast<Bits>(blockFor(ptr))))
+        return 0;
+    CopiedBlock* block = m_oversizeBlockTree.findGreatestLessThanOrEqual(ptr);
+    if (!block || static_cast<char*>(ptr) >= reinterpret_cast<char*>(block) + block->m_allocation.size())
+        return 0;
+    return block;
+}
+
+inline void CopiedSpace::addToOversizeFilter(CopiedBlock* block)
+{
+    char* end = reinterpret_cast<char*>(block) + block->m_allocation.size();
+    for (char* region = reinterpret_cast<char*>(blockFor(block)); region < end; region += s_blockSize)
+        m_oversizeFilter.add(reinterpret_cast<Bits>(region));
 }
 
 inline void CopiedSpace::pin(CopiedBlock* block)
@@ -100,6 +121,7 @@ inline void CopiedSpace::doneCopying()
         if (block->m_isPinned) {
             block->m_isPinned = false;
             m_toSpace->push(block);
+            m_totalMemoryUtilized += static_cast<size_t>(static_cast<char*>(block->m_offset) - block->m_payload);
             continue;
         }
 
@@ -111,16 +133,23 @@ inline void CopiedSpace::doneCopying()
         }
     }
 
+    // Whatever nobody reused since the last collection goes back to the OS.
+    releaseOversizeBlockCache();
+
+    // Rebuilt from the survivors, so that freed blocks stop matching.
+    m_oversizeFilter.reset();
     CopiedBlock* curr = static_cast<CopiedBlock*>(m_oversizeBlocks.head());
     while (curr) {
         CopiedBlock* next = static_cast<CopiedBlock*>(curr->next());
         if (!curr->m_isPinned) {
             m_oversizeBlocks.remove(curr);
-            m_totalMemoryAllocated -= curr->m_allocation.size();
-            m_totalMemoryUtilized -= curr->m_allocation.size() - sizeof(CopiedBlock);
-            curr->m_allocation.deallocate();
-        } else
+            freeOversizeBlock(curr);
+        } else {
+            // Utilization was reset when copying started, so count the survivors again.
             curr->m_isPinned = false;
+            m_totalMemoryUtilized += curr->m_allocation.size() - sizeof(CopiedBlock);
+            addToOversizeFilter(curr);
+        }
         curr = next;
     }
 
@@ -285,7 +314,7 @@ inline CheckedBoolean CopiedSpace::tryAllocateOversize(size_t bytes, void** outP
     ASSERT(isOversize(bytes));
     
     size_t blockSize = WTF::roundUpToMultipleOf<s_pageSize>(sizeof(CopiedBlock) + bytes);
-    PageAllocationAligned allocation = PageAllocationAligned::allocate(blockSize, s_pageSize, OSAllocator::JSGCHeapPages);
+    PageAllocationAligned allocation = allocateOversizePages(blockSize);
     if (!static_cast<bool>(allocation)) {
         *outPtr = 0;
         return false;
@@ -294,15 +323,55 @@ inline CheckedBoolean CopiedSpace::tryAllocateOversize(size_t bytes, void** outP
     m_oversizeBlocks.push(block);
     ASSERT(isPointerAligned(block->m_offset));
 
-    m_oversizeFilter.add(reinterpret_cast<Bits>(block));
+    m_oversizeBlockTree.insert(block);
+    addToOversizeFilter(block);
     
-    m_totalMemoryAllocated += blockSize;
-    m_totalMemoryUtilized += bytes;
+    m_totalMemoryUtilized += blockSize - sizeof(CopiedBlock);
 
     *outPtr = block->m_offset;
     return true;
 }
 
+inline PageAllocationAligned CopiedSpace::allocateOversizePages(size_t blockSize)
+{
+    size_t pages = blockSize / s_pageSize;
+    if (pages <= s_maxCachedOversizePages && !m_oversizeBlockCache[pages].isEmpty()) {
+        HeapBlock* block = m_oversizeBlockCache[pages].removeHead();
+        return block->m_allocation;
+    }
+
+    PageAllocationAligned allocation = PageAllocationAligned::allocate(blockSize, s_pageSize, OSAllocator::JSGCHeapPages);
+    if (static_cast<bool>(allocation))
+        m_totalMemoryAllocated += blockSize;
+    return allocation;
+}
+
+inline void CopiedSpace::freeOversizeBlock(CopiedBlock* block)
+{
+    size_t blockSize = block->m_allocation.size();
+    size_t pages = blockSize / s_pageSize;
+    m_oversizeBlockTree.remove(block);
+
+    if (pages <= s_maxCachedOversizePages) {
+        m_oversizeBlockCache[pages].push(block);
+        return;
+    }
+
+    m_totalMemoryAllocated -= blockSize;
+    block->m_allocation.deallocate();
+}
+
+inline void CopiedSpace::releaseOversizeBlockCache()
+{
+    for (size_t i = 0; i < m_oversizeBlockCache.size(); ++i) {
+        while (!m_oversizeBlockCache[i].isEmpty()) {
+            HeapBlock* block = m_oversizeBlockCache[i].removeHead();
+            m_totalMemoryAllocated -= block->m_allocation.size();
+            block->m_allocation.deallocate();
+        }
+    }
+}
+
 inline void* CopiedSpace::allocateFromBlock(CopiedBlock* block, size_t bytes)
 {
     ASSERT(!isOversize(bytes));
@@ -365,11 +434,10 @@ inline CheckedBoolean CopiedSpace::tryReallocateOversize(void** ptr, size_t oldS
     if (isOversize(oldSize)) {
         CopiedBlock* oldBlock = oversizeBlockFor(oldPtr);
         m_oversizeBlocks.remove(oldBlock);
-        oldBlock->m_allocation.deallocate();
-        m_totalMemoryAllocated -= oldSize + sizeof(CopiedBlock);
-    }
-    
-    m_totalMemoryUtilized -= oldSize;
+        m_totalMemoryUtilized -= oldBlock->m_allocation.size() - sizeof(CopiedBlock);
+        freeOversizeBlock(oldBlock);
+    } else
+        m_totalMemoryUtilized -= oldSize;
 
     *ptr = newPtr;
     return true;
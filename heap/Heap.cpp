@@ -25,6 +25,7 @@
 #include "CopiedSpaceInlineMethods.h"
 #include "CodeBlock.h"
 #include "ConservativeRoots.h"
+#include "DFGWorklist.h"
 #include "GCActivityCallback.h"
 #include "HeapRootVisitor.h"
 #include "Interpreter.h"
@@ -32,6 +33,7 @@
 #include "JSGlobalObject.h"
 #include "JSLock.h"
 #include "JSONObject.h"
+#include "SamplingProfiler.h"
 #include "Tracing.h"
 #include <algorithm>
 #include <wtf/CurrentTime.h>
@@ -213,15 +215,6 @@ inline void ClearMarks::operator()(MarkedBlock* block)
     block->clearMarks();
 }
 
-struct Sweep : MarkedBlock::VoidFunctor {
-    void operator()(MarkedBlock*);
-};
-
-inline void Sweep::operator()(MarkedBlock* block)
-{
-    block->sweep();
-}
-
 struct MarkCount : CountFunctor {
     void operator()(MarkedBlock*);
 };
@@ -313,6 +306,11 @@ Heap::Heap(JSGlobalData* globalData, HeapSize heapSize)
     : m_heapSize(heapSize)
     , m_minBytesPerCycle(heapSizeForHint(heapSize))
     , m_lastFullGCSize(0)
+#if ENABLE(GGC)
+    , m_lastFullVisitCount(0)
+    , m_storageSizeAfterLastCopy(0)
+    , m_incrementalMarkingStepSize(0)
+#endif
     , m_waterMark(0)
     , m_highWaterMark(m_minBytesPerCycle)
     , m_operationInProgress(NoOperation)
@@ -369,6 +367,17 @@ void Heap::destroy()
     m_globalData->jitStubs->clearHostFunctionStubs();
 #endif
 
+#if ENABLE(DFG_JIT)
+    if (m_globalData->dfgWorklist)
+        m_globalData->dfgWorklist->cancelAllPlans();
+#endif
+
+#if ENABLE(GGC)
+    // Nothing may be left waiting to be visited when the heap goes away.
+    if (m_objectSpace.isMarkingIncrementally())
+        collect(DoNotSweep);
+#endif
+
     delete m_markListSet;
     m_markListSet = 0;
 
@@ -568,7 +577,6 @@ void Heap::markRoots(bool fullGC)
     SamplingRegion samplingRegion("Garbage Collection: Tracing");
 
     COND_GCPHASE(fullGC, MarkFullRoots, MarkYoungRoots);
-    UNUSED_PARAM(fullGC);
     ASSERT(isValidThreadState(m_globalData));
     if (m_operationInProgress != NoOperation)
         CRASH();
@@ -576,22 +584,43 @@ void Heap::markRoots(bool fullGC)
 
     void* dummy;
     
+    // Young collections leave storage where it is, since old objects are not
+    // revisited to have their storage pointers updated. So there is nothing to
+    // pin either.
+    CopiedSpace* copiedSpace = fullGC ? &m_storageSpace : 0;
+
     // We gather conservative roots before clearing mark bits because conservative
     // gathering uses the mark bits to determine whether a reference is valid.
-    ConservativeRoots machineThreadRoots(&m_objectSpace.blocks(), &m_storageSpace);
+    ConservativeRoots machineThreadRoots(&m_objectSpace.blocks(), copiedSpace);
     {
         GCPHASE(GatherConservativeRoots);
         m_machineThreads.gatherConservativeRoots(machineThreadRoots, &dummy);
     }
 
-    ConservativeRoots registerFileRoots(&m_objectSpace.blocks(), &m_storageSpace);
-    m_dfgCodeBlocks.clearMarks();
+#if ENABLE(GGC)
+    // Finishing incremental marking is a young collection on top of the cells
+    // that have been marked so far.
+    bool finishingIncrementalMarking = m_objectSpace.isMarkingIncrementally();
+    ASSERT(!finishingIncrementalMarking || !fullGC);
+#else
+    bool finishingIncrementalMarking = false;
+#endif
+
+    ConservativeRoots registerFileRoots(&m_objectSpace.blocks(), copiedSpace);
+    if (!finishingIncrementalMarking)
+        m_dfgCodeBlocks.clearMarks();
     {
         GCPHASE(GatherRegisterFileRoots);
         registerFile().gatherConservativeRoots(registerFileRoots, m_dfgCodeBlocks);
     }
 #if ENABLE(GGC)
     MarkedBlock::DirtyCellVector dirtyCells;
+    if (finishingIncrementalMarking) {
+        // The write barrier ignores stores into cells that have not been marked,
+        // so cells allocated during marking are all treated as dirty.
+        GCPHASE(GatheringCellsAllocatedDuringMarking);
+        m_objectSpace.gatherCellsAllocatedDuringMarking(dirtyCells);
+    }
     if (!fullGC) {
         GCPHASE(GatheringDirtyCells);
         m_objectSpace.gatherDirtyCells(dirtyCells);
@@ -602,7 +631,8 @@ void Heap::markRoots(bool fullGC)
         clearMarks();
     }
 
-    m_storageSpace.startedCopying();
+    if (fullGC)
+        m_storageSpace.startedCopying();
     SlotVisitor& visitor = m_slotVisitor;
     HeapRootVisitor heapRootVisitor(visitor);
 
@@ -614,7 +644,7 @@ void Heap::markRoots(bool fullGC)
             GCPHASE(VisitDirtyCells);
             GCCOUNTER(DirtyCellCount, dirtyCellCount);
             for (size_t i = 0; i < dirtyCellCount; i++) {
-                heapRootVisitor.visitChildren(dirtyCells[i]);
+                dirtyCells[i]->methodTable()->visitChildren(dirtyCells[i], visitor);
                 visitor.donateAndDrain();
             }
         }
@@ -677,6 +707,14 @@ void Heap::markRoots(bool fullGC)
             m_dfgCodeBlocks.traceMarkedCodeBlocks(visitor);
             visitor.donateAndDrain();
         }
+
+#if ENABLE(DFG_JIT)
+        if (m_globalData->dfgWorklist) {
+            GCPHASE(VisitDFGWorklist);
+            m_globalData->dfgWorklist->visitChildren(visitor);
+            visitor.donateAndDrain();
+        }
+#endif
     
 #if ENABLE(PARALLEL_GC)
         {
@@ -705,11 +743,16 @@ void Heap::markRoots(bool fullGC)
         }
     }
     GCCOUNTER(VisitedValueCount, visitor.visitCount());
+#if ENABLE(GGC)
+    if (fullGC || finishingIncrementalMarking)
+        m_lastFullVisitCount = visitor.visitCount();
+#endif
 
     visitor.doneCopying();
     visitor.reset();
     m_sharedData.reset();
-    m_storageSpace.doneCopying();
+    if (fullGC)
+        m_storageSpace.doneCopying();
 
     m_operationInProgress = NoOperation;
 }
@@ -719,11 +762,6 @@ void Heap::clearMarks()
     m_objectSpace.forEachBlock<ClearMarks>();
 }
 
-void Heap::sweep()
-{
-    m_objectSpace.forEachBlock<Sweep>();
-}
-
 size_t Heap::objectCount()
 {
     return m_objectSpace.forEachBlock<MarkCount>();
@@ -781,19 +819,46 @@ void Heap::collect(SweepToggle sweepToggle)
     GCPHASE(Collect);
     ASSERT(globalData()->identifierTable == wtfThreadData().currentIdentifierTable());
     ASSERT(m_isSafeToCollect);
-    JAVASCRIPTCORE_GC_BEGIN();
 #if ENABLE(GGC)
+    // A collection that sweeps has to copy and mark from scratch, so it finishes
+    // any incremental marking first.
+    if (sweepToggle == DoSweep && m_objectSpace.isMarkingIncrementally())
+        collect(DoNotSweep);
+    bool finishingIncrementalMarking = m_objectSpace.isMarkingIncrementally();
+
+    // Old objects and storage are only reclaimed by full collections, so do one
+    // whenever what survived young collections outgrows the last full one's budget.
     bool fullGC = sweepToggle == DoSweep;
-    if (!fullGC)
-        fullGC = (capacity() > 4 * m_lastFullGCSize);  
+    if (!fullGC && !finishingIncrementalMarking)
+        fullGC = size() + m_storageSpace.totalMemoryUtilized() > highWaterMark();
+
+    if (fullGC && sweepToggle == DoNotSweep && shouldMarkIncrementally()) {
+        startIncrementalMarking();
+        return;
+    }
 #else
+    bool finishingIncrementalMarking = false;
     bool fullGC = true;
 #endif
+    JAVASCRIPTCORE_GC_BEGIN();
+#if ENABLE(DFG_JIT)
+    // The compiler threads must not touch the heap while we are collecting.
+    if (m_globalData->dfgWorklist)
+        m_globalData->dfgWorklist->suspendAllThreads();
+#endif
+
     {
         GCPHASE(Canonicalize);
         canonicalizeCellLivenessData();
     }
 
+#if ENABLE(SAMPLING_PROFILER)
+    // Samples refer to executables by address, so name them while nothing has
+    // been swept yet.
+    if (m_globalData->samplingProfiler)
+        m_globalData->samplingProfiler->processSamples();
+#endif
+
     markRoots(fullGC);
     
     {
@@ -820,27 +885,129 @@ void Heap::collect(SweepToggle sweepToggle)
     }
 
     if (sweepToggle == DoSweep) {
-        SamplingRegion samplingRegion("Garbage Collection: Sweeping");
-        GCPHASE(Sweeping);
-        sweep();
+        GCPHASE(Shrinking);
         shrink();
     }
 
+    {
+        GCPHASE(StartSweeping);
+        m_objectSpace.startSweeping();
+    }
+
+#if ENABLE(DFG_JIT)
+    if (m_globalData->dfgWorklist)
+        m_globalData->dfgWorklist->resumeAllThreads();
+#endif
+
     // To avoid pathological GC churn in large heaps, we set the allocation high
     // water mark to be proportional to the current size of the heap. The exact
     // proportion is a bit arbitrary. A 2X multiplier gives a 1:1 (heap size :
     // new bytes allocated) proportion, and seems to work well in benchmarks.
     size_t newSize = size() + m_storageSpace.totalMemoryUtilized();
     size_t proportionalBytes = 2 * newSize;
-    if (fullGC) {
+    if (fullGC || finishingIncrementalMarking) {
         m_lastFullGCSize = newSize;
         setHighWaterMark(max(proportionalBytes, m_minBytesPerCycle));
     }
+#if ENABLE(GGC)
+    if (fullGC)
+        m_storageSizeAfterLastCopy = m_storageSpace.totalMemoryUtilized();
+#endif
     JAVASCRIPTCORE_GC_END();
 
     (*m_activityCallback)();
 }
 
+#if ENABLE(GGC)
+bool Heap::shouldMarkIncrementally()
+{
+    if (!Options::minimumIncrementalMarkingStepSize)
+        return false;
+
+    // Storage is only compacted by collections that stop the world, so have one
+    // of those once storage has grown well past what the last one left behind.
+    return m_storageSpace.totalMemoryUtilized() <= 2 * m_storageSizeAfterLastCopy + m_minBytesPerCycle;
+}
+
+void Heap::startIncrementalMarking()
+{
+    GCPHASE(StartIncrementalMarking);
+    ASSERT(m_operationInProgress == NoOperation);
+
+#if ENABLE(DFG_JIT)
+    // Like a collection, each step of marking touches the heap, so the compiler
+    // threads must not run while it does.
+    if (m_globalData->dfgWorklist)
+        m_globalData->dfgWorklist->suspendAllThreads();
+#endif
+
+    canonicalizeCellLivenessData();
+
+    m_operationInProgress = Collection;
+
+    void* dummy;
+    ConservativeRoots machineThreadRoots(&m_objectSpace.blocks(), 0);
+    m_machineThreads.gatherConservativeRoots(machineThreadRoots, &dummy);
+    ConservativeRoots registerFileRoots(&m_objectSpace.blocks(), 0);
+    m_dfgCodeBlocks.clearMarks();
+    registerFile().gatherConservativeRoots(registerFileRoots, m_dfgCodeBlocks);
+
+    m_extraCost = 0;
+    m_objectSpace.startIncrementalMarking();
+
+    // The roots are only pushed here. They are visited a step at a time, and
+    // visited again when marking finishes, since they may have changed by then.
+    SlotVisitor& visitor = m_slotVisitor;
+    HeapRootVisitor heapRootVisitor(visitor);
+    {
+        ParallelModeEnabler enabler(visitor);
+        visitor.append(machineThreadRoots);
+        visitor.append(registerFileRoots);
+        markProtectedObjects(heapRootVisitor);
+        m_handleHeap.visitStrongHandles(heapRootVisitor);
+        m_handleStack.visit(heapRootVisitor);
+    }
+
+    // Pace the steps so that marking as much as the last full collection found
+    // takes about half of the allocation budget before marking has to finish.
+    size_t stepSize = m_lastFullVisitCount * 2 * MarkedBlock::blockSize / m_minBytesPerCycle;
+    m_incrementalMarkingStepSize = max<size_t>(stepSize, Options::minimumIncrementalMarkingStepSize);
+
+    m_operationInProgress = NoOperation;
+
+#if ENABLE(DFG_JIT)
+    if (m_globalData->dfgWorklist)
+        m_globalData->dfgWorklist->resumeAllThreads();
+#endif
+}
+
+void Heap::markIncrementally()
+{
+    ASSERT(m_objectSpace.isMarkingIncrementally());
+    ASSERT(m_operationInProgress == NoOperation);
+
+#if ENABLE(DFG_JIT)
+    if (m_globalData->dfgWorklist)
+        m_globalData->dfgWorklist->suspendAllThreads();
+#endif
+
+    m_operationInProgress = Collection;
+    {
+        ParallelModeEnabler enabler(m_slotVisitor);
+        m_slotVisitor.drainSome(m_incrementalMarkingStepSize);
+    }
+    m_operationInProgress = NoOperation;
+
+#if ENABLE(DFG_JIT)
+    if (m_globalData->dfgWorklist)
+        m_globalData->dfgWorklist->resumeAllThreads();
+#endif
+
+    if (m_slotVisitor.isEmpty())
+        collect(DoNotSweep);
+}
+#endif
+
 void Heap::canonicalizeCellLivenessData()
 {
     m_objectSpace.canonicalizeCellLivenessData();
@@ -884,6 +1051,7 @@ void Heap::freeBlocks(MarkedBlock* head)
 void Heap::shrink()
 {
     m_objectSpace.shrink();
+    m_storageSpace.releaseOversizeBlockCache();
 }
 
 void Heap::releaseFreeBlocks()
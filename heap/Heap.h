@@ -178,9 +178,13 @@ namespace JSC {
         
         enum SweepToggle { DoNotSweep, DoSweep };
         void collect(SweepToggle);
+#if ENABLE(GGC)
+        bool shouldMarkIncrementally();
+        void startIncrementalMarking();
+        void markIncrementally();
+#endif
         void shrink();
         void releaseFreeBlocks();
-        void sweep();
 
         RegisterFile& registerFile();
 
@@ -192,6 +196,11 @@ namespace JSC {
         const HeapSize m_heapSize;
         const size_t m_minBytesPerCycle;
         size_t m_lastFullGCSize;
+#if ENABLE(GGC)
+        size_t m_lastFullVisitCount;
+        size_t m_storageSizeAfterLastCopy;
+        size_t m_incrementalMarkingStepSize;
+#endif
         size_t m_waterMark;
         size_t m_highWaterMark;
         
@@ -362,6 +362,24 @@ void SlotVisitor::drain()
     }
 }
 
+void SlotVisitor::drainSome(size_t budget)
+{
+    ASSERT(m_isInParallelMode);
+
+    size_t countdown = budget;
+    while (!m_stack.isEmpty() && countdown) {
+        m_stack.refill();
+        while (m_stack.canRemoveLast() && countdown) {
+            visitChildren(*this, m_stack.removeLast());
+            countdown--;
+        }
+    }
+
+#if ENABLE(PARALLEL_GC)
+    mergeOpaqueRootsIfNecessary();
+#endif
+}
+
 void SlotVisitor::drainFromShared(SharedDrainMode sharedDrainMode)
 {
     ASSERT(m_isInParallelMode);
@@ -465,6 +483,10 @@ void SlotVisitor::startCopying()
 
 void* SlotVisitor::allocateNewSpace(void* ptr, size_t bytes)
 {
+    // Young collections do not copy.
+    if (!m_shared.m_copiedSpace->isInCopyPhase())
+        return 0;
+
     if (CopiedSpace::isOversize(bytes)) {
         m_shared.m_copiedSpace->pin(CopiedSpace::oversizeBlockFor(ptr));
         return 0;
@@ -41,6 +41,20 @@ void* MarkedAllocator::allocateSlowCase()
     ASSERT(m_heap->m_operationInProgress == NoOperation);
 #endif
     
+    // Every trip through here also pays for sweeping a block left over from
+    // the last collection, so collections do not have to sweep the heap, or
+    // for a step of an incremental full collection while one is in progress.
+#if ENABLE(GGC)
+    if (m_markedSpace->isMarkingIncrementally())
+        m_heap->markIncrementally();
+    else
+#endif
+    {
+        m_heap->m_operationInProgress = Allocation;
+        m_markedSpace->sweepSomeBlocks();
+        m_heap->m_operationInProgress = NoOperation;
+    }
+
     void* result = tryAllocate();
     
     if (LIKELY(result != 0))
@@ -50,7 +64,7 @@ void* MarkedAllocator::allocateSlowCase()
     
     if ((
 #if ENABLE(GGC)
-         nurseryWaterMark() < m_heap->m_minBytesPerCycle
+         m_markedSpace->nurseryWaterMark() < m_heap->m_minBytesPerCycle
 #else
          m_heap->waterMark() < m_heap->highWaterMark()
 #endif
@@ -20,6 +20,7 @@ class MarkedAllocator {
 public:
     MarkedAllocator();
     void reset();
+    void skipExistingBlocks();
     void zapFreeList();
     size_t cellSize() { return m_cellSize; }
     bool cellsNeedDestruction() { return m_cellsNeedDestruction; }
@@ -81,6 +82,12 @@ inline void MarkedAllocator::reset()
     m_currentBlock = static_cast<MarkedBlock*>(m_blockList.head());
 }
 
+inline void MarkedAllocator::skipExistingBlocks()
+{
+    // Only allocate from blocks added after this point.
+    m_currentBlock = 0;
+}
+
 inline void MarkedAllocator::zapFreeList()
 {
     if (!m_currentBlock) {
@@ -142,12 +142,31 @@ MarkedBlock::FreeCell* MarkedBlock::sweepHelper(SweepMode sweepMode)
         return sweepMode == SweepToFreeList
             ? specializedSweep<Zapped, SweepToFreeList, destructorCallNeeded>()
             : specializedSweep<Zapped, SweepOnly, destructorCallNeeded>();
+    case Snapshotted:
+        // Nothing may be swept until incremental marking is done.
+        ASSERT_NOT_REACHED();
+        return 0;
     }
 
     ASSERT_NOT_REACHED();
     return 0;
 }
 
+#if ENABLE(GGC)
+void MarkedBlock::markLiveCells(DirtyCellVector& cells)
+{
+    HEAP_LOG_BLOCK_STATE_TRANSITION(this);
+
+    for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
+        JSCell* cell = reinterpret_cast_ptr<JSCell*>(&atoms()[i]);
+        if (!isLive(cell))
+            continue;
+        m_marks.set(i);
+        cells.append(cell);
+    }
+}
+#endif
+
 void MarkedBlock::zapFreeList(FreeCell* firstFreeCell)
 {
     HEAP_LOG_BLOCK_STATE_TRANSITION(this);
@@ -114,6 +114,10 @@ namespace JSC {
         void zapFreeList(FreeCell* firstFreeCell); // Call this to undo the free list.
 
         void clearMarks();
+#if ENABLE(GGC)
+        void clearMarksForIncrementalMarking();
+#endif
+        bool needsSweeping();
         size_t markCount();
         bool markCountIsZero(); // Faster than markCount().
 
@@ -155,6 +159,7 @@ namespace JSC {
         typedef Vector<JSCell*, 32> DirtyCellVector;
         inline void gatherDirtyCells(DirtyCellVector&);
         template <int size> inline void gatherDirtyCellsWithSize(DirtyCellVector&);
+        void markLiveCells(DirtyCellVector&);
 #endif
 
         template <typename Functor> void forEachCell(Functor&);
@@ -162,7 +167,10 @@ namespace JSC {
     private:
         static const size_t atomAlignmentMask = atomSize - 1; // atomSize must be a power of two.
 
-        enum BlockState { New, FreeListed, Allocated, Marked, Zapped };
+        // A block is Snapshotted while incremental marking is in progress if it
+        // was Marked when marking started. Its old mark bits are kept in
+        // m_liveSnapshot, since the new ones only cover the cells visited so far.
+        enum BlockState { New, FreeListed, Allocated, Marked, Zapped, Snapshotted };
         template<bool destructorCallNeeded> FreeCell* sweepHelper(SweepMode = SweepOnly);
 
         typedef char Atom[atomSize];
@@ -181,8 +189,14 @@ namespace JSC {
         size_t m_endAtom; // This is a fuzzy end. Always test for < m_endAtom.
 #if ENABLE(PARALLEL_GC)
         WTF::Bitmap<atomsPerBlock, WTF::BitmapAtomic> m_marks;
+#if ENABLE(GGC)
+        WTF::Bitmap<atomsPerBlock, WTF::BitmapAtomic> m_liveSnapshot;
+#endif
 #else
         WTF::Bitmap<atomsPerBlock, WTF::BitmapNotAtomic> m_marks;
+#if ENABLE(GGC)
+        WTF::Bitmap<atomsPerBlock, WTF::BitmapNotAtomic> m_liveSnapshot;
+#endif
 #endif
         bool m_cellsNeedDestruction;
         BlockState m_state;
@@ -234,6 +248,28 @@ namespace JSC {
         m_state = Marked;
     }
 
+#if ENABLE(GGC)
+    inline void MarkedBlock::clearMarksForIncrementalMarking()
+    {
+        HEAP_LOG_BLOCK_STATE_TRANSITION(this);
+
+        ASSERT(m_state != New && m_state != FreeListed);
+
+        // Allocated and Zapped blocks can still tell live cells from dead ones
+        // without their mark bits. Marked blocks need a copy.
+        if (m_state == Marked) {
+            m_liveSnapshot = m_marks;
+            m_state = Snapshotted;
+        }
+        m_marks.clearAll();
+    }
+#endif
+
+    inline bool MarkedBlock::needsSweeping()
+    {
+        return m_state == Marked;
+    }
+
     inline size_t MarkedBlock::markCount()
     {
         return m_marks.count();
@@ -301,6 +337,10 @@ namespace JSC {
             return true;
         case Marked:
             return m_marks.get(atomNumber(cell));
+#if ENABLE(GGC)
+        case Snapshotted:
+            return m_liveSnapshot.get(atomNumber(cell));
+#endif
 
         case New:
         case FreeListed:
@@ -34,6 +34,9 @@ MarkedSpace::MarkedSpace(Heap* heap)
     : m_waterMark(0)
     , m_nurseryWaterMark(0)
     , m_heap(heap)
+#if ENABLE(GGC)
+    , m_isMarkingIncrementally(false)
+#endif
 {
     for (size_t cellSize = preciseStep; cellSize <= preciseCutoff; cellSize += preciseStep) {
         allocatorFor(cellSize).init(heap, this, cellSize, false);
@@ -124,11 +127,58 @@ inline TakeIfUnmarked::ReturnType TakeIfUnmarked::returnValue()
 
 void MarkedSpace::shrink()
 {
+    // Blocks waiting to be swept may be about to be freed. The allocators will
+    // get to whatever survives.
+    m_blocksToSweep.clear();
+
     // We record a temporary list of empties to avoid modifying m_blocks while iterating it.
     TakeIfUnmarked takeIfUnmarked(this);
     freeBlocks(forEachBlock(takeIfUnmarked));
 }
 
+class GatherBlocksToSweep : public MarkedBlock::VoidFunctor {
+public:
+    GatherBlocksToSweep(Vector<MarkedBlock*>&);
+    void operator()(MarkedBlock*);
+
+private:
+    Vector<MarkedBlock*>& m_blocksToSweep;
+};
+
+inline GatherBlocksToSweep::GatherBlocksToSweep(Vector<MarkedBlock*>& blocksToSweep)
+    : m_blocksToSweep(blocksToSweep)
+{
+}
+
+inline void GatherBlocksToSweep::operator()(MarkedBlock* block)
+{
+    // Sweeping a block of cells without destructors only builds a free list,
+    // which the allocator does when it gets to the block.
+    if (block->cellsNeedDestruction())
+        m_blocksToSweep.append(block);
+}
+
+void MarkedSpace::startSweeping()
+{
+    m_blocksToSweep.clear();
+    GatherBlocksToSweep gatherBlocksToSweep(m_blocksToSweep);
+    forEachBlock(gatherBlocksToSweep);
+}
+
+void MarkedSpace::sweepSomeBlocks()
+{
+    // Sweep one block that nobody has swept since the last collection, so that
+    // the dead cells in it are destroyed even if no allocator needs it soon.
+    while (!m_blocksToSweep.isEmpty()) {
+        MarkedBlock* block = m_blocksToSweep.last();
+        m_blocksToSweep.removeLast();
+        if (!block->needsSweeping())
+            continue;
+        block->sweep();
+        return;
+    }
+}
+
 #if ENABLE(GGC)
 class GatherDirtyCells {
     WTF_MAKE_NONCOPYABLE(GatherDirtyCells);
@@ -158,6 +208,47 @@ void MarkedSpace::gatherDirtyCells(MarkedBlock::DirtyCellVector& dirtyCells)
     GatherDirtyCells gatherDirtyCells(&dirtyCells);
     forEachBlock(gatherDirtyCells);
 }
+
+class ClearMarksForIncrementalMarking : public MarkedBlock::VoidFunctor {
+public:
+    void operator()(MarkedBlock* block) { block->clearMarksForIncrementalMarking(); }
+};
+
+void MarkedSpace::startIncrementalMarking()
+{
+    ASSERT(!m_isMarkingIncrementally);
+
+    // Until marking is done, sweeping a block that existed when it started
+    // would free live cells that have not been visited yet.
+    m_blocksToSweep.clear();
+    forEachBlock<ClearMarksForIncrementalMarking>();
+
+    resetAllocators();
+    for (size_t cellSize = preciseStep; cellSize <= preciseCutoff; cellSize += preciseStep) {
+        allocatorFor(cellSize).skipExistingBlocks();
+        destructorAllocatorFor(cellSize).skipExistingBlocks();
+    }
+
+    for (size_t cellSize = impreciseStep; cellSize <= impreciseCutoff; cellSize += impreciseStep) {
+        allocatorFor(cellSize).skipExistingBlocks();
+        destructorAllocatorFor(cellSize).skipExistingBlocks();
+    }
+
+    m_isMarkingIncrementally = true;
+}
+
+void MarkedSpace::gatherCellsAllocatedDuringMarking(MarkedBlock::DirtyCellVector& cells)
+{
+    ASSERT(m_isMarkingIncrementally);
+
+    // Nothing told the collector about stores into these cells, so they are all
+    // treated as live and visited again.
+    for (size_t i = 0; i < m_blocksAllocatedDuringMarking.size(); ++i)
+        m_blocksAllocatedDuringMarking[i]->markLiveCells(cells);
+    m_blocksAllocatedDuringMarking.clear();
+
+    m_isMarkingIncrementally = false;
+}
 #endif
 
 } // namespace JSC
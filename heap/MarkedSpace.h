@@ -63,6 +63,14 @@ public:
     
     void canonicalizeCellLivenessData();
 
+#if ENABLE(GGC)
+    void gatherDirtyCells(MarkedBlock::DirtyCellVector&);
+
+    void startIncrementalMarking();
+    bool isMarkingIncrementally() { return m_isMarkingIncrementally; }
+    void gatherCellsAllocatedDuringMarking(MarkedBlock::DirtyCellVector&);
+#endif
+
     size_t waterMark();
     size_t nurseryWaterMark();
 
@@ -75,6 +83,8 @@ public:
     
     void shrink();
     void freeBlocks(MarkedBlock* head);
+    void startSweeping();
+    void sweepSomeBlocks();
     void didAddBlock(MarkedBlock*);
     void didConsumeFreeList(MarkedBlock*);
 
@@ -101,6 +111,11 @@ private:
     size_t m_nurseryWaterMark;
     Heap* m_heap;
     MarkedBlockSet m_blocks;
+    Vector<MarkedBlock*> m_blocksToSweep;
+#if ENABLE(GGC)
+    bool m_isMarkingIncrementally;
+    Vector<MarkedBlock*> m_blocksAllocatedDuringMarking;
+#endif
 };
 
 inline size_t MarkedSpace::waterMark()
@@ -186,6 +201,10 @@ template <typename Functor> inline typename Functor::ReturnType MarkedSpace::for
 inline void MarkedSpace::didAddBlock(MarkedBlock* block)
 {
     m_blocks.add(block);
+#if ENABLE(GGC)
+    if (m_isMarkingIncrementally)
+        m_blocksAllocatedDuringMarking.append(block);
+#endif
 }
 
 inline void MarkedSpace::didConsumeFreeList(MarkedBlock* block)
@@ -48,6 +48,7 @@ public:
     }
     
     void drain();
+    void drainSome(size_t budget); // Visits at most about budget cells, on this thread only.
     
     void donateAndDrain()
     {
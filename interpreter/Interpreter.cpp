@@ -100,7 +100,7 @@ NEVER_INLINE bool Interpreter::resolve(CallFrame* callFrame, Instruction* vPC, J
     ASSERT(iter != end);
 
     CodeBlock* codeBlock = callFrame->codeBlock();
-    Identifier& ident = codeBlock->identifier(property);
+    const Identifier& ident = codeBlock->identifier(property);
     do {
         JSObject* o = iter->get();
         PropertySlot slot(o);
@@ -139,7 +139,7 @@ NEVER_INLINE bool Interpreter::resolveSkip(CallFrame* callFrame, Instruction* vP
         ++iter;
         ASSERT(iter != end);
     }
-    Identifier& ident = codeBlock->identifier(property);
+    const Identifier& ident = codeBlock->identifier(property);
     do {
         JSObject* o = iter->get();
         PropertySlot slot(o);
@@ -172,7 +172,7 @@ NEVER_INLINE bool Interpreter::resolveGlobal(CallFrame* callFrame, Instruction*
         return true;
     }
 
-    Identifier& ident = codeBlock->identifier(property);
+    const Identifier& ident = codeBlock->identifier(property);
     PropertySlot slot(globalObject);
     if (globalObject->getPropertySlot(callFrame, ident, slot)) {
         JSValue result = slot.getValue(callFrame, ident);
@@ -218,7 +218,7 @@ NEVER_INLINE bool Interpreter::resolveGlobalDynamic(CallFrame* callFrame, Instru
     while (skip--) {
         JSObject* o = iter->get();
         if (o->hasCustomProperties()) {
-            Identifier& ident = codeBlock->identifier(property);
+            const Identifier& ident = codeBlock->identifier(property);
             do {
                 PropertySlot slot(o);
                 if (o->getPropertySlot(callFrame, ident, slot)) {
@@ -247,7 +247,7 @@ NEVER_INLINE bool Interpreter::resolveGlobalDynamic(CallFrame* callFrame, Instru
         return true;
     }
 
-    Identifier& ident = codeBlock->identifier(property);
+    const Identifier& ident = codeBlock->identifier(property);
     PropertySlot slot(globalObject);
     if (globalObject->getPropertySlot(callFrame, ident, slot)) {
         JSValue result = slot.getValue(callFrame, ident);
@@ -300,7 +300,7 @@ NEVER_INLINE bool Interpreter::resolveBaseAndProperty(CallFrame* callFrame, Inst
     ASSERT(iter != end);
 
     CodeBlock* codeBlock = callFrame->codeBlock();
-    Identifier& ident = codeBlock->identifier(property);
+    const Identifier& ident = codeBlock->identifier(property);
     JSObject* base;
     do {
         base = iter->get();
@@ -336,7 +336,7 @@ NEVER_INLINE bool Interpreter::resolveThisAndProperty(CallFrame* callFrame, Inst
     ASSERT(iter != end);
 
     CodeBlock* codeBlock = callFrame->codeBlock();
-    Identifier& ident = codeBlock->identifier(property);
+    const Identifier& ident = codeBlock->identifier(property);
     JSObject* base;
     do {
         base = iter->get();
@@ -1442,7 +1442,7 @@ NEVER_INLINE ScopeChainNode* Interpreter::createExceptionScope(CallFrame* callFr
 {
     int dst = vPC[1].u.operand;
     CodeBlock* codeBlock = callFrame->codeBlock();
-    Identifier& property = codeBlock->identifier(vPC[2].u.operand);
+    const Identifier& property = codeBlock->identifier(vPC[2].u.operand);
     JSValue value = callFrame->r(vPC[3].u.operand).jsValue();
     JSObject* scope = JSStaticScopeObject::create(callFrame, property, value, DontDelete);
     callFrame->uncheckedR(dst) = JSValue(scope);
@@ -2762,7 +2762,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
          */
         int base = vPC[1].u.operand;
         int property = vPC[2].u.operand;
-        Identifier& ident = codeBlock->identifier(property);
+        const Identifier& ident = codeBlock->identifier(property);
         
         JSValue baseVal = callFrame->r(base).jsValue();
         JSObject* baseObject = asObject(baseVal);
@@ -2819,7 +2819,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         int base = vPC[2].u.operand;
         int property = vPC[3].u.operand;
 
-        Identifier& ident = codeBlock->identifier(property);
+        const Identifier& ident = codeBlock->identifier(property);
         JSValue baseValue = callFrame->r(base).jsValue();
         PropertySlot slot(baseValue);
         JSValue result = baseValue.get(callFrame, ident, slot);
@@ -2968,7 +2968,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
                 if (LIKELY(protoObject->structure() == prototypeStructure)) {
                     int dst = vPC[1].u.operand;
                     int property = vPC[3].u.operand;
-                    Identifier& ident = codeBlock->identifier(property);
+                    const Identifier& ident = codeBlock->identifier(property);
                     
                     PropertySlot::GetValueFunc getter = vPC[6].u.getterFunc;
                     JSValue result = getter(callFrame, protoObject, ident);
@@ -3099,7 +3099,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
                 ASSERT(baseCell->isObject());
                 int dst = vPC[1].u.operand;
                 int property = vPC[3].u.operand;
-                Identifier& ident = codeBlock->identifier(property);
+                const Identifier& ident = codeBlock->identifier(property);
 
                 PropertySlot::GetValueFunc getter = vPC[5].u.getterFunc;
                 JSValue result = getter(callFrame, baseValue, ident);
@@ -3125,7 +3125,7 @@ skip_id_custom_self:
         int base = vPC[2].u.operand;
         int property = vPC[3].u.operand;
 
-        Identifier& ident = codeBlock->identifier(property);
+        const Identifier& ident = codeBlock->identifier(property);
         JSValue baseValue = callFrame->r(base).jsValue();
         PropertySlot slot(baseValue);
         JSValue result = baseValue.get(callFrame, ident, slot);
@@ -3221,7 +3221,7 @@ skip_id_custom_self:
                     if (++it == end) {
                         int dst = vPC[1].u.operand;
                         int property = vPC[3].u.operand;
-                        Identifier& ident = codeBlock->identifier(property);
+                        const Identifier& ident = codeBlock->identifier(property);
                         
                         PropertySlot::GetValueFunc getter = vPC[7].u.getterFunc;
                         JSValue result = getter(callFrame, baseObject, ident);
@@ -3310,7 +3310,7 @@ skip_id_custom_self:
         int direct = vPC[8].u.operand;
 
         JSValue baseValue = callFrame->r(base).jsValue();
-        Identifier& ident = codeBlock->identifier(property);
+        const Identifier& ident = codeBlock->identifier(property);
         PutPropertySlot slot(codeBlock->isStrictMode());
         if (direct) {
             ASSERT(baseValue.isObject());
@@ -3429,7 +3429,7 @@ skip_id_custom_self:
         int direct = vPC[8].u.operand;
 
         JSValue baseValue = callFrame->r(base).jsValue();
-        Identifier& ident = codeBlock->identifier(property);
+        const Identifier& ident = codeBlock->identifier(property);
         PutPropertySlot slot(codeBlock->isStrictMode());
         if (direct) {
             ASSERT(baseValue.isObject());
@@ -3454,7 +3454,7 @@ skip_id_custom_self:
         int property = vPC[3].u.operand;
 
         JSObject* baseObj = callFrame->r(base).jsValue().toObject(callFrame);
-        Identifier& ident = codeBlock->identifier(property);
+        const Identifier& ident = codeBlock->identifier(property);
         bool result = baseObj->methodTable()->deleteProperty(baseObj, callFrame, ident);
         if (!result && codeBlock->isStrictMode()) {
             exceptionValue = createTypeError(callFrame, "Unable to delete property.");
@@ -3500,7 +3500,7 @@ skip_id_custom_self:
         int property = vPC[3].u.operand;
         JSValue arguments = callFrame->r(argumentsRegister).jsValue();
         if (arguments) {
-            Identifier& ident = codeBlock->identifier(property);
+            const Identifier& ident = codeBlock->identifier(property);
             PropertySlot slot(arguments);
             JSValue result = arguments.get(callFrame, ident, slot);
             CHECK_FOR_EXCEPTION();
@@ -4979,7 +4979,7 @@ skip_id_custom_self:
 
         ASSERT(callFrame->r(base).jsValue().isObject());
         JSObject* baseObj = asObject(callFrame->r(base).jsValue());
-        Identifier& ident = codeBlock->identifier(property);
+        const Identifier& ident = codeBlock->identifier(property);
 
         GetterSetter* accessor = GetterSetter::create(callFrame);
 
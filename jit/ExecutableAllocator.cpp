@@ -29,6 +29,7 @@
 
 #if ENABLE(EXECUTABLE_ALLOCATOR_DEMAND)
 #include "CodeProfiling.h"
+#include "PerfMap.h"
 #include <wtf/MetaAllocator.h>
 #include <wtf/PageReservation.h>
 #include <wtf/VMTags.h>
@@ -95,6 +96,7 @@ void ExecutableAllocator::initializeAllocator()
     ASSERT(!allocator);
     allocator = new DemandExecutableAllocator();
     CodeProfiling::notifyAllocator(allocator);
+    PerfMap::notifyAllocator(allocator);
 }
 
 ExecutableAllocator::ExecutableAllocator(JSGlobalData&)
@@ -112,6 +114,11 @@ bool ExecutableAllocator::underMemoryPressure()
     return false;
 }
 
+bool ExecutableAllocator::isValidExecutableMemory(void*)
+{
+    return false;
+}
+
 PassRefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(JSGlobalData&, size_t sizeInBytes, void* ownerUID)
 {
     RefPtr<ExecutableMemoryHandle> result = allocator->allocate(sizeInBytes, ownerUID);
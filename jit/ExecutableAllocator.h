@@ -106,6 +106,11 @@ public:
     bool isValid() const;
 
     static bool underMemoryPressure();
+
+    // Whether the address is in memory handed out for JIT code. This does not
+    // take any locks, so it may be called from a signal handler. Allocators that
+    // cannot answer that cheaply return false.
+    static bool isValidExecutableMemory(void*);
     
 #if ENABLE(META_ALLOCATOR_PROFILE)
     static void dumpProfile();
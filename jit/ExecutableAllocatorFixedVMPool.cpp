@@ -30,6 +30,7 @@
 #if ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
 
 #include "CodeProfiling.h"
+#include "PerfMap.h"
 #include <errno.h>
 #include <sys/mman.h>
 #include <unistd.h>
@@ -68,6 +69,12 @@ public:
             addFreshFreeSpace(m_reservation.base(), m_reservation.size());
         }
     }
+
+    bool contains(void* address) const
+    {
+        char* base = static_cast<char*>(m_reservation.base());
+        return address >= base && address < base + m_reservation.size();
+    }
     
 protected:
     virtual void* allocateNewSpace(size_t&)
@@ -97,6 +104,7 @@ void ExecutableAllocator::initializeAllocator()
     ASSERT(!allocator);
     allocator = new FixedVMPoolExecutableAllocator();
     CodeProfiling::notifyAllocator(allocator);
+    PerfMap::notifyAllocator(allocator);
 }
 
 ExecutableAllocator::ExecutableAllocator(JSGlobalData&)
@@ -115,6 +123,11 @@ bool ExecutableAllocator::underMemoryPressure()
     return statistics.bytesAllocated > statistics.bytesReserved / 2;
 }
 
+bool ExecutableAllocator::isValidExecutableMemory(void* address)
+{
+    return allocator->contains(address);
+}
+
 PassRefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(JSGlobalData& globalData, size_t sizeInBytes, void* ownerUID)
 {
     RefPtr<ExecutableMemoryHandle> result = allocator->allocate(sizeInBytes, ownerUID);
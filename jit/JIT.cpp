@@ -420,6 +420,8 @@ void JIT::privateCompileSlowCases()
 #ifndef NDEBUG
         unsigned firstTo = m_bytecodeOffset;
 #endif
+        if (UNLIKELY(PerfMap::wantsBytecodeLocations()))
+            m_slowCaseLabels.append(std::make_pair(label(), m_bytecodeOffset));
         Instruction* currentInstruction = instructionsBegin + m_bytecodeOffset;
         
 #if ENABLE(VALUE_PROFILER)
@@ -707,7 +709,17 @@ JITCode JIT::privateCompile(CodePtr* functionEntryArityCheck)
     if (m_codeBlock->codeType() == FunctionCode && functionEntryArityCheck)
         *functionEntryArityCheck = patchBuffer.locationOf(arityCheck);
     
-    CodeRef result = patchBuffer.finalizeCode();
+    Vector<PerfMap::BytecodeLocation> bytecodeLocations;
+    if (UNLIKELY(PerfMap::wantsBytecodeLocations())) {
+        for (unsigned bytecodeOffset = 0; bytecodeOffset < m_labels.size(); ++bytecodeOffset) {
+            if (m_labels[bytecodeOffset].isSet())
+                bytecodeLocations.append(PerfMap::BytecodeLocation(patchBuffer.offsetOf(m_labels[bytecodeOffset]), bytecodeOffset));
+        }
+        for (unsigned i = 0; i < m_slowCaseLabels.size(); ++i)
+            bytecodeLocations.append(PerfMap::BytecodeLocation(patchBuffer.offsetOf(m_slowCaseLabels[i].first), m_slowCaseLabels[i].second));
+    }
+
+    CodeRef result = patchBuffer.finalizeCode(PerfMap::Description(PerfMap::Baseline, m_codeBlock, &bytecodeLocations));
     
 #if ENABLE(JIT_VERBOSE)
     dataLog("JIT generated code for %p at [%p, %p).\n", m_codeBlock, result.executableMemory()->start(), result.executableMemory()->end());
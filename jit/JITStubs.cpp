@@ -39,6 +39,7 @@
 #include "CodeBlock.h"
 #include "CodeProfiling.h"
 #include "DFGOSREntry.h"
+#include "DFGWorklist.h"
 #include "Debugger.h"
 #include "ExceptionHelpers.h"
 #include "GetterSetter.h"
@@ -55,9 +56,11 @@
 #include "JSPropertyNameIterator.h"
 #include "JSStaticScopeObject.h"
 #include "JSString.h"
+#include "JSTypedArray.h"
 #include "ObjectPrototype.h"
 #include "Operations.h"
 #include "Parser.h"
+#include "PolymorphicPutByIdList.h"
 #include "Profiler.h"
 #include "RegExpObject.h"
 #include "RegExpPrototype.h"
@@ -1458,6 +1461,63 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id_direct)
     CHECK_FOR_EXCEPTION_AT_END();
 }
 
+#if ENABLE(VALUE_PROFILER)
+// The baseline JIT only caches one put_by_id access, and takes the slow path for any other
+// structure. Remember the other accesses that it could have cached, so that the DFG can
+// compile the put for all of the structures that it has seen. This only records the accesses;
+// the code stays as it is.
+static void recordPolymorphicPutByIdAccess(CallFrame* callFrame, JSValue baseValue, const PutPropertySlot& slot, StructureStubInfo* stubInfo, PutKind putKind)
+{
+    if (stubInfo->accessType != access_put_by_id_replace
+        && stubInfo->accessType != access_put_by_id_transition_normal
+        && stubInfo->accessType != access_put_by_id_transition_direct
+        && stubInfo->accessType != access_put_by_id_list)
+        return;
+    
+    if (!baseValue.isCell() || !slot.isCacheable() || baseValue.asCell() != slot.base())
+        return;
+    
+    JSCell* baseCell = baseValue.asCell();
+    Structure* structure = baseCell->structure();
+    if (structure->isUncacheableDictionary() || structure->typeInfo().prohibitsPropertyCaching())
+        return;
+    if (slot.type() == PutPropertySlot::NewProperty && structure->isDictionary())
+        return;
+    
+    Structure* oldStructure = slot.type() == PutPropertySlot::NewProperty ? structure->previousID() : structure;
+    
+    if (stubInfo->accessType == access_put_by_id_list) {
+        PolymorphicPutByIdList* list = stubInfo->u.putByIdList.list;
+        if (list->isFull())
+            return;
+        for (unsigned i = 0; i < list->size(); ++i) {
+            if (list->at(i).oldStructure() == oldStructure)
+                return;
+        }
+    }
+    
+    CodeBlock* codeBlock = callFrame->codeBlock();
+    JSGlobalData& globalData = callFrame->globalData();
+    PolymorphicPutByIdList* list = PolymorphicPutByIdList::from(putKind, *stubInfo, MacroAssemblerCodePtr());
+    
+    if (slot.type() == PutPropertySlot::NewProperty) {
+        // put_by_id_transition checks the prototype chain for setters.
+        normalizePrototypeChain(callFrame, baseCell);
+        
+        list->addAccess(
+            PutByIdAccess::transition(
+                globalData, codeBlock->ownerExecutable(),
+                oldStructure, structure, structure->prototypeChain(callFrame),
+                MacroAssemblerCodeRef()));
+    } else {
+        list->addAccess(
+            PutByIdAccess::replace(
+                globalData, codeBlock->ownerExecutable(),
+                structure, MacroAssemblerCodeRef()));
+    }
+}
+#endif
+
 DEFINE_STUB_FUNCTION(void, op_put_by_id_fail)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
@@ -1468,6 +1528,10 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id_fail)
     PutPropertySlot slot(callFrame->codeBlock()->isStrictMode());
     stackFrame.args[0].jsValue().put(callFrame, ident, stackFrame.args[2].jsValue(), slot);
 
+#if ENABLE(VALUE_PROFILER)
+    recordPolymorphicPutByIdAccess(callFrame, stackFrame.args[0].jsValue(), slot, &callFrame->codeBlock()->getStubInfo(STUB_RETURN_ADDRESS), NotDirect);
+#endif
+
     CHECK_FOR_EXCEPTION_AT_END();
 }
 
@@ -1483,6 +1547,10 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id_direct_fail)
     ASSERT(baseValue.isObject());
     asObject(baseValue)->putDirect(callFrame->globalData(), ident, stackFrame.args[2].jsValue(), slot);
     
+#if ENABLE(VALUE_PROFILER)
+    recordPolymorphicPutByIdAccess(callFrame, baseValue, slot, &callFrame->codeBlock()->getStubInfo(STUB_RETURN_ADDRESS), Direct);
+#endif
+    
     CHECK_FOR_EXCEPTION_AT_END();
 }
 
@@ -1922,6 +1990,20 @@ DEFINE_STUB_FUNCTION(void, op_check_has_instance)
 }
 
 #if ENABLE(DFG_JIT)
+// The optimization triggers are where we install the code that the DFG compiler
+// threads have finished with.
+static void completeConcurrentCompilations(CallFrame* callFrame)
+{
+    if (DFG::Worklist* worklist = callFrame->globalData().dfgWorklist.get())
+        worklist->completeAllReadyPlans();
+}
+
+static bool isCompilingConcurrently(CallFrame* callFrame, CodeBlock* codeBlock)
+{
+    DFG::Worklist* worklist = callFrame->globalData().dfgWorklist.get();
+    return worklist && worklist->isCompiling(codeBlock);
+}
+
 DEFINE_STUB_FUNCTION(void, optimize_from_loop)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
@@ -1934,6 +2016,15 @@ DEFINE_STUB_FUNCTION(void, optimize_from_loop)
     dataLog("Entered optimize_from_loop with executeCounter = %d, reoptimizationRetryCounter = %u, optimizationDelayCounter = %u\n", codeBlock->jitExecuteCounter(), codeBlock->reoptimizationRetryCounter(), codeBlock->optimizationDelayCounter());
 #endif
 
+    completeConcurrentCompilations(callFrame);
+    if (isCompilingConcurrently(callFrame, codeBlock)) {
+#if ENABLE(JIT_VERBOSE_OSR)
+        dataLog("Optimized replacement for %p (in loop) is still being compiled.\n", codeBlock);
+#endif
+        codeBlock->optimizeSoon();
+        return;
+    }
+
     if (codeBlock->hasOptimizedReplacement()) {
 #if ENABLE(JIT_VERBOSE_OSR)
         dataLog("Considering loop OSR into %p(%p) with success/fail %u/%u.\n", codeBlock, codeBlock->replacement(), codeBlock->replacement()->speculativeSuccessCounter(), codeBlock->replacement()->speculativeFailCounter());
@@ -1964,6 +2055,11 @@ DEFINE_STUB_FUNCTION(void, optimize_from_loop)
 #endif
         
         if (codeBlock->replacement() == codeBlock) {
+            if (isCompilingConcurrently(callFrame, codeBlock)) {
+                codeBlock->optimizeSoon();
+                return;
+            }
+            
 #if ENABLE(JIT_VERBOSE_OSR)
             dataLog("Optimizing %p from loop failed.\n", codeBlock);
 #endif
@@ -2032,6 +2128,15 @@ DEFINE_STUB_FUNCTION(void, optimize_from_ret)
     dataLog("Entered optimize_from_ret with executeCounter = %d, reoptimizationRetryCounter = %u, optimizationDelayCounter = %u\n", codeBlock->jitExecuteCounter(), codeBlock->reoptimizationRetryCounter(), codeBlock->optimizationDelayCounter());
 #endif
 
+    completeConcurrentCompilations(callFrame);
+    if (isCompilingConcurrently(callFrame, codeBlock)) {
+#if ENABLE(JIT_VERBOSE_OSR)
+        dataLog("Optimized replacement for %p (in return) is still being compiled.\n", codeBlock);
+#endif
+        codeBlock->optimizeSoon();
+        return;
+    }
+
     if (codeBlock->hasOptimizedReplacement()) {
 #if ENABLE(JIT_VERBOSE_OSR)
         dataLog("Returning from old JIT call frame with optimized replacement %p(%p), with success/fail %u/%u", codeBlock, codeBlock->replacement(), codeBlock->replacement()->speculativeSuccessCounter(), codeBlock->replacement()->speculativeFailCounter());
@@ -2065,6 +2170,11 @@ DEFINE_STUB_FUNCTION(void, optimize_from_ret)
         dataLog("WARNING: optimized compilation from ret failed.\n");
     
     if (codeBlock->replacement() == codeBlock) {
+        if (isCompilingConcurrently(callFrame, codeBlock)) {
+            codeBlock->optimizeSoon();
+            return;
+        }
+
 #if ENABLE(JIT_VERBOSE_OSR)
         dataLog("Optimizing %p from return failed.\n", codeBlock);
 #endif
@@ -2472,6 +2582,13 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_val)
             ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_val_byte_array));
             return JSValue::encode(asByteArray(baseValue)->getIndex(callFrame, i));
         }
+        if (JSArrayBufferView* view = toJSArrayBufferView(baseValue)) {
+            if (view->canAccessIndex(i)) {
+                // Typed array reads cannot throw, so return immediately to avoid exception checks.
+                ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_val_typed_array));
+                return JSValue::encode(view->getIndex(i));
+            }
+        }
         JSValue result = baseValue.get(callFrame, i);
         CHECK_FOR_EXCEPTION();
         return JSValue::encode(result);
@@ -2542,6 +2659,35 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_val_byte_array)
     return JSValue::encode(result);
 }
 
+DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_val_typed_array)
+{
+    STUB_INIT_STACK_FRAME(stackFrame);
+    
+    CallFrame* callFrame = stackFrame.callFrame;
+    
+    JSValue baseValue = stackFrame.args[0].jsValue();
+    JSValue subscript = stackFrame.args[1].jsValue();
+    
+    JSValue result;
+
+    if (LIKELY(subscript.isUInt32())) {
+        uint32_t i = subscript.asUInt32();
+        JSArrayBufferView* view = toJSArrayBufferView(baseValue);
+        if (view && view->canAccessIndex(i))
+            return JSValue::encode(view->getIndex(i));
+
+        result = baseValue.get(callFrame, i);
+        if (!view)
+            ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_val));
+    } else {
+        Identifier property(callFrame, subscript.toString(callFrame)->value(callFrame));
+        result = baseValue.get(callFrame, property);
+    }
+    
+    CHECK_FOR_EXCEPTION_AT_END();
+    return JSValue::encode(result);
+}
+
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_sub)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
@@ -2592,6 +2738,19 @@ DEFINE_STUB_FUNCTION(void, op_put_by_val)
             }
 
             baseValue.put(callFrame, i, value);
+        } else if (JSArrayBufferView* view = toJSArrayBufferView(baseValue)) {
+            ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_put_by_val_typed_array));
+            // Stores of numbers cannot throw, so return immediately to avoid exception checks.
+            if (value.isNumber()) {
+                if (view->canAccessIndex(i)) {
+                    if (value.isInt32())
+                        view->setIndex(i, value.asInt32());
+                    else
+                        view->setIndex(i, value.asDouble());
+                }
+                return;
+            }
+            view->setIndex(callFrame, i, value);
         } else
             baseValue.put(callFrame, i, value);
     } else {
@@ -2646,6 +2805,44 @@ DEFINE_STUB_FUNCTION(void, op_put_by_val_byte_array)
     CHECK_FOR_EXCEPTION_AT_END();
 }
 
+DEFINE_STUB_FUNCTION(void, op_put_by_val_typed_array)
+{
+    STUB_INIT_STACK_FRAME(stackFrame);
+    
+    CallFrame* callFrame = stackFrame.callFrame;
+    
+    JSValue baseValue = stackFrame.args[0].jsValue();
+    JSValue subscript = stackFrame.args[1].jsValue();
+    JSValue value = stackFrame.args[2].jsValue();
+    
+    if (LIKELY(subscript.isUInt32())) {
+        uint32_t i = subscript.asUInt32();
+        JSArrayBufferView* view = toJSArrayBufferView(baseValue);
+        if (view && value.isNumber()) {
+            // Stores of numbers cannot throw, so return immediately to avoid exception checks.
+            if (view->canAccessIndex(i)) {
+                if (value.isInt32())
+                    view->setIndex(i, value.asInt32());
+                else
+                    view->setIndex(i, value.asDouble());
+            }
+            return;
+        }
+
+        if (!view)
+            ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_put_by_val));
+        baseValue.put(callFrame, i, value);
+    } else {
+        Identifier property(callFrame, subscript.toString(callFrame)->value(callFrame));
+        if (!stackFrame.globalData->exception) { // Don't put to an object if toString threw an exception.
+            PutPropertySlot slot(callFrame->codeBlock()->isStrictMode());
+            baseValue.put(callFrame, property, value, slot);
+        }
+    }
+    
+    CHECK_FOR_EXCEPTION_AT_END();
+}
+
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_less)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
@@ -132,13 +132,13 @@ namespace JSC {
             ret();
         }
         
-        MacroAssemblerCodeRef finalize(JSGlobalData& globalData, MacroAssemblerCodePtr fallback)
+        MacroAssemblerCodeRef finalize(JSGlobalData& globalData, MacroAssemblerCodePtr fallback, const char* thunkKind)
         {
             LinkBuffer patchBuffer(globalData, this, GLOBAL_THUNK_ID);
             patchBuffer.link(m_failures, CodeLocationLabel(fallback));
             for (unsigned i = 0; i < m_calls.size(); i++)
                 patchBuffer.link(m_calls[i].first, m_calls[i].second);
-            return patchBuffer.finalizeCode();
+            return patchBuffer.finalizeCode(PerfMap::Description(PerfMap::Stub, thunkKind));
         }
 
         // Assumes that the target function uses fpRegister0 as the first argument
@@ -148,6 +148,13 @@ namespace JSC {
             m_calls.append(std::make_pair(call(), function));
         }
 
+        // The caller is responsible for placing arguments according to the
+        // platform's C calling convention.
+        void callFunction(FunctionPtr function)
+        {
+            m_calls.append(std::make_pair(call(), function));
+        }
+
     private:
 
         void tagReturnAsInt32()
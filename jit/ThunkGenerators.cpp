@@ -28,7 +28,9 @@
 
 #include "CodeBlock.h"
 #include "InlineASM.h"
+#include "JITStubs.h"
 #include "SpecializedThunkJIT.h"
+#include <wtf/StdLibExtras.h>
 #include <wtf/text/StringImpl.h>
 
 #if ENABLE(JIT)
@@ -78,7 +80,7 @@ MacroAssemblerCodeRef charCodeAtThunkGenerator(JSGlobalData* globalData)
     SpecializedThunkJIT jit(1, globalData);
     stringCharLoad(jit);
     jit.returnInt32(SpecializedThunkJIT::regT0);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "charCodeAt thunk");
 }
 
 MacroAssemblerCodeRef charAtThunkGenerator(JSGlobalData* globalData)
@@ -87,7 +89,7 @@ MacroAssemblerCodeRef charAtThunkGenerator(JSGlobalData* globalData)
     stringCharLoad(jit);
     charToString(jit, globalData, SpecializedThunkJIT::regT0, SpecializedThunkJIT::regT0, SpecializedThunkJIT::regT1);
     jit.returnJSCell(SpecializedThunkJIT::regT0);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "charAt thunk");
 }
 
 MacroAssemblerCodeRef fromCharCodeThunkGenerator(JSGlobalData* globalData)
@@ -97,7 +99,7 @@ MacroAssemblerCodeRef fromCharCodeThunkGenerator(JSGlobalData* globalData)
     jit.loadInt32Argument(0, SpecializedThunkJIT::regT0);
     charToString(jit, globalData, SpecializedThunkJIT::regT0, SpecializedThunkJIT::regT0, SpecializedThunkJIT::regT1);
     jit.returnJSCell(SpecializedThunkJIT::regT0);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "fromCharCode thunk");
 }
 
 MacroAssemblerCodeRef sqrtThunkGenerator(JSGlobalData* globalData)
@@ -109,7 +111,7 @@ MacroAssemblerCodeRef sqrtThunkGenerator(JSGlobalData* globalData)
     jit.loadDoubleArgument(0, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::regT0);
     jit.sqrtDouble(SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::fpRegT0);
     jit.returnDouble(SpecializedThunkJIT::fpRegT0);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "sqrt thunk");
 }
 
 
@@ -191,7 +193,7 @@ MacroAssemblerCodeRef floorThunkGenerator(JSGlobalData* globalData)
     jit.returnInt32(SpecializedThunkJIT::regT0);
     doubleResult.link(&jit);
     jit.returnDouble(SpecializedThunkJIT::fpRegT0);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "floor thunk");
 }
 
 MacroAssemblerCodeRef ceilThunkGenerator(JSGlobalData* globalData)
@@ -210,7 +212,7 @@ MacroAssemblerCodeRef ceilThunkGenerator(JSGlobalData* globalData)
     jit.returnInt32(SpecializedThunkJIT::regT0);
     doubleResult.link(&jit);
     jit.returnDouble(SpecializedThunkJIT::fpRegT0);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "ceil thunk");
 }
 
 static const double oneConstant = 1.0;
@@ -232,7 +234,7 @@ MacroAssemblerCodeRef roundThunkGenerator(JSGlobalData* globalData)
     jit.returnInt32(SpecializedThunkJIT::regT0);
     doubleResult.link(&jit);
     jit.returnDouble(SpecializedThunkJIT::fpRegT0);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "round thunk");
 }
 
 MacroAssemblerCodeRef expThunkGenerator(JSGlobalData* globalData)
@@ -245,7 +247,7 @@ MacroAssemblerCodeRef expThunkGenerator(JSGlobalData* globalData)
     jit.loadDoubleArgument(0, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::regT0);
     jit.callDoubleToDouble(UnaryDoubleOpWrapper(exp));
     jit.returnDouble(SpecializedThunkJIT::fpRegT0);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "exp thunk");
 }
 
 MacroAssemblerCodeRef logThunkGenerator(JSGlobalData* globalData)
@@ -258,7 +260,7 @@ MacroAssemblerCodeRef logThunkGenerator(JSGlobalData* globalData)
     jit.loadDoubleArgument(0, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::regT0);
     jit.callDoubleToDouble(UnaryDoubleOpWrapper(log));
     jit.returnDouble(SpecializedThunkJIT::fpRegT0);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "log thunk");
 }
 
 MacroAssemblerCodeRef absThunkGenerator(JSGlobalData* globalData)
@@ -278,7 +280,7 @@ MacroAssemblerCodeRef absThunkGenerator(JSGlobalData* globalData)
     jit.loadDoubleArgument(0, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::regT0);
     jit.absDouble(SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::fpRegT1);
     jit.returnDouble(SpecializedThunkJIT::fpRegT1);
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "abs thunk");
 }
 
 MacroAssemblerCodeRef powThunkGenerator(JSGlobalData* globalData)
@@ -330,9 +332,119 @@ MacroAssemblerCodeRef powThunkGenerator(JSGlobalData* globalData)
     } else
         jit.appendFailure(nonIntExponent);
 
-    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall());
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "pow thunk");
 }
 
+
+#if USE(JSVALUE64) && CPU(X86_64)
+MacroAssemblerCodeRef typedNativeCallThunkGenerator(JSGlobalData* globalData, FunctionPtr function, UnboxedType resultType, const UnboxedType* argumentTypes, unsigned argumentCount)
+{
+    SpecializedThunkJIT jit(argumentCount, globalData);
+
+    // The unboxed arguments and the exception slot live in our own stack frame. On entry
+    // the stack is misaligned by the return address, so keep the frame size 8 mod 16.
+    int exceptionOffset = argumentCount * sizeof(void*);
+    int frameSize = WTF::roundUpToMultipleOf<16>(exceptionOffset + sizeof(void*)) + sizeof(void*);
+    jit.subPtr(SpecializedThunkJIT::TrustedImm32(frameSize), SpecializedThunkJIT::stackPointerRegister);
+
+    SpecializedThunkJIT::JumpList conversionFailures;
+    for (unsigned i = 0; i < argumentCount; ++i) {
+        unsigned src = CallFrame::argumentOffset(i);
+        SpecializedThunkJIT::Address dst(SpecializedThunkJIT::stackPointerRegister, i * sizeof(void*));
+        switch (argumentTypes[i]) {
+        case UnboxedInt32:
+            conversionFailures.append(jit.emitLoadInt32(src, SpecializedThunkJIT::regT0));
+            jit.store32(SpecializedThunkJIT::regT0, dst);
+            break;
+        case UnboxedDouble:
+            conversionFailures.append(jit.emitLoadDouble(src, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::regT0));
+            jit.storeDouble(SpecializedThunkJIT::fpRegT0, dst);
+            break;
+        case UnboxedBoolean:
+            jit.loadPtr(jit.addressFor(src), SpecializedThunkJIT::regT0);
+            jit.xorPtr(SpecializedThunkJIT::TrustedImm32(static_cast<int32_t>(ValueFalse)), SpecializedThunkJIT::regT0);
+            conversionFailures.append(jit.branchTestPtr(SpecializedThunkJIT::NonZero, SpecializedThunkJIT::regT0, SpecializedThunkJIT::TrustedImm32(static_cast<int32_t>(~1))));
+            jit.store32(SpecializedThunkJIT::regT0, dst);
+            break;
+        case UnboxedVoid:
+            ASSERT_NOT_REACHED();
+            break;
+        }
+    }
+    jit.storePtr(SpecializedThunkJIT::TrustedImmPtr(0), SpecializedThunkJIT::Address(SpecializedThunkJIT::stackPointerRegister, exceptionOffset));
+
+    // Give the callee frame enough of a header for the callback to use the API with it.
+    jit.storePtr(SpecializedThunkJIT::TrustedImmPtr(0), jit.addressFor(RegisterFile::CodeBlock));
+    jit.loadPtr(jit.addressFor(RegisterFile::CallerFrame), SpecializedThunkJIT::regT0);
+    jit.loadPtr(jit.addressFor(RegisterFile::ScopeChain, SpecializedThunkJIT::regT0), SpecializedThunkJIT::regT1);
+    jit.storePtr(SpecializedThunkJIT::regT1, jit.addressFor(RegisterFile::ScopeChain));
+    jit.loadPtr(SpecializedThunkJIT::Address(SpecializedThunkJIT::stackPointerRegister, frameSize), SpecializedThunkJIT::regT1);
+    jit.storePtr(SpecializedThunkJIT::regT1, jit.addressFor(RegisterFile::ReturnPC));
+
+    // Anything the callback does that walks the stack, like creating an error or
+    // calling back into JavaScript, starts from topCallFrame.
+    jit.storePtr(SpecializedThunkJIT::callFrameRegister, &globalData->topCallFrame);
+
+    // Calling convention: f(edi, esi, edx, ...);
+    jit.move(SpecializedThunkJIT::callFrameRegister, X86Registers::edi);
+    jit.move(SpecializedThunkJIT::stackPointerRegister, X86Registers::esi);
+    jit.move(SpecializedThunkJIT::stackPointerRegister, X86Registers::edx);
+    jit.addPtr(SpecializedThunkJIT::TrustedImm32(exceptionOffset), X86Registers::edx);
+    jit.callFunction(function);
+
+    jit.loadPtr(SpecializedThunkJIT::Address(SpecializedThunkJIT::stackPointerRegister, exceptionOffset), SpecializedThunkJIT::regT1);
+    jit.addPtr(SpecializedThunkJIT::TrustedImm32(frameSize), SpecializedThunkJIT::stackPointerRegister);
+    SpecializedThunkJIT::Jump threw = jit.branchTestPtr(SpecializedThunkJIT::NonZero, SpecializedThunkJIT::regT1);
+
+    switch (resultType) {
+    case UnboxedVoid:
+        jit.move(SpecializedThunkJIT::TrustedImmPtr(JSValue::encode(jsUndefined())), SpecializedThunkJIT::regT0);
+        jit.returnJSValue(SpecializedThunkJIT::regT0);
+        break;
+    case UnboxedInt32:
+        jit.zeroExtend32ToPtr(SpecializedThunkJIT::regT0, SpecializedThunkJIT::regT0);
+        jit.returnInt32(SpecializedThunkJIT::regT0);
+        break;
+    case UnboxedDouble: {
+        jit.movePtrToDouble(SpecializedThunkJIT::regT0, SpecializedThunkJIT::fpRegT0);
+        // Impure NaNs would alias other JSValues once boxed.
+        SpecializedThunkJIT::Jump isNaN = jit.branchDouble(SpecializedThunkJIT::DoubleNotEqualOrUnordered, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::fpRegT0);
+        jit.returnDouble(SpecializedThunkJIT::fpRegT0);
+        isNaN.link(&jit);
+        jit.move(SpecializedThunkJIT::TrustedImmPtr(JSValue::encode(jsNaN())), SpecializedThunkJIT::regT0);
+        jit.returnJSValue(SpecializedThunkJIT::regT0);
+        break;
+    }
+    case UnboxedBoolean:
+        jit.and32(SpecializedThunkJIT::TrustedImm32(0xff), SpecializedThunkJIT::regT0);
+        jit.compare32(SpecializedThunkJIT::NotEqual, SpecializedThunkJIT::regT0, SpecializedThunkJIT::TrustedImm32(0), SpecializedThunkJIT::regT0);
+        jit.orPtr(SpecializedThunkJIT::TrustedImm32(static_cast<int32_t>(ValueFalse)), SpecializedThunkJIT::regT0);
+        jit.returnJSValue(SpecializedThunkJIT::regT0);
+        break;
+    }
+
+    // The callback has already run, so we can't fall back to the host call path; hand
+    // the exception to ctiVMThrowTrampoline the same way the native call trampoline does.
+    threw.link(&jit);
+    jit.storePtr(SpecializedThunkJIT::regT1, &globalData->exception);
+    jit.loadPtr(jit.addressFor(RegisterFile::CallerFrame), SpecializedThunkJIT::callFrameRegister);
+    jit.pop(SpecializedThunkJIT::regT1);
+    jit.move(SpecializedThunkJIT::TrustedImmPtr(&globalData->exceptionLocation), SpecializedThunkJIT::regT2);
+    jit.storePtr(SpecializedThunkJIT::regT1, SpecializedThunkJIT::Address(SpecializedThunkJIT::regT2));
+    jit.poke(SpecializedThunkJIT::callFrameRegister, OBJECT_OFFSETOF(struct JITStackFrame, callFrame) / sizeof(void*));
+    jit.storePtr(SpecializedThunkJIT::callFrameRegister, &globalData->topCallFrame);
+    jit.move(SpecializedThunkJIT::TrustedImmPtr(FunctionPtr(ctiVMThrowTrampoline).value()), SpecializedThunkJIT::regT1);
+    jit.push(SpecializedThunkJIT::regT1);
+    jit.ret();
+
+    conversionFailures.link(&jit);
+    jit.addPtr(SpecializedThunkJIT::TrustedImm32(frameSize), SpecializedThunkJIT::stackPointerRegister);
+    jit.appendFailure(jit.jump());
+
+    return jit.finalize(*globalData, globalData->jitStubs->ctiNativeCall(), "typed native call thunk");
+}
+#endif
+
 }
 
 #endif // ENABLE(JIT)
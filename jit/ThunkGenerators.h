@@ -45,6 +45,18 @@ namespace JSC {
     MacroAssemblerCodeRef roundThunkGenerator(JSGlobalData*);
     MacroAssemblerCodeRef sqrtThunkGenerator(JSGlobalData*);
     MacroAssemblerCodeRef powThunkGenerator(JSGlobalData*);
+
+#if USE(JSVALUE64) && CPU(X86_64)
+    class FunctionPtr;
+
+    enum UnboxedType { UnboxedVoid, UnboxedInt32, UnboxedDouble, UnboxedBoolean };
+
+    // Generates a call thunk for a host function that takes and returns unboxed
+    // values. The native function is called as f(ExecState*, const uint64_t arguments[], EncodedJSValue* exception)
+    // and returns its result in the integer return register. Arguments that are not
+    // of the expected type send the call down the regular host call path.
+    MacroAssemblerCodeRef typedNativeCallThunkGenerator(JSGlobalData*, FunctionPtr, UnboxedType resultType, const UnboxedType* argumentTypes, unsigned argumentCount);
+#endif
 }
 #endif
 
@@ -32,7 +32,10 @@
 #include "JSLock.h"
 #include "JSString.h"
 #include "MainThread.h"
+#include "SamplingProfiler.h"
 #include "SamplingTool.h"
+#include "SourceProvider.h"
+#include "UStringConcatenate.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -115,6 +118,8 @@ struct CommandLine {
 
     bool interactive;
     bool dump;
+    UString parserCacheDirectory;
+    UString profileFile;
     Vector<Script> scripts;
     Vector<UString> arguments;
 };
@@ -453,7 +458,73 @@ static void cleanupGlobalData(JSGlobalData* globalData)
     globalData->deref();
 }
 
-static bool runWithScripts(GlobalObject* globalObject, const Vector<Script>& scripts, bool dump)
+struct ParserCacheFile {
+    ParserCacheFile(PassRefPtr<SourceProvider> provider, const UString& path)
+        : provider(provider)
+        , path(path)
+        , loadedByteSize(0)
+    {
+    }
+
+    RefPtr<SourceProvider> provider;
+    UString path;
+    unsigned loadedByteSize;
+};
+
+static UString parserCachePath(const UString& directory, const SourceProvider* provider)
+{
+    // The cache is named after the source text rather than the file, so that
+    // copies of the same script share it.
+    SourceProviderCache::SourceDigest digest;
+    SourceProviderCache::computeSourceDigest(provider, digest);
+    char name[2 * 16 + 1];
+    for (size_t i = 0; i < digest.size(); ++i)
+        snprintf(name + 2 * i, 3, "%02x", digest[i]);
+    return makeUString(directory, "/", name, ".cache");
+}
+
+static void loadParserCache(JSGlobalData& globalData, ParserCacheFile& file)
+{
+    FILE* f = fopen(file.path.utf8().data(), "rb");
+    if (!f)
+        return;
+
+    Vector<char> buffer;
+    char chunk[4096];
+    while (size_t length = fread(chunk, 1, sizeof(chunk), f))
+        buffer.append(chunk, length);
+    bool failed = ferror(f);
+    fclose(f);
+
+    if (failed || !file.provider->cache()->decode(&globalData, file.provider.get(), buffer.data(), buffer.size()))
+        return;
+    file.loadedByteSize = file.provider->cache()->byteSize();
+}
+
+static void saveParserCache(ParserCacheFile& file)
+{
+    if (file.provider->cache()->byteSize() == file.loadedByteSize)
+        return;
+
+    Vector<char> buffer;
+    file.provider->cache()->encode(file.provider.get(), buffer);
+
+    // Write the cache next to its final name and move it into place, so that
+    // another process starting up never reads a partly written one.
+    UString temporaryPath = makeUString(file.path, ".tmp");
+#if !OS(WINDOWS)
+    temporaryPath = makeUString(temporaryPath, UString::number(getpid()));
+#endif
+    FILE* f = fopen(temporaryPath.utf8().data(), "wb");
+    if (!f)
+        return;
+    bool failed = fwrite(buffer.data(), 1, buffer.size(), f) != buffer.size();
+    failed |= fclose(f);
+    if (failed || rename(temporaryPath.utf8().data(), file.path.utf8().data()))
+        remove(temporaryPath.utf8().data());
+}
+
+static bool runWithScripts(GlobalObject* globalObject, const Vector<Script>& scripts, bool dump, const UString& parserCacheDirectory)
 {
     const char* script;
     UString fileName;
@@ -468,6 +539,8 @@ static bool runWithScripts(GlobalObject* globalObject, const Vector<Script>& scr
     SamplingFlags::start();
 #endif
 
+    Vector<ParserCacheFile> parserCacheFiles;
+
     bool success = true;
     for (size_t i = 0; i < scripts.size(); i++) {
         if (scripts[i].isFile) {
@@ -480,10 +553,16 @@ static bool runWithScripts(GlobalObject* globalObject, const Vector<Script>& scr
             fileName = "[Command Line]";
         }
 
+        SourceCode source = jscSource(script, fileName);
+        if (scripts[i].isFile && !parserCacheDirectory.isNull()) {
+            parserCacheFiles.append(ParserCacheFile(source.provider(), parserCachePath(parserCacheDirectory, source.provider())));
+            loadParserCache(globalData, parserCacheFiles.last());
+        }
+
         globalData.startSampling();
 
         JSValue evaluationException;
-        JSValue returnValue = evaluate(globalObject->globalExec(), globalObject->globalScopeChain(), jscSource(script, fileName), JSValue(), &evaluationException);
+        JSValue returnValue = evaluate(globalObject->globalExec(), globalObject->globalScopeChain(), source, JSValue(), &evaluationException);
         success = success && !evaluationException;
         if (dump) {
             if (evaluationException)
@@ -496,6 +575,11 @@ static bool runWithScripts(GlobalObject* globalObject, const Vector<Script>& scr
         globalObject->globalExec()->clearException();
     }
 
+    // Functions keep adding to the cache as they are compiled, so only save it
+    // once every script has run.
+    for (size_t i = 0; i < parserCacheFiles.size(); ++i)
+        saveParserCache(parserCacheFiles[i]);
+
 #if ENABLE(SAMPLING_FLAGS)
     SamplingFlags::stop();
 #endif
@@ -555,14 +639,34 @@ static void runInteractive(GlobalObject* globalObject)
     printf("\n");
 }
 
+#if ENABLE(SAMPLING_PROFILER)
+static void writeProfile(JSGlobalData* globalData, const UString& fileName)
+{
+    globalData->samplingProfiler->stop();
+    CString profile = globalData->samplingProfiler->toJSON().utf8();
+
+    FILE* f = fopen(fileName.utf8().data(), "w");
+    if (!f) {
+        fprintf(stderr, "Could not open file: %s\n", fileName.utf8().data());
+        return;
+    }
+    fwrite(profile.data(), 1, profile.length(), f);
+    fclose(f);
+}
+#endif
+
 static NO_RETURN void printUsageStatement(JSGlobalData* globalData, bool help = false)
 {
     fprintf(stderr, "Usage: jsc [options] [files] [-- arguments]\n");
+    fprintf(stderr, "  -c dir     Keeps what the parser learns about script files in dir, to speed up later runs\n");
     fprintf(stderr, "  -d         Dumps bytecode (debug builds only)\n");
     fprintf(stderr, "  -e         Evaluate argument as script code\n");
     fprintf(stderr, "  -f         Specifies a source file (deprecated)\n");
     fprintf(stderr, "  -h|--help  Prints this help message\n");
     fprintf(stderr, "  -i         Enables interactive mode (default if no files are specified)\n");
+#if ENABLE(SAMPLING_PROFILER)
+    fprintf(stderr, "  -p file    Samples the call stack while running and writes the call tree to file as JSON\n");
+#endif
 #if HAVE(SIGNAL_H)
     fprintf(stderr, "  -s         Installs signal handlers that exit on a crash (Unix platforms only)\n");
 #endif
@@ -588,6 +692,12 @@ static void parseArguments(int argc, char** argv, CommandLine& options, JSGlobal
             options.scripts.append(Script(false, argv[i]));
             continue;
         }
+        if (!strcmp(arg, "-c")) {
+            if (++i == argc)
+                printUsageStatement(globalData);
+            options.parserCacheDirectory = argv[i];
+            continue;
+        }
         if (!strcmp(arg, "-i")) {
             options.interactive = true;
             continue;
@@ -596,6 +706,14 @@ static void parseArguments(int argc, char** argv, CommandLine& options, JSGlobal
             options.dump = true;
             continue;
         }
+#if ENABLE(SAMPLING_PROFILER)
+        if (!strcmp(arg, "-p")) {
+            if (++i == argc)
+                printUsageStatement(globalData);
+            options.profileFile = argv[i];
+            continue;
+        }
+#endif
         if (!strcmp(arg, "-s")) {
 #if HAVE(SIGNAL_H)
             signal(SIGILL, _exit);
@@ -629,9 +747,17 @@ int jscmain(int argc, char** argv, JSGlobalData* globalData)
     parseArguments(argc, argv, options, globalData);
 
     GlobalObject* globalObject = GlobalObject::create(*globalData, GlobalObject::createStructure(*globalData, jsNull()), options.arguments);
-    bool success = runWithScripts(globalObject, options.scripts, options.dump);
+#if ENABLE(SAMPLING_PROFILER)
+    if (!options.profileFile.isNull())
+        globalData->samplingProfiler->start();
+#endif
+    bool success = runWithScripts(globalObject, options.scripts, options.dump, options.parserCacheDirectory);
     if (options.interactive && success)
         runInteractive(globalObject);
+#if ENABLE(SAMPLING_PROFILER)
+    if (!options.profileFile.isNull())
+        writeProfile(globalData, options.profileFile);
+#endif
 
     return success ? 0 : 3;
 }
@@ -26,8 +26,92 @@
 #include "config.h"
 #include "SourceProviderCache.h"
 
+#include "Identifier.h"
+#include "SourceProvider.h"
+
 namespace JSC {
 
+static const uint32_t encodedCacheMagic = 0x4350534a; // "JSPC"
+static const uint32_t encodedCacheVersion = 1;
+
+struct EncodedCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sourceLength;
+    int32_t firstLine;
+    uint8_t sourceDigest[16];
+    uint32_t itemCount;
+};
+
+// Each item is followed by its used and then its written variables, each encoded
+// as a uint32_t length and that many UChars.
+struct EncodedCacheItem {
+    int32_t openBracePos;
+    int32_t closeBracePos;
+    int32_t closeBraceLine;
+    uint8_t usesEval;
+    uint8_t strictMode;
+    uint8_t needsFullActivation;
+    uint8_t unused;
+    uint32_t usedVariableCount;
+    uint32_t writtenVariableCount;
+};
+
+template <typename T> static void appendEncoded(Vector<char>& buffer, const T& value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void appendEncodedVariables(Vector<char>& buffer, const Vector<RefPtr<StringImpl> >& variables)
+{
+    for (size_t i = 0; i < variables.size(); ++i) {
+        StringImpl* variable = variables[i].get();
+        appendEncoded(buffer, static_cast<uint32_t>(variable->length()));
+        for (unsigned j = 0; j < variable->length(); ++j)
+            appendEncoded(buffer, static_cast<UChar>((*variable)[j]));
+    }
+}
+
+class EncodedCacheReader {
+public:
+    EncodedCacheReader(const char* data, size_t length)
+        : m_position(data)
+        , m_end(data + length)
+    {
+    }
+
+    bool atEnd() const { return m_position == m_end; }
+
+    template <typename T> bool read(T& value)
+    {
+        if (static_cast<size_t>(m_end - m_position) < sizeof(T))
+            return false;
+        // The data may not be aligned for T.
+        memcpy(&value, m_position, sizeof(T));
+        m_position += sizeof(T);
+        return true;
+    }
+
+    bool readVariables(JSGlobalData* globalData, uint32_t count, Vector<RefPtr<StringImpl> >& variables)
+    {
+        Vector<UChar, 64> characters;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t length;
+            if (!read(length) || static_cast<size_t>(m_end - m_position) / sizeof(UChar) < length)
+                return false;
+            characters.resize(length);
+            memcpy(characters.data(), m_position, length * sizeof(UChar));
+            m_position += length * sizeof(UChar);
+            variables.append(Identifier(globalData, characters.data(), length).impl());
+        }
+        return true;
+    }
+
+private:
+    const char* m_position;
+    const char* m_end;
+};
+
 SourceProviderCache::~SourceProviderCache()
 {
     clear();
@@ -50,4 +134,114 @@ void SourceProviderCache::add(int sourcePosition, PassOwnPtr<SourceProviderCache
     m_contentByteSize += size;
 }
 
+template <typename CharType> static void hashCharacters(const CharType* characters, unsigned length, uint64_t& hash1, uint64_t& hash2)
+{
+    for (unsigned i = 0; i < length; ++i) {
+        hash1 = (hash1 ^ characters[i]) * 0x100000001b3ULL;
+        hash2 = ((hash2 << 5 | hash2 >> 59) ^ characters[i]) * 0x9e3779b97f4a7c15ULL;
+    }
+}
+
+void SourceProviderCache::computeSourceDigest(const SourceProvider* provider, SourceDigest& digest)
+{
+    // This has to be much cheaper than parsing, so it is two independent 64-bit
+    // hashes rather than a cryptographic one. The characters are hashed as code
+    // units, so the same text gets the same digest whatever its width.
+    const StringImpl* source = provider->data();
+    uint64_t hash1 = 0xcbf29ce484222325ULL;
+    uint64_t hash2 = source->length();
+    if (source->is8Bit())
+        hashCharacters(source->characters8(), source->length(), hash1, hash2);
+    else
+        hashCharacters(source->characters16(), source->length(), hash1, hash2);
+
+    digest.resize(sizeof(hash1) + sizeof(hash2));
+    memcpy(digest.data(), &hash1, sizeof(hash1));
+    memcpy(digest.data() + sizeof(hash1), &hash2, sizeof(hash2));
+}
+
+void SourceProviderCache::encode(const SourceProvider* provider, Vector<char>& buffer) const
+{
+    SourceDigest digest;
+    computeSourceDigest(provider, digest);
+
+    EncodedCacheHeader header;
+    header.magic = encodedCacheMagic;
+    header.version = encodedCacheVersion;
+    header.sourceLength = provider->length();
+    header.firstLine = provider->startPosition().m_line.zeroBasedInt();
+    memcpy(header.sourceDigest, digest.data(), sizeof(header.sourceDigest));
+    header.itemCount = m_map.size();
+    appendEncoded(buffer, header);
+
+    HashMap<int, OwnPtr<SourceProviderCacheItem> >::const_iterator end = m_map.end();
+    for (HashMap<int, OwnPtr<SourceProviderCacheItem> >::const_iterator it = m_map.begin(); it != end; ++it) {
+        const SourceProviderCacheItem* item = it->second.get();
+        EncodedCacheItem encodedItem;
+        encodedItem.openBracePos = it->first;
+        encodedItem.closeBracePos = item->closeBracePos;
+        encodedItem.closeBraceLine = item->closeBraceLine;
+        encodedItem.usesEval = item->usesEval;
+        encodedItem.strictMode = item->strictMode;
+        encodedItem.needsFullActivation = item->needsFullActivation;
+        encodedItem.unused = 0;
+        encodedItem.usedVariableCount = item->usedVariables.size();
+        encodedItem.writtenVariableCount = item->writtenVariables.size();
+        appendEncoded(buffer, encodedItem);
+        appendEncodedVariables(buffer, item->usedVariables);
+        appendEncodedVariables(buffer, item->writtenVariables);
+    }
+}
+
+bool SourceProviderCache::decode(JSGlobalData* globalData, const SourceProvider* provider, const char* data, size_t length)
+{
+    EncodedCacheReader reader(data, length);
+
+    EncodedCacheHeader header;
+    if (!reader.read(header))
+        return false;
+    if (header.magic != encodedCacheMagic || header.version != encodedCacheVersion)
+        return false;
+    if (header.sourceLength != static_cast<uint32_t>(provider->length()) || header.firstLine != provider->startPosition().m_line.zeroBasedInt())
+        return false;
+
+    SourceDigest digest;
+    computeSourceDigest(provider, digest);
+    if (memcmp(header.sourceDigest, digest.data(), sizeof(header.sourceDigest)))
+        return false;
+
+    // Decode everything before adding anything, so that a truncated or damaged
+    // cache is ignored as a whole.
+    const StringImpl* source = provider->data();
+    HashMap<int, OwnPtr<SourceProviderCacheItem> > items;
+    for (uint32_t i = 0; i < header.itemCount; ++i) {
+        EncodedCacheItem encodedItem;
+        if (!reader.read(encodedItem))
+            return false;
+        if (encodedItem.openBracePos < 0 || encodedItem.openBracePos >= encodedItem.closeBracePos || static_cast<uint32_t>(encodedItem.closeBracePos) >= header.sourceLength)
+            return false;
+        if ((*source)[encodedItem.openBracePos] != '{' || (*source)[encodedItem.closeBracePos] != '}')
+            return false;
+
+        OwnPtr<SourceProviderCacheItem> item = adoptPtr(new SourceProviderCacheItem(encodedItem.closeBraceLine, encodedItem.closeBracePos));
+        item->usesEval = encodedItem.usesEval;
+        item->strictMode = encodedItem.strictMode;
+        item->needsFullActivation = encodedItem.needsFullActivation;
+        if (!reader.readVariables(globalData, encodedItem.usedVariableCount, item->usedVariables))
+            return false;
+        if (!reader.readVariables(globalData, encodedItem.writtenVariableCount, item->writtenVariables))
+            return false;
+        items.add(encodedItem.openBracePos, item.release());
+    }
+    if (!reader.atEnd())
+        return false;
+
+    HashMap<int, OwnPtr<SourceProviderCacheItem> >::iterator end = items.end();
+    for (HashMap<int, OwnPtr<SourceProviderCacheItem> >::iterator it = items.begin(); it != end; ++it) {
+        unsigned size = it->second->approximateByteSize();
+        add(it->first, it->second.release(), size);
+    }
+    return true;
+}
+
 }
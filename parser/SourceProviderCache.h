@@ -33,6 +33,9 @@
 
 namespace JSC {
 
+class JSGlobalData;
+class SourceProvider;
+
 class SourceProviderCache {
 public:
     SourceProviderCache() : m_contentByteSize(0) {}
@@ -43,6 +46,16 @@ public:
     void add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem>, unsigned size);
     const SourceProviderCacheItem* get(int sourcePosition) const { return m_map.get(sourcePosition); }
 
+    // The cache can be kept across processes, so that the parser does not have to
+    // go through the bodies of functions it has already seen. The encoded form is
+    // position independent, so it can be decoded straight out of a mapped file.
+    // Decoding fails, and adds nothing, unless the source is the same as when the
+    // cache was encoded.
+    typedef Vector<uint8_t, 16> SourceDigest;
+    JS_EXPORT_PRIVATE static void computeSourceDigest(const SourceProvider*, SourceDigest&);
+    JS_EXPORT_PRIVATE void encode(const SourceProvider*, Vector<char>&) const;
+    JS_EXPORT_PRIVATE bool decode(JSGlobalData*, const SourceProvider*, const char* data, size_t length);
+
 private:
     HashMap<int, OwnPtr<SourceProviderCacheItem> > m_map;
     unsigned m_contentByteSize;
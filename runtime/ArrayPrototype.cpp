@@ -166,6 +166,17 @@ static unsigned argumentClampedIndexFromStartOrEnd(ExecState* exec, int argument
     return indexDouble > length ? length : static_cast<unsigned>(indexDouble);
 }
 
+// Numbers take their strings straight from the numeric string cache, rather than from a
+// JSString made for each element.
+static inline UString elementToString(ExecState* exec, JSValue element)
+{
+    if (element.isInt32())
+        return exec->globalData().numericStrings.add(element.asInt32());
+    if (element.isDouble())
+        return exec->globalData().numericStrings.add(element.asDouble());
+    return element.toString(exec)->value(exec);
+}
+
 EncodedJSValue JSC_HOST_CALL arrayProtoFuncToString(ExecState* exec)
 {
     JSValue thisValue = exec->hostThisValue();
@@ -197,7 +208,7 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncToString(ExecState* exec)
         if (element.isUndefinedOrNull())
             continue;
         
-        UString str = element.toString(exec)->value(exec);
+        UString str = elementToString(exec, element);
         strBuffer[k] = str.impl();
         totalSize += str.length();
         allStrings8Bit = allStrings8Bit && str.is8Bit();
@@ -308,7 +319,7 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncJoin(ExecState* exec)
                 goto skipFirstLoop;
             JSValue element = array->getIndex(k);
             if (!element.isUndefinedOrNull())
-                strBuffer.append(element.toString(exec)->value(exec));
+                strBuffer.append(elementToString(exec, element));
             k++;
         }
 
@@ -319,7 +330,7 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncJoin(ExecState* exec)
                 strBuffer.append(',');
                 JSValue element = array->getIndex(k);
                 if (!element.isUndefinedOrNull())
-                    strBuffer.append(element.toString(exec)->value(exec));
+                    strBuffer.append(elementToString(exec, element));
             }
         } else {
             for (; k < length; k++) {
@@ -328,7 +339,7 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncJoin(ExecState* exec)
                 strBuffer.append(separator);
                 JSValue element = array->getIndex(k);
                 if (!element.isUndefinedOrNull())
-                    strBuffer.append(element.toString(exec)->value(exec));
+                    strBuffer.append(elementToString(exec, element));
             }
         }
     }
@@ -1138,6 +1149,22 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncReduceRight(ExecState* exec)
     return JSValue::encode(rv);        
 }
 
+// indexOf and lastIndexOf read the vector of a JSArray directly, up to the first hole,
+// since the prototype chain might fill a hole. When the indexing shape says that the
+// vector only holds numbers, they compare numbers without going through strictEqual(),
+// and know without looking that nothing else can be found there.
+static inline bool strictEqualForArraySearch(ExecState* exec, JSArray::IndexingShape shape, JSValue searchElement, JSValue element)
+{
+    if (shape <= JSArray::DoubleShape) {
+        if (!searchElement.isNumber())
+            return false;
+        if (shape == JSArray::Int32Shape && searchElement.isInt32())
+            return element.asInt32() == searchElement.asInt32();
+        return element.asNumber() == searchElement.asNumber();
+    }
+    return JSValue::strictEqual(exec, searchElement, element);
+}
+
 EncodedJSValue JSC_HOST_CALL arrayProtoFuncIndexOf(ExecState* exec)
 {
     // 15.4.4.14
@@ -1148,6 +1175,14 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncIndexOf(ExecState* exec)
 
     unsigned index = argumentClampedIndexFromStartOrEnd(exec, 1, length);
     JSValue searchElement = exec->argument(0);
+    if (isJSArray(thisObj)) {
+        JSArray* array = asArray(thisObj);
+        JSArray::IndexingShape shape = array->indexingShape();
+        for (; index < length && array->canGetIndex(index); ++index) {
+            if (strictEqualForArraySearch(exec, shape, searchElement, array->getIndex(index)))
+                return JSValue::encode(jsNumber(index));
+        }
+    }
     for (; index < length; ++index) {
         JSValue e = getProperty(exec, thisObj, index);
         if (exec->hadException())
@@ -1183,6 +1218,16 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncLastIndexOf(ExecState* exec)
     }
 
     JSValue searchElement = exec->argument(0);
+    if (isJSArray(thisObj)) {
+        JSArray* array = asArray(thisObj);
+        JSArray::IndexingShape shape = array->indexingShape();
+        for (; array->canGetIndex(index); --index) {
+            if (strictEqualForArraySearch(exec, shape, searchElement, array->getIndex(index)))
+                return JSValue::encode(jsNumber(index));
+            if (!index)
+                return JSValue::encode(jsNumber(-1));
+        }
+    }
     do {
         ASSERT(index < length);
         JSValue e = getProperty(exec, thisObj, index);
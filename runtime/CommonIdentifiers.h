@@ -34,6 +34,10 @@
     macro(apply) \
     macro(arguments) \
     macro(bind) \
+    macro(buffer) \
+    macro(byteLength) \
+    macro(byteOffset) \
+    macro(BYTES_PER_ELEMENT) \
     macro(call) \
     macro(callee) \
     macro(caller) \
@@ -61,7 +65,9 @@
     macro(propertyIsEnumerable) \
     macro(prototype) \
     macro(set) \
+    macro(slice) \
     macro(source) \
+    macro(subarray) \
     macro(test) \
     macro(toExponential) \
     macro(toFixed) \
@@ -29,8 +29,10 @@
 #include "BytecodeGenerator.h"
 #include "CodeBlock.h"
 #include "DFGDriver.h"
+#include "DFGWorklist.h"
 #include "JIT.h"
 #include "JITDriver.h"
+#include "Options.h"
 #include "Parser.h"
 #include "UStringBuilder.h"
 #include "Vector.h"
@@ -503,6 +505,15 @@ JSObject* FunctionExecutable::compileForCallInternal(ExecState* exec, ScopeChain
     if (!newCodeBlock)
         return exception;
 
+#if ENABLE(DFG_JIT)
+    if (jitType == JITCode::DFGJIT && exec->globalData().canUseJIT() && Options::numberOfDFGCompilerThreads) {
+        // The baseline code block stays installed until the compiler threads are
+        // done; the stubs that trigger optimization pick up the result.
+        DFG::tryCompileFunctionConcurrently(exec->globalData(), newCodeBlock.release(), m_codeBlockForCall.get());
+        return 0;
+    }
+#endif
+
     newCodeBlock->setAlternative(static_pointer_cast<CodeBlock>(m_codeBlockForCall.release()));
     m_codeBlockForCall = newCodeBlock.release();
     
@@ -545,6 +556,15 @@ JSObject* FunctionExecutable::compileForConstructInternal(ExecState* exec, Scope
     if (!newCodeBlock)
         return exception;
 
+#if ENABLE(DFG_JIT)
+    if (jitType == JITCode::DFGJIT && exec->globalData().canUseJIT() && Options::numberOfDFGCompilerThreads) {
+        // The baseline code block stays installed until the compiler threads are
+        // done; the stubs that trigger optimization pick up the result.
+        DFG::tryCompileFunctionConcurrently(exec->globalData(), newCodeBlock.release(), m_codeBlockForConstruct.get());
+        return 0;
+    }
+#endif
+
     newCodeBlock->setAlternative(static_pointer_cast<CodeBlock>(m_codeBlockForConstruct.release()));
     m_codeBlockForConstruct = newCodeBlock.release();
     
@@ -572,6 +592,36 @@ JSObject* FunctionExecutable::compileForConstructInternal(ExecState* exec, Scope
     return 0;
 }
 
+#if ENABLE(DFG_JIT)
+void FunctionExecutable::installOptimizedCodeFor(CodeSpecializationKind kind, PassOwnPtr<FunctionCodeBlock> passedCodeBlock, const JITCode& jitCode, MacroAssemblerCodePtr jitCodeWithArityCheck)
+{
+    OwnPtr<FunctionCodeBlock>& codeBlock = codeBlockFor(kind);
+    ASSERT(codeBlock->getJITType() == JITCode::BaselineJIT);
+
+    OwnPtr<FunctionCodeBlock> newCodeBlock = passedCodeBlock;
+    codeBlock->unlinkIncomingCalls();
+    newCodeBlock->setAlternative(static_pointer_cast<CodeBlock>(codeBlock.release()));
+    codeBlock = newCodeBlock.release();
+
+    if (kind == CodeForCall) {
+        m_numParametersForCall = codeBlock->numParameters();
+        m_jitCodeForCall = jitCode;
+        m_jitCodeForCallWithArityCheck = jitCodeWithArityCheck;
+    } else {
+        ASSERT(kind == CodeForConstruct);
+        m_numParametersForConstruct = codeBlock->numParameters();
+        m_jitCodeForConstruct = jitCode;
+        m_jitCodeForConstructWithArityCheck = jitCodeWithArityCheck;
+    }
+    m_numCapturedVariables = codeBlock->m_numCapturedVars;
+    m_symbolTable = codeBlock->sharedSymbolTable();
+
+    codeBlock->setJITCode(jitCode, jitCodeWithArityCheck);
+
+    Heap::heap(this)->reportExtraMemoryCost(sizeof(*codeBlock) + jitCode.size());
+}
+#endif
+
 #if ENABLE(JIT)
 void FunctionExecutable::jettisonOptimizedCodeForCall(JSGlobalData& globalData)
 {
@@ -605,6 +655,12 @@ void FunctionExecutable::visitChildren(JSCell* cell, SlotVisitor& visitor)
 
 void FunctionExecutable::discardCode()
 {
+#if ENABLE(DFG_JIT)
+    // An optimizing compilation in flight may refer to the code blocks we are
+    // about to throw away, either as the block it optimizes or as one it inlines.
+    if (DFG::Worklist* worklist = Heap::heap(this)->globalData()->dfgWorklist.get())
+        worklist->cancelPlansFor(this);
+#endif
 #if ENABLE(JIT)
     // These first two checks are to handle the rare case where
     // we are trying to evict code for a function during its
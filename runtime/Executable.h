@@ -578,6 +578,12 @@ namespace JSC {
             return compileOptimizedForConstruct(exec, scopeChainNode);
         }
         
+#if ENABLE(DFG_JIT)
+        // Makes the given DFG code block, which was compiled on a compiler thread
+        // against the current baseline code block, the replacement for this executable.
+        void installOptimizedCodeFor(CodeSpecializationKind, PassOwnPtr<FunctionCodeBlock>, const JITCode&, MacroAssemblerCodePtr jitCodeWithArityCheck);
+#endif
+
 #if ENABLE(JIT)
         void jettisonOptimizedCodeFor(JSGlobalData& globalData, CodeSpecializationKind kind)
         {
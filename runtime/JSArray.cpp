@@ -35,6 +35,7 @@
 #include <wtf/Assertions.h>
 #include <wtf/OwnPtr.h>
 #include <Operations.h>
+#include <algorithm>
 
 using namespace std;
 using namespace WTF;
@@ -134,6 +135,7 @@ inline void JSArray::checkConsistency(ConsistencyCheckType)
 JSArray::JSArray(JSGlobalData& globalData, Structure* structure)
     : JSNonFinalObject(globalData, structure)
     , m_indexBias(0)
+    , m_indexingShape(Int32Shape)
     , m_storage(0)
     , m_sparseValueMap(0)
     , m_subclassData(0)
@@ -313,6 +315,7 @@ inline void SparseArrayValueMap::visitChildren(SlotVisitor& visitor)
 void JSArray::allocateSparseMap(JSGlobalData& globalData)
 {
     m_sparseValueMap = new SparseArrayValueMap;
+    m_indexingShape = SparseShape;
     globalData.heap.addFinalizer(this, finalize);
 }
 
@@ -760,6 +763,7 @@ void JSArray::putByIndex(JSCell* cell, ExecState* exec, unsigned i, JSValue valu
             ++storage->m_numValuesInVector;
 
         valueSlot.set(exec->globalData(), thisObject, value);
+        thisObject->noteIndexedValue(value);
         thisObject->checkConsistency();
         return;
     }
@@ -801,6 +805,7 @@ NEVER_INLINE void JSArray::putByIndexBeyondVectorLength(ExecState* exec, unsigne
             // success! - reread m_storage since it has likely been reallocated, and store to the vector.
             storage = m_storage;
             storage->m_vector[i].set(globalData, this, value);
+            noteIndexedValue(value);
             ++storage->m_numValuesInVector;
             return;
         }
@@ -1170,6 +1175,10 @@ bool JSArray::setLength(ExecState* exec, unsigned newLength, bool throwException
 
     storage->m_length = newLength;
 
+    // An empty array holds no values, so its shape can start over.
+    if (!newLength && !m_sparseValueMap)
+        m_indexingShape = Int32Shape;
+
     checkConsistency();
     return true;
 }
@@ -1242,6 +1251,7 @@ void JSArray::push(ExecState* exec, JSValue value)
     unsigned length = storage->m_length;
     if (length < m_vectorLength) {
         storage->m_vector[length].set(exec->globalData(), this, value);
+        noteIndexedValue(value);
         storage->m_length = length + 1;
         ++storage->m_numValuesInVector;
         checkConsistency();
@@ -1390,12 +1400,20 @@ static int compareByStringPairForQSort(const void* a, const void* b)
     return codePointCompare(va->second, vb->second);
 }
 
+static inline bool lessThanForInt32Sort(const JSValue& a, const JSValue& b)
+{
+    return a.asInt32() < b.asInt32();
+}
+
+static inline bool lessThanForDoubleSort(const JSValue& a, const JSValue& b)
+{
+    return a.asNumber() < b.asNumber();
+}
+
 void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
 {
     ASSERT(!inSparseMode());
 
-    ArrayStorage* storage = m_storage;
-
     unsigned lengthNotIncludingUndefined = compactForSorting(exec->globalData());
     if (m_sparseValueMap) {
         throwOutOfMemoryError(exec);
@@ -1404,23 +1422,43 @@ void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType cal
 
     if (!lengthNotIncludingUndefined)
         return;
-        
-    bool allValuesAreNumbers = true;
+
+    ArrayStorage* storage = m_storage;
     size_t size = storage->m_numValuesInVector;
+    JSValue* values = storage->m_vector[0].slot();
+
+    // For numeric comparison, which is fast, quicksort is faster than mergesort. We
+    // also don't require mergesort's stability, since there's no user visible
+    // side-effect from swapping the order of equal primitive values. When the
+    // indexing shape tells us what the values are, we sort them with a comparison
+    // that the compiler can inline, which needs a strict weak ordering and so no NaNs.
+    IndexingShape shape = indexingShape();
+    if (shape == Int32Shape) {
+        std::sort(values, values + size, lessThanForInt32Sort);
+        checkConsistency(SortConsistencyCheck);
+        return;
+    }
+
+    bool allValuesAreNumbers = true;
+    bool haveNaN = false;
     for (size_t i = 0; i < size; ++i) {
-        if (!storage->m_vector[i].isNumber()) {
+        JSValue value = values[i];
+        if (!value.isNumber()) {
             allValuesAreNumbers = false;
             break;
         }
+        if (value.isDouble() && isnan(value.asDouble()))
+            haveNaN = true;
     }
+    ASSERT(allValuesAreNumbers || shape > DoubleShape);
 
     if (!allValuesAreNumbers)
         return sort(exec, compareFunction, callType, callData);
 
-    // For numeric comparison, which is fast, qsort is faster than mergesort. We
-    // also don't require mergesort's stability, since there's no user visible
-    // side-effect from swapping the order of equal primitive values.
-    qsort(storage->m_vector, size, sizeof(WriteBarrier<Unknown>), compareNumbersForQSort);
+    if (!haveNaN)
+        std::sort(values, values + size, lessThanForDoubleSort);
+    else
+        qsort(storage->m_vector, size, sizeof(WriteBarrier<Unknown>), compareNumbersForQSort);
 
     checkConsistency(SortConsistencyCheck);
 }
@@ -1460,8 +1498,17 @@ void JSArray::sort(ExecState* exec)
     // FIXME: The following loop continues to call toString on subsequent values even after
     // a toString call raises an exception.
 
-    for (size_t i = 0; i < lengthNotIncludingUndefined; i++)
-        values[i].second = values[i].first.toString(exec)->value(exec);
+    if (indexingShape() <= DoubleShape) {
+        // Numbers can go straight to the numeric string cache, without a JSString each.
+        NumericStrings& numericStrings = exec->globalData().numericStrings;
+        for (size_t i = 0; i < lengthNotIncludingUndefined; i++) {
+            JSValue value = values[i].first;
+            values[i].second = value.isInt32() ? numericStrings.add(value.asInt32()) : numericStrings.add(value.asDouble());
+        }
+    } else {
+        for (size_t i = 0; i < lengthNotIncludingUndefined; i++)
+            values[i].second = values[i].first.toString(exec)->value(exec);
+    }
 
     if (exec->hadException()) {
         Heap::heap(this)->popTempSortVector(&values);
@@ -1808,6 +1855,7 @@ void JSArray::checkConsistency(ConsistencyCheckType type)
             ASSERT(i < storage->m_length);
             if (type != DestructorConsistencyCheck)
                 value.isUndefined(); // Likely to crash if the object was deallocated.
+            ASSERT((m_indexingShape | indexingShapeFor(value)) == m_indexingShape);
             ++numValuesInVector;
         } else {
             if (type == SortConsistencyCheck)
@@ -1818,6 +1866,7 @@ void JSArray::checkConsistency(ConsistencyCheckType type)
     ASSERT(numValuesInVector <= storage->m_length);
 
     if (m_sparseValueMap) {
+        ASSERT(m_indexingShape == SparseShape);
         SparseArrayValueMap::iterator end = m_sparseValueMap->end();
         for (SparseArrayValueMap::iterator it = m_sparseValueMap->begin(); it != end; ++it) {
             unsigned index = it->first;
@@ -133,6 +133,18 @@ namespace JSC {
     public:
         typedef JSNonFinalObject Base;
 
+        // The indexing shape is an upper bound on the kinds of values that the array's
+        // indexed properties hold, so that array builtins can skip type dispatch. The
+        // values themselves are still stored as boxed JSValues. Shapes only ever move
+        // towards SparseShape, and each shape's bits include those of the shapes before
+        // it, so moving to a shape is a bitwise or.
+        enum IndexingShape {
+            Int32Shape = 0, // Every value in the vector is an int32.
+            DoubleShape = 1, // Every value in the vector is a number.
+            ContiguousShape = 3, // The vector may hold any value.
+            SparseShape = 7 // The array has, or has had, a sparse map.
+        };
+
         static void finalize(JSCell*);
 
         static JSArray* create(JSGlobalData&, Structure*, unsigned initialLength = 0);
@@ -187,6 +199,18 @@ namespace JSC {
                     storage->m_length = i + 1;
             }
             x.set(globalData, this, v);
+            noteIndexedValue(v);
+        }
+
+        IndexingShape indexingShape() const { return static_cast<IndexingShape>(m_indexingShape); }
+
+        static IndexingShape indexingShapeFor(JSValue value)
+        {
+            if (value.isInt32())
+                return Int32Shape;
+            if (value.isDouble())
+                return DoubleShape;
+            return ContiguousShape;
         }
         
         inline void initializeIndex(JSGlobalData& globalData, unsigned i, JSValue v)
@@ -204,6 +228,7 @@ namespace JSC {
             // It is improtant that we increment length here, so that all newly added
             // values in the array still get marked during the initialization phase.
             storage->m_vector[storage->m_length++].set(globalData, this, v);
+            noteIndexedValue(v);
         }
 
         inline void completeInitialization(unsigned newLength)
@@ -242,6 +267,11 @@ namespace JSC {
             return OBJECT_OFFSETOF(JSArray, m_vectorLength);
         }
 
+        static ptrdiff_t indexingShapeOffset()
+        {
+            return OBJECT_OFFSETOF(JSArray, m_indexingShape);
+        }
+
         JS_EXPORT_PRIVATE static void visitChildren(JSCell*, SlotVisitor&);
 
         void enterDictionaryMode(JSGlobalData&);
@@ -258,6 +288,11 @@ namespace JSC {
         JS_EXPORT_PRIVATE void setSubclassData(void*);
 
     private:
+        void noteIndexedValue(JSValue value)
+        {
+            m_indexingShape |= indexingShapeFor(value);
+        }
+
         bool isLengthWritable()
         {
             SparseArrayValueMap* map = m_sparseValueMap;
@@ -284,6 +319,7 @@ namespace JSC {
 
         unsigned m_vectorLength; // The valid length of m_vector
         unsigned m_indexBias; // The number of JSValue sized blocks before ArrayStorage.
+        unsigned m_indexingShape; // An IndexingShape, kept as an unsigned so that JIT code can or into it.
         ArrayStorage *m_storage;
 
         // FIXME: Maybe SparseArrayValueMap should be put into its own JSCell?
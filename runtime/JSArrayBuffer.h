@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef JSArrayBuffer_h
+#define JSArrayBuffer_h
+
+#include "JSObject.h"
+
+#include <wtf/ArrayBuffer.h>
+
+namespace JSC {
+
+    class JSArrayBuffer : public JSNonFinalObject {
+    public:
+        typedef JSNonFinalObject Base;
+
+        static JSArrayBuffer* create(ExecState* exec, Structure* structure, PassRefPtr<ArrayBuffer> impl)
+        {
+            JSArrayBuffer* buffer = new (NotNull, allocateCell<JSArrayBuffer>(*exec->heap())) JSArrayBuffer(exec, structure, impl);
+            buffer->finishCreation(exec);
+            return buffer;
+        }
+
+        static Structure* createStructure(JSGlobalData& globalData, JSGlobalObject* globalObject, JSValue prototype)
+        {
+            return Structure::create(globalData, globalObject, prototype, TypeInfo(ObjectType, StructureFlags), &s_info);
+        }
+
+        static JS_EXPORTDATA const ClassInfo s_info;
+
+        ArrayBuffer* impl() const { return m_impl.get(); }
+
+        ~JSArrayBuffer();
+        static void destroy(JSCell*);
+
+    protected:
+        void finishCreation(ExecState*);
+
+    private:
+        JSArrayBuffer(ExecState*, Structure*, PassRefPtr<ArrayBuffer>);
+
+        RefPtr<ArrayBuffer> m_impl;
+    };
+
+    inline JSArrayBuffer* toJSArrayBuffer(JSValue value)
+    {
+        if (!value.inherits(&JSArrayBuffer::s_info))
+            return 0;
+        return static_cast<JSArrayBuffer*>(value.asCell());
+    }
+
+} // namespace JSC
+
+#endif // JSArrayBuffer_h
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSArrayBufferConstructor.h"
+
+#include "Error.h"
+#include "JSArrayBuffer.h"
+#include "JSArrayBufferPrototype.h"
+#include "JSGlobalObject.h"
+
+namespace JSC {
+
+ASSERT_CLASS_FITS_IN_CELL(JSArrayBufferConstructor);
+ASSERT_HAS_TRIVIAL_DESTRUCTOR(JSArrayBufferConstructor);
+
+const ClassInfo JSArrayBufferConstructor::s_info = { "Function", &Base::s_info, 0, 0, CREATE_METHOD_TABLE(JSArrayBufferConstructor) };
+
+JSArrayBufferConstructor::JSArrayBufferConstructor(JSGlobalObject* globalObject, Structure* structure)
+    : InternalFunction(globalObject, structure)
+{
+}
+
+void JSArrayBufferConstructor::finishCreation(ExecState* exec, JSArrayBufferPrototype* arrayBufferPrototype)
+{
+    Base::finishCreation(exec->globalData(), Identifier(exec, "ArrayBuffer"));
+    putDirectWithoutTransition(exec->globalData(), exec->propertyNames().prototype, arrayBufferPrototype, DontEnum | DontDelete | ReadOnly);
+    putDirectWithoutTransition(exec->globalData(), exec->propertyNames().length, jsNumber(1), ReadOnly | DontDelete | DontEnum);
+}
+
+static EncodedJSValue JSC_HOST_CALL constructWithArrayBufferConstructor(ExecState* exec)
+{
+    int length = exec->argument(0).toInt32(exec);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+    if (length < 0)
+        return throwVMError(exec, createRangeError(exec, "ArrayBuffer size is not a small enough positive integer"));
+
+    RefPtr<ArrayBuffer> buffer = ArrayBuffer::create(length, 1);
+    if (!buffer)
+        return throwVMError(exec, createRangeError(exec, "Out of memory allocating an ArrayBuffer"));
+    exec->heap()->reportExtraMemoryCost(buffer->byteLength());
+    return JSValue::encode(JSArrayBuffer::create(exec, asInternalFunction(exec->callee())->globalObject()->arrayBufferStructure(), buffer.release()));
+}
+
+ConstructType JSArrayBufferConstructor::getConstructData(JSCell*, ConstructData& constructData)
+{
+    constructData.native.function = constructWithArrayBufferConstructor;
+    return ConstructTypeHost;
+}
+
+} // namespace JSC
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSArrayBufferPrototype.h"
+
+#include "Error.h"
+#include "JSArrayBuffer.h"
+#include "JSFunction.h"
+#include "JSGlobalObject.h"
+
+namespace JSC {
+
+ASSERT_CLASS_FITS_IN_CELL(JSArrayBufferPrototype);
+ASSERT_HAS_TRIVIAL_DESTRUCTOR(JSArrayBufferPrototype);
+
+static EncodedJSValue JSC_HOST_CALL arrayBufferProtoFuncSlice(ExecState*);
+
+const ClassInfo JSArrayBufferPrototype::s_info = { "ArrayBufferPrototype", &Base::s_info, 0, 0, CREATE_METHOD_TABLE(JSArrayBufferPrototype) };
+
+JSArrayBufferPrototype::JSArrayBufferPrototype(ExecState* exec, Structure* structure)
+    : JSNonFinalObject(exec->globalData(), structure)
+{
+}
+
+void JSArrayBufferPrototype::finishCreation(ExecState* exec, JSGlobalObject* globalObject)
+{
+    Base::finishCreation(exec->globalData());
+    ASSERT(inherits(&s_info));
+
+    putDirectWithoutTransition(exec->globalData(), exec->propertyNames().slice, JSFunction::create(exec, globalObject, 2, exec->propertyNames().slice, arrayBufferProtoFuncSlice), DontEnum);
+}
+
+// ------------------------------ Functions ---------------------------
+
+EncodedJSValue JSC_HOST_CALL arrayBufferProtoFuncSlice(ExecState* exec)
+{
+    JSArrayBuffer* thisObject = toJSArrayBuffer(exec->hostThisValue());
+    if (!thisObject)
+        return throwVMTypeError(exec);
+
+    ArrayBuffer* impl = thisObject->impl();
+    int begin = exec->argument(0).toInt32(exec);
+    int end = exec->argument(1).isUndefined() ? impl->byteLength() : exec->argument(1).toInt32(exec);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+
+    RefPtr<ArrayBuffer> result = impl->slice(begin, end);
+    if (!result)
+        return throwVMError(exec, createRangeError(exec, "Out of memory allocating an ArrayBuffer"));
+    exec->heap()->reportExtraMemoryCost(result->byteLength());
+    return JSValue::encode(JSArrayBuffer::create(exec, exec->lexicalGlobalObject()->arrayBufferStructure(), result.release()));
+}
+
+} // namespace JSC
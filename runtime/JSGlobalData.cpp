@@ -32,6 +32,7 @@
 #include "ArgList.h"
 #include "Heap.h"
 #include "CommonIdentifiers.h"
+#include "DFGWorklist.h"
 #include "DebuggerActivation.h"
 #include "FunctionConstructor.h"
 #include "GetterSetter.h"
@@ -52,6 +53,8 @@
 #include "ParserArena.h"
 #include "RegExpCache.h"
 #include "RegExpObject.h"
+#include "SamplingProfiler.h"
+#include "SharedCodeBlockData.h"
 #include "StrictEvalActivation.h"
 #include "StrongInlines.h"
 #include <wtf/Threading.h>
@@ -139,6 +142,7 @@ JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType thread
 #endif
     , parserArena(adoptPtr(new ParserArena))
     , keywords(adoptPtr(new Keywords(this)))
+    , sharedCodeBlockDataTable(adoptPtr(new SharedCodeBlockDataTable))
     , interpreter(0)
     , heap(this, heapSize)
 #if ENABLE(DFG_JIT)
@@ -161,6 +165,9 @@ JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType thread
     , m_isInitializingObject(false)
 #endif
 {
+#if ENABLE(SAMPLING_PROFILER)
+    samplingProfiler = adoptPtr(new SamplingProfiler(*this));
+#endif
     interpreter = new Interpreter;
 
     // Need to be careful to keep everything consistent here
@@ -249,6 +256,11 @@ JSGlobalData::~JSGlobalData()
 {
     // By the time this is destroyed, heap.destroy() must already have been called.
 
+#if ENABLE(SAMPLING_PROFILER)
+    // The profile holds on to identifiers, which must not outlive the identifier table.
+    samplingProfiler.clear();
+#endif
+
     delete interpreter;
 #ifndef NDEBUG
     // Zeroing out to make the behavior more predictable when someone attempts to use a deleted instance.
@@ -438,6 +450,12 @@ void JSGlobalData::recompileAllJSFunctions()
     // up throwing away code that is live on the stack.
     ASSERT(!dynamicGlobalObject);
     
+#if ENABLE(DFG_JIT)
+    // In-flight compilations refer to the code blocks that are about to go away.
+    if (dfgWorklist)
+        dfgWorklist->cancelAllPlans();
+#endif
+
     heap.objectSpace().forEachCell<Recompiler>();
 }
 
@@ -456,6 +474,11 @@ struct StackPreservingRecompiler : public MarkedBlock::VoidFunctor {
 
 void JSGlobalData::releaseExecutableMemory()
 {
+#if ENABLE(DFG_JIT)
+    if (dfgWorklist)
+        dfgWorklist->cancelAllPlans();
+#endif
+
     if (dynamicGlobalObject) {
         StackPreservingRecompiler recompiler;
         HashSet<JSCell*> roots;
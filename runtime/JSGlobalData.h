@@ -47,6 +47,7 @@
 #include <wtf/HashMap.h>
 #include <wtf/RefCounted.h>
 #include <wtf/ThreadSpecific.h>
+#include <wtf/ThreadingPrimitives.h>
 #include <wtf/WTFThreadData.h>
 #if ENABLE(REGEXP_TRACING)
 #include <wtf/ListHashSet.h>
@@ -68,9 +69,16 @@ namespace JSC {
     class NativeExecutable;
     class ParserArena;
     class RegExpCache;
+    class SamplingProfiler;
+    class SharedCodeBlockDataTable;
     class Stringifier;
     class Structure;
     class UString;
+#if ENABLE(DFG_JIT)
+    namespace DFG {
+        class Worklist;
+    }
+#endif
 #if ENABLE(REGEXP_TRACING)
     class RegExp;
 #endif
@@ -225,6 +233,7 @@ namespace JSC {
 
         OwnPtr<ParserArena> parserArena;
         OwnPtr<Keywords> keywords;
+        OwnPtr<SharedCodeBlockDataTable> sharedCodeBlockDataTable;
         Interpreter* interpreter;
 #if ENABLE(JIT)
         OwnPtr<JITThunks> jitStubs;
@@ -252,12 +261,16 @@ namespace JSC {
         void* osrExitJumpDestination;
         Vector<void*> scratchBuffers;
         size_t sizeOfLastScratchBuffer;
+        Mutex scratchBufferLock;
         
         void* scratchBufferForSize(size_t size)
         {
             if (!size)
                 return 0;
             
+            // The DFG asks for scratch buffers from its compiler threads as well.
+            MutexLocker locker(scratchBufferLock);
+            
             if (size > sizeOfLastScratchBuffer) {
                 // Protect against a N^2 memory usage pathology by ensuring
                 // that at worst, we get a geometric series, meaning that the
@@ -270,7 +283,13 @@ namespace JSC {
             
             return scratchBuffers.last();
         }
+        
+        OwnPtr<DFG::Worklist> dfgWorklist;
+#endif
 #endif
+
+#if ENABLE(SAMPLING_PROFILER)
+        OwnPtr<SamplingProfiler> samplingProfiler;
 #endif
 
         HashMap<OpaqueJSClass*, OwnPtr<OpaqueJSClassContextData> > opaqueJSClassData;
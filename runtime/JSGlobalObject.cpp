@@ -48,6 +48,9 @@
 #include "FunctionConstructor.h"
 #include "FunctionPrototype.h"
 #include "GetterSetter.h"
+#include "JSArrayBuffer.h"
+#include "JSArrayBufferConstructor.h"
+#include "JSArrayBufferPrototype.h"
 #include "JSBoundFunction.h"
 #include "JSFunction.h"
 #include "JSGlobalObjectFunctions.h"
@@ -70,6 +73,9 @@
 #include "ScopeChainMark.h"
 #include "StringConstructor.h"
 #include "StringPrototype.h"
+#include "JSTypedArray.h"
+#include "JSTypedArrayConstructor.h"
+#include "JSTypedArrayPrototype.h"
 #include "Debugger.h"
 
 #include "JSGlobalObject.lut.h"
@@ -211,6 +217,7 @@ void JSGlobalObject::reset(JSValue prototype)
     m_nullPrototypeObjectStructure.set(exec->globalData(), this, createEmptyObjectStructure(exec->globalData(), this, jsNull()));
 
     m_callbackFunctionStructure.set(exec->globalData(), this, JSCallbackFunction::createStructure(exec->globalData(), this, m_functionPrototype.get()));
+    m_typedCallbackFunctionStructure.set(exec->globalData(), this, JSTypedCallbackFunction::createStructure(exec->globalData(), this, m_functionPrototype.get()));
     m_argumentsStructure.set(exec->globalData(), this, Arguments::createStructure(exec->globalData(), this, m_objectPrototype.get()));
     m_callbackConstructorStructure.set(exec->globalData(), this, JSCallbackConstructor::createStructure(exec->globalData(), this, m_objectPrototype.get()));
     m_callbackObjectStructure.set(exec->globalData(), this, JSCallbackObject<JSNonFinalObject>::createStructure(exec->globalData(), this, m_objectPrototype.get()));
@@ -290,6 +297,22 @@ void JSGlobalObject::reset(JSValue prototype)
     putDirectWithoutTransition(exec->globalData(), Identifier(exec, "TypeError"), m_typeErrorConstructor.get(), DontEnum);
     putDirectWithoutTransition(exec->globalData(), Identifier(exec, "URIError"), m_URIErrorConstructor.get(), DontEnum);
 
+    JSArrayBufferPrototype* arrayBufferPrototype = JSArrayBufferPrototype::create(exec, this, JSArrayBufferPrototype::createStructure(exec->globalData(), this, m_objectPrototype.get()));
+    m_arrayBufferStructure.set(exec->globalData(), this, JSArrayBuffer::createStructure(exec->globalData(), this, arrayBufferPrototype));
+    JSCell* arrayBufferConstructor = JSArrayBufferConstructor::create(exec, this, JSArrayBufferConstructor::createStructure(exec->globalData(), this, m_functionPrototype.get()), arrayBufferPrototype);
+    arrayBufferPrototype->putDirectWithoutTransition(exec->globalData(), exec->propertyNames().constructor, arrayBufferConstructor, DontEnum);
+    putDirectWithoutTransition(exec->globalData(), Identifier(exec, "ArrayBuffer"), arrayBufferConstructor, DontEnum);
+
+    for (unsigned i = TypedArrayInt8; i <= TypedArrayFloat64; ++i) {
+        TypedArrayType type = static_cast<TypedArrayType>(i);
+        JSTypedArrayPrototype* typedArrayPrototype = JSTypedArrayPrototype::create(exec, this, JSTypedArrayPrototype::createStructure(exec->globalData(), this, m_objectPrototype.get()), type);
+        m_typedArrayStructures[type].set(exec->globalData(), this, JSArrayBufferView::createStructure(exec->globalData(), this, typedArrayPrototype, type));
+        JSCell* typedArrayConstructor = JSTypedArrayConstructor::create(exec, this, JSTypedArrayConstructor::createStructure(exec->globalData(), this, m_functionPrototype.get()), typedArrayPrototype, type);
+        typedArrayPrototype->putDirectWithoutTransition(exec->globalData(), exec->propertyNames().constructor, typedArrayConstructor, DontEnum);
+        putDirectWithoutTransition(exec->globalData(), Identifier(exec, JSArrayBufferView::classInfoForTypedArrayType(type)->className), typedArrayConstructor, DontEnum);
+    }
+    JSArrayBufferView::registerDescriptors(exec->globalData());
+
     m_evalFunction.set(exec->globalData(), this, JSFunction::create(exec, this, 1, exec->propertyNames().eval, globalFuncEval));
     putDirectWithoutTransition(exec->globalData(), exec->propertyNames().eval, m_evalFunction.get(), DontEnum);
 
@@ -366,6 +389,7 @@ void JSGlobalObject::visitChildren(JSCell* cell, SlotVisitor& visitor)
     visitIfNeeded(visitor, &thisObject->m_callbackConstructorStructure);
     visitIfNeeded(visitor, &thisObject->m_callbackFunctionStructure);
     visitIfNeeded(visitor, &thisObject->m_callbackObjectStructure);
+    visitIfNeeded(visitor, &thisObject->m_typedCallbackFunctionStructure);
     visitIfNeeded(visitor, &thisObject->m_dateStructure);
     visitIfNeeded(visitor, &thisObject->m_emptyObjectStructure);
     visitIfNeeded(visitor, &thisObject->m_nullPrototypeObjectStructure);
@@ -378,6 +402,9 @@ void JSGlobalObject::visitChildren(JSCell* cell, SlotVisitor& visitor)
     visitIfNeeded(visitor, &thisObject->m_regExpStructure);
     visitIfNeeded(visitor, &thisObject->m_stringObjectStructure);
     visitIfNeeded(visitor, &thisObject->m_internalFunctionStructure);
+    visitIfNeeded(visitor, &thisObject->m_arrayBufferStructure);
+    for (unsigned i = TypedArrayInt8; i <= TypedArrayFloat64; ++i)
+        visitIfNeeded(visitor, &thisObject->m_typedArrayStructures[i]);
 
     if (thisObject->m_registerArray) {
         // Outside the execution of global code, when our variables are torn off,
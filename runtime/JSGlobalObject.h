@@ -119,6 +119,7 @@ namespace JSC {
         WriteBarrier<Structure> m_callbackConstructorStructure;
         WriteBarrier<Structure> m_callbackFunctionStructure;
         WriteBarrier<Structure> m_callbackObjectStructure;
+        WriteBarrier<Structure> m_typedCallbackFunctionStructure;
         WriteBarrier<Structure> m_dateStructure;
         WriteBarrier<Structure> m_emptyObjectStructure;
         WriteBarrier<Structure> m_nullPrototypeObjectStructure;
@@ -132,6 +133,8 @@ namespace JSC {
         WriteBarrier<Structure> m_regExpStructure;
         WriteBarrier<Structure> m_stringObjectStructure;
         WriteBarrier<Structure> m_internalFunctionStructure;
+        WriteBarrier<Structure> m_arrayBufferStructure;
+        WriteBarrier<Structure> m_typedArrayStructures[TypedArrayFloat64 + 1]; // Indexed by TypedArrayType.
 
         Debugger* m_debugger;
 
@@ -252,6 +255,7 @@ namespace JSC {
         Structure* callbackConstructorStructure() const { return m_callbackConstructorStructure.get(); }
         Structure* callbackFunctionStructure() const { return m_callbackFunctionStructure.get(); }
         Structure* callbackObjectStructure() const { return m_callbackObjectStructure.get(); }
+        Structure* typedCallbackFunctionStructure() const { return m_typedCallbackFunctionStructure.get(); }
         Structure* dateStructure() const { return m_dateStructure.get(); }
         Structure* emptyObjectStructure() const { return m_emptyObjectStructure.get(); }
         Structure* nullPrototypeObjectStructure() const { return m_nullPrototypeObjectStructure.get(); }
@@ -265,6 +269,8 @@ namespace JSC {
         Structure* regExpMatchesArrayStructure() const { return m_regExpMatchesArrayStructure.get(); }
         Structure* regExpStructure() const { return m_regExpStructure.get(); }
         Structure* stringObjectStructure() const { return m_stringObjectStructure.get(); }
+        Structure* arrayBufferStructure() const { return m_arrayBufferStructure.get(); }
+        Structure* typedArrayStructure(TypedArrayType type) const { return m_typedArrayStructures[type].get(); }
 
         void setProfileGroup(unsigned value) { createRareDataIfNeeded(); m_rareData->profileGroup = value; }
         unsigned profileGroup() const
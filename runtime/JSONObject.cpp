@@ -304,6 +304,11 @@ static void appendStringToUStringBuilder(UStringBuilder& builder, const CharType
 }
     
 void Stringifier::appendQuotedString(UStringBuilder& builder, const UString& value)
+{
+    appendQuotedJSONString(builder, value);
+}
+
+void appendQuotedJSONString(UStringBuilder& builder, const UString& value)
 {
     int length = value.length();
 
@@ -31,6 +31,7 @@
 namespace JSC {
 
     class Stringifier;
+    class UStringBuilder;
 
     class JSONObject : public JSNonFinalObject {
     public:
@@ -63,6 +64,9 @@ namespace JSC {
 
     UString JSONStringify(ExecState* exec, JSValue value, unsigned indent);
 
+    // Appends the string as a JSON string literal, quoted and escaped.
+    void appendQuotedJSONString(UStringBuilder&, const UString&);
+
 } // namespace JSC
 
 #endif // JSONObject_h
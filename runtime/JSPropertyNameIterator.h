@@ -83,6 +83,11 @@ namespace JSC {
 
         void setCachedPrototypeChain(JSGlobalData& globalData, StructureChain* cachedPrototypeChain) { m_cachedPrototypeChain.set(globalData, this, cachedPrototypeChain); }
         StructureChain* cachedPrototypeChain() { return m_cachedPrototypeChain.get(); }
+
+        static size_t offsetOfCachedStructure() { return OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedStructure); }
+        static size_t offsetOfCachedPrototypeChain() { return OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedPrototypeChain); }
+        static size_t offsetOfJSStringsSize() { return OBJECT_OFFSETOF(JSPropertyNameIterator, m_jsStringsSize); }
+        static size_t offsetOfJSStrings() { return OBJECT_OFFSETOF(JSPropertyNameIterator, m_jsStrings); }
         
         static const ClassInfo s_info;
 
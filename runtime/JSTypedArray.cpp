@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSTypedArray.h"
+
+#include "JSArrayBuffer.h"
+#include "JSGlobalObject.h"
+#include "PropertyNameArray.h"
+
+namespace JSC {
+
+const ClassInfo JSArrayBufferView::s_info = { "ArrayBufferView", &Base::s_info, 0, 0, CREATE_METHOD_TABLE(JSArrayBufferView) };
+
+#define DEFINE_JS_TYPED_ARRAY(Name, name, ElementType) \
+    template<> const ClassInfo JS##Name##Array::s_info = { #Name "Array", &Base::s_info, 0, 0, CREATE_METHOD_TABLE(JS##Name##Array) }; \
+    ASSERT_CLASS_FITS_IN_CELL(JS##Name##Array);
+FOR_EACH_TYPED_ARRAY_TYPE(DEFINE_JS_TYPED_ARRAY)
+#undef DEFINE_JS_TYPED_ARRAY
+
+JSArrayBufferView::JSArrayBufferView(ExecState* exec, Structure* structure, ArrayBufferView* impl, TypedArrayType type, unsigned length)
+    : JSNonFinalObject(exec->globalData(), structure)
+    , m_impl(impl)
+    , m_storage(impl->baseAddress())
+    , m_storageLength(length)
+    , m_type(type)
+{
+}
+
+JSArrayBufferView::~JSArrayBufferView()
+{
+    ASSERT(jsCast<JSArrayBufferView*>(this));
+}
+
+void JSArrayBufferView::destroy(JSCell* cell)
+{
+    jsCast<JSArrayBufferView*>(cell)->JSArrayBufferView::~JSArrayBufferView();
+}
+
+void JSArrayBufferView::finishCreation(ExecState* exec, JSArrayBuffer* buffer)
+{
+    Base::finishCreation(exec->globalData());
+    ASSERT(inherits(&s_info));
+    ASSERT(classInfo()->typedArrayStorageType == m_type);
+
+    JSGlobalData& globalData = exec->globalData();
+    putDirect(globalData, globalData.propertyNames->length, jsNumber(m_storageLength), DontEnum | ReadOnly | DontDelete);
+    putDirect(globalData, globalData.propertyNames->byteOffset, jsNumber(m_impl->byteOffset()), DontEnum | ReadOnly | DontDelete);
+    putDirect(globalData, globalData.propertyNames->byteLength, jsNumber(byteLength()), DontEnum | ReadOnly | DontDelete);
+    if (buffer) {
+        ASSERT(buffer->impl() == m_impl->buffer());
+        putDirect(globalData, globalData.propertyNames->buffer, buffer, DontEnum | ReadOnly | DontDelete);
+    }
+}
+
+Structure* JSArrayBufferView::createStructure(JSGlobalData& globalData, JSGlobalObject* globalObject, JSValue prototype, TypedArrayType type)
+{
+    return Structure::create(globalData, globalObject, prototype, TypeInfo(ObjectType, StructureFlags), classInfoForTypedArrayType(type));
+}
+
+void JSArrayBufferView::registerDescriptors(JSGlobalData& globalData)
+{
+#define REGISTER_TYPED_ARRAY_DESCRIPTOR(Name, name, ElementType) \
+    globalData.registerTypedArrayDescriptor(static_cast<Name##Array*>(0), TypedArrayDescriptor(&JS##Name##Array::s_info, OBJECT_OFFSETOF(JSArrayBufferView, m_storage), OBJECT_OFFSETOF(JSArrayBufferView, m_storageLength)));
+    FOR_EACH_TYPED_ARRAY_TYPE(REGISTER_TYPED_ARRAY_DESCRIPTOR)
+#undef REGISTER_TYPED_ARRAY_DESCRIPTOR
+}
+
+unsigned JSArrayBufferView::elementSizeForTypedArrayType(TypedArrayType type)
+{
+    switch (type) {
+#define TYPED_ARRAY_ELEMENT_SIZE(Name, name, ElementType) \
+    case TypedArray##Name: \
+        return sizeof(ElementType);
+    FOR_EACH_TYPED_ARRAY_TYPE(TYPED_ARRAY_ELEMENT_SIZE)
+#undef TYPED_ARRAY_ELEMENT_SIZE
+    case TypedArrayNone:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
+const ClassInfo* JSArrayBufferView::classInfoForTypedArrayType(TypedArrayType type)
+{
+    switch (type) {
+#define TYPED_ARRAY_CLASS_INFO(Name, name, ElementType) \
+    case TypedArray##Name: \
+        return &JS##Name##Array::s_info;
+    FOR_EACH_TYPED_ARRAY_TYPE(TYPED_ARRAY_CLASS_INFO)
+#undef TYPED_ARRAY_CLASS_INFO
+    case TypedArrayNone:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
+JSArrayBuffer* JSArrayBufferView::buffer(ExecState* exec)
+{
+    JSGlobalData& globalData = exec->globalData();
+    if (JSValue buffer = getDirect(globalData, globalData.propertyNames->buffer))
+        return jsCast<JSArrayBuffer*>(buffer.asCell());
+
+    JSArrayBuffer* buffer = JSArrayBuffer::create(exec, globalObject()->arrayBufferStructure(), m_impl->buffer());
+    putDirect(globalData, globalData.propertyNames->buffer, buffer, DontEnum | ReadOnly | DontDelete);
+    return buffer;
+}
+
+void JSArrayBufferView::setIndex(unsigned i, int32_t value)
+{
+    ASSERT(canAccessIndex(i));
+    switch (m_type) {
+    case TypedArrayInt8:
+        static_cast<int8_t*>(m_storage)[i] = static_cast<int8_t>(value);
+        return;
+    case TypedArrayInt16:
+        static_cast<int16_t*>(m_storage)[i] = static_cast<int16_t>(value);
+        return;
+    case TypedArrayInt32:
+        static_cast<int32_t*>(m_storage)[i] = value;
+        return;
+    case TypedArrayUint8:
+        static_cast<uint8_t*>(m_storage)[i] = static_cast<uint8_t>(value);
+        return;
+    case TypedArrayUint8Clamped:
+        if (value & ~0xFF)
+            value = value < 0 ? 0 : 255;
+        static_cast<uint8_t*>(m_storage)[i] = static_cast<uint8_t>(value);
+        return;
+    case TypedArrayUint16:
+        static_cast<uint16_t*>(m_storage)[i] = static_cast<uint16_t>(value);
+        return;
+    case TypedArrayUint32:
+        static_cast<uint32_t*>(m_storage)[i] = static_cast<uint32_t>(value);
+        return;
+    case TypedArrayFloat32:
+        static_cast<float*>(m_storage)[i] = static_cast<float>(value);
+        return;
+    case TypedArrayFloat64:
+        static_cast<double*>(m_storage)[i] = value;
+        return;
+    case TypedArrayNone:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+void JSArrayBufferView::setIndex(unsigned i, double value)
+{
+    ASSERT(canAccessIndex(i));
+    switch (m_type) {
+    case TypedArrayInt8:
+    case TypedArrayInt16:
+    case TypedArrayInt32:
+    case TypedArrayUint8:
+    case TypedArrayUint16:
+    case TypedArrayUint32:
+        setIndex(i, toInt32(value));
+        return;
+    case TypedArrayUint8Clamped:
+        if (!(value > 0)) // Clamp NaN to 0
+            value = 0;
+        else if (value > 255)
+            value = 255;
+        static_cast<uint8_t*>(m_storage)[i] = static_cast<uint8_t>(value + 0.5);
+        return;
+    case TypedArrayFloat32:
+        static_cast<float*>(m_storage)[i] = static_cast<float>(value);
+        return;
+    case TypedArrayFloat64:
+        static_cast<double*>(m_storage)[i] = value;
+        return;
+    case TypedArrayNone:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+void JSArrayBufferView::setIndex(ExecState* exec, unsigned i, JSValue value)
+{
+    if (value.isInt32()) {
+        if (canAccessIndex(i))
+            setIndex(i, value.asInt32());
+        return;
+    }
+    double number = value.toNumber(exec);
+    if (exec->hadException())
+        return;
+    if (canAccessIndex(i))
+        setIndex(i, number);
+}
+
+bool JSArrayBufferView::getOwnPropertySlot(JSCell* cell, ExecState* exec, const Identifier& propertyName, PropertySlot& slot)
+{
+    JSArrayBufferView* thisObject = jsCast<JSArrayBufferView*>(cell);
+    bool ok;
+    unsigned index = propertyName.toUInt32(ok);
+    if (ok && thisObject->canAccessIndex(index)) {
+        slot.setValue(thisObject->getIndex(index));
+        return true;
+    }
+    if (propertyName == exec->propertyNames().buffer)
+        thisObject->buffer(exec);
+    return JSObject::getOwnPropertySlot(thisObject, exec, propertyName, slot);
+}
+
+bool JSArrayBufferView::getOwnPropertyDescriptor(JSObject* object, ExecState* exec, const Identifier& propertyName, PropertyDescriptor& descriptor)
+{
+    JSArrayBufferView* thisObject = jsCast<JSArrayBufferView*>(object);
+    bool ok;
+    unsigned index = propertyName.toUInt32(ok);
+    if (ok && thisObject->canAccessIndex(index)) {
+        descriptor.setDescriptor(thisObject->getIndex(index), DontDelete);
+        return true;
+    }
+    if (propertyName == exec->propertyNames().buffer)
+        thisObject->buffer(exec);
+    return JSObject::getOwnPropertyDescriptor(thisObject, exec, propertyName, descriptor);
+}
+
+bool JSArrayBufferView::getOwnPropertySlotByIndex(JSCell* cell, ExecState* exec, unsigned propertyName, PropertySlot& slot)
+{
+    JSArrayBufferView* thisObject = jsCast<JSArrayBufferView*>(cell);
+    if (thisObject->canAccessIndex(propertyName)) {
+        slot.setValue(thisObject->getIndex(propertyName));
+        return true;
+    }
+    return JSObject::getOwnPropertySlot(thisObject, exec, Identifier::from(exec, propertyName), slot);
+}
+
+void JSArrayBufferView::put(JSCell* cell, ExecState* exec, const Identifier& propertyName, JSValue value, PutPropertySlot& slot)
+{
+    JSArrayBufferView* thisObject = jsCast<JSArrayBufferView*>(cell);
+    bool ok;
+    unsigned index = propertyName.toUInt32(ok);
+    if (ok) {
+        thisObject->setIndex(exec, index, value);
+        return;
+    }
+    if (propertyName == exec->propertyNames().buffer)
+        thisObject->buffer(exec);
+    JSObject::put(thisObject, exec, propertyName, value, slot);
+}
+
+void JSArrayBufferView::putByIndex(JSCell* cell, ExecState* exec, unsigned propertyName, JSValue value)
+{
+    jsCast<JSArrayBufferView*>(cell)->setIndex(exec, propertyName, value);
+}
+
+bool JSArrayBufferView::deleteProperty(JSCell* cell, ExecState* exec, const Identifier& propertyName)
+{
+    JSArrayBufferView* thisObject = jsCast<JSArrayBufferView*>(cell);
+    bool isStrictUInt32;
+    unsigned i = propertyName.toUInt32(isStrictUInt32);
+    if (isStrictUInt32)
+        return deletePropertyByIndex(thisObject, exec, i);
+    return JSObject::deleteProperty(thisObject, exec, propertyName);
+}
+
+bool JSArrayBufferView::deletePropertyByIndex(JSCell* cell, ExecState* exec, unsigned propertyName)
+{
+    JSArrayBufferView* thisObject = jsCast<JSArrayBufferView*>(cell);
+    if (thisObject->canAccessIndex(propertyName))
+        return false;
+    return JSObject::deletePropertyByIndex(thisObject, exec, propertyName);
+}
+
+void JSArrayBufferView::getOwnPropertyNames(JSObject* object, ExecState* exec, PropertyNameArray& propertyNames, EnumerationMode mode)
+{
+    JSArrayBufferView* thisObject = jsCast<JSArrayBufferView*>(object);
+    unsigned length = thisObject->length();
+    for (unsigned i = 0; i < length; ++i)
+        propertyNames.add(Identifier::from(exec, i));
+    if (mode == IncludeDontEnumProperties)
+        thisObject->buffer(exec);
+    JSObject::getOwnPropertyNames(thisObject, exec, propertyNames, mode);
+}
+
+JSArrayBufferView* createTypedArray(ExecState* exec, JSGlobalObject* globalObject, TypedArrayType type, PassRefPtr<ArrayBuffer> buffer, unsigned byteOffset, unsigned length, JSArrayBuffer* bufferObject)
+{
+    switch (type) {
+#define CREATE_TYPED_ARRAY(Name, name, ElementType) \
+    case TypedArray##Name: { \
+        RefPtr<Name##Array> view = Name##Array::create(buffer, byteOffset, length); \
+        if (!view) \
+            return 0; \
+        return JS##Name##Array::create(exec, globalObject->typedArrayStructure(type), view.release(), bufferObject); \
+    }
+    FOR_EACH_TYPED_ARRAY_TYPE(CREATE_TYPED_ARRAY)
+#undef CREATE_TYPED_ARRAY
+    case TypedArrayNone:
+        break;
+    }
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
+JSArrayBufferView* createTypedArray(ExecState* exec, JSGlobalObject* globalObject, TypedArrayType type, unsigned length)
+{
+    unsigned elementSize = JSArrayBufferView::elementSizeForTypedArrayType(type);
+    RefPtr<ArrayBuffer> buffer = ArrayBuffer::create(length, elementSize);
+    if (!buffer)
+        return 0;
+    exec->heap()->reportExtraMemoryCost(buffer->byteLength());
+    return createTypedArray(exec, globalObject, type, buffer.release(), 0, length);
+}
+
+} // namespace JSC
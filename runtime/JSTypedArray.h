@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef JSTypedArray_h
+#define JSTypedArray_h
+
+#include "JSObject.h"
+
+#include <wtf/Float32Array.h>
+#include <wtf/Float64Array.h>
+#include <wtf/Int16Array.h>
+#include <wtf/Int32Array.h>
+#include <wtf/Int8Array.h>
+#include <wtf/Uint16Array.h>
+#include <wtf/Uint32Array.h>
+#include <wtf/Uint8Array.h>
+#include <wtf/Uint8ClampedArray.h>
+
+// macro(Name, name, ElementType) for every TypedArrayType but TypedArrayNone.
+#define FOR_EACH_TYPED_ARRAY_TYPE(macro) \
+    macro(Int8, int8, int8_t) \
+    macro(Int16, int16, int16_t) \
+    macro(Int32, int32, int32_t) \
+    macro(Uint8, uint8, uint8_t) \
+    macro(Uint8Clamped, uint8Clamped, uint8_t) \
+    macro(Uint16, uint16, uint16_t) \
+    macro(Uint32, uint32, uint32_t) \
+    macro(Float32, float32, float) \
+    macro(Float64, float64, double)
+
+namespace JSC {
+
+    class JSArrayBuffer;
+
+    // The JS wrapper of a WTF::ArrayBufferView. The view's element storage and
+    // length are cached in the cell, so that the JITs can get at the elements
+    // without calling into the view; the DFG finds them through the
+    // TypedArrayDescriptors that registerDescriptors() hands to the JSGlobalData.
+    // Every TypedArrayType has its own JSTypedArray subclass, so that its
+    // ClassInfo tells the DFG's predictions which type it is.
+    class JSArrayBufferView : public JSNonFinalObject {
+    public:
+        typedef JSNonFinalObject Base;
+
+        static JS_EXPORTDATA const ClassInfo s_info;
+
+        static Structure* createStructure(JSGlobalData&, JSGlobalObject*, JSValue prototype, TypedArrayType);
+        static void registerDescriptors(JSGlobalData&);
+
+        TypedArrayType typedArrayType() const { return m_type; }
+        ArrayBufferView* impl() const { return m_impl.get(); }
+        void* baseAddress() const { return m_storage; }
+        unsigned length() const { return m_storageLength; }
+        unsigned elementSize() const { return elementSizeForTypedArrayType(m_type); }
+        unsigned byteLength() const { return m_storageLength * elementSize(); }
+
+        // The JSArrayBuffer for the view's buffer, which is created the first
+        // time anyone asks for it.
+        JSArrayBuffer* buffer(ExecState*);
+
+        bool canAccessIndex(unsigned i) const { return i < m_storageLength; }
+        JSValue getIndex(unsigned i) const;
+        void setIndex(unsigned i, int32_t value);
+        void setIndex(unsigned i, double value);
+        void setIndex(ExecState*, unsigned i, JSValue);
+
+        static unsigned elementSizeForTypedArrayType(TypedArrayType);
+        static const ClassInfo* classInfoForTypedArrayType(TypedArrayType);
+
+        ~JSArrayBufferView();
+        static void destroy(JSCell*);
+
+        static bool getOwnPropertySlot(JSCell*, ExecState*, const Identifier& propertyName, PropertySlot&);
+        static bool getOwnPropertySlotByIndex(JSCell*, ExecState*, unsigned propertyName, PropertySlot&);
+        static bool getOwnPropertyDescriptor(JSObject*, ExecState*, const Identifier&, PropertyDescriptor&);
+        static void put(JSCell*, ExecState*, const Identifier& propertyName, JSValue, PutPropertySlot&);
+        static void putByIndex(JSCell*, ExecState*, unsigned propertyName, JSValue);
+        static bool deleteProperty(JSCell*, ExecState*, const Identifier& propertyName);
+        static bool deletePropertyByIndex(JSCell*, ExecState*, unsigned propertyName);
+        static void getOwnPropertyNames(JSObject*, ExecState*, PropertyNameArray&, EnumerationMode);
+
+    protected:
+        static const unsigned StructureFlags = OverridesGetOwnPropertySlot | OverridesGetPropertyNames | JSObject::StructureFlags;
+
+        JSArrayBufferView(ExecState*, Structure*, ArrayBufferView*, TypedArrayType, unsigned length);
+        void finishCreation(ExecState*, JSArrayBuffer*);
+
+    private:
+        RefPtr<ArrayBufferView> m_impl;
+        void* m_storage;
+        unsigned m_storageLength;
+        TypedArrayType m_type;
+    };
+
+    template<typename ViewClass, TypedArrayType arrayType>
+    class JSTypedArray : public JSArrayBufferView {
+    public:
+        typedef JSArrayBufferView Base;
+        typedef ViewClass ViewType;
+
+        static const TypedArrayType TypedArrayStorageType = arrayType;
+
+        // If the JSArrayBuffer for the view's buffer already exists, pass it in
+        // so that the view's buffer property is that object.
+        static JSTypedArray* create(ExecState* exec, Structure* structure, PassRefPtr<ViewClass> impl, JSArrayBuffer* buffer = 0)
+        {
+            RefPtr<ViewClass> view = impl;
+            JSTypedArray* array = new (NotNull, allocateCell<JSTypedArray>(*exec->heap())) JSTypedArray(exec, structure, view.get());
+            array->finishCreation(exec, buffer);
+            return array;
+        }
+
+        static const ClassInfo s_info;
+
+        ViewClass* impl() const { return static_cast<ViewClass*>(Base::impl()); }
+
+    private:
+        JSTypedArray(ExecState* exec, Structure* structure, ViewClass* impl)
+            : Base(exec, structure, impl, arrayType, impl->length())
+        {
+        }
+    };
+
+#define DECLARE_JS_TYPED_ARRAY(Name, name, ElementType) \
+    typedef JSTypedArray<Name##Array, TypedArray##Name> JS##Name##Array; \
+    template<> const ClassInfo JS##Name##Array::s_info;
+    FOR_EACH_TYPED_ARRAY_TYPE(DECLARE_JS_TYPED_ARRAY)
+#undef DECLARE_JS_TYPED_ARRAY
+
+    // Create a view of the given type on part of a buffer, or return 0 if the
+    // part is not within the buffer or is misaligned.
+    JSArrayBufferView* createTypedArray(ExecState*, JSGlobalObject*, TypedArrayType, PassRefPtr<ArrayBuffer>, unsigned byteOffset, unsigned length, JSArrayBuffer* = 0);
+    // Create a view of the given type on a new, zero filled buffer, or return 0
+    // if the buffer could not be allocated.
+    JSArrayBufferView* createTypedArray(ExecState*, JSGlobalObject*, TypedArrayType, unsigned length);
+
+    inline JSArrayBufferView* toJSArrayBufferView(JSValue value)
+    {
+        if (!value.inherits(&JSArrayBufferView::s_info))
+            return 0;
+        return static_cast<JSArrayBufferView*>(value.asCell());
+    }
+
+    inline JSValue JSArrayBufferView::getIndex(unsigned i) const
+    {
+        ASSERT(canAccessIndex(i));
+        switch (m_type) {
+        case TypedArrayInt8:
+            return jsNumber(static_cast<int8_t*>(m_storage)[i]);
+        case TypedArrayInt16:
+            return jsNumber(static_cast<int16_t*>(m_storage)[i]);
+        case TypedArrayInt32:
+            return jsNumber(static_cast<int32_t*>(m_storage)[i]);
+        case TypedArrayUint8:
+        case TypedArrayUint8Clamped:
+            return jsNumber(static_cast<uint8_t*>(m_storage)[i]);
+        case TypedArrayUint16:
+            return jsNumber(static_cast<uint16_t*>(m_storage)[i]);
+        case TypedArrayUint32:
+            return jsNumber(static_cast<uint32_t*>(m_storage)[i]);
+        case TypedArrayFloat32: {
+            // Anything can be stored in the buffer, so NaNs have to be purified
+            // before they are boxed.
+            double value = static_cast<float*>(m_storage)[i];
+            return isnan(value) ? jsNaN() : jsNumber(value);
+        }
+        case TypedArrayFloat64: {
+            double value = static_cast<double*>(m_storage)[i];
+            return isnan(value) ? jsNaN() : jsNumber(value);
+        }
+        case TypedArrayNone:
+            break;
+        }
+        ASSERT_NOT_REACHED();
+        return jsUndefined();
+    }
+
+} // namespace JSC
+
+#endif // JSTypedArray_h
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSTypedArrayConstructor.h"
+
+#include "Error.h"
+#include "JSArrayBuffer.h"
+#include "JSGlobalObject.h"
+#include "JSTypedArray.h"
+#include "JSTypedArrayPrototype.h"
+
+namespace JSC {
+
+ASSERT_CLASS_FITS_IN_CELL(JSTypedArrayConstructor);
+ASSERT_HAS_TRIVIAL_DESTRUCTOR(JSTypedArrayConstructor);
+
+const ClassInfo JSTypedArrayConstructor::s_info = { "Function", &Base::s_info, 0, 0, CREATE_METHOD_TABLE(JSTypedArrayConstructor) };
+
+JSTypedArrayConstructor::JSTypedArrayConstructor(JSGlobalObject* globalObject, Structure* structure, TypedArrayType type)
+    : InternalFunction(globalObject, structure)
+    , m_type(type)
+{
+}
+
+void JSTypedArrayConstructor::finishCreation(ExecState* exec, JSTypedArrayPrototype* typedArrayPrototype)
+{
+    Base::finishCreation(exec->globalData(), Identifier(exec, JSArrayBufferView::classInfoForTypedArrayType(m_type)->className));
+    putDirectWithoutTransition(exec->globalData(), exec->propertyNames().prototype, typedArrayPrototype, DontEnum | DontDelete | ReadOnly);
+    putDirectWithoutTransition(exec->globalData(), exec->propertyNames().length, jsNumber(3), ReadOnly | DontDelete | DontEnum);
+    putDirectWithoutTransition(exec->globalData(), exec->propertyNames().BYTES_PER_ELEMENT, jsNumber(JSArrayBufferView::elementSizeForTypedArrayType(m_type)), DontEnum | DontDelete | ReadOnly);
+}
+
+static EncodedJSValue constructTypedArrayOnBuffer(ExecState* exec, JSGlobalObject* globalObject, TypedArrayType type, JSArrayBuffer* buffer)
+{
+    unsigned elementSize = JSArrayBufferView::elementSizeForTypedArrayType(type);
+    unsigned byteLength = buffer->impl()->byteLength();
+    int byteOffset = exec->argument(1).toInt32(exec);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+    if (byteOffset < 0 || static_cast<unsigned>(byteOffset) > byteLength)
+        return throwVMError(exec, createRangeError(exec, "Start offset is out of range"));
+
+    unsigned length;
+    if (exec->argument(2).isUndefined()) {
+        if ((byteLength - byteOffset) % elementSize)
+            return throwVMError(exec, createRangeError(exec, "ArrayBuffer length minus the byteOffset is not a multiple of the element size"));
+        length = (byteLength - byteOffset) / elementSize;
+    } else {
+        int requestedLength = exec->argument(2).toInt32(exec);
+        if (exec->hadException())
+            return JSValue::encode(jsUndefined());
+        if (requestedLength < 0)
+            return throwVMError(exec, createRangeError(exec, "Length is out of range"));
+        length = requestedLength;
+    }
+
+    JSArrayBufferView* result = createTypedArray(exec, globalObject, type, buffer->impl(), byteOffset, length, buffer);
+    if (!result)
+        return throwVMError(exec, createRangeError(exec, "Length is out of range, or the start offset is not a multiple of the element size"));
+    return JSValue::encode(result);
+}
+
+static EncodedJSValue JSC_HOST_CALL constructWithTypedArrayConstructor(ExecState* exec)
+{
+    JSTypedArrayConstructor* constructor = jsCast<JSTypedArrayConstructor*>(exec->callee());
+    JSGlobalObject* globalObject = constructor->globalObject();
+    TypedArrayType type = constructor->typedArrayType();
+    JSValue argument = exec->argument(0);
+
+    if (JSArrayBuffer* buffer = toJSArrayBuffer(argument))
+        return constructTypedArrayOnBuffer(exec, globalObject, type, buffer);
+
+    if (!argument.isObject()) {
+        int length = argument.toInt32(exec);
+        if (exec->hadException())
+            return JSValue::encode(jsUndefined());
+        if (length < 0)
+            return throwVMError(exec, createRangeError(exec, "Array size is not a small enough positive integer"));
+        JSArrayBufferView* result = createTypedArray(exec, globalObject, type, length);
+        if (!result)
+            return throwVMError(exec, createRangeError(exec, "Out of memory allocating a typed array"));
+        return JSValue::encode(result);
+    }
+
+    // Copy the elements of a typed array or any other array-like object.
+    JSObject* source = asObject(argument);
+    JSArrayBufferView* sourceView = toJSArrayBufferView(source);
+    unsigned length = sourceView ? sourceView->length() : source->get(exec, exec->propertyNames().length).toUInt32(exec);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+    JSArrayBufferView* result = createTypedArray(exec, globalObject, type, length);
+    if (!result)
+        return throwVMError(exec, createRangeError(exec, "Out of memory allocating a typed array"));
+    if (sourceView) {
+        for (unsigned i = 0; i < length; ++i)
+            result->setIndex(i, sourceView->getIndex(i).asNumber());
+        return JSValue::encode(result);
+    }
+    for (unsigned i = 0; i < length; ++i) {
+        double value = source->get(exec, i).toNumber(exec);
+        if (exec->hadException())
+            return JSValue::encode(jsUndefined());
+        result->setIndex(i, value);
+    }
+    return JSValue::encode(result);
+}
+
+ConstructType JSTypedArrayConstructor::getConstructData(JSCell*, ConstructData& constructData)
+{
+    constructData.native.function = constructWithTypedArrayConstructor;
+    return ConstructTypeHost;
+}
+
+} // namespace JSC
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "JSTypedArrayPrototype.h"
+
+#include "Error.h"
+#include "JSArrayBuffer.h"
+#include "JSFunction.h"
+#include "JSGlobalObject.h"
+#include "JSTypedArray.h"
+
+namespace JSC {
+
+ASSERT_CLASS_FITS_IN_CELL(JSTypedArrayPrototype);
+ASSERT_HAS_TRIVIAL_DESTRUCTOR(JSTypedArrayPrototype);
+
+static EncodedJSValue JSC_HOST_CALL typedArrayProtoFuncSet(ExecState*);
+static EncodedJSValue JSC_HOST_CALL typedArrayProtoFuncSubarray(ExecState*);
+
+const ClassInfo JSTypedArrayPrototype::s_info = { "TypedArrayPrototype", &Base::s_info, 0, 0, CREATE_METHOD_TABLE(JSTypedArrayPrototype) };
+
+JSTypedArrayPrototype::JSTypedArrayPrototype(ExecState* exec, Structure* structure)
+    : JSNonFinalObject(exec->globalData(), structure)
+{
+}
+
+void JSTypedArrayPrototype::finishCreation(ExecState* exec, JSGlobalObject* globalObject, TypedArrayType type)
+{
+    Base::finishCreation(exec->globalData());
+    ASSERT(inherits(&s_info));
+
+    putDirectWithoutTransition(exec->globalData(), exec->propertyNames().BYTES_PER_ELEMENT, jsNumber(JSArrayBufferView::elementSizeForTypedArrayType(type)), DontEnum | DontDelete | ReadOnly);
+    putDirectWithoutTransition(exec->globalData(), exec->propertyNames().set, JSFunction::create(exec, globalObject, 2, exec->propertyNames().set, typedArrayProtoFuncSet), DontEnum);
+    putDirectWithoutTransition(exec->globalData(), exec->propertyNames().subarray, JSFunction::create(exec, globalObject, 2, exec->propertyNames().subarray, typedArrayProtoFuncSubarray), DontEnum);
+}
+
+// ------------------------------ Functions ---------------------------
+
+EncodedJSValue JSC_HOST_CALL typedArrayProtoFuncSet(ExecState* exec)
+{
+    JSArrayBufferView* thisObject = toJSArrayBufferView(exec->hostThisValue());
+    if (!thisObject)
+        return throwVMTypeError(exec);
+
+    JSValue sourceValue = exec->argument(0);
+    if (!sourceValue.isObject())
+        return throwVMTypeError(exec);
+    int offset = exec->argument(1).toInt32(exec);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+    if (offset < 0 || static_cast<unsigned>(offset) > thisObject->length())
+        return throwVMError(exec, createRangeError(exec, "Offset is out of range"));
+    unsigned available = thisObject->length() - offset;
+
+    if (JSArrayBufferView* source = toJSArrayBufferView(sourceValue)) {
+        unsigned length = source->length();
+        if (length > available)
+            return throwVMError(exec, createRangeError(exec, "Source is too large"));
+        if (source->typedArrayType() == thisObject->typedArrayType()) {
+            memmove(static_cast<char*>(thisObject->baseAddress()) + offset * thisObject->elementSize(), source->baseAddress(), source->byteLength());
+            return JSValue::encode(jsUndefined());
+        }
+        // The views may share a buffer, so all of the source has to be read
+        // before any of it is overwritten.
+        Vector<double> values(length);
+        for (unsigned i = 0; i < length; ++i)
+            values[i] = source->getIndex(i).asNumber();
+        for (unsigned i = 0; i < length; ++i)
+            thisObject->setIndex(offset + i, values[i]);
+        return JSValue::encode(jsUndefined());
+    }
+
+    JSObject* source = asObject(sourceValue);
+    unsigned length = source->get(exec, exec->propertyNames().length).toUInt32(exec);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+    if (length > available)
+        return throwVMError(exec, createRangeError(exec, "Source is too large"));
+    for (unsigned i = 0; i < length; ++i) {
+        double value = source->get(exec, i).toNumber(exec);
+        if (exec->hadException())
+            return JSValue::encode(jsUndefined());
+        thisObject->setIndex(offset + i, value);
+    }
+    return JSValue::encode(jsUndefined());
+}
+
+static unsigned clampSubarrayIndex(int index, unsigned length)
+{
+    if (index < 0) {
+        index += length;
+        if (index < 0)
+            return 0;
+    }
+    return std::min(static_cast<unsigned>(index), length);
+}
+
+EncodedJSValue JSC_HOST_CALL typedArrayProtoFuncSubarray(ExecState* exec)
+{
+    JSArrayBufferView* thisObject = toJSArrayBufferView(exec->hostThisValue());
+    if (!thisObject)
+        return throwVMTypeError(exec);
+
+    unsigned length = thisObject->length();
+    unsigned begin = clampSubarrayIndex(exec->argument(0).toInt32(exec), length);
+    unsigned end = exec->argument(1).isUndefined() ? length : clampSubarrayIndex(exec->argument(1).toInt32(exec), length);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+    if (end < begin)
+        end = begin;
+
+    ArrayBufferView* impl = thisObject->impl();
+    unsigned byteOffset = impl->byteOffset() + begin * thisObject->elementSize();
+    JSArrayBufferView* result = createTypedArray(exec, thisObject->globalObject(), thisObject->typedArrayType(), impl->buffer(), byteOffset, end - begin, thisObject->buffer(exec));
+    ASSERT(result);
+    return JSValue::encode(result);
+}
+
+} // namespace JSC
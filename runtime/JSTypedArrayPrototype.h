@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef JSTypedArrayPrototype_h
+#define JSTypedArrayPrototype_h
+
+#include "JSObject.h"
+
+namespace JSC {
+
+    // The prototype of one of the typed array types. Its functions work on a
+    // view of any type.
+    class JSTypedArrayPrototype : public JSNonFinalObject {
+    public:
+        typedef JSNonFinalObject Base;
+
+        static JSTypedArrayPrototype* create(ExecState* exec, JSGlobalObject* globalObject, Structure* structure, TypedArrayType type)
+        {
+            JSTypedArrayPrototype* prototype = new (NotNull, allocateCell<JSTypedArrayPrototype>(*exec->heap())) JSTypedArrayPrototype(exec, structure);
+            prototype->finishCreation(exec, globalObject, type);
+            return prototype;
+        }
+
+        static const ClassInfo s_info;
+
+        static Structure* createStructure(JSGlobalData& globalData, JSGlobalObject* globalObject, JSValue prototype)
+        {
+            return Structure::create(globalData, globalObject, prototype, TypeInfo(ObjectType, StructureFlags), &s_info);
+        }
+
+    protected:
+        void finishCreation(ExecState*, JSGlobalObject*, TypedArrayType);
+
+    private:
+        JSTypedArrayPrototype(ExecState*, Structure*);
+    };
+
+} // namespace JSC
+
+#endif // JSTypedArrayPrototype_h
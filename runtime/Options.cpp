@@ -35,7 +35,9 @@
 #endif
 
 // Set to 1 to control the heuristics using environment variables.
+#ifndef ENABLE_RUN_TIME_HEURISTICS
 #define ENABLE_RUN_TIME_HEURISTICS 0
+#endif
 
 #if ENABLE(RUN_TIME_HEURISTICS)
 #include <stdio.h>
@@ -90,6 +92,8 @@ unsigned maximumNumberOfSharedSegments;
 unsigned sharedStackWakeupThreshold;
 unsigned numberOfGCMarkers;
 unsigned opaqueRootMergeThreshold;
+unsigned minimumIncrementalMarkingStepSize;
+unsigned numberOfDFGCompilerThreads;
 
 #if ENABLE(RUN_TIME_HEURISTICS)
 static bool parse(const char* string, int32_t& value)
@@ -174,11 +178,24 @@ void initializeOptions()
     SET(sharedStackWakeupThreshold,           1);
     SET(opaqueRootMergeThreshold,             1000);
 
+    // Full collections that are not asked to sweep are marked a step at a time
+    // from the allocation slow path, visiting at least this many cells per step.
+    // Zero means that every full collection stops the world.
+#if ENABLE(GGC)
+    SET(minimumIncrementalMarkingStepSize,    1000);
+#else
+    SET(minimumIncrementalMarkingStepSize,    0);
+#endif
+
     int cpusToUse = 1;
 #if ENABLE(PARALLEL_GC)
     cpusToUse = WTF::numberOfProcessorCores();
 #endif
-    // We don't scale so well beyond 4.
+    // We don't scale so well beyond 4. Markers share work through a single
+    // lock-protected mark stack holding a few segments, so extra markers mostly
+    // wait on that lock. This applies on Linux as well; builds with
+    // ENABLE_RUN_TIME_HEURISTICS can raise the count through JSC_numberOfGCMarkers
+    // and measure with tests/perf/run-gc-marking-benchmark.
     if (cpusToUse > 4)
         cpusToUse = 4;
     // Be paranoid, it is the OS we're dealing with, after all.
@@ -187,6 +204,10 @@ void initializeOptions()
     
     SET(numberOfGCMarkers, cpusToUse);
 
+    // Optimizing compilations are handed off to this many background threads. Zero
+    // means that the DFG compiles synchronously on the thread that triggered it.
+    SET(numberOfDFGCompilerThreads, 1);
+
     ASSERT(executionCounterValueForDontOptimizeAnytimeSoon <= executionCounterValueForOptimizeAfterLongWarmUp);
     ASSERT(executionCounterValueForOptimizeAfterLongWarmUp <= executionCounterValueForOptimizeAfterWarmUp);
     ASSERT(executionCounterValueForOptimizeAfterWarmUp <= executionCounterValueForOptimizeSoon);
@@ -75,6 +75,8 @@ extern unsigned maximumNumberOfSharedSegments;
 extern unsigned sharedStackWakeupThreshold;
 JS_EXPORTDATA extern unsigned numberOfGCMarkers;
 JS_EXPORTDATA extern unsigned opaqueRootMergeThreshold;
+extern unsigned minimumIncrementalMarkingStepSize;
+extern unsigned numberOfDFGCompilerThreads;
 
 void initializeOptions();
 
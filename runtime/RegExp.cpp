@@ -269,7 +269,7 @@ RegExp* RegExp::create(JSGlobalData& globalData, const UString& patternString, R
     return globalData.regExpCache()->lookupOrCreate(patternString, flags);
 }
 
-void RegExp::compile(JSGlobalData* globalData, Yarr::YarrCharSize charSize)
+void RegExp::compile(JSGlobalData* globalData, Yarr::YarrCharSize charSize, Yarr::YarrJITCompileMode compileMode)
 {
     Yarr::YarrPattern pattern(m_patternString, ignoreCase(), multiline(), &m_constructionError);
     if (m_constructionError) {
@@ -287,8 +287,8 @@ void RegExp::compile(JSGlobalData* globalData, Yarr::YarrCharSize charSize)
     }
 
 #if ENABLE(YARR_JIT)
-    if (!pattern.m_containsBackreferences && globalData->canUseJIT()) {
-        Yarr::jitCompile(pattern, charSize, globalData, m_representation->m_regExpJITCode);
+    if (globalData->canUseJIT()) {
+        Yarr::jitCompile(pattern, m_patternString, charSize, globalData, m_representation->m_regExpJITCode, compileMode);
 #if ENABLE(YARR_JIT_DEBUG)
         if (!m_representation->m_regExpJITCode.isFallBack())
             m_state = JITCode;
@@ -303,9 +303,11 @@ void RegExp::compile(JSGlobalData* globalData, Yarr::YarrCharSize charSize)
     }
 #else
     UNUSED_PARAM(charSize);
+    UNUSED_PARAM(compileMode);
 #endif
 
-    m_representation->m_regExpBytecode = Yarr::byteCompile(pattern, &globalData->m_regExpAllocator);
+    if (!m_representation->m_regExpBytecode)
+        m_representation->m_regExpBytecode = Yarr::byteCompile(pattern, &globalData->m_regExpAllocator);
 }
 
 void RegExp::compileIfNecessary(JSGlobalData& globalData, Yarr::YarrCharSize charSize)
@@ -330,6 +332,26 @@ void RegExp::compileIfNecessary(JSGlobalData& globalData, Yarr::YarrCharSize cha
     compile(&globalData, charSize);
 }
 
+void RegExp::compileIfNecessaryMatchOnly(JSGlobalData& globalData, Yarr::YarrCharSize charSize)
+{
+    ASSERT(!!m_representation == (m_state == JITCode || m_state == ByteCode));
+
+    if (m_representation) {
+#if ENABLE(YARR_JIT)
+        if (m_state != JITCode)
+            return;
+        if ((charSize == Yarr::Char8) && (m_representation->m_regExpJITCode.has8BitCodeMatchOnly()))
+            return;
+        if ((charSize == Yarr::Char16) && (m_representation->m_regExpJITCode.has16BitCodeMatchOnly()))
+            return;
+#else
+        return;
+#endif
+    }
+
+    compile(&globalData, charSize, Yarr::MatchOnly);
+}
+
 int RegExp::match(JSGlobalData& globalData, const UString& s, unsigned startOffset, Vector<int, 32>* ovector)
 {
 #if ENABLE(REGEXP_TRACING)
@@ -378,6 +400,44 @@ int RegExp::match(JSGlobalData& globalData, const UString& s, unsigned startOffs
     return result;
 }
 
+int RegExp::matchOnly(JSGlobalData& globalData, const UString& s, unsigned startOffset, int& matchEnd)
+{
+#if ENABLE(REGEXP_TRACING)
+    m_rtMatchCallCount++;
+#endif
+
+    ASSERT(m_state != ParseError);
+    compileIfNecessaryMatchOnly(globalData, s.is8Bit() ? Yarr::Char8 : Yarr::Char16);
+
+    // Match only code leaves the subpatterns alone unless the pattern has
+    // backreferences, and the interpreter always records them, so there still
+    // needs to be room for them all.
+    Vector<int, 32> offsetVector;
+    offsetVector.resize((m_numSubpatterns + 1) * 2);
+
+    int result;
+#if ENABLE(YARR_JIT)
+    if (m_state == JITCode) {
+        if (s.is8Bit())
+            result = Yarr::executeMatchOnly(m_representation->m_regExpJITCode, s.characters8(), startOffset, s.length(), offsetVector.data());
+        else
+            result = Yarr::executeMatchOnly(m_representation->m_regExpJITCode, s.characters16(), startOffset, s.length(), offsetVector.data());
+    } else
+#endif
+        result = Yarr::interpret(m_representation->m_regExpBytecode.get(), s, startOffset, s.length(), offsetVector.data());
+    ASSERT(result >= -1);
+
+    if (result >= 0)
+        matchEnd = offsetVector[1];
+
+#if ENABLE(REGEXP_TRACING)
+    if (result != -1)
+        m_rtMatchFoundCount++;
+#endif
+
+    return result;
+}
+
 void RegExp::invalidateCode()
 {
     if (!m_representation)
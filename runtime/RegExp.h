@@ -54,6 +54,8 @@ namespace JSC {
         const char* errorMessage() const { return m_constructionError; }
 
         JS_EXPORT_PRIVATE int match(JSGlobalData&, const UString&, unsigned startOffset, Vector<int, 32>* ovector = 0);
+        // Like match(), but only finds where the match ends, not where each subpattern matched.
+        int matchOnly(JSGlobalData&, const UString&, unsigned startOffset, int& matchEnd);
         unsigned numSubpatterns() const { return m_numSubpatterns; }
 
         bool hasCode()
@@ -92,8 +94,9 @@ namespace JSC {
             NotCompiled
         } m_state;
 
-        void compile(JSGlobalData*, Yarr::YarrCharSize);
+        void compile(JSGlobalData*, Yarr::YarrCharSize, Yarr::YarrJITCompileMode = Yarr::IncludeSubpatterns);
         void compileIfNecessary(JSGlobalData&, Yarr::YarrCharSize);
+        void compileIfNecessaryMatchOnly(JSGlobalData&, Yarr::YarrCharSize);
 
 #if ENABLE(YARR_JIT_DEBUG)
         void matchCompareWithInterpreter(const UString&, int startOffset, int* offsetVector, int jitResult);
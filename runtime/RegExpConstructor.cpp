@@ -129,6 +129,28 @@ void RegExpConstructor::destroy(JSCell* cell)
     jsCast<RegExpConstructor*>(cell)->RegExpConstructor::~RegExpConstructor();
 }
 
+void RegExpConstructor::visitChildren(JSCell* cell, SlotVisitor& visitor)
+{
+    RegExpConstructor* thisObject = jsCast<RegExpConstructor*>(cell);
+    ASSERT_GC_OBJECT_INHERITS(thisObject, &s_info);
+    COMPILE_ASSERT(StructureFlags & OverridesVisitChildren, OverridesVisitChildrenWithoutSettingFlag);
+    ASSERT(thisObject->structure()->typeInfo().overridesVisitChildren());
+    Base::visitChildren(thisObject, visitor);
+    if (thisObject->d.lazyRegExp)
+        visitor.append(&thisObject->d.lazyRegExp);
+}
+
+void RegExpConstructor::reifyLazyMatch(JSGlobalData& globalData)
+{
+    if (!d.lazyRegExp)
+        return;
+
+    int position = d.lazyRegExp->match(globalData, d.lastInput, d.lazyStartOffset, &d.tempOvector());
+    ASSERT_UNUSED(position, position != -1);
+    d.changeLastOvector();
+    d.lazyRegExp.clear();
+}
+
 RegExpMatchesArray::RegExpMatchesArray(ExecState* exec)
     : JSArray(exec->globalData(), exec->lexicalGlobalObject()->regExpMatchesArrayStructure())
     , m_didFillArrayInstance(false)
@@ -165,13 +187,15 @@ void RegExpMatchesArray::fillArrayInstance(ExecState* exec)
     m_didFillArrayInstance = true;
 }
 
-JSObject* RegExpConstructor::arrayOfMatches(ExecState* exec) const
+JSObject* RegExpConstructor::arrayOfMatches(ExecState* exec)
 {
+    reifyLazyMatch(exec->globalData());
     return RegExpMatchesArray::create(exec, d);
 }
 
-JSValue RegExpConstructor::getBackref(ExecState* exec, unsigned i) const
+JSValue RegExpConstructor::getBackref(ExecState* exec, unsigned i)
 {
+    reifyLazyMatch(exec->globalData());
     if (!d.lastOvector().isEmpty() && i <= d.lastNumSubPatterns) {
         int start = d.lastOvector()[2 * i];
         if (start >= 0)
@@ -180,8 +204,9 @@ JSValue RegExpConstructor::getBackref(ExecState* exec, unsigned i) const
     return jsEmptyString(exec);
 }
 
-JSValue RegExpConstructor::getLastParen(ExecState* exec) const
+JSValue RegExpConstructor::getLastParen(ExecState* exec)
 {
+    reifyLazyMatch(exec->globalData());
     unsigned i = d.lastNumSubPatterns;
     if (i > 0) {
         ASSERT(!d.lastOvector().isEmpty());
@@ -192,15 +217,17 @@ JSValue RegExpConstructor::getLastParen(ExecState* exec) const
     return jsEmptyString(exec);
 }
 
-JSValue RegExpConstructor::getLeftContext(ExecState* exec) const
+JSValue RegExpConstructor::getLeftContext(ExecState* exec)
 {
+    reifyLazyMatch(exec->globalData());
     if (!d.lastOvector().isEmpty())
         return jsSubstring(exec, d.lastInput, 0, d.lastOvector()[0]);
     return jsEmptyString(exec);
 }
 
-JSValue RegExpConstructor::getRightContext(ExecState* exec) const
+JSValue RegExpConstructor::getRightContext(ExecState* exec)
 {
+    reifyLazyMatch(exec->globalData());
     if (!d.lastOvector().isEmpty())
         return jsSubstring(exec, d.lastInput, d.lastOvector()[1], d.lastInput.length() - d.lastOvector()[1]);
     return jsEmptyString(exec);
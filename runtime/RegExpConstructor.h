@@ -39,6 +39,7 @@ namespace JSC {
             : lastNumSubPatterns(0)
             , multiline(false)
             , lastOvectorIndex(0)
+            , lazyStartOffset(0)
         {
         }
 
@@ -53,6 +54,11 @@ namespace JSC {
         unsigned lastNumSubPatterns : 30;
         bool multiline : 1;
         unsigned lastOvectorIndex : 1;
+
+        // Set when the last match only found where it started and ended. The
+        // subpatterns are found by matching again if anything asks for them.
+        WriteBarrier<RegExp> lazyRegExp;
+        int lazyStartOffset;
     };
 
     struct RegExpResult {
@@ -94,7 +100,8 @@ namespace JSC {
         static const ClassInfo s_info;
 
         void performMatch(JSGlobalData&, RegExp*, const UString&, int startOffset, int& position, int& length, int** ovector = 0);
-        JSObject* arrayOfMatches(ExecState*) const;
+        void performMatchOnly(JSGlobalData&, RegExp*, const UString&, int startOffset, int& position, int& length);
+        JSObject* arrayOfMatches(ExecState*);
 
         void setInput(const UString&);
         const UString& input() const;
@@ -102,14 +109,16 @@ namespace JSC {
         void setMultiline(bool);
         bool multiline() const;
 
-        JSValue getBackref(ExecState*, unsigned) const;
-        JSValue getLastParen(ExecState*) const;
-        JSValue getLeftContext(ExecState*) const;
-        JSValue getRightContext(ExecState*) const;
+        JSValue getBackref(ExecState*, unsigned);
+        JSValue getLastParen(ExecState*);
+        JSValue getLeftContext(ExecState*);
+        JSValue getRightContext(ExecState*);
 
     protected:
         void finishCreation(ExecState*, RegExpPrototype*);
-        static const unsigned StructureFlags = OverridesGetOwnPropertySlot | ImplementsHasInstance | InternalFunction::StructureFlags;
+        static const unsigned StructureFlags = OverridesVisitChildren | OverridesGetOwnPropertySlot | ImplementsHasInstance | InternalFunction::StructureFlags;
+
+        static void visitChildren(JSCell*, SlotVisitor&);
 
     private:
         RegExpConstructor(JSGlobalObject*, Structure*);
@@ -117,6 +126,8 @@ namespace JSC {
         static ConstructType getConstructData(JSCell*, ConstructData&);
         static CallType getCallData(JSCell*, CallData&);
 
+        void reifyLazyMatch(JSGlobalData&);
+
         RegExpConstructorPrivate d;
     };
 
@@ -151,6 +162,29 @@ namespace JSC {
             d.lastInput = s;
             d.changeLastOvector();
             d.lastNumSubPatterns = r->numSubpatterns();
+            d.lazyRegExp.clear();
+        }
+    }
+
+    /*
+      test(), search() and global match() only need to know where each match is, so they dispatch
+      through performMatchOnly, which skips finding the subpatterns. Matching is deterministic, so
+      they can be found later by matching again from the same offset, if RegExp.$1 and friends are
+      ever read.
+    */
+    ALWAYS_INLINE void RegExpConstructor::performMatchOnly(JSGlobalData& globalData, RegExp* r, const UString& s, int startOffset, int& position, int& length)
+    {
+        int matchEnd;
+        position = r->matchOnly(globalData, s, startOffset, matchEnd);
+
+        if (position != -1) {
+            length = matchEnd - position;
+
+            d.input = s;
+            d.lastInput = s;
+            d.lastNumSubPatterns = r->numSubpatterns();
+            d.lazyRegExp.set(globalData, this, r);
+            d.lazyStartOffset = startOffset;
         }
     }
 
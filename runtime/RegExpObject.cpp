@@ -217,18 +217,18 @@ void setRegExpObjectLastIndex(ExecState* exec, JSObject* baseObject, JSValue val
 
 JSValue RegExpObject::test(ExecState* exec)
 {
-    return jsBoolean(match(exec));
+    return jsBoolean(match(exec, MatchOnly));
 }
 
 JSValue RegExpObject::exec(ExecState* exec)
 {
-    if (match(exec))
+    if (match(exec, MatchWithSubpatterns))
         return exec->lexicalGlobalObject()->regExpConstructor()->arrayOfMatches(exec);
     return jsNull();
 }
 
 // Shared implementation used by test and exec.
-bool RegExpObject::match(ExecState* exec)
+bool RegExpObject::match(ExecState* exec, MatchKind kind)
 {
     RegExpConstructor* regExpConstructor = exec->lexicalGlobalObject()->regExpConstructor();
     UString input = exec->argument(0).toString(exec)->value(exec);
@@ -236,7 +236,10 @@ bool RegExpObject::match(ExecState* exec)
     if (!regExp()->global()) {
         int position;
         int length;
-        regExpConstructor->performMatch(*globalData, d->regExp.get(), input, 0, position, length);
+        if (kind == MatchOnly)
+            regExpConstructor->performMatchOnly(*globalData, d->regExp.get(), input, 0, position, length);
+        else
+            regExpConstructor->performMatch(*globalData, d->regExp.get(), input, 0, position, length);
         return position >= 0;
     }
 
@@ -259,7 +262,10 @@ bool RegExpObject::match(ExecState* exec)
 
     int position;
     int length = 0;
-    regExpConstructor->performMatch(*globalData, d->regExp.get(), input, lastIndex, position, length);
+    if (kind == MatchOnly)
+        regExpConstructor->performMatchOnly(*globalData, d->regExp.get(), input, lastIndex, position, length);
+    else
+        regExpConstructor->performMatch(*globalData, d->regExp.get(), input, lastIndex, position, length);
     if (position < 0) {
         setLastIndex(0);
         return false;
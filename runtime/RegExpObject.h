@@ -84,7 +84,8 @@ namespace JSC {
         static void visitChildren(JSCell*, SlotVisitor&);
 
     private:
-        bool match(ExecState*);
+        enum MatchKind { MatchWithSubpatterns, MatchOnly };
+        bool match(ExecState*, MatchKind);
 
         struct RegExpObjectData {
             WTF_MAKE_FAST_ALLOCATED;
@@ -52,6 +52,7 @@ namespace JSC {
             return chain;
         }
         WriteBarrier<Structure>* head() { return m_vector.get(); }
+        static size_t offsetOfVector() { return OBJECT_OFFSETOF(StructureChain, m_vector); }
         static void visitChildren(JSCell*, SlotVisitor&);
 
         static Structure* createStructure(JSGlobalData& globalData, JSGlobalObject* globalObject, JSValue prototype) { return Structure::create(globalData, globalObject, prototype, TypeInfo(CompoundType, OverridesVisitChildren), &s_info); }
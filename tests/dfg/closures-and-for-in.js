@@ -0,0 +1,106 @@
+// Checks functions that the DFG compiles although they create activations and
+// closures, enumerate properties with for-in, or use typeof. Run it with jsc; it
+// prints PASS, or throws on the first wrong result. Each function is called often
+// enough to be compiled, and is then given values that make it exit.
+(function () {
+    var iterations = 2000;
+
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    // The loop variable is captured, so every access goes through the register
+    // file that the activation shares. The closure sees the final value.
+    function captureCounter(n) {
+        var count = 0;
+        function read() { return count; }
+        for (var i = 0; i < n; ++i)
+            count += i;
+        return read() + ":" + count;
+    }
+
+    // The closure writes a captured variable that the compiled code then reads.
+    function closureWrites(n) {
+        var total = 0;
+        var add = function (x) { total += x; };
+        for (var i = 0; i < n; ++i)
+            add(i);
+        return total;
+    }
+
+    // Each call makes a new activation, which must outlive the call once torn off.
+    function makeAdder(x) {
+        return function (y) { return x + y; };
+    }
+
+    function typeOf(value) {
+        return typeof value;
+    }
+
+    function sumOfValues(object) {
+        var sum = 0;
+        for (var key in object)
+            sum += object[key];
+        return sum;
+    }
+
+    function keysOf(object) {
+        var keys = [];
+        for (var key in object)
+            keys.push(key);
+        return keys.join();
+    }
+
+    function Base() { this.a = 1; this.b = 2; }
+    Base.prototype.c = 3;
+
+    var adders = [];
+    for (var n = 0; n < iterations; ++n) {
+        check(captureCounter(5), "10:10", "captureCounter");
+        check(closureWrites(5), 10, "closureWrites");
+        var adder = makeAdder(n);
+        if (n < 10)
+            adders.push(adder);
+        check(adder(1), n + 1, "makeAdder");
+        check(typeOf(n), "number", "typeof number");
+        check(typeOf("s"), "string", "typeof string");
+        check(sumOfValues(new Base()), 6, "for-in over own and prototype properties");
+        check(keysOf(new Base()), "a,b,c", "for-in keys");
+    }
+    for (var i = 0; i < adders.length; ++i)
+        check(adders[i](100), i + 100, "torn off activation");
+
+    // Exits from the compiled code, with captured variables live.
+    check(captureCounter(2.5), "3:3", "captureCounter with a double");
+    check(closureWrites("3"), 3, "closureWrites with a string bound");
+    check(makeAdder("x")("y"), "xy", "makeAdder with strings");
+    check(typeOf(undefined), "undefined", "typeof undefined");
+    check(typeOf(null), "object", "typeof null");
+    check(typeOf(typeOf), "function", "typeof function");
+
+    // The cached enumeration no longer matches once a structure along the chain
+    // changes, so the next property name is found by the runtime.
+    Base.prototype.d = 4;
+    check(sumOfValues(new Base()), 10, "for-in after the prototype changed");
+    check(keysOf(new Base()), "a,b,c,d", "for-in keys after the prototype changed");
+    var dictionary = new Base();
+    delete dictionary.a;
+    check(keysOf(dictionary), "b,c,d", "for-in over an object with a deleted property");
+    check(sumOfValues({ x: "1", y: 2 }), "012", "for-in summing strings");
+    check(sumOfValues(7), 0, "for-in over a number");
+
+    // Deleting a property that the loop has not reached yet skips it.
+    function deleteAhead(object) {
+        var keys = [];
+        for (var key in object) {
+            keys.push(key);
+            delete object.z;
+        }
+        return keys.join();
+    }
+    for (var n = 0; n < iterations; ++n)
+        check(deleteAhead({ x: 1, y: 2, z: 3 }), "x,y", "deleting ahead of for-in");
+
+    print("PASS");
+})();
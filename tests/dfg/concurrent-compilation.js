@@ -0,0 +1,82 @@
+// Checks functions whose DFG code is compiled on the compiler threads while the
+// main thread keeps running their baseline code. Run it with jsc; it prints PASS,
+// or throws on the first wrong result. Collections, and in debug builds
+// releaseExecutableMemory(), happen while compilations are in flight, and some
+// functions exit their optimized code once it has been installed.
+(function () {
+    var iterations = 3000;
+
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    function add(a, b) { return a + b; }
+
+    // Inlines add, so its plan refers to add's executable too.
+    function sumTo(n) {
+        var sum = 0;
+        for (var i = 0; i < n; ++i)
+            sum = add(sum, i);
+        return sum;
+    }
+
+    function Point(x, y) {
+        this.x = x;
+        this.y = y;
+    }
+
+    function lengthSquared(point) {
+        return point.x * point.x + point.y * point.y;
+    }
+
+    // Many functions get hot at about the same time, so several plans are queued at once.
+    var functions = [];
+    for (var k = 0; k < 8; ++k)
+        functions.push(new Function("a", "b", "var r = 0; for (var i = 0; i < a; ++i) r = (r + i * " + k + " + b) | 0; return r;"));
+
+    function expectedFor(k, a, b) {
+        var r = 0;
+        for (var i = 0; i < a; ++i)
+            r = (r + i * k + b) | 0;
+        return r;
+    }
+
+    var canReleaseCode = typeof releaseExecutableMemory === "function";
+    var points = [];
+    for (var i = 0; i < 10; ++i)
+        points.push(new Point(i, i + 1));
+
+    for (var n = 0; n < iterations; ++n) {
+        check(sumTo(20), 190, "sumTo");
+        check(lengthSquared(points[n % 10]), (n % 10) * (n % 10) + (n % 10 + 1) * (n % 10 + 1), "lengthSquared");
+        for (var k = 0; k < functions.length; ++k)
+            check(functions[k](10, n), expectedFor(k, 10, n), "function " + k);
+
+        // Collect and throw away code while the compiler threads may be working
+        // on these functions. Each plan must either be finished or cancelled,
+        // and the baseline code must keep running in the meantime.
+        if (!(n % 500))
+            gc();
+        if (canReleaseCode && n % 1000 === 999)
+            releaseExecutableMemory();
+    }
+
+    // The optimized code speculated on ints and on Point's structure. Break both
+    // speculations, and check that the exits return to correct baseline code.
+    check(sumTo(3.5), 6, "sumTo with a double bound");
+    check(add("a", "b"), "ab", "add with strings");
+    check(sumTo(4), 6, "sumTo after add saw strings");
+    check(lengthSquared({ y: 2, x: 1 }), 5, "lengthSquared with another structure");
+    check(lengthSquared({ x: 0.5, y: 0.5 }), 0.5, "lengthSquared with doubles");
+    for (var k = 0; k < functions.length; ++k)
+        check(functions[k](4, 0.5), expectedFor(k, 4, 0.5), "function " + k + " with a double");
+
+    // Keep going after the exits, so that the functions are compiled again.
+    for (var n = 0; n < iterations; ++n) {
+        check(sumTo(n % 7), (n % 7) * (n % 7 - 1) / 2, "sumTo again");
+        check(lengthSquared(n & 1 ? points[1] : { y: 2, x: 1 }), 5, "lengthSquared again");
+    }
+
+    print("PASS");
+})();
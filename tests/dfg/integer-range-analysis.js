@@ -0,0 +1,126 @@
+// Checks the loops whose overflow and bounds checks the DFG's integer range
+// analysis may remove. Run it with jsc; it prints PASS, or throws on the first
+// wrong result. Each function is called often enough to be compiled by the DFG,
+// and most of the counters run right up to, or past, the int32 limits.
+(function () {
+    var INT_MAX = 0x7fffffff;
+    var INT_MIN = -0x80000000;
+    var iterations = 2000;
+
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    // The counter stays below INT_MAX, so its increment cannot overflow.
+    function countUpBelowMax(start) {
+        var count = 0;
+        var last = 0;
+        for (var i = start; i < INT_MAX; ++i) {
+            ++count;
+            last = i;
+        }
+        return count + ":" + last + ":" + i;
+    }
+
+    // The last increment goes past INT_MAX; the check must stay.
+    function countUpToMax(start) {
+        var count = 0;
+        for (var i = start; i <= INT_MAX; ++i)
+            ++count;
+        return count + ":" + i;
+    }
+
+    // Steps of two can jump over the bound.
+    function countUpByTwo(start) {
+        var count = 0;
+        for (var i = start; i < INT_MAX; i += 2)
+            ++count;
+        return count + ":" + i;
+    }
+
+    function countDownAboveMin(start) {
+        var count = 0;
+        for (var i = start; i > INT_MIN; --i)
+            ++count;
+        return count + ":" + i;
+    }
+
+    function countDownToMin(start) {
+        var count = 0;
+        for (var i = start; i >= INT_MIN; --i)
+            ++count;
+        return count + ":" + i;
+    }
+
+    // The limit is a variable, so only the comparison bounds the counter.
+    function countUpToLimit(start, limit) {
+        var count = 0;
+        for (var i = start; i < limit; ++i)
+            ++count;
+        return count + ":" + i;
+    }
+
+    // Two counters in one loop; only the first one is bounded by the comparison.
+    function twoCounters(start) {
+        var j = INT_MAX - 4;
+        for (var i = start; i < start + 8; ++i)
+            j = j + 1;
+        return i + ":" + j;
+    }
+
+    // The inner counter restarts near INT_MAX on every outer iteration.
+    function nested(start) {
+        var total = 0;
+        for (var i = 0; i < 3; ++i) {
+            for (var j = start; j < INT_MAX; ++j)
+                ++total;
+        }
+        return total + ":" + j;
+    }
+
+    for (var n = 0; n < iterations; ++n) {
+        check(countUpBelowMax(INT_MAX - 5), "5:" + (INT_MAX - 1) + ":" + INT_MAX, "countUpBelowMax");
+        check(countUpToMax(INT_MAX - 5), "6:" + (INT_MAX + 1), "countUpToMax");
+        check(countUpByTwo(INT_MAX - 4), "2:" + INT_MAX, "countUpByTwo even");
+        check(countUpByTwo(INT_MAX - 5), "3:" + (INT_MAX + 1), "countUpByTwo odd");
+        check(countDownAboveMin(INT_MIN + 5), "5:" + INT_MIN, "countDownAboveMin");
+        check(countDownToMin(INT_MIN + 5), "6:" + (INT_MIN - 1), "countDownToMin");
+        check(countUpToLimit(INT_MAX - 3, INT_MAX), "3:" + INT_MAX, "countUpToLimit below");
+        check(countUpToLimit(INT_MAX - 3, INT_MAX + 2), "5:" + (INT_MAX + 2), "countUpToLimit past");
+        check(twoCounters(0), "8:" + (INT_MAX + 4), "twoCounters");
+        check(nested(INT_MAX - 2), "6:" + INT_MAX, "nested");
+    }
+
+    // Typed array loops whose bounds checks may be removed, with a valueOf
+    // conversion inside the loop body that runs code we did not compile.
+    var conversions = 0;
+    var convertible = { valueOf: function () { ++conversions; return 1; } };
+
+    function sumWithConversion(array, value) {
+        var sum = 0;
+        for (var i = 0; i < array.length; ++i) {
+            sum += array[i];
+            sum += value | 0;
+        }
+        return sum;
+    }
+
+    function fill(array) {
+        for (var i = 0; i < array.length; ++i)
+            array[i] = i;
+        return array;
+    }
+
+    var int32Array = fill(new Int32Array(16));
+    var float64Array = fill(new Float64Array(16));
+    for (var n = 0; n < iterations; ++n) {
+        check(sumWithConversion(int32Array, 1), 120 + 16, "Int32Array with int");
+        check(sumWithConversion(float64Array, 1), 120 + 16, "Float64Array with int");
+    }
+    conversions = 0;
+    check(sumWithConversion(int32Array, convertible), 120 + 16, "Int32Array with valueOf");
+    check(conversions, 16, "valueOf calls");
+
+    print("PASS");
+})();
@@ -0,0 +1,96 @@
+// Checks loops whose structure and typed array checks the DFG may hoist into the
+// loop preheader. Run it with jsc; it prints PASS, or throws on the first wrong
+// result. Each function is called often enough to be compiled, and is then given
+// objects that fail the hoisted checks, often enough for it to be compiled again.
+(function () {
+    var iterations = 2000;
+
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    // The base is not assigned in the loop, and nothing in the loop can change
+    // its structure, so the CheckStructure for o.x and o.y can run once.
+    function sumFields(o, n) {
+        var sum = 0;
+        for (var i = 0; i < n; ++i)
+            sum += o.x * i + o.y;
+        return sum;
+    }
+
+    // Same for the typed array class check made by the loads and the length.
+    function sumArray(array) {
+        var sum = 0;
+        for (var i = 0; i < array.length; ++i)
+            sum += array[i];
+        return sum;
+    }
+
+    // The loop body may run code that changes the base's structure, so the check
+    // has to stay in the loop.
+    function sumWithCallback(o, n, callback) {
+        var sum = 0;
+        for (var i = 0; i < n; ++i) {
+            sum += o.x;
+            callback(o, i);
+        }
+        return sum;
+    }
+
+    // The hoisted checks run even when the loop does not, so they may exit for a
+    // base that the loop would never have touched.
+    function sumFieldsMaybe(o, n) {
+        var sum = 0;
+        for (var i = 0; i < n; ++i)
+            sum += o.x;
+        return sum;
+    }
+
+    function Point(x, y) { this.x = x; this.y = y; }
+    function expectedSum(x, y, n) { return x * n * (n - 1) / 2 + y * n; }
+
+    function fill(array) {
+        for (var i = 0; i < array.length; ++i)
+            array[i] = i;
+        return array;
+    }
+
+    var point = new Point(2, 3);
+    var int32Array = fill(new Int32Array(10));
+    var nothing = function () { };
+    for (var n = 0; n < iterations; ++n) {
+        check(sumFields(point, 10), expectedSum(2, 3, 10), "sumFields");
+        check(sumArray(int32Array), 45, "sumArray");
+        check(sumWithCallback(point, 4, nothing), 8, "sumWithCallback");
+        check(sumFieldsMaybe(point, 3), 6, "sumFieldsMaybe");
+    }
+
+    // Each of these fails a hoisted check before the loop starts. After enough
+    // of them the preheader is a frequent exit site, and the recompiled code
+    // must keep the checks in the loop.
+    var other = { y: 3, x: 2 };
+    var float64Array = fill(new Float64Array(10));
+    for (var n = 0; n < iterations; ++n) {
+        var o = n & 1 ? point : other;
+        check(sumFields(o, 10), expectedSum(2, 3, 10), "sumFields with two structures");
+        check(sumArray(n & 1 ? int32Array : float64Array), 45, "sumArray with two array classes");
+        check(sumArray(n % 3 ? int32Array : [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]), 45, "sumArray with a JSArray");
+    }
+    check(sumFieldsMaybe("not an object", 0), 0, "sumFieldsMaybe with a loop that does not run");
+    check(sumFieldsMaybe({ x: 1 }, 0), 0, "sumFieldsMaybe with another structure and a loop that does not run");
+    check(sumFieldsMaybe({ x: 1 }, 2), 2, "sumFieldsMaybe with another structure");
+
+    // The callback changes the structure part way through the loop.
+    var changing = new Point(1, 0);
+    check(sumWithCallback(changing, 6, function (o, i) {
+        if (i === 2) {
+            delete o.y;
+            o.z = 0;
+            o.x = 10;
+        }
+    }), 1 + 1 + 1 + 10 + 10 + 10, "sumWithCallback with a structure change in the loop");
+    check(sumWithCallback(new Point(1, 0), 3, function (o) { o.x += 1; }), 1 + 2 + 3, "sumWithCallback with a store in the loop");
+
+    print("PASS");
+})();
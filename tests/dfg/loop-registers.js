@@ -0,0 +1,122 @@
+// Checks inner loops whose double variables the DFG keeps in loop registers
+// rather than in the register file. Run it with jsc; it prints PASS, or throws on
+// the first wrong result. Each function is called often enough to be compiled,
+// and then exits from the middle of its loop, where the doubles only live in
+// registers.
+(function () {
+    var iterations = 2000;
+
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    // Several doubles are live across the back edge.
+    function integrate(steps, scale) {
+        var x = 0.5, v = 0.25, a = 0.125, t = 0;
+        for (var i = 0; i < steps; ++i) {
+            v += a * scale;
+            x += v * scale;
+            t += scale;
+        }
+        return x + v + a + t;
+    }
+
+    function integrateSlowly(steps, scale) {
+        var x = 0.5, v = 0.25, a = 0.125, t = 0;
+        var i = 0;
+        while (true) {
+            if (!(i < steps))
+                break;
+            v = v + a * scale;
+            x = x + v * scale;
+            t = t + scale;
+            i = i + 1;
+        }
+        return x + v + a + t;
+    }
+
+    // A call in the loop reads the variables through the register file.
+    var seen = 0;
+    function observe(value) { seen += value; return value; }
+    function sumWithCalls(n) {
+        var sum = 0.5;
+        for (var i = 0; i < n; ++i)
+            sum += observe(sum) * 0.5;
+        return sum;
+    }
+
+    // The inner loop keeps its doubles in registers and the outer one reads them
+    // on the edge that leaves the inner loop.
+    function nested(n) {
+        var total = 0.5;
+        for (var j = 0; j < n; ++j) {
+            var partial = 0.25;
+            for (var i = 0; i < n; ++i)
+                partial += 1.5;
+            total += partial;
+        }
+        return total;
+    }
+
+    // The array load speculates on doubles; an int or a string in the array
+    // exits in the middle of the loop.
+    function sumArray(array) {
+        var sum = 0.5;
+        var product = 1.5;
+        for (var i = 0; i < array.length; ++i) {
+            sum += array[i];
+            product *= 1.0;
+        }
+        return sum + product;
+    }
+
+    // Switch in the loop means the loop keeps its variables in the register file.
+    function withSwitch(n) {
+        var sum = 0.5;
+        for (var i = 0; i < n; ++i) {
+            switch (i & 3) {
+            case 0: sum += 0.5; break;
+            case 1: sum += 1.5; break;
+            default: sum -= 0.25; break;
+            }
+        }
+        return sum;
+    }
+
+    var doubles = [0.5, 1.5, 2.5, 3.5];
+    for (var n = 0; n < iterations; ++n) {
+        check(integrate(8, 0.5), integrateSlowly(8, 0.5), "integrate");
+        seen = 0;
+        check(sumWithCalls(4), 0.5 * Math.pow(1.5, 4), "sumWithCalls");
+        check(seen, 0.5 * (Math.pow(1.5, 4) - 1) / 0.5, "sumWithCalls observed values");
+        check(nested(3), 0.5 + 3 * (0.25 + 4.5), "nested");
+        check(sumArray(doubles), 0.5 + 8 + 1.5, "sumArray");
+        check(withSwitch(8), 0.5 + 2 * (0.5 + 1.5 - 0.5), "withSwitch");
+    }
+
+    // Exits with the doubles live in loop registers.
+    check(integrate(8, "0.5"), integrateSlowly(8, "0.5"), "integrate with a string scale");
+    check(integrate(8, 1 << 30), integrateSlowly(8, 1 << 30), "integrate with an int scale");
+    check(sumArray([0.5, 1.5, "x", 3.5]), "2.5x3.51.5", "sumArray with a string element");
+    check(sumArray([0.5, 1, 2.5, 3.5]), 0.5 + 7.5 + 1.5, "sumArray with an int element");
+    check(sumArray([0.5, 1.5, { valueOf: function () { return 2.5; } }, 3.5]), 0.5 + 8 + 1.5, "sumArray with an object element");
+    observe = function (value) { return "" + value; };
+    check(sumWithCalls(2), 1.125, "sumWithCalls after observe returns strings");
+
+    // A function that is only called once, so its optimized code is entered
+    // through OSR in the middle of the loop, and the entry has to load the loop
+    // registers from the register file.
+    function runOnce(steps) {
+        var x = 0.5, v = 0.25;
+        for (var i = 0; i < steps; ++i) {
+            v += 0.125;
+            x += v;
+        }
+        return x + ":" + v;
+    }
+    var steps = 100000;
+    check(runOnce(steps), (0.5 + 0.25 * steps + 0.125 * steps * (steps + 1) / 2) + ":" + (0.25 + 0.125 * steps), "runOnce with OSR entry");
+
+    print("PASS");
+})();
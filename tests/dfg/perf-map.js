@@ -0,0 +1,46 @@
+// Generates each kind of JIT code that the perf map describes: baseline and DFG
+// code for named and anonymous functions, inline cache stubs, OSR exits, thunks
+// and regular expressions. Run it with run-perf-map-test, which checks what
+// JSC_PERF_MAP=1 and JSC_PERF_MAP=2 write; run on its own with jsc, it prints PASS,
+// or throws on the first wrong result.
+(function () {
+    var iterations = 2000;
+
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    // Compiled by the DFG, with a get_by_id that sees several structures.
+    function perfMapHotFunction(o, n) {
+        var sum = 0;
+        for (var i = 0; i < n; ++i)
+            sum += o.x;
+        return sum;
+    }
+
+    var perfMapAnonymous = function (s) {
+        return /a+b/.test(s) ? Math.sqrt(s.length) : 0;
+    };
+
+    var objects = [{ x: 1 }, { y: 0, x: 1 }, { z: 0, y: 0, x: 1 }];
+    for (var n = 0; n < iterations; ++n) {
+        check(perfMapHotFunction(objects[n % 3], 4), 4, "perfMapHotFunction");
+        check(perfMapAnonymous("aaab"), 2, "perfMapAnonymous");
+    }
+
+    // Exits from the DFG code, which compiles the OSR exit.
+    check(perfMapHotFunction({ x: "1" }, 2), "011", "perfMapHotFunction with a string");
+
+    // Code that is thrown away once the functions are collected. The perf map keeps
+    // its entries; the jitdump records that the code went away.
+    for (var n = 0; n < 50; ++n) {
+        var f = new Function("a", "return a * " + n + " + 1;");
+        for (var i = 0; i < 100; ++i)
+            check(f(i), i * n + 1, "generated function");
+    }
+    f = null;
+    gc();
+
+    print("PASS");
+})();
@@ -0,0 +1,89 @@
+// Checks property accesses that the DFG inlines although the baseline JIT saw
+// several structures, or found the property on the prototype chain. Run it with
+// jsc; it prints PASS, or throws on the first wrong result. Each function is called
+// often enough to be compiled, and is then given structures it did not see, and
+// prototypes that changed.
+(function () {
+    var iterations = 2000;
+
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    function getX(o) { return o.x; }
+    function setX(o, value) { o.x = value; return o; }
+    function callGreet(o) { return o.greet(); }
+
+    // x is at a different offset in each of these.
+    var objects = [
+        { x: 1 },
+        { a: 0, x: 2 },
+        { a: 0, b: 0, x: 3 },
+        { a: 0, b: 0, c: 0, x: 4 }
+    ];
+
+    // And found on the prototype chain, at one or two levels.
+    function Base() { }
+    Base.prototype.x = 5;
+    Base.prototype.greet = function () { return "base"; };
+    function Derived() { }
+    Derived.prototype = new Base();
+    Derived.prototype.greet = function () { return "derived"; };
+    var base = new Base();
+    var derived = new Derived();
+
+    for (var n = 0; n < iterations; ++n) {
+        for (var i = 0; i < objects.length; ++i)
+            check(getX(objects[i]), i + 1, "getX self " + i);
+        check(getX(base), 5, "getX prototype");
+        check(getX(derived), 5, "getX prototype chain");
+        check(callGreet(n & 1 ? base : derived), n & 1 ? "base" : "derived", "callGreet");
+
+        // Replaces on existing properties, and transitions that add x.
+        check(setX({ x: 0 }, n).x, n, "setX replace");
+        check(setX({ a: 0, x: 0 }, n).x, n, "setX replace at another offset");
+        check(setX({}, n).x, n, "setX transition");
+        check(setX({ a: 0 }, n).x, n, "setX transition from another structure");
+    }
+
+    // A structure that none of the variants match.
+    check(getX({ b: 0, a: 0, x: 6 }), 6, "getX with a new structure");
+    check(getX({ b: 0 }), undefined, "getX with a missing property");
+    check(getX("string"), undefined, "getX with a string");
+    check(setX({ q: 0 }, 7).x, 7, "setX with a new structure");
+
+    // Shadowing and changing the prototype's property: the CheckStructure on
+    // each prototype must fail rather than load the old value.
+    Derived.prototype.x = 8;
+    check(getX(derived), 8, "getX after shadowing on the prototype");
+    Base.prototype.x = 9;
+    check(getX(base), 9, "getX after changing the prototype's value");
+    delete Derived.prototype.x;
+    check(getX(derived), 9, "getX after deleting the shadowing property");
+    derived.x = 10;
+    check(getX(derived), 10, "getX after adding an own property");
+    Derived.prototype.greet = function () { return "changed"; };
+    check(callGreet(new Derived()), "changed", "callGreet after replacing the method");
+    Object.defineProperty(Base.prototype, "x", { get: function () { return 11; } });
+    check(getX(base), 11, "getX through a getter");
+
+    // A setter on the prototype must run instead of adding a property.
+    var setterCalls = 0;
+    var proto = {};
+    Object.defineProperty(proto, "x", { set: function (value) { setterCalls += value; } });
+    var withSetter = Object.create(proto);
+    setX(withSetter, 12);
+    check(setterCalls, 12, "setX through a setter");
+    check(withSetter.hasOwnProperty("x"), false, "setX through a setter adds no property");
+
+    // Dictionaries are not inlined; make sure they still work after compilation.
+    var dictionary = { x: 1, y: 2 };
+    delete dictionary.y;
+    for (var i = 0; i < 100; ++i)
+        dictionary["p" + i] = i;
+    check(getX(dictionary), 1, "getX on a dictionary");
+    check(setX(dictionary, 13).x, 13, "setX on a dictionary");
+
+    print("PASS");
+})();
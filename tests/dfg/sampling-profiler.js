@@ -0,0 +1,53 @@
+// Keeps the JavaScript thread busy in baseline code, DFG code and code that the DFG
+// inlined, across OSR exits and collections, for the sampling profiler to walk.
+// Run it with run-sampling-profiler-test, which checks the call tree that jsc -p
+// writes; run on its own with jsc, it prints PASS, or throws on the first wrong
+// result.
+(function () {
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    // Small enough to be inlined into samplingOuter.
+    function samplingInlinedCallee(x) {
+        return (x * 3 + 1) | 0;
+    }
+
+    function samplingOuter(n) {
+        var sum = 0;
+        for (var i = 0; i < n; ++i)
+            sum = (sum + samplingInlinedCallee(i)) | 0;
+        return sum;
+    }
+
+    // Exits from its DFG code every so often, so samples land in baseline code,
+    // OSR exits and recompiled code.
+    function samplingExits(values) {
+        var sum = 0;
+        for (var i = 0; i < values.length; ++i)
+            sum += values[i];
+        return sum;
+    }
+
+    function expectedOuter(n) {
+        var sum = 0;
+        for (var i = 0; i < n; ++i)
+            sum = (sum + ((i * 3 + 1) | 0)) | 0;
+        return sum;
+    }
+
+    var ints = [1, 2, 3, 4];
+    var mixed = [1, 2.5, "3", 4];
+    var expected = expectedOuter(10000);
+    var start = preciseTime();
+    for (var round = 0; preciseTime() - start < 1; ++round) {
+        check(samplingOuter(10000), expected, "samplingOuter");
+        check(samplingExits(round % 50 ? ints : mixed), round % 50 ? 10 : "3.534", "samplingExits");
+        // Collections turn the sampled executables into call identifiers.
+        if (!(round % 200))
+            gc();
+    }
+
+    print("PASS");
+})();
@@ -0,0 +1,118 @@
+// Checks switch statements compiled by the DFG, through jump tables and binary
+// searches, over ints, characters and strings. Run it with jsc; it prints PASS, or
+// throws on the first wrong result. Each function is called often enough to be
+// compiled, and is then given operands that it did not speculate on.
+(function () {
+    var iterations = 2000;
+
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    // Dense cases: lowered to a jump table.
+    function dense(x) {
+        switch (x) {
+        case 0: return "zero";
+        case 1: return "one";
+        case 2: return "two";
+        case 3: return "three";
+        case 4: return "four";
+        case 6: return "six";
+        default: return "other";
+        }
+    }
+
+    // Sparse cases: lowered to a binary search.
+    function sparse(x) {
+        switch (x) {
+        case -100: return "a";
+        case 0: return "b";
+        case 7: return "c";
+        case 1000: return "d";
+        case 100000: return "e";
+        default: return "f";
+        }
+    }
+
+    // Falls through from case to case.
+    function fallThrough(x) {
+        var result = "";
+        switch (x) {
+        case 1: result += "1";
+        case 2: result += "2"; break;
+        case 3: result += "3";
+        default: result += "d";
+        }
+        return result;
+    }
+
+    function character(c) {
+        switch (c) {
+        case "a": return 1;
+        case "b": return 2;
+        case "c": return 3;
+        case "d": return 4;
+        case "z": return 26;
+        default: return 0;
+        }
+    }
+
+    function string(s) {
+        switch (s) {
+        case "alpha": return 1;
+        case "beta": return 2;
+        case "": return 3;
+        case "gamma delta": return 4;
+        default: return 0;
+        }
+    }
+
+    // A switch in a loop, where each case changes the loop's state.
+    function stateMachine(input) {
+        var state = 0, count = 0;
+        for (var i = 0; i < input.length; ++i) {
+            switch (state) {
+            case 0: state = input[i] === "(" ? 1 : 0; break;
+            case 1: state = input[i] === ")" ? 2 : 1; break;
+            case 2: ++count; state = 0; --i; break;
+            }
+        }
+        return count + (state === 2 ? 1 : 0);
+    }
+
+    var denseNames = ["zero", "one", "two", "three", "four", "other", "six", "other"];
+    var sparseKeys = [-100, 0, 7, 1000, 100000, 5, -1, 99999];
+    var sparseNames = ["a", "b", "c", "d", "e", "f", "f", "f"];
+    for (var n = 0; n < iterations; ++n) {
+        var k = n % 8;
+        check(dense(k), denseNames[k], "dense");
+        check(dense(-k - 1), "other", "dense below the table");
+        check(sparse(sparseKeys[k]), sparseNames[k], "sparse");
+        check(fallThrough(k % 5), ["d", "12", "2", "3d", "d"][k % 5], "fallThrough");
+        check(character("abcdzy"[n % 6]), [1, 2, 3, 4, 26, 0][n % 6], "character");
+        check(string(["alpha", "beta", "", "gamma delta", "gamma"][n % 5]), [1, 2, 3, 4, 0][n % 5], "string");
+        check(stateMachine("(a)(b)x()"), 3, "stateMachine");
+    }
+
+    // Operands that the compiled code did not expect: doubles that hold ints and
+    // doubles that do not, values of other types, and strings that are not one
+    // character long.
+    check(dense(2.0), "two", "dense with an integral double");
+    check(dense(2.5), "other", "dense with a fractional double");
+    check(dense(-0), "zero", "dense with negative zero");
+    check(dense("2"), "other", "dense with a string");
+    check(dense(null), "other", "dense with null");
+    check(dense({ valueOf: function () { return 2; } }), "other", "dense with an object");
+    check(sparse(1000.0), "d", "sparse with an integral double");
+    check(sparse(0x80000000), "f", "sparse with a value outside int32");
+    check(character("ab"), 0, "character with a longer string");
+    check(character(""), 0, "character with an empty string");
+    check(character(97), 0, "character with a number");
+    check(string(1), 0, "string with a number");
+    check(string(new String("alpha")), 0, "string with a String object");
+    check(string("al" + "pha"), 1, "string with a rope");
+    check(stateMachine(["(", ")", ")"]), 1, "stateMachine over an array");
+
+    print("PASS");
+})();
@@ -0,0 +1,81 @@
+// Checks that full collections marked a step at a time keep objects that the
+// program allocates, or moves around, while marking is under way. Run it with jsc
+// and a small step size, for example JSC_minimumIncrementalMarkingStepSize=10 in
+// a build with ENABLE_RUN_TIME_HEURISTICS, so that each collection is marked over
+// many allocation slow paths. It prints PASS, or throws on the first object that
+// was collected or reused.
+(function () {
+    function makeValue(seed) {
+        return { seed: seed, check: seed * 7 + 3, payload: [seed, "s" + seed] };
+    }
+
+    function checkValue(value, seed, where) {
+        if (!value || value.seed !== seed || value.check !== seed * 7 + 3
+            || value.payload.length !== 2 || value.payload[1] !== "s" + seed)
+            throw new Error("object lost in " + where + " for seed " + seed);
+    }
+
+    // A long list keeps marking busy for many steps, so the mutations below land
+    // between steps rather than before or after the whole collection.
+    var count = 3000;
+    var list = null;
+    for (var i = 0; i < count; ++i)
+        list = { next: list, index: i, slot: null };
+    var nodes = [];
+    for (var node = list; node; node = node.next)
+        nodes.push(node);
+    var table = {};
+    var array = new Array(count);
+
+    // Enough garbage to start a full collection and run a few of its steps.
+    function allocateSome(n) {
+        var garbage;
+        for (var i = 0; i < n; ++i)
+            garbage = { a: i, b: [i] };
+        return garbage;
+    }
+
+    gc();
+
+    for (var round = 0; round < 8; ++round) {
+        var base = round * count;
+        for (var i = 0; i < count; ++i) {
+            // Fresh objects stored into objects that may already have been visited.
+            nodes[i].slot = makeValue(base + i);
+            array[i] = makeValue(base + i);
+            table["k" + (i % 500)] = makeValue(base + i);
+
+            // Move an object from a node that marking has not reached yet into
+            // one it has, and drop the only other reference to it.
+            if (i >= 2) {
+                var moved = nodes[count - i].slot;
+                nodes[count - i].slot = null;
+                nodes[i - 2].moved = moved;
+                nodes[count - i].slot = makeValue(base + count - i);
+            }
+
+            if (!(i % 50))
+                allocateSome(200);
+        }
+
+        allocateSome(5000);
+
+        for (var i = 0; i < count; ++i) {
+            if (nodes[i].index !== count - 1 - i)
+                throw new Error("list node reused at " + i);
+            checkValue(array[i], base + i, "put_by_val");
+            if (nodes[i].moved)
+                checkValue(nodes[i].moved, nodes[i].moved.seed, "moved object");
+        }
+        for (var i = count - 500; i < count; ++i)
+            checkValue(table["k" + (i % 500)], base + i, "dictionary put");
+    }
+
+    // Objects that survived incremental cycles must also survive one that stops the world.
+    gc();
+    allocateSome(5000);
+    for (var i = 0; i < count; ++i)
+        checkValue(nodes[i].slot, 7 * count + i, "after a full collection");
+
+    print("PASS");
+})();
@@ -0,0 +1,84 @@
+// Checks that blocks which full collections leave unswept are reused correctly.
+// Run it with jsc; it prints PASS, or throws on the first object that was collected
+// or reused while it was still alive. Every round keeps a sparse set of objects and
+// strings alive in otherwise dead blocks, collects, and then allocates enough to
+// sweep those blocks, both for the same size class and for other ones.
+(function () {
+    function check(actual, expected, what) {
+        if (actual !== expected)
+            throw new Error(what + ": expected " + expected + " but got " + actual);
+    }
+
+    // Objects of a few different sizes land in different size classes. Strings
+    // built by concatenation have destructors, so their blocks are swept ahead of
+    // allocation too.
+    function makeSmall(i) { return { i: i }; }
+    function makeLarge(i) { return { i: i, a: i + 1, b: i + 2, c: i + 3, d: i + 4, e: i + 5, f: i + 6 }; }
+    function makeString(i) { return "s" + i + ":" + (i * 7); }
+
+    function checkSmall(o, i) { check(o && o.i, i, "small object"); }
+    function checkLarge(o, i) {
+        check(o && o.i, i, "large object");
+        check(o.f, i + 6, "large object field");
+    }
+    function checkString(s, i) { check(s, "s" + i + ":" + (i * 7), "string"); }
+
+    var count = 20000;
+    var stride = 37;
+    for (var round = 0; round < 5; ++round) {
+        var base = round * count;
+        var small = [], large = [], strings = [];
+        var keptSmall = [], keptLarge = [], keptStrings = [];
+        for (var i = 0; i < count; ++i) {
+            small.push(makeSmall(base + i));
+            large.push(makeLarge(base + i));
+            strings.push(makeString(base + i));
+        }
+        for (var i = 0; i < count; i += stride) {
+            keptSmall.push(small[i]);
+            keptLarge.push(large[i]);
+            keptStrings.push(strings[i]);
+        }
+        small = large = strings = null;
+
+        // Most blocks now hold a few live cells among many dead ones. Some blocks
+        // are entirely dead and are freed by the collection itself.
+        gc();
+
+        // Collecting again before anything was allocated finds blocks that the
+        // last collection left unswept.
+        if (round & 1)
+            gc();
+
+        // Allocate only small objects first. Their blocks are swept as they are
+        // allocated from. Meanwhile the string blocks, whose cells have destructors,
+        // are swept a block per slow path, ahead of any allocation in them.
+        var fresh = [];
+        for (var i = 0; i < count; ++i)
+            fresh.push(makeSmall(-i));
+        for (var j = 0; j < keptSmall.length; ++j) {
+            checkSmall(keptSmall[j], base + j * stride);
+            checkLarge(keptLarge[j], base + j * stride);
+            checkString(keptStrings[j], base + j * stride);
+        }
+
+        // Now allocate in the other size classes, into the holes left by the dead cells.
+        var freshLarge = [], freshStrings = [];
+        for (var i = 0; i < count; ++i) {
+            freshLarge.push(makeLarge(-i));
+            freshStrings.push(makeString(-i));
+        }
+        for (var j = 0; j < keptSmall.length; ++j) {
+            checkSmall(keptSmall[j], base + j * stride);
+            checkLarge(keptLarge[j], base + j * stride);
+            checkString(keptStrings[j], base + j * stride);
+        }
+        for (var i = 0; i < count; i += 101) {
+            checkSmall(fresh[i], -i);
+            checkLarge(freshLarge[i], -i);
+            checkString(freshStrings[i], -i);
+        }
+    }
+
+    print("PASS");
+})();
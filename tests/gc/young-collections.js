@@ -0,0 +1,75 @@
+// Checks that young collections keep objects that are only reachable from old
+// objects through stores the write barrier has to see. Run it with jsc; it prints
+// PASS, or throws on the first object that was collected or reused.
+(function () {
+    function Holder() {
+        this.slot = null;
+    }
+
+    function makeValue(seed) {
+        return { seed: seed, check: seed * 3 + 1, payload: [seed, seed + 1, seed + 2] };
+    }
+
+    function checkValue(value, seed, where) {
+        if (!value || value.seed !== seed || value.check !== seed * 3 + 1
+            || value.payload.length !== 3 || value.payload[2] !== seed + 2)
+            throw new Error("young object lost in " + where + " for seed " + seed);
+    }
+
+    function churn() {
+        // Allocate enough short-lived garbage to run several young collections.
+        var garbage;
+        for (var i = 0; i < 20000; ++i)
+            garbage = { a: i, b: [i, i], c: "x" + i };
+        return garbage;
+    }
+
+    var count = 2000;
+    var holders = [];
+    var array = new Array(count);
+    var byName = {};
+    for (var i = 0; i < count; ++i) {
+        holders.push(new Holder());
+        array[i] = null;
+        byName["p" + i] = null;
+    }
+    var prototypeHolder = {};
+    var derived = Object.create(prototypeHolder);
+    var setterTarget = null;
+    Object.defineProperty(prototypeHolder, "viaSetter", { set: function (value) { setterTarget = value; } });
+
+    // Make the holders old before storing young objects into them.
+    gc();
+
+    function storeById(holder, value) { holder.slot = value; }
+    function storeByVal(array, index, value) { array[index] = value; }
+
+    for (var round = 0; round < 3; ++round) {
+        var base = round * count;
+        for (var i = 0; i < count; ++i) {
+            storeById(holders[i], makeValue(base + i));
+            storeByVal(array, i, makeValue(base + i));
+            byName["p" + i] = makeValue(base + i);
+            // Adding a property to an old object may also reallocate its storage.
+            holders[i]["extra" + (i % 8)] = makeValue(base + i);
+        }
+        derived.viaSetter = makeValue(base);
+        churn();
+
+        for (var i = 0; i < count; ++i) {
+            checkValue(holders[i].slot, base + i, "put_by_id");
+            checkValue(array[i], base + i, "put_by_val");
+            checkValue(byName["p" + i], base + i, "dictionary put");
+            checkValue(holders[i]["extra" + (i % 8)], base + i, "property transition");
+        }
+        checkValue(setterTarget, base, "setter");
+    }
+
+    // Objects tenured by a full collection must survive later young collections too.
+    gc();
+    churn();
+    for (var i = 0; i < count; ++i)
+        checkValue(holders[i].slot, 2 * count + i, "tenured put_by_id");
+
+    print("PASS");
+})();
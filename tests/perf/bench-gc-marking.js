@@ -0,0 +1,33 @@
+// Measures how long full collections take on a large, live object graph. Run it
+// through run-gc-marking-benchmark to compare different numbers of GC markers.
+(function () {
+    function makeTree(depth) {
+        if (!depth)
+            return { left: null, right: null, value: 0 };
+        return { left: makeTree(depth - 1), right: makeTree(depth - 1), value: depth };
+    }
+
+    var roots = [];
+    for (var i = 0; i < 8; ++i)
+        roots.push(makeTree(16));
+
+    var lists = [];
+    for (var i = 0; i < 64; ++i) {
+        var list = new Array(4096);
+        for (var j = 0; j < list.length; ++j)
+            list[j] = { index: j, next: j ? list[j - 1] : null };
+        lists.push(list);
+    }
+
+    var iterations = 20;
+    gc();
+    var before = preciseTime();
+    for (var i = 0; i < iterations; ++i)
+        gc();
+    var after = preciseTime();
+
+    var cells = roots.length * ((1 << 17) - 1) + lists.length * 4096;
+    var milliseconds = (after - before) * 1000 / iterations;
+    print("bench-gc-marking: " + milliseconds.toFixed(2) + " ms per collection, "
+        + Math.round(cells / milliseconds) + " live objects per ms");
+})();
@@ -0,0 +1,32 @@
+// Times full collections of a heap holding many arrays of one storage size, for
+// sizes on both sides of CopiedSpace's oversize threshold. Storage at or below the
+// threshold is copied by every full collection; storage above it gets its own
+// page-granular block, which is never copied but is rounded up to whole pages.
+(function () {
+    var sizes = [1, 2, 3, 4, 6, 8, 10, 12, 16, 24, 32]; // In KB.
+    var totalBytes = 32 * 1024 * 1024;
+    var iterations = 10;
+
+    for (var s = 0; s < sizes.length; ++s) {
+        var length = sizes[s] * 1024 / 8;
+        var count = Math.floor(totalBytes / (sizes[s] * 1024));
+        var arrays = new Array(count);
+        for (var i = 0; i < count; ++i) {
+            var array = new Array(length);
+            for (var j = 0; j < length; ++j)
+                array[j] = j;
+            arrays[i] = array;
+        }
+
+        gc();
+        var before = preciseTime();
+        for (var i = 0; i < iterations; ++i)
+            gc();
+        var after = preciseTime();
+
+        print("bench-oversize-storage: " + sizes[s] + "KB x " + count + ": "
+            + ((after - before) * 1000 / iterations).toFixed(2) + " ms per collection");
+        arrays = null;
+        gc();
+    }
+})();
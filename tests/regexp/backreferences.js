@@ -0,0 +1,99 @@
+// Checks backreferences against both 8-bit and 16-bit subject strings. Run it
+// with jsc, once as is and once with JavaScriptCoreUseJIT=0 so that the regexps
+// run in the interpreter; both runs must print PASS.
+//
+// Case insensitively, a captured character matches itself and its lower and
+// upper case forms, which is also what a character in the pattern matches.
+(function () {
+    var failures = 0;
+
+    function describe(value) {
+        if (value === null)
+            return "null";
+        if (value === undefined)
+            return "undefined";
+        var result = "";
+        for (var i = 0; i < value.length; ++i) {
+            var code = value.charCodeAt(i);
+            result += code < 0x20 || code > 0x7e ? "\\u" + (0x10000 + code).toString(16).substring(1) : value.charAt(i);
+        }
+        return "\"" + result + "\"";
+    }
+
+    function describeMatch(match) {
+        if (!match)
+            return "null";
+        var parts = [];
+        for (var i = 0; i < match.length; ++i)
+            parts.push(describe(match[i]));
+        return "[" + parts.join(", ") + "] at " + match.index;
+    }
+
+    // Returns a copy of the string that is stored with 16-bit characters.
+    function sixteenBit(string) {
+        return ("\u0100" + string).substring(1);
+    }
+
+    function shouldMatch(regexp, subject, expected) {
+        var subjects = [subject, sixteenBit(subject)];
+        var widths = ["8-bit", "16-bit"];
+        for (var i = 0; i < subjects.length; ++i) {
+            var actual = describeMatch(regexp.exec(subjects[i]));
+            if (actual !== expected) {
+                print("FAIL: " + regexp + ".exec(" + describe(subject) + ") on " + widths[i] + " input is " + actual + ", expected " + expected);
+                ++failures;
+            }
+        }
+    }
+
+    // Case sensitive.
+    shouldMatch(/(a+)b\1/, "aabaa", "[\"aabaa\", \"aa\"] at 0");
+    shouldMatch(/(a+)b\1/, "aaba", "[\"aba\", \"a\"] at 1");
+    shouldMatch(/(abc)\1/, "abcABC", "null");
+    shouldMatch(/(\xe9)\1/, "\xe9\xc9", "null");
+    shouldMatch(/(\u03c3)\1/, "\u03c3\u03c3", "[\"\\u03c3\\u03c3\", \"\\u03c3\"] at 0");
+
+    // Case insensitive, ASCII and Latin-1.
+    shouldMatch(/(abc)\1/i, "abcABC", "[\"abcABC\", \"abc\"] at 0");
+    shouldMatch(/(ABC)\1/i, "xABCabc", "[\"ABCabc\", \"ABC\"] at 1");
+    shouldMatch(/(a[0-9])\1/i, "a1A1", "[\"a1A1\", \"a1\"] at 0");
+    shouldMatch(/(@)\1/i, "@`", "null");
+    shouldMatch(/(\xe9)\1/i, "\xe9\xc9", "[\"\\u00e9\\u00c9\", \"\\u00e9\"] at 0");
+    shouldMatch(/(\xc9)\1/i, "\xc9\xe9", "[\"\\u00c9\\u00e9\", \"\\u00c9\"] at 0");
+    shouldMatch(/(\xd7)\1/i, "\xd7\xf7", "null");
+    shouldMatch(/(\xdf)\1/i, "\xdf\xff", "null");
+    shouldMatch(/(\xff)\1/i, "\xff\xff", "[\"\\u00ff\\u00ff\", \"\\u00ff\"] at 0");
+
+    // Case insensitive, outside Latin-1.
+    shouldMatch(/(\u03c3)\1/i, "\u03c3\u03a3", "[\"\\u03c3\\u03a3\", \"\\u03c3\"] at 0");
+    shouldMatch(/(\u03c2)\1/i, "\u03c2\u03a3", "[\"\\u03c2\\u03a3\", \"\\u03c2\"] at 0");
+    shouldMatch(/(\u03c2)\1/i, "\u03c2\u03c3", "null");
+    shouldMatch(/(\u01c5)\1/i, "\u01c5\u01c5", "[\"\\u01c5\\u01c5\", \"\\u01c5\"] at 0");
+    shouldMatch(/(\u01c5)\1/i, "\u01c5\u01c6", "[\"\\u01c5\\u01c6\", \"\\u01c5\"] at 0");
+    shouldMatch(/(\u212a)\1/i, "\u212ak", "[\"\\u212ak\", \"\\u212a\"] at 0");
+    shouldMatch(/(\u212a)\1/i, "\u212aK", "null");
+    shouldMatch(/(\u017f)\1/i, "\u017fS", "[\"\\u017fS\", \"\\u017f\"] at 0");
+    shouldMatch(/(\u017f)\1/i, "\u017fs", "null");
+    shouldMatch(/(k)\1/i, "k\u212a", "null");
+
+    // References to groups that did not participate, or that come later, match
+    // the empty string.
+    shouldMatch(/(a)|b\1/, "b", "[\"b\", undefined] at 0");
+    shouldMatch(/(?:(a)|b)\1/, "ba", "[\"b\", undefined] at 0");
+    shouldMatch(/\1(a)/, "a", "[\"a\", \"a\"] at 0");
+    shouldMatch(/(a\1)/, "aa", "[\"a\", \"a\"] at 0");
+    shouldMatch(/()\1*x/, "x", "[\"x\", \"\"] at 0");
+
+    // Fixed size and quantified groups and references.
+    shouldMatch(/(ab){2}\1/, "ababab", "[\"ababab\", \"ab\"] at 0");
+    shouldMatch(/(a){3}\1/i, "aaAa", "[\"aaAa\", \"A\"] at 0");
+    shouldMatch(/(a)\1{2}/i, "aAA", "[\"aAA\", \"a\"] at 0");
+    shouldMatch(/(ab)\1{2,}/, "abababab", "[\"abababab\", \"ab\"] at 0");
+    shouldMatch(/(ab)\1*?c/, "abababc", "[\"abababc\", \"ab\"] at 0");
+    shouldMatch(/(a|b)\1+c/, "abbbc", "[\"bbbc\", \"b\"] at 1");
+    shouldMatch(/(\u03c3)\1{2}/i, "\u03c3\u03a3\u03c3", "[\"\\u03c3\\u03a3\\u03c3\", \"\\u03c3\"] at 0");
+
+    if (failures)
+        throw new Error(failures + " backreference tests failed");
+    print("PASS");
+})();
@@ -0,0 +1,88 @@
+// test(), search() and global match() only find where the match is, and leave the
+// subpatterns to be found again if RegExp.$1 and friends are ever read. Checks
+// that what those properties return is the same as after a full match. Run it
+// with jsc; it prints PASS.
+(function () {
+    var failures = 0;
+
+    function shouldBe(what, actual, expected) {
+        if (actual !== expected) {
+            print("FAIL: " + what + " is " + JSON.stringify(actual) + ", expected " + JSON.stringify(expected));
+            ++failures;
+        }
+    }
+
+    function checkLastMatch(what, $1, $2, lastMatch, leftContext, rightContext, lastParen) {
+        shouldBe(what + ": RegExp.$1", RegExp.$1, $1);
+        shouldBe(what + ": RegExp.$2", RegExp.$2, $2);
+        shouldBe(what + ": RegExp.lastMatch", RegExp.lastMatch, lastMatch);
+        shouldBe(what + ": RegExp.leftContext", RegExp.leftContext, leftContext);
+        shouldBe(what + ": RegExp.rightContext", RegExp.rightContext, rightContext);
+        shouldBe(what + ": RegExp.lastParen", RegExp.lastParen, lastParen);
+    }
+
+    var subject = "one=1, two=22, three=333";
+
+    shouldBe("test()", /(\w+)=(\d+)/.test(subject), true);
+    checkLastMatch("test()", "one", "1", "one=1", "", ", two=22, three=333", "1");
+
+    shouldBe("search()", subject.search(/(t\w+)=(\d+)/), 7);
+    checkLastMatch("search()", "two", "22", "two=22", "one=1, ", ", three=333", "22");
+
+    // The properties describe the last of the matches.
+    shouldBe("global match()", subject.match(/(\w+)=(\d+)/g).join("|"), "one=1|two=22|three=333");
+    checkLastMatch("global match()", "three", "333", "three=333", "one=1, two=22, ", "", "333");
+
+    // A global regexp starts matching at lastIndex, and so must finding the
+    // subpatterns again.
+    var global = /(\w+)=(\d+)/g;
+    global.lastIndex = 3;
+    shouldBe("global test() from lastIndex 3", global.test(subject), true);
+    shouldBe("lastIndex after global test()", global.lastIndex, 13);
+    checkLastMatch("global test() from lastIndex 3", "two", "22", "two=22", "one=1, ", ", three=333", "22");
+
+    // A match that starts inside an earlier one: from index 9, "o=22" is found.
+    global.lastIndex = 9;
+    shouldBe("global test() from lastIndex 9", global.test(subject), true);
+    checkLastMatch("global test() from lastIndex 9", "o", "22", "o=22", "one=1, tw", ", three=333", "22");
+
+    // A failed match leaves the properties alone.
+    shouldBe("failing test()", /(x+)=(y+)/.test(subject), false);
+    checkLastMatch("failing test()", "o", "22", "o=22", "one=1, tw", ", three=333", "22");
+
+    // split() does not update the properties.
+    shouldBe("split()", subject.split(/(,) /).join("|"), "one=1|,|two=22|,|three=333");
+    checkLastMatch("split()", "o", "22", "o=22", "one=1, tw", ", three=333", "22");
+
+    // Subpatterns that did not participate are empty strings.
+    shouldBe("test() with an unmatched group", /(a)|(b)/.test("xb"), true);
+    checkLastMatch("test() with an unmatched group", "", "b", "b", "x", "", "b");
+
+    // Reading the properties after the subject string is gone must still work,
+    // and a later full match replaces the lazy one.
+    (function () {
+        /(\d)(\d)/.test("ab" + 12 + "cd");
+    })();
+    checkLastMatch("test() on a temporary string", "1", "2", "12", "ab", "cd", "2");
+    shouldBe("exec()", /(c)(d)/.exec("abcd").index, 2);
+    checkLastMatch("exec()", "c", "d", "cd", "ab", "", "d");
+
+    // Each lazy match replaces the one before it, whether or not that one was read.
+    /(a)(b)/.test("ab");
+    shouldBe("first of two test()s: RegExp.$1", RegExp.$1, "a");
+    /(c)(d)/.test("cd");
+    checkLastMatch("second of two test()s", "c", "d", "cd", "", "", "d");
+
+    // Global match() starts from the beginning whatever the lastIndex is.
+    shouldBe("match() on a global regexp with a lastIndex", (function () {
+        var regexp = /(\d+)/g;
+        regexp.lastIndex = 5;
+        return "a1b22c333".match(regexp).length;
+    })(), 3);
+    checkLastMatch("match() on a global regexp with a lastIndex", "333", "", "333", "a1b22c", "", "333");
+    shouldBe("RegExp.input", RegExp.input, "a1b22c333");
+
+    if (failures)
+        throw new Error(failures + " lazy match tests failed");
+    print("PASS");
+})();
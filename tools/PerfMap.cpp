@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "PerfMap.h"
+
+#include "CodeBlock.h"
+#include "CodeProfiling.h"
+#include "Executable.h"
+#include "MetaAllocator.h"
+#include "UString.h"
+#include <wtf/PageBlock.h>
+#include <wtf/Threading.h>
+#include <wtf/text/CString.h>
+
+#if OS(LINUX)
+#include <elf.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace JSC {
+
+PerfMap::Mode PerfMap::s_mode = PerfMap::Disabled;
+
+#if OS(LINUX)
+
+// The jitdump format is described in tools/perf/Documentation/jitdump-specification.txt
+// in the Linux sources. All fields are naturally aligned, so these need no packing.
+struct JITDumpHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t totalSize;
+    uint32_t elfMachine;
+    uint32_t padding;
+    uint32_t pid;
+    uint64_t timestamp;
+    uint64_t flags;
+};
+
+struct JITDumpRecordHeader {
+    uint32_t id;
+    uint32_t totalSize;
+    uint64_t timestamp;
+};
+
+// Followed by the name, with its terminating null, and then by the code.
+struct JITDumpCodeLoad {
+    JITDumpRecordHeader header;
+    uint32_t pid;
+    uint32_t tid;
+    uint64_t vma;
+    uint64_t codeAddress;
+    uint64_t codeSize;
+    uint64_t codeIndex;
+};
+
+// Followed by entryCount entries.
+struct JITDumpDebugInfo {
+    JITDumpRecordHeader header;
+    uint64_t codeAddress;
+    uint64_t entryCount;
+};
+
+// Followed by the file name, with its terminating null.
+struct JITDumpDebugEntry {
+    uint64_t codeAddress;
+    uint32_t line;
+    uint32_t discriminator;
+};
+
+static const uint32_t jitDumpMagic = 0x4A695444;
+static const uint32_t jitDumpVersion = 1;
+static const uint32_t jitDumpCodeLoad = 0;
+static const uint32_t jitDumpDebugInfo = 2;
+
+static Mutex* perfMapLock;
+static FILE* perfMapFile;
+static uint64_t nextCodeIndex;
+
+// Frees are only worth recording in a jitdump, which timestamps every record. A
+// perf map has no way to say that an address range no longer holds some code.
+class PerfMapTracker : public WTF::MetaAllocatorTracker {
+public:
+    virtual void notify(WTF::MetaAllocatorHandle*) { }
+    virtual void release(WTF::MetaAllocatorHandle* handle)
+    {
+        PerfMap::codeFreed(handle->start(), handle->sizeInBytes());
+    }
+};
+
+static uint64_t timestamp()
+{
+    // perf record -k mono makes perf use the same clock.
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+static uint32_t elfMachine()
+{
+#if CPU(X86_64)
+    return EM_X86_64;
+#elif CPU(X86)
+    return EM_386;
+#elif CPU(ARM)
+    return EM_ARM;
+#elif CPU(MIPS)
+    return EM_MIPS;
+#elif CPU(SH4)
+    return EM_SH;
+#else
+    return EM_NONE;
+#endif
+}
+
+static const char* tierName(PerfMap::Tier tier)
+{
+    switch (tier) {
+    case PerfMap::Baseline:
+        return "Baseline";
+    case PerfMap::DFG:
+        return "DFG";
+    case PerfMap::Stub:
+        return "Stub";
+    case PerfMap::Yarr:
+        return "Yarr";
+    }
+    ASSERT_NOT_REACHED();
+    return "";
+}
+
+static CString codeBlockName(CodeBlock* codeBlock)
+{
+    switch (codeBlock->codeType()) {
+    case GlobalCode:
+        return "<global>";
+    case EvalCode:
+        return "<eval>";
+    case FunctionCode: {
+        FunctionExecutable* executable = static_cast<FunctionExecutable*>(codeBlock->ownerExecutable());
+        if (!executable->name().isEmpty())
+            return executable->name().ustring().utf8();
+        if (!executable->inferredName().isEmpty())
+            return executable->inferredName().ustring().utf8();
+        return "<anonymous>";
+    }
+    }
+    ASSERT_NOT_REACHED();
+    return CString();
+}
+
+static void writeJITDump(const void* data, size_t size)
+{
+    fwrite(data, 1, size, perfMapFile);
+}
+
+static void writeJITDumpZeros(size_t size)
+{
+    static const char zeros[256] = { 0 };
+    for (; size > sizeof(zeros); size -= sizeof(zeros))
+        writeJITDump(zeros, sizeof(zeros));
+    writeJITDump(zeros, size);
+}
+
+static void writeJITDumpCodeLoad(void* code, size_t size, const char* name, bool codeIsLive)
+{
+    size_t nameSize = strlen(name) + 1;
+
+    JITDumpCodeLoad record;
+    record.header.id = jitDumpCodeLoad;
+    record.header.totalSize = sizeof(record) + nameSize + size;
+    record.header.timestamp = timestamp();
+    record.pid = getpid();
+    record.tid = syscall(SYS_gettid);
+    record.vma = reinterpret_cast<uintptr_t>(code);
+    record.codeAddress = reinterpret_cast<uintptr_t>(code);
+    record.codeSize = size;
+    record.codeIndex = nextCodeIndex++;
+    writeJITDump(&record, sizeof(record));
+    writeJITDump(name, nameSize);
+    if (codeIsLive)
+        writeJITDump(code, size);
+    else
+        writeJITDumpZeros(size);
+}
+
+// perf expects the debug info for some code right before the code itself.
+static void writeJITDumpDebugInfo(void* code, CodeBlock* codeBlock, const Vector<PerfMap::BytecodeLocation>& bytecodeLocations)
+{
+    CString sourceURL = codeBlock->ownerExecutable()->sourceURL().utf8();
+    size_t sourceURLSize = sourceURL.length() + 1;
+
+    JITDumpDebugInfo record;
+    record.header.id = jitDumpDebugInfo;
+    record.header.totalSize = sizeof(record) + bytecodeLocations.size() * (sizeof(JITDumpDebugEntry) + sourceURLSize);
+    record.header.timestamp = timestamp();
+    record.codeAddress = reinterpret_cast<uintptr_t>(code);
+    record.entryCount = bytecodeLocations.size();
+    writeJITDump(&record, sizeof(record));
+
+    // The line is the source line, and the discriminator is the bytecode offset.
+    for (unsigned i = 0; i < bytecodeLocations.size(); ++i) {
+        JITDumpDebugEntry entry;
+        entry.codeAddress = reinterpret_cast<uintptr_t>(code) + bytecodeLocations[i].codeOffset;
+        entry.line = codeBlock->lineNumberForBytecodeOffset(bytecodeLocations[i].bytecodeOffset);
+        entry.discriminator = bytecodeLocations[i].bytecodeOffset;
+        writeJITDump(&entry, sizeof(entry));
+        writeJITDump(sourceURL.data(), sourceURLSize);
+    }
+}
+
+#endif // OS(LINUX)
+
+void PerfMap::notifyAllocator(WTF::MetaAllocator* allocator)
+{
+#if OS(LINUX)
+    // Check for JSC_PERF_MAP.
+    const char* perfMapMode = getenv("JSC_PERF_MAP");
+    if (!perfMapMode)
+        return;
+
+    // Check for a valid mode, currently "1" or "2".
+    if (!perfMapMode[0] || perfMapMode[1])
+        return;
+    Mode mode;
+    switch (*perfMapMode) {
+    case '1':
+        mode = PerfMapFile;
+        break;
+    case '2':
+        mode = JITDump;
+        break;
+    default:
+        return;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), mode == PerfMapFile ? "/tmp/perf-%d.map" : "/tmp/jit-%d.dump", getpid());
+    int fd = open(path, O_CREAT | O_TRUNC | O_RDWR, 0666);
+    if (fd < 0)
+        return;
+    FILE* file = fdopen(fd, "w");
+    if (!file) {
+        close(fd);
+        return;
+    }
+
+    if (mode == JITDump) {
+        JITDumpHeader header;
+        header.magic = jitDumpMagic;
+        header.version = jitDumpVersion;
+        header.totalSize = sizeof(header);
+        header.elfMachine = elfMachine();
+        header.padding = 0;
+        header.pid = getpid();
+        header.timestamp = timestamp();
+        header.flags = 0;
+        fwrite(&header, 1, sizeof(header), file);
+        fflush(file);
+
+        // perf record finds the jitdump through this executable mapping of it,
+        // which stays around for the life of the process.
+        if (mmap(0, pageSize(), PROT_READ | PROT_EXEC, MAP_PRIVATE, fd, 0) == MAP_FAILED) {
+            fclose(file);
+            return;
+        }
+    }
+
+    perfMapLock = new Mutex();
+    perfMapFile = file;
+    s_mode = mode;
+
+    // The allocator only has room for one tracker, and code profiling needs its own.
+    if (mode == JITDump && !CodeProfiling::enabled())
+        allocator->trackAllocations(new PerfMapTracker());
+#else
+    UNUSED_PARAM(allocator);
+#endif
+}
+
+void PerfMap::codeAdded(void* code, size_t size, const Description& description)
+{
+#if OS(LINUX)
+    if (!enabled())
+        return;
+
+    char name[512];
+    const char* tier = tierName(description.m_tier);
+    if (description.m_codeBlock) {
+        CodeBlock* codeBlock = description.m_codeBlock;
+        CString functionName = codeBlockName(codeBlock);
+        CString sourceURL = codeBlock->ownerExecutable()->sourceURL().utf8();
+        int line = codeBlock->ownerExecutable()->lineNo();
+        if (description.m_bytecodeOffset != Description::noBytecodeOffset)
+            snprintf(name, sizeof(name), "%s: %s %s:%d bc#%u [%s]", description.m_name, functionName.data(), sourceURL.data(), line, description.m_bytecodeOffset, tier);
+        else
+            snprintf(name, sizeof(name), "%s %s:%d [%s]", functionName.data(), sourceURL.data(), line, tier);
+    } else if (description.m_ustringName)
+        snprintf(name, sizeof(name), "%s [%s]", description.m_ustringName->utf8().data(), tier);
+    else
+        snprintf(name, sizeof(name), "%s [%s]", description.m_name ? description.m_name : "JIT code", tier);
+
+    MutexLocker locker(*perfMapLock);
+    if (s_mode == PerfMapFile)
+        fprintf(perfMapFile, "%lx %lx %s\n", static_cast<unsigned long>(reinterpret_cast<uintptr_t>(code)), static_cast<unsigned long>(size), name);
+    else {
+        if (description.m_codeBlock && description.m_bytecodeLocations && !description.m_bytecodeLocations->isEmpty())
+            writeJITDumpDebugInfo(code, description.m_codeBlock, *description.m_bytecodeLocations);
+        writeJITDumpCodeLoad(code, size, name, true);
+    }
+    // Flush every record, so that the file is complete however the process ends.
+    fflush(perfMapFile);
+#else
+    UNUSED_PARAM(code);
+    UNUSED_PARAM(size);
+    UNUSED_PARAM(description);
+#endif
+}
+
+void PerfMap::codeFreed(void* code, size_t size)
+{
+#if OS(LINUX)
+    if (s_mode != JITDump || !size)
+        return;
+
+    // A load of zeros covers the range from now on, so that perf does not attribute
+    // later samples in it to the code that used to be there, should the range not
+    // be reused right away.
+    MutexLocker locker(*perfMapLock);
+    writeJITDumpCodeLoad(code, size, "[freed JIT code]", false);
+    fflush(perfMapFile);
+#else
+    UNUSED_PARAM(code);
+    UNUSED_PARAM(size);
+#endif
+}
+
+} // namespace JSC
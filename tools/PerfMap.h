@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef PerfMap_h
+#define PerfMap_h
+
+#include <wtf/Vector.h>
+
+namespace WTF {
+
+class MetaAllocator;
+
+}
+
+namespace JSC {
+
+class CodeBlock;
+class UString;
+
+// Tells external profilers, such as Linux perf, what JIT code is. Without this,
+// samples in JIT code can only be attributed to anonymous addresses. Setting
+// JSC_PERF_MAP=1 appends a line for each piece of code to /tmp/perf-<pid>.map,
+// which perf report reads directly. Setting JSC_PERF_MAP=2 writes the jitdump
+// format to /tmp/jit-<pid>.dump instead, for use with perf record -k mono and
+// perf inject --jit. A jitdump also has the bytecode offset of every instruction
+// of a code block, and records code being freed, so that samples are attributed
+// correctly when the executable allocator reuses memory.
+class PerfMap {
+public:
+    enum Tier {
+        Baseline,
+        DFG,
+        Stub,
+        Yarr
+    };
+
+    // The machine code starting at codeOffset, up to the next location, was
+    // generated for the bytecode instruction at bytecodeOffset.
+    struct BytecodeLocation {
+        BytecodeLocation(unsigned codeOffset, unsigned bytecodeOffset)
+            : codeOffset(codeOffset)
+            , bytecodeOffset(bytecodeOffset)
+        {
+        }
+
+        unsigned codeOffset;
+        unsigned bytecodeOffset;
+    };
+
+    // Describes code to LinkBuffer::finalizeCode(). This is cheap to build, and the
+    // name is only formatted if the perf map is enabled.
+    class Description {
+    public:
+        Description()
+            : m_tier(Stub)
+            , m_codeBlock(0)
+            , m_name(0)
+            , m_ustringName(0)
+            , m_bytecodeOffset(noBytecodeOffset)
+            , m_bytecodeLocations(0)
+        {
+        }
+
+        // Code that does not belong to a code block, like a thunk.
+        Description(Tier tier, const char* name)
+            : m_tier(tier)
+            , m_codeBlock(0)
+            , m_name(name)
+            , m_ustringName(0)
+            , m_bytecodeOffset(noBytecodeOffset)
+            , m_bytecodeLocations(0)
+        {
+        }
+
+        Description(Tier tier, const UString& name)
+            : m_tier(tier)
+            , m_codeBlock(0)
+            , m_name(0)
+            , m_ustringName(&name)
+            , m_bytecodeOffset(noBytecodeOffset)
+            , m_bytecodeLocations(0)
+        {
+        }
+
+        // The code for a whole code block.
+        Description(Tier tier, CodeBlock* codeBlock, const Vector<BytecodeLocation>* bytecodeLocations = 0)
+            : m_tier(tier)
+            , m_codeBlock(codeBlock)
+            , m_name(0)
+            , m_ustringName(0)
+            , m_bytecodeOffset(noBytecodeOffset)
+            , m_bytecodeLocations(bytecodeLocations)
+        {
+        }
+
+        // A stub for one instruction of a code block, like a get_by_id list.
+        Description(Tier tier, CodeBlock* codeBlock, const char* name, unsigned bytecodeOffset)
+            : m_tier(tier)
+            , m_codeBlock(codeBlock)
+            , m_name(name)
+            , m_ustringName(0)
+            , m_bytecodeOffset(bytecodeOffset)
+            , m_bytecodeLocations(0)
+        {
+        }
+
+    private:
+        friend class PerfMap;
+
+        static const unsigned noBytecodeOffset = 0xffffffff;
+
+        Tier m_tier;
+        CodeBlock* m_codeBlock;
+        const char* m_name;
+        const UString* m_ustringName;
+        unsigned m_bytecodeOffset;
+        const Vector<BytecodeLocation>* m_bytecodeLocations;
+    };
+
+    static bool enabled() { return s_mode != Disabled; }
+    static bool wantsBytecodeLocations() { return s_mode == JITDump; }
+
+    static void notifyAllocator(WTF::MetaAllocator*);
+    static void codeAdded(void* code, size_t size, const Description&);
+    static void codeFreed(void* code, size_t size);
+
+private:
+    enum Mode {
+        Disabled,
+        PerfMapFile,
+        JITDump
+    };
+
+    static Mode s_mode;
+};
+
+} // namespace JSC
+
+#endif // PerfMap_h
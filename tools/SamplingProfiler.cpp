@@ -0,0 +1,507 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "SamplingProfiler.h"
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include "CodeBlock.h"
+#include "ExecutableAllocator.h"
+#include "Interpreter.h"
+#include "JSFunction.h"
+#include "JSONObject.h"
+#include "UStringBuilder.h"
+#include <wtf/Atomics.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/HashFunctions.h>
+
+namespace JSC {
+
+// Stacks deeper than this are cut off at the bottom.
+static const unsigned maximumStackDepth = 128;
+
+// Enough for a few thousand distinct stacks between garbage collections. Samples
+// that would fill the table past three quarters are dropped.
+static const unsigned rawNodeTableSize = 1 << 15;
+static const unsigned maximumRawNodeCount = rawNodeTableSize / 4 * 3;
+static const unsigned noRawNode = std::numeric_limits<unsigned>::max();
+
+SamplingProfiler* volatile SamplingProfiler::s_samplingProfiler = 0;
+
+SamplingProfiler::SamplingProfiler(JSGlobalData& globalData)
+    : m_globalData(globalData)
+    , m_codeBlocksLock(0)
+    , m_timerThread(0)
+    , m_timerShouldStop(false)
+    , m_intervalInMicroseconds(0)
+    , m_rawNodes(0)
+    , m_rawNodeOrder(0)
+    , m_rawNodeCount(0)
+    , m_rawRootSamples(0)
+    , m_isProcessing(false)
+    , m_root(CallIdentifier("(root)", "", 0))
+    , m_sampleCount(0)
+    , m_droppedSampleCount(0)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+    fastFree(m_rawNodes);
+    fastFree(m_rawNodeOrder);
+}
+
+void SamplingProfiler::lockCodeBlocks()
+{
+    while (!tryLockCodeBlocks())
+        yield();
+}
+
+bool SamplingProfiler::tryLockCodeBlocks()
+{
+    return WTF::weakCompareAndSwap(&m_codeBlocksLock, 0, 1);
+}
+
+void SamplingProfiler::unlockCodeBlocks()
+{
+    bool wasLocked = WTF::weakCompareAndSwap(&m_codeBlocksLock, 1, 0);
+    ASSERT_UNUSED(wasLocked, wasLocked);
+}
+
+void SamplingProfiler::addCodeBlock(CodeBlock* codeBlock)
+{
+    lockCodeBlocks();
+    m_codeBlocks.add(codeBlock);
+    unlockCodeBlocks();
+}
+
+void SamplingProfiler::removeCodeBlock(CodeBlock* codeBlock)
+{
+    lockCodeBlocks();
+    m_codeBlocks.remove(codeBlock);
+    unlockCodeBlocks();
+}
+
+bool SamplingProfiler::start(unsigned intervalInMicroseconds)
+{
+    if (m_timerThread)
+        return true;
+    if (!WTF::weakCompareAndSwap(reinterpret_cast<void* volatile*>(&s_samplingProfiler), 0, this))
+        return false;
+
+    if (!m_rawNodes) {
+        m_rawNodes = static_cast<RawNode*>(fastZeroedMalloc(rawNodeTableSize * sizeof(RawNode)));
+        m_rawNodeOrder = static_cast<unsigned*>(fastMalloc(maximumRawNodeCount * sizeof(unsigned)));
+    }
+
+    m_sampledThread = pthread_self();
+    m_intervalInMicroseconds = std::max(intervalInMicroseconds, 10u);
+
+    struct sigaction action;
+    action.sa_sigaction = signalHandler;
+    sigfillset(&action.sa_mask);
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigaction(SIGPROF, &action, &m_previousAction);
+
+    m_timerShouldStop = false;
+    m_timerThread = createThread(timerThreadStart, this, "JavaScriptCore::SamplingProfiler");
+    return true;
+}
+
+void SamplingProfiler::stop()
+{
+    if (!m_timerThread)
+        return;
+    ASSERT(pthread_equal(m_sampledThread, pthread_self()));
+
+    {
+        MutexLocker locker(m_timerLock);
+        m_timerShouldStop = true;
+        m_timerCondition.signal();
+    }
+    waitForThreadCompletion(m_timerThread, 0);
+    m_timerThread = 0;
+
+    // A signal that was already sent is ignored by the handler once this is cleared.
+    s_samplingProfiler = 0;
+    sigaction(SIGPROF, &m_previousAction, 0);
+}
+
+void* SamplingProfiler::timerThreadStart(void* profiler)
+{
+    static_cast<SamplingProfiler*>(profiler)->timerThreadMain();
+    return 0;
+}
+
+void SamplingProfiler::timerThreadMain()
+{
+    MutexLocker locker(m_timerLock);
+    while (!m_timerShouldStop) {
+        m_timerCondition.timedWait(m_timerLock, currentTime() + m_intervalInMicroseconds / 1000000.0);
+        if (!m_timerShouldStop)
+            pthread_kill(m_sampledThread, SIGPROF);
+    }
+}
+
+void SamplingProfiler::signalHandler(int, siginfo_t*, void* uap)
+{
+    SamplingProfiler* profiler = s_samplingProfiler;
+    if (!profiler)
+        return;
+    mcontext_t& context = static_cast<ucontext_t*>(uap)->uc_mcontext;
+    profiler->takeSample(reinterpret_cast<void*>(context.gregs[REG_RIP]), reinterpret_cast<void*>(context.gregs[REG_R13]));
+}
+
+// Everything from here until recordStack() runs in the signal handler, on the
+// sampled thread, so it must not allocate, lock or write to the stack it walks.
+void SamplingProfiler::takeSample(void* pc, void* callFrameRegister)
+{
+    if (m_isProcessing || !tryLockCodeBlocks()) {
+        ++m_droppedSampleCount;
+        return;
+    }
+
+    Frame frames[maximumStackDepth];
+    unsigned depth = walkStack(frames, pc, callFrameRegister);
+    unlockCodeBlocks();
+
+    recordStack(frames, depth);
+}
+
+static bool codeOriginForFrame(CodeBlock* codeBlock, CallFrame* callFrame, void* pc, void* returnPC, CodeOrigin& codeOrigin)
+{
+    if (!codeBlock->hasCodeOrigins())
+        return false;
+
+    // Code that has called out knows where it was from its return address. The
+    // frame that was interrupted knows from the pc, if it was compiled while we
+    // were sampling. Otherwise the best we have is the code origin index stored
+    // by the last call out.
+    if (pc && codeBlock->codeOriginForMachineCode(pc, codeOrigin))
+        return true;
+    if (returnPC) {
+        JITCode& jitCode = codeBlock->getJITCode();
+        char* start = static_cast<char*>(jitCode.start());
+        if (returnPC <= start || returnPC > start + jitCode.size())
+            return false;
+        return codeBlock->codeOriginForReturn(ReturnAddressPtr(returnPC), codeOrigin);
+    }
+
+    unsigned index = callFrame->codeOriginIndexForDFG();
+    if (index >= codeBlock->codeOrigins().size())
+        return false;
+    codeOrigin = codeBlock->codeOrigin(index);
+    return true;
+}
+
+unsigned SamplingProfiler::walkStack(Frame* frames, void* pc, void* callFrameRegister)
+{
+    unsigned depth = 0;
+    if (m_globalData.heap.isBusy()) {
+        frames[depth].kind = GarbageCollectorFrame;
+        frames[depth].key = 0;
+        ++depth;
+    }
+
+    RegisterFile& registerFile = m_globalData.interpreter->registerFile();
+    Register* begin = registerFile.begin() + RegisterFile::CallFrameHeaderSize;
+    Register* end = registerFile.end();
+
+    // JIT code keeps the current call frame in a register. Anywhere else, the
+    // last call out of JavaScript will have stored it.
+    CallFrame* callFrame = m_globalData.topCallFrame->removeHostCallFrameFlag();
+    Register* candidate = static_cast<Register*>(callFrameRegister);
+    if (ExecutableAllocator::isValidExecutableMemory(pc) && candidate >= begin && candidate < end) {
+        CodeBlock* codeBlock = CallFrame::create(candidate)->codeBlock();
+        if (!codeBlock || m_codeBlocks.contains(codeBlock))
+            callFrame = CallFrame::create(candidate);
+    }
+
+    // Only the top frame can be executing at pc.
+    void* framePC = pc;
+    void* returnPC = 0;
+    while (callFrame && depth < maximumStackDepth) {
+        Register* registers = callFrame->registers();
+        if (registers < begin || registers >= end || reinterpret_cast<uintptr_t>(registers) % sizeof(Register))
+            break;
+
+        CodeBlock* codeBlock = callFrame->codeBlock();
+        if (codeBlock) {
+            if (!m_codeBlocks.contains(codeBlock))
+                break;
+
+#if ENABLE(DFG_JIT)
+            CodeOrigin codeOrigin;
+            if (codeBlock->getJITType() == JITCode::DFGJIT && codeOriginForFrame(codeBlock, callFrame, framePC, returnPC, codeOrigin)) {
+                for (InlineCallFrame* inlineCallFrame = codeOrigin.inlineCallFrame; inlineCallFrame && depth < maximumStackDepth; inlineCallFrame = inlineCallFrame->caller.inlineCallFrame) {
+                    frames[depth].kind = ExecutableFrame;
+                    frames[depth].key = inlineCallFrame->executable.get();
+                    ++depth;
+                }
+                if (depth == maximumStackDepth)
+                    break;
+            }
+#endif
+            frames[depth].kind = ExecutableFrame;
+            frames[depth].key = codeBlock->ownerExecutable();
+            ++depth;
+        } else if (JSObject* callee = callFrame->callee()) {
+            frames[depth].kind = HostFunctionFrame;
+            frames[depth].key = callee;
+            ++depth;
+        }
+
+        framePC = 0;
+        CallFrame* callerFrame = callFrame->callerFrame();
+        if (callerFrame->hasHostCallFrameFlag()) {
+            returnPC = 0;
+            callerFrame = callerFrame->removeHostCallFrameFlag();
+        } else
+            returnPC = callFrame->returnPC().value();
+
+        // Callers are always further down the register file, which also makes
+        // sure that this terminates however the frames were overwritten.
+        if (callerFrame >= callFrame)
+            break;
+        callFrame = callerFrame;
+    }
+    return depth;
+}
+
+unsigned SamplingProfiler::findOrAddRawNode(unsigned parent, const Frame& frame)
+{
+    unsigned hash = WTF::intHash(reinterpret_cast<uint64_t>(frame.key)) ^ WTF::intHash(parent * 4 + frame.kind);
+    for (unsigned i = hash & (rawNodeTableSize - 1); ; i = (i + 1) & (rawNodeTableSize - 1)) {
+        RawNode& node = m_rawNodes[i];
+        if (node.kind == NoFrame) {
+            if (m_rawNodeCount == maximumRawNodeCount)
+                return noRawNode;
+            node.key = frame.key;
+            node.kind = frame.kind;
+            node.parent = parent;
+            node.number = m_rawNodeCount;
+            node.samples = 0;
+            m_rawNodeOrder[m_rawNodeCount] = i;
+            return m_rawNodeCount++;
+        }
+        if (node.key == frame.key && node.kind == static_cast<unsigned>(frame.kind) && node.parent == parent)
+            return node.number;
+    }
+}
+
+void SamplingProfiler::recordStack(const Frame* frames, unsigned depth)
+{
+    if (!depth) {
+        ++m_rawRootSamples;
+        ++m_sampleCount;
+        return;
+    }
+
+    unsigned node = noRawNode;
+    for (unsigned i = depth; i--;) {
+        node = findOrAddRawNode(node, frames[i]);
+        if (node == noRawNode) {
+            ++m_droppedSampleCount;
+            return;
+        }
+    }
+    ++m_rawNodes[m_rawNodeOrder[node]].samples;
+    ++m_sampleCount;
+}
+
+bool SamplingProfiler::isLiveCell(void* candidate)
+{
+    MarkedBlockSet& blocks = m_globalData.heap.objectSpace().blocks();
+    MarkedBlock* block = MarkedBlock::blockFor(candidate);
+    if (!MarkedBlock::isAtomAligned(candidate) || blocks.filter().ruleOut(reinterpret_cast<Bits>(block)) || !blocks.set().contains(block))
+        return false;
+    return block->isLiveCell(candidate);
+}
+
+CallIdentifier SamplingProfiler::identifierFor(FrameKind kind, void* key)
+{
+    if (kind == GarbageCollectorFrame)
+        return CallIdentifier("(garbage collector)", "", 0);
+
+    // The signal handler can be misled by call frames that have not been fully
+    // set up or torn down, so anything it found may not be what it seems.
+    if (!key || !isLiveCell(key))
+        return CallIdentifier("(unknown)", "", 0);
+    JSCell* cell = static_cast<JSCell*>(key);
+
+    if (kind == HostFunctionFrame) {
+        if (!cell->isObject())
+            return CallIdentifier("(unknown)", "", 0);
+        JSValue name = asObject(cell)->getDirect(m_globalData, m_globalData.propertyNames->name);
+        if (!name.isString() || asString(name)->tryGetValue().isEmpty())
+            return CallIdentifier("(anonymous function)", "", 0);
+        return CallIdentifier(asString(name)->tryGetValue(), "", 0);
+    }
+
+    if (FunctionExecutable* executable = jsDynamicCast<FunctionExecutable*>(cell)) {
+        UString name = executable->name().ustring();
+        if (name.isEmpty())
+            name = executable->inferredName().ustring();
+        return CallIdentifier(name.isEmpty() ? "(anonymous function)" : name, executable->sourceURL(), executable->lineNo());
+    }
+    if (ProgramExecutable* executable = jsDynamicCast<ProgramExecutable*>(cell))
+        return CallIdentifier("(program)", executable->sourceURL(), executable->lineNo());
+    if (EvalExecutable* executable = jsDynamicCast<EvalExecutable*>(cell))
+        return CallIdentifier("(eval)", executable->sourceURL(), executable->lineNo());
+    return CallIdentifier("(unknown)", "", 0);
+}
+
+void SamplingProfiler::processSamples()
+{
+    if (!m_rawNodeCount && !m_rawRootSamples)
+        return;
+
+    // Keep the signal handler away from the table while it is being emptied.
+    m_isProcessing = true;
+
+    m_globalData.heap.objectSpace().canonicalizeCellLivenessData();
+
+    HashMap<void*, CallIdentifier> identifiers;
+    Vector<Node*> nodes(m_rawNodeCount);
+    for (unsigned i = 0; i < m_rawNodeCount; ++i) {
+        RawNode& rawNode = m_rawNodes[m_rawNodeOrder[i]];
+        FrameKind kind = static_cast<FrameKind>(rawNode.kind);
+
+        CallIdentifier identifier;
+        if (kind == GarbageCollectorFrame || !rawNode.key)
+            identifier = identifierFor(kind, rawNode.key);
+        else {
+            HashMap<void*, CallIdentifier>::iterator iter = identifiers.find(rawNode.key);
+            if (iter == identifiers.end())
+                iter = identifiers.add(rawNode.key, identifierFor(kind, rawNode.key)).first;
+            identifier = iter->second;
+        }
+
+        Node* parent = rawNode.parent == noRawNode ? &m_root : nodes[rawNode.parent];
+        nodes[i] = parent->child(identifier);
+        nodes[i]->selfSamples += rawNode.samples;
+
+        rawNode.kind = NoFrame;
+    }
+    m_rawNodeCount = 0;
+
+    m_root.selfSamples += m_rawRootSamples;
+    m_rawRootSamples = 0;
+
+    m_isProcessing = false;
+}
+
+void SamplingProfiler::clear()
+{
+    m_isProcessing = true;
+    for (unsigned i = 0; i < m_rawNodeCount; ++i)
+        m_rawNodes[m_rawNodeOrder[i]].kind = NoFrame;
+    m_rawNodeCount = 0;
+    m_rawRootSamples = 0;
+    m_isProcessing = false;
+
+    deleteAllValues(m_root.children);
+    m_root.children.clear();
+    m_root.selfSamples = 0;
+    m_sampleCount = 0;
+    m_droppedSampleCount = 0;
+}
+
+SamplingProfiler::Node::~Node()
+{
+    deleteAllValues(children);
+}
+
+SamplingProfiler::Node* SamplingProfiler::Node::child(const CallIdentifier& identifier)
+{
+    pair<HashMap<CallIdentifier, Node*>::iterator, bool> result = children.add(identifier, 0);
+    if (result.second)
+        result.first->second = new Node(identifier);
+    return result.first->second;
+}
+
+unsigned SamplingProfiler::Node::totalSamples() const
+{
+    unsigned result = selfSamples;
+    HashMap<CallIdentifier, Node*>::const_iterator end = children.end();
+    for (HashMap<CallIdentifier, Node*>::const_iterator iter = children.begin(); iter != end; ++iter)
+        result += iter->second->totalSamples();
+    return result;
+}
+
+bool SamplingProfiler::Node::hasMoreSamples(const pair<unsigned, const Node*>& a, const pair<unsigned, const Node*>& b)
+{
+    return a.first > b.first;
+}
+
+void SamplingProfiler::Node::appendJSON(UStringBuilder& builder) const
+{
+    builder.append("{\"name\":");
+    appendQuotedJSONString(builder, identifier.m_name);
+    builder.append(",\"url\":");
+    appendQuotedJSONString(builder, identifier.m_url);
+    builder.append(",\"line\":");
+    builder.append(UString::number(identifier.m_lineNumber));
+    builder.append(",\"selfSamples\":");
+    builder.append(UString::number(selfSamples));
+    builder.append(",\"totalSamples\":");
+    builder.append(UString::number(totalSamples()));
+    builder.append(",\"children\":[");
+
+    Vector<pair<unsigned, const Node*> > sortedChildren;
+    HashMap<CallIdentifier, Node*>::const_iterator end = children.end();
+    for (HashMap<CallIdentifier, Node*>::const_iterator iter = children.begin(); iter != end; ++iter)
+        sortedChildren.append(std::make_pair(iter->second->totalSamples(), iter->second));
+    std::stable_sort(sortedChildren.begin(), sortedChildren.end(), hasMoreSamples);
+    for (size_t i = 0; i < sortedChildren.size(); ++i) {
+        if (i)
+            builder.append(',');
+        sortedChildren[i].second->appendJSON(builder);
+    }
+    builder.append("]}");
+}
+
+UString SamplingProfiler::toJSON()
+{
+    processSamples();
+
+    UStringBuilder builder;
+    builder.append("{\"interval\":");
+    builder.append(UString::number(m_intervalInMicroseconds));
+    builder.append(",\"samples\":");
+    builder.append(UString::number(m_sampleCount));
+    builder.append(",\"droppedSamples\":");
+    builder.append(UString::number(m_droppedSampleCount));
+    builder.append(",\"tree\":");
+    m_root.appendJSON(builder);
+    builder.append('}');
+    return builder.toUString();
+}
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
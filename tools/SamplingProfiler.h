@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2012 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef SamplingProfiler_h
+#define SamplingProfiler_h
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include "CallIdentifier.h"
+#include <pthread.h>
+#include <signal.h>
+#include <wtf/FastAllocBase.h>
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+
+namespace JSC {
+
+class CodeBlock;
+class ExecState;
+class JSGlobalData;
+class UString;
+class UStringBuilder;
+
+// Interrupts the thread running JavaScript at a fixed interval and records which
+// functions were on its stack, so that a profile can be left on for a whole run.
+// The instrumenting Profiler calls back on every call and return, which makes it
+// far too slow for that.
+//
+// A timer thread sends the JavaScript thread SIGPROF. The signal handler walks
+// the call frames from the current one, expanding the functions that the DFG
+// inlined by way of their CodeOrigins, and adds the stack to a table that is
+// preallocated so that the handler never allocates or takes a lock. Stacks only
+// name functions by their executable, which is turned into a CallIdentifier on
+// the JavaScript thread, either when the profile is asked for or at the start of
+// a garbage collection, before anything the table points to can be swept.
+class SamplingProfiler {
+    WTF_MAKE_NONCOPYABLE(SamplingProfiler);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    SamplingProfiler(JSGlobalData&);
+    ~SamplingProfiler();
+
+    // Starts sampling the current thread. Only one profiler in the process can be
+    // sampling at a time; this returns false if another one is.
+    JS_EXPORT_PRIVATE bool start(unsigned intervalInMicroseconds = 1000);
+    JS_EXPORT_PRIVATE void stop();
+    bool isSampling() const { return m_timerThread; }
+
+    // Discards the samples taken so far.
+    JS_EXPORT_PRIVATE void clear();
+
+    // The call tree of the samples taken so far, as JSON. Each node has a name, url,
+    // line, selfSamples, totalSamples and children. Samples taken outside of any
+    // JavaScript function count towards the root's selfSamples.
+    JS_EXPORT_PRIVATE UString toJSON();
+
+    // Names the functions in the samples taken since the last call.
+    void processSamples();
+
+    // Call frames are only followed into code blocks that are known to be live.
+    void addCodeBlock(CodeBlock*);
+    void removeCodeBlock(CodeBlock*);
+
+private:
+    enum FrameKind {
+        NoFrame,
+        ExecutableFrame,
+        HostFunctionFrame,
+        GarbageCollectorFrame
+    };
+
+    struct Frame {
+        FrameKind kind;
+        void* key;
+    };
+
+    // A node of the call tree as the signal handler builds it, keyed by its parent
+    // and frame. The table is open addressed, and entries are never removed except
+    // by processSamples(), which empties it. Nodes are numbered in the order they
+    // were added, so a parent always comes before its children.
+    struct RawNode {
+        void* key;
+        unsigned kind;
+        unsigned parent;
+        unsigned number;
+        unsigned samples;
+    };
+
+    struct Node {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Node(const CallIdentifier& identifier)
+            : identifier(identifier)
+            , selfSamples(0)
+        {
+        }
+        ~Node();
+
+        Node* child(const CallIdentifier&);
+        unsigned totalSamples() const;
+        void appendJSON(UStringBuilder&) const;
+        static bool hasMoreSamples(const std::pair<unsigned, const Node*>&, const std::pair<unsigned, const Node*>&);
+
+        CallIdentifier identifier;
+        unsigned selfSamples;
+        HashMap<CallIdentifier, Node*> children;
+    };
+
+    static void* timerThreadStart(void*);
+    void timerThreadMain();
+    static void signalHandler(int, siginfo_t*, void*);
+    void takeSample(void* pc, void* callFrameRegister);
+    unsigned walkStack(Frame*, void* pc, void* callFrameRegister);
+    void recordStack(const Frame*, unsigned depth);
+    unsigned findOrAddRawNode(unsigned parent, const Frame&);
+    CallIdentifier identifierFor(FrameKind, void* key);
+    bool isLiveCell(void*);
+
+    void lockCodeBlocks();
+    bool tryLockCodeBlocks();
+    void unlockCodeBlocks();
+
+    JSGlobalData& m_globalData;
+    HashSet<CodeBlock*> m_codeBlocks;
+    unsigned m_codeBlocksLock;
+
+    pthread_t m_sampledThread;
+    ThreadIdentifier m_timerThread;
+    Mutex m_timerLock;
+    ThreadCondition m_timerCondition;
+    bool m_timerShouldStop;
+    unsigned m_intervalInMicroseconds;
+    struct sigaction m_previousAction;
+
+    RawNode* m_rawNodes;
+    unsigned* m_rawNodeOrder;
+    unsigned m_rawNodeCount;
+    unsigned m_rawRootSamples;
+    volatile bool m_isProcessing;
+
+    Node m_root;
+    unsigned m_sampleCount;
+    unsigned m_droppedSampleCount;
+
+    static SamplingProfiler* volatile s_samplingProfiler;
+};
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
+
+#endif // SamplingProfiler_h
@@ -36,14 +36,29 @@ namespace WTF {
 class ArrayBuffer;
 class ArrayBufferView;
 
+typedef void (*ArrayBufferDeallocator)(void* data, void* deallocatorContext);
+
 class ArrayBufferContents {
     WTF_MAKE_NONCOPYABLE(ArrayBufferContents);
 public:
     ArrayBufferContents() 
         : m_data(0)
         , m_sizeInBytes(0)
+        , m_deallocator(0)
+        , m_deallocatorContext(0)
     { }
 
+    // Adopts memory that was not allocated by the ArrayBuffer. It is handed to
+    // the deallocator, rather than freed, when the contents are destroyed.
+    ArrayBufferContents(void* data, unsigned sizeInBytes, ArrayBufferDeallocator deallocator, void* deallocatorContext)
+        : m_data(data)
+        , m_sizeInBytes(sizeInBytes)
+        , m_deallocator(deallocator)
+        , m_deallocatorContext(deallocatorContext)
+    {
+        ASSERT(deallocator);
+    }
+
     inline ~ArrayBufferContents();
 
     void* data() { return m_data; }
@@ -53,6 +68,8 @@ private:
     ArrayBufferContents(void* data, unsigned sizeInBytes) 
         : m_data(data)
         , m_sizeInBytes(sizeInBytes)
+        , m_deallocator(0)
+        , m_deallocatorContext(0)
     { }
 
     friend class ArrayBuffer;
@@ -63,12 +80,18 @@ private:
         ASSERT(!other.m_data);
         other.m_data = m_data;
         other.m_sizeInBytes = m_sizeInBytes;
+        other.m_deallocator = m_deallocator;
+        other.m_deallocatorContext = m_deallocatorContext;
         m_data = 0;
         m_sizeInBytes = 0;
+        m_deallocator = 0;
+        m_deallocatorContext = 0;
     }
 
     void* m_data;
     unsigned m_sizeInBytes;
+    ArrayBufferDeallocator m_deallocator;
+    void* m_deallocatorContext;
 };
 
 class ArrayBuffer : public RefCounted<ArrayBuffer> {
@@ -210,11 +233,17 @@ void ArrayBufferContents::tryAllocate(unsigned numElements, unsigned elementByte
 
 ArrayBufferContents::~ArrayBufferContents()
 {
+    if (m_deallocator) {
+        m_deallocator(m_data, m_deallocatorContext);
+        return;
+    }
     WTF::fastFree(m_data);
 }
 
 } // namespace WTF
 
 using WTF::ArrayBuffer;
+using WTF::ArrayBufferContents;
+using WTF::ArrayBufferDeallocator;
 
 #endif // ArrayBuffer_h
@@ -45,8 +45,10 @@ namespace WTF {
 
 class MetaAllocatorTracker {
 public:
-    void notify(MetaAllocatorHandle*);
-    void release(MetaAllocatorHandle*);
+    virtual ~MetaAllocatorTracker() { }
+
+    virtual void notify(MetaAllocatorHandle*);
+    virtual void release(MetaAllocatorHandle*);
 
     MetaAllocatorHandle* find(void* address)
     {
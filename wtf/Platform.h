@@ -955,6 +955,13 @@
 #define ENABLE_WRITE_BARRIER_PROFILING 0
 #endif
 
+/* Generational collection: between full collections, only objects allocated
+   since the last collection and old objects whose cards were dirtied by the
+   write barrier are traced. */
+#if !defined(ENABLE_GGC) && USE(JSVALUE64)
+#define ENABLE_GGC 1
+#endif
+
 /* Ensure that either the JIT or the interpreter has been enabled. */
 #if !defined(ENABLE_CLASSIC_INTERPRETER) && !ENABLE(JIT)
 #define ENABLE_CLASSIC_INTERPRETER 1
@@ -1010,6 +1017,11 @@
 #define ENABLE_YARR_JIT_DEBUG 0
 #endif
 
+/* Matching a backreference needs one more register than the YARR JIT has elsewhere. */
+#if ENABLE(YARR_JIT) && CPU(X86_64) && !defined(ENABLE_YARR_JIT_BACKREFERENCES)
+#define ENABLE_YARR_JIT_BACKREFERENCES 1
+#endif
+
 #if ENABLE(JIT) || ENABLE(YARR_JIT)
 #define ENABLE_ASSEMBLER 1
 #endif
@@ -1126,10 +1138,15 @@
 #define ENABLE_COMPARE_AND_SWAP 1
 #endif
 
-#if !defined(ENABLE_PARALLEL_GC) && (PLATFORM(MAC) || PLATFORM(IOS) || PLATFORM(QT)) && ENABLE(COMPARE_AND_SWAP)
+#if !defined(ENABLE_PARALLEL_GC) && (PLATFORM(MAC) || PLATFORM(IOS) || PLATFORM(QT) || (OS(LINUX) && USE(PTHREADS))) && ENABLE(COMPARE_AND_SWAP)
 #define ENABLE_PARALLEL_GC 1
 #endif
 
+/* The sampling profiler reads the call frame register out of a signal context. */
+#if !defined(ENABLE_SAMPLING_PROFILER) && OS(LINUX) && CPU(X86_64) && ENABLE(JIT) && USE(JSVALUE64) && ENABLE(COMPARE_AND_SWAP)
+#define ENABLE_SAMPLING_PROFILER 1
+#endif
+
 #ifndef NDEBUG
 #ifndef ENABLE_GC_VALIDATION
 #define ENABLE_GC_VALIDATION 1
@@ -70,11 +70,44 @@ StringImpl::~StringImpl()
         return;
     }
 
+    if (ownership == BufferExternal) {
+        ExternalBuffer* buffer = externalBuffer();
+        if (buffer->finalizer)
+            buffer->finalizer(buffer->context, m_data8);
+        return;
+    }
+
     ASSERT(ownership == BufferSubstring);
     ASSERT(m_substringBuffer);
     m_substringBuffer->deref();
 }
 
+template <typename CharType>
+inline PassRefPtr<StringImpl> StringImpl::createExternal(const CharType* characters, unsigned length, ExternalBufferFinalizer finalizer, void* context)
+{
+    if (!length) {
+        if (finalizer)
+            finalizer(context, characters);
+        return empty();
+    }
+
+    StringImpl* string = static_cast<StringImpl*>(fastMalloc(sizeof(StringImpl) + sizeof(ExternalBuffer)));
+    ExternalBuffer* buffer = reinterpret_cast<ExternalBuffer*>(string + 1);
+    buffer->finalizer = finalizer;
+    buffer->context = context;
+    return adoptRef(new (NotNull, string) StringImpl(characters, length, ConstructExternalBuffer));
+}
+
+PassRefPtr<StringImpl> StringImpl::createWithoutCopying(const LChar* characters, unsigned length, ExternalBufferFinalizer finalizer, void* context)
+{
+    return createExternal(characters, length, finalizer, context);
+}
+
+PassRefPtr<StringImpl> StringImpl::createWithoutCopying(const UChar* characters, unsigned length, ExternalBufferFinalizer finalizer, void* context)
+{
+    return createExternal(characters, length, finalizer, context);
+}
+
 PassRefPtr<StringImpl> StringImpl::createUninitialized(unsigned length, LChar*& data)
 {
     if (!length) {
@@ -78,6 +78,14 @@ private:
         BufferInternal,
         BufferOwned,
         BufferSubstring,
+        BufferExternal,
+    };
+
+    // Strings with an external buffer keep the means to release it just past
+    // the StringImpl, in the same allocation.
+    struct ExternalBuffer {
+        void (*finalizer)(void* context, const void* characters);
+        void* context;
     };
 
     // Used to construct static strings, which have an special refCount that can never hit zero.
@@ -163,6 +171,30 @@ private:
         ASSERT(m_length);
     }
 
+    // Create a StringImpl referencing a buffer that it does not own (BufferExternal)
+    enum ConstructExternalBufferTag { ConstructExternalBuffer };
+    StringImpl(const LChar* characters, unsigned length, ConstructExternalBufferTag)
+        : m_refCount(s_refCountIncrement)
+        , m_length(length)
+        , m_data8(characters)
+        , m_buffer(0)
+        , m_hashAndFlags(s_hashFlag8BitBuffer | BufferExternal)
+    {
+        ASSERT(m_data8);
+        ASSERT(m_length);
+    }
+
+    StringImpl(const UChar* characters, unsigned length, ConstructExternalBufferTag)
+        : m_refCount(s_refCountIncrement)
+        , m_length(length)
+        , m_data16(characters)
+        , m_buffer(0)
+        , m_hashAndFlags(BufferExternal)
+    {
+        ASSERT(m_data16);
+        ASSERT(m_length);
+    }
+
     // Used to create new strings that are a substring of an existing 8-bit StringImpl (BufferSubstring)
     StringImpl(const LChar* characters, unsigned length, PassRefPtr<StringImpl> base)
         : m_refCount(s_refCountIncrement)
@@ -279,6 +311,19 @@ public:
     static PassRefPtr<StringImpl> adopt(StringBuffer<LChar>& buffer);
     WTF_EXPORT_PRIVATE static PassRefPtr<StringImpl> adopt(StringBuffer<UChar>& buffer);
 
+    // Create a string using the characters in place. They must stay valid and unchanged
+    // until the finalizer, if any, is called when the string is destroyed.
+    typedef void (*ExternalBufferFinalizer)(void* context, const void* characters);
+    WTF_EXPORT_PRIVATE static PassRefPtr<StringImpl> createWithoutCopying(const LChar*, unsigned length, ExternalBufferFinalizer, void* context);
+    WTF_EXPORT_PRIVATE static PassRefPtr<StringImpl> createWithoutCopying(const UChar*, unsigned length, ExternalBufferFinalizer, void* context);
+    // The context of a string made by createWithoutCopying() with the given finalizer, or 0.
+    void* externalBufferContext(ExternalBufferFinalizer finalizer) const
+    {
+        if (bufferOwnership() != BufferExternal || externalBuffer()->finalizer != finalizer)
+            return 0;
+        return externalBuffer()->context;
+    }
+
     unsigned length() const { return m_length; }
     bool is8Bit() const { return m_hashAndFlags & s_hashFlag8BitBuffer; }
 
@@ -509,6 +554,8 @@ private:
     static const unsigned s_copyCharsInlineCutOff = 20;
 
     BufferOwnership bufferOwnership() const { return static_cast<BufferOwnership>(m_hashAndFlags & s_hashMaskBufferOwnership); }
+    ExternalBuffer* externalBuffer() const { ASSERT(bufferOwnership() == BufferExternal); return reinterpret_cast<ExternalBuffer*>(const_cast<StringImpl*>(this + 1)); }
+    template <typename CharType> static PassRefPtr<StringImpl> createExternal(const CharType*, unsigned length, ExternalBufferFinalizer, void* context);
     bool isStatic() const { return m_refCount & s_refCountFlagIsStaticString; }
     template <class UCharPredicate> PassRefPtr<StringImpl> stripMatchedCharacters(UCharPredicate);
     template <typename CharType, class UCharPredicate> PassRefPtr<StringImpl> simplifyMatchedCharactersToSpace(UCharPredicate);
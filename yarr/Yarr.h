@@ -62,6 +62,13 @@ enum YarrCharSize {
     Char16
 };
 
+// Code compiled MatchOnly only reports where the match starts and ends, and
+// leaves the rest of the output vector alone.
+enum YarrJITCompileMode {
+    MatchOnly,
+    IncludeSubpatterns
+};
+
 JS_EXPORT_PRIVATE PassOwnPtr<BytecodePattern> byteCompile(YarrPattern&, BumpPointerAllocator*);
 JS_EXPORT_PRIVATE int interpret(BytecodePattern*, const UString& input, unsigned start, unsigned length, int* output);
 
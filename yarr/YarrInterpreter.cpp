@@ -378,13 +378,17 @@ public:
             return false;
 
         if (pattern->m_ignoreCase) {
+            // A captured character matches itself and its lower and upper case forms,
+            // just like a character in the pattern does. YarrJIT does the same.
             for (int i = 0; i < matchSize; ++i) {
                 int ch = input.reread(matchBegin + i);
+                if (checkCharacter(ch, inputOffset - matchSize + i))
+                    continue;
 
                 int lo = Unicode::toLower(ch);
                 int hi = Unicode::toUpper(ch);
 
-                if ((lo != hi) ? (!checkCasedCharacter(lo, hi, inputOffset - matchSize + i)) : (!checkCharacter(ch, inputOffset - matchSize + i))) {
+                if ((lo == hi) || !checkCasedCharacter(lo, hi, inputOffset - matchSize + i)) {
                     input.uncheckInput(matchSize);
                     return false;
                 }
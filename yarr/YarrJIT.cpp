@@ -29,6 +29,7 @@
 #include "ASCIICType.h"
 #include "LinkBuffer.h"
 #include "Yarr.h"
+#include <wtf/Threading.h>
 
 #if ENABLE(YARR_JIT)
 
@@ -36,6 +37,36 @@ using namespace WTF;
 
 namespace JSC { namespace Yarr {
 
+#if ENABLE(YARR_JIT_BACKREFERENCES)
+// Map each UTF-16 code unit to its lower and upper case forms. A case insensitive
+// backreference matches a captured character, or either of its case forms, which
+// is what YarrInterpreter and pattern characters match too.
+static UChar* createCaseTable(UChar32 (*convert)(UChar32))
+{
+    UChar* table = static_cast<UChar*>(fastMalloc(0x10000 * sizeof(UChar)));
+    for (UChar32 ch = 0; ch < 0x10000; ++ch) {
+        UChar32 converted = convert(ch);
+        table[ch] = converted > 0xffff ? ch : converted;
+    }
+    return table;
+}
+
+static UChar32 toLowerCase(UChar32 ch) { return Unicode::toLower(ch); }
+static UChar32 toUpperCase(UChar32 ch) { return Unicode::toUpper(ch); }
+
+static const UChar* lowerCaseTable()
+{
+    AtomicallyInitializedStatic(UChar*, table = createCaseTable(toLowerCase));
+    return table;
+}
+
+static const UChar* upperCaseTable()
+{
+    AtomicallyInitializedStatic(UChar*, table = createCaseTable(toUpperCase));
+    return table;
+}
+#endif
+
 class YarrGenerator : private MacroAssembler {
     friend void jitCompile(JSGlobalData*, YarrCodeBlock& jitObject, const UString& pattern, unsigned& numSubpatterns, const char*& error, bool ignoreCase, bool multiline);
 
@@ -87,6 +118,10 @@ class YarrGenerator : private MacroAssembler {
 
     static const RegisterID regT0 = X86Registers::eax;
     static const RegisterID regT1 = X86Registers::ebx;
+#if ENABLE(YARR_JIT_BACKREFERENCES)
+    static const RegisterID regT2 = X86Registers::r8;
+    static const RegisterID regT3 = X86Registers::r9;
+#endif
 
     static const RegisterID returnRegister = X86Registers::eax;
 #endif
@@ -332,6 +367,10 @@ class YarrGenerator : private MacroAssembler {
         // Used to wrap 'Terminal' subpattern matches (at the end of the regexp).
         OpParenthesesSubpatternTerminalBegin,
         OpParenthesesSubpatternTerminalEnd,
+        // Used to wrap repeated subpatterns that capture nothing, and where every
+        // iteration matches the same number of characters.
+        OpParenthesesSubpatternFixedSizeBegin,
+        OpParenthesesSubpatternFixedSizeEnd,
         // Used to wrap parenthetical assertions.
         OpParentheticalAssertionBegin,
         OpParentheticalAssertionEnd,
@@ -1124,6 +1163,206 @@ class YarrGenerator : private MacroAssembler {
     {
         backtrackTermDefault(opIndex);
     }
+
+#if ENABLE(YARR_JIT_BACKREFERENCES)
+    // A backreference to a subpattern that has not matched, or that matched the
+    // empty string, matches the empty string, and there is nothing to backtrack.
+    void jumpIfBackReferenceIsEmpty(PatternTerm* term, JumpList& matchesEmpty)
+    {
+        const RegisterID matchBegin = regT0;
+
+        unsigned subpatternId = term->backReferenceSubpatternId;
+        Address beginAddress(output, (subpatternId << 1) * sizeof(int));
+        Address endAddress(output, ((subpatternId << 1) + 1) * sizeof(int));
+
+        matchesEmpty.append(branch32(Equal, endAddress, TrustedImm32(-1)));
+        load32(beginAddress, matchBegin);
+        matchesEmpty.append(branch32(Equal, matchBegin, TrustedImm32(-1)));
+        matchesEmpty.append(branch32(GreaterThanOrEqual, matchBegin, endAddress));
+    }
+
+    // Matches one copy of the referenced subpattern's text, advancing the input
+    // position past it. On failure the input position is left part way through.
+    void matchBackReference(size_t opIndex, JumpList& characterMatchFails)
+    {
+        YarrOp& op = m_ops[opIndex];
+        PatternTerm* term = op.m_term;
+
+        const RegisterID character = regT0;
+        const RegisterID patternCharacter = regT1;
+        const RegisterID patternIndex = regT2;
+
+        unsigned subpatternId = term->backReferenceSubpatternId;
+        load32(Address(output, (subpatternId << 1) * sizeof(int)), patternIndex);
+
+        Label loop(this);
+        Jump matched = branch32(Equal, patternIndex, Address(output, ((subpatternId << 1) + 1) * sizeof(int)));
+        characterMatchFails.append(atEndOfInput());
+
+        readCharacter(term->inputPosition - m_checked, character);
+        if (m_charSize == Char8)
+            load8(BaseIndex(input, patternIndex, TimesOne, 0), patternCharacter);
+        else
+            load16(BaseIndex(input, patternIndex, TimesTwo, 0), patternCharacter);
+
+        if (m_pattern.m_ignoreCase) {
+            JumpList charactersMatch;
+            charactersMatch.append(branch32(Equal, character, patternCharacter));
+            if (m_charSize == Char8) {
+                // Latin-1 letters differ from their other case in bit 5 alone. Of the
+                // characters that pair up that way, only the letters are cased.
+                or32(TrustedImm32(32), character);
+                or32(TrustedImm32(32), patternCharacter);
+                characterMatchFails.append(branch32(NotEqual, character, patternCharacter));
+                sub32(TrustedImm32('a'), character);
+                charactersMatch.append(branch32(BelowOrEqual, character, TrustedImm32('z' - 'a')));
+                sub32(TrustedImm32(0xe0 - 'a'), character);
+                characterMatchFails.append(branch32(Above, character, TrustedImm32(0xfe - 0xe0)));
+                characterMatchFails.append(branch32(Equal, character, TrustedImm32(0xf7 - 0xe0)));
+            } else {
+                const RegisterID caseForm = regT3;
+                move(TrustedImmPtr(lowerCaseTable()), caseForm);
+                load16(BaseIndex(caseForm, patternCharacter, TimesTwo, 0), caseForm);
+                charactersMatch.append(branch32(Equal, character, caseForm));
+                move(TrustedImmPtr(upperCaseTable()), caseForm);
+                load16(BaseIndex(caseForm, patternCharacter, TimesTwo, 0), caseForm);
+                characterMatchFails.append(branch32(NotEqual, character, caseForm));
+            }
+            charactersMatch.link(this);
+        } else
+            characterMatchFails.append(branch32(NotEqual, character, patternCharacter));
+
+        add32(TrustedImm32(1), index);
+        add32(TrustedImm32(1), patternIndex);
+        jump(loop);
+
+        matched.link(this);
+    }
+
+    // The frame holds the input position before the backreference was matched (for
+    // greedy quantifiers, before the copy being matched), and the number of copies
+    // matched so far.
+    void generateBackReference(size_t opIndex)
+    {
+        YarrOp& op = m_ops[opIndex];
+        PatternTerm* term = op.m_term;
+
+        const RegisterID countRegister = regT0;
+        unsigned beginFrameLocation = term->frameLocation;
+        unsigned matchAmountFrameLocation = term->frameLocation + 1;
+
+        switch (term->quantityType) {
+        case QuantifierFixedCount: {
+            storeToFrame(index, beginFrameLocation);
+
+            JumpList matchesEmpty;
+            jumpIfBackReferenceIsEmpty(term, matchesEmpty);
+            if (term->quantityCount == 1)
+                matchBackReference(opIndex, op.m_jumps);
+            else {
+                storeToFrame(TrustedImm32(0), matchAmountFrameLocation);
+                Label loop(this);
+                matchBackReference(opIndex, op.m_jumps);
+                loadFromFrame(matchAmountFrameLocation, countRegister);
+                add32(TrustedImm32(1), countRegister);
+                storeToFrame(countRegister, matchAmountFrameLocation);
+                branch32(NotEqual, countRegister, Imm32(term->quantityCount.unsafeGet())).linkTo(loop, this);
+            }
+            matchesEmpty.link(this);
+            break;
+        }
+
+        case QuantifierGreedy: {
+            JumpList done;
+            storeToFrame(TrustedImm32(0), matchAmountFrameLocation);
+            jumpIfBackReferenceIsEmpty(term, done);
+
+            Label loop(this);
+            if (term->quantityCount != quantifyInfinite) {
+                loadFromFrame(matchAmountFrameLocation, countRegister);
+                done.append(branch32(Equal, countRegister, Imm32(term->quantityCount.unsafeGet())));
+            }
+            storeToFrame(index, beginFrameLocation);
+            JumpList partialMatch;
+            matchBackReference(opIndex, partialMatch);
+            loadFromFrame(matchAmountFrameLocation, countRegister);
+            add32(TrustedImm32(1), countRegister);
+            storeToFrame(countRegister, matchAmountFrameLocation);
+            jump(loop);
+
+            // Give back the characters of the copy that failed to match.
+            partialMatch.link(this);
+            loadFromFrame(beginFrameLocation, index);
+
+            done.link(this);
+            op.m_reentry = label();
+            break;
+        }
+
+        case QuantifierNonGreedy:
+            storeToFrame(index, beginFrameLocation);
+            storeToFrame(TrustedImm32(0), matchAmountFrameLocation);
+            op.m_reentry = label();
+            break;
+        }
+    }
+    void backtrackBackReference(size_t opIndex)
+    {
+        YarrOp& op = m_ops[opIndex];
+        PatternTerm* term = op.m_term;
+
+        const RegisterID countRegister = regT0;
+        const RegisterID matchLength = regT1;
+        unsigned beginFrameLocation = term->frameLocation;
+        unsigned matchAmountFrameLocation = term->frameLocation + 1;
+
+        switch (term->quantityType) {
+        case QuantifierFixedCount:
+            m_backtrackingState.append(op.m_jumps);
+            m_backtrackingState.link(this);
+            loadFromFrame(beginFrameLocation, index);
+            m_backtrackingState.fallthrough();
+            break;
+
+        case QuantifierGreedy: {
+            unsigned subpatternId = term->backReferenceSubpatternId;
+
+            m_backtrackingState.link(this);
+            loadFromFrame(matchAmountFrameLocation, countRegister);
+            m_backtrackingState.append(branchTest32(Zero, countRegister));
+            sub32(TrustedImm32(1), countRegister);
+            storeToFrame(countRegister, matchAmountFrameLocation);
+
+            load32(Address(output, ((subpatternId << 1) + 1) * sizeof(int)), matchLength);
+            sub32(Address(output, (subpatternId << 1) * sizeof(int)), matchLength);
+            sub32(matchLength, index);
+            jump(op.m_reentry);
+            break;
+        }
+
+        case QuantifierNonGreedy: {
+            JumpList nonGreedyFailures;
+
+            m_backtrackingState.link(this);
+            jumpIfBackReferenceIsEmpty(term, nonGreedyFailures);
+            if (term->quantityCount != quantifyInfinite) {
+                loadFromFrame(matchAmountFrameLocation, countRegister);
+                nonGreedyFailures.append(branch32(Equal, countRegister, Imm32(term->quantityCount.unsafeGet())));
+            }
+            matchBackReference(opIndex, nonGreedyFailures);
+            loadFromFrame(matchAmountFrameLocation, countRegister);
+            add32(TrustedImm32(1), countRegister);
+            storeToFrame(countRegister, matchAmountFrameLocation);
+            jump(op.m_reentry);
+
+            nonGreedyFailures.link(this);
+            loadFromFrame(beginFrameLocation, index);
+            m_backtrackingState.fallthrough();
+            break;
+        }
+        }
+    }
+#endif
     
     // Code generation/backtracking for simple terms
     // (pattern characters, character classes, and assertions).
@@ -1187,7 +1426,11 @@ class YarrGenerator : private MacroAssembler {
         case PatternTerm::TypeParentheticalAssertion:
             ASSERT_NOT_REACHED();
         case PatternTerm::TypeBackReference:
-            m_shouldFallBack = true;
+#if ENABLE(YARR_JIT_BACKREFERENCES)
+            generateBackReference(opIndex);
+#else
+            ASSERT_NOT_REACHED();
+#endif
             break;
         case PatternTerm::TypeDotStarEnclosure:
             generateDotStarEnclosure(opIndex);
@@ -1258,7 +1501,11 @@ class YarrGenerator : private MacroAssembler {
             break;
 
         case PatternTerm::TypeBackReference:
-            m_shouldFallBack = true;
+#if ENABLE(YARR_JIT_BACKREFERENCES)
+            backtrackBackReference(opIndex);
+#else
+            ASSERT_NOT_REACHED();
+#endif
             break;
         }
     }
@@ -1388,7 +1635,7 @@ class YarrGenerator : private MacroAssembler {
 
                 // Calculate how much input we need to check for, and if non-zero check.
                 op.m_checkAdjust = alternative->m_minimumSize;
-                if ((term->quantityType == QuantifierFixedCount) && (term->type != PatternTerm::TypeParentheticalAssertion))
+                if ((term->quantityType == QuantifierFixedCount) && (term->type != PatternTerm::TypeParentheticalAssertion) && !term->parentheses.isFixedSizeRepeat)
                     op.m_checkAdjust -= disjunction->m_minimumSize;
                 if (op.m_checkAdjust)
                     op.m_jumps.append(jumpIfNoAvailableInput(op.m_checkAdjust));
@@ -1438,7 +1685,7 @@ class YarrGenerator : private MacroAssembler {
 
                 // Calculate how much input we need to check for, and if non-zero check.
                 op.m_checkAdjust = alternative->m_minimumSize;
-                if ((term->quantityType == QuantifierFixedCount) && (term->type != PatternTerm::TypeParentheticalAssertion))
+                if ((term->quantityType == QuantifierFixedCount) && (term->type != PatternTerm::TypeParentheticalAssertion) && !term->parentheses.isFixedSizeRepeat)
                     op.m_checkAdjust -= disjunction->m_minimumSize;
                 if (op.m_checkAdjust)
                     op.m_jumps.append(jumpIfNoAvailableInput(op.m_checkAdjust));
@@ -1517,7 +1764,7 @@ class YarrGenerator : private MacroAssembler {
                 // FIXME: could avoid offsetting this value in JIT code, apply
                 // offsets only afterwards, at the point the results array is
                 // being accessed.
-                if (term->capture()) {
+                if (term->capture() && shouldRecordSubpatterns()) {
                     int offsetId = term->parentheses.subpatternId << 1;
                     int inputOffset = term->inputPosition - m_checked;
                     if (term->quantityType == QuantifierFixedCount)
@@ -1528,6 +1775,11 @@ class YarrGenerator : private MacroAssembler {
                         store32(indexTemporary, Address(output, offsetId * sizeof(int)));
                     } else
                         store32(index, Address(output, offsetId * sizeof(int)));
+
+                    // A backreference from within the parentheses must not see the
+                    // end of an earlier match of them.
+                    if (m_pattern.m_containsBackreferences)
+                        store32(TrustedImm32(-1), Address(output, (offsetId + 1) * sizeof(int)));
                 }
                 break;
             }
@@ -1553,7 +1805,7 @@ class YarrGenerator : private MacroAssembler {
                 // FIXME: could avoid offsetting this value in JIT code, apply
                 // offsets only afterwards, at the point the results array is
                 // being accessed.
-                if (term->capture()) {
+                if (term->capture() && shouldRecordSubpatterns()) {
                     int offsetId = (term->parentheses.subpatternId << 1) + 1;
                     int inputOffset = term->inputPosition - m_checked;
                     if (inputOffset) {
@@ -1614,6 +1866,57 @@ class YarrGenerator : private MacroAssembler {
                 break;
             }
 
+            // OpParenthesesSubpatternFixedSizeBegin/End
+            //
+            // These nodes loop over subpatterns that capture nothing, and where
+            // every alternative matches the same, non-zero, number of characters.
+            // Since which alternative matched cannot affect the rest of the match,
+            // backtracking only ever needs to give back or take one more whole
+            // iteration, so the frame just holds the index on entry and the number
+            // of iterations matched.
+            case OpParenthesesSubpatternFixedSizeBegin: {
+                PatternTerm* term = op.m_term;
+                unsigned parenthesesFrameLocation = term->frameLocation;
+
+                storeToFrame(index, parenthesesFrameLocation);
+                storeToFrame(TrustedImm32(0), parenthesesFrameLocation + 1);
+
+                // NonGreedy parentheses first try matching no iterations at all.
+                if (term->quantityType == QuantifierNonGreedy)
+                    op.m_jumps.append(jump());
+
+                // This is the start of each iteration.
+                op.m_reentry = label();
+                break;
+            }
+            case OpParenthesesSubpatternFixedSizeEnd: {
+                PatternTerm* term = op.m_term;
+                YarrOp& beginOp = m_ops[op.m_previousOp];
+                unsigned parenthesesFrameLocation = term->frameLocation;
+                const RegisterID countRegister = regT0;
+
+                loadFromFrame(parenthesesFrameLocation + 1, countRegister);
+                add32(TrustedImm32(1), countRegister);
+                storeToFrame(countRegister, parenthesesFrameLocation + 1);
+
+                if (term->quantityType == QuantifierGreedy) {
+                    if (term->quantityCount == quantifyInfinite)
+                        jump(beginOp.m_reentry);
+                    else
+                        branch32(NotEqual, countRegister, Imm32(term->quantityCount.unsafeGet())).linkTo(beginOp.m_reentry, this);
+                } else if (term->quantityType == QuantifierFixedCount)
+                    branch32(NotEqual, countRegister, Imm32(term->quantityCount.unsafeGet())).linkTo(beginOp.m_reentry, this);
+
+                // This is the entry point to jump to when we are done iterating.
+                op.m_reentry = label();
+
+                if (term->quantityType == QuantifierNonGreedy) {
+                    beginOp.m_jumps.link(this);
+                    beginOp.m_jumps.clear();
+                }
+                break;
+            }
+
             // OpParentheticalAssertionBegin/End
             case OpParentheticalAssertionBegin: {
                 PatternTerm* term = op.m_term;
@@ -2060,11 +2363,12 @@ class YarrGenerator : private MacroAssembler {
                 ASSERT(term->quantityCount == 1);
 
                 // We only need to backtrack to thispoint if capturing or greedy.
-                if (term->capture() || term->quantityType == QuantifierGreedy) {
+                bool recordsCapture = term->capture() && shouldRecordSubpatterns();
+                if (recordsCapture || term->quantityType == QuantifierGreedy) {
                     m_backtrackingState.link(this);
 
                     // If capturing, clear the capture (we only need to reset start).
-                    if (term->capture())
+                    if (recordsCapture)
                         store32(TrustedImm32(-1), Address(output, (term->parentheses.subpatternId << 1) * sizeof(int)));
 
                     // If Greedy, jump to the end.
@@ -2137,6 +2441,64 @@ class YarrGenerator : private MacroAssembler {
                 m_backtrackingState.append(op.m_jumps);
                 break;
 
+            // OpParenthesesSubpatternFixedSizeBegin/End
+            //
+            // A failure after Greedy parentheses gives back one iteration, and a
+            // failure after NonGreedy parentheses tries one more. Once there is
+            // nothing left to give back or take, and whenever an iteration fails
+            // to match in any other case, we restore the index on entry and
+            // backtrack out of the parentheses.
+            case OpParenthesesSubpatternFixedSizeBegin: {
+                PatternTerm* term = op.m_term;
+                YarrOp& endOp = m_ops[op.m_nextOp];
+
+                // An iteration that fails to match leaves the index at its start.
+                // For Greedy parentheses that is where matching continues from.
+                if (term->quantityType == QuantifierGreedy) {
+                    m_backtrackingState.linkTo(endOp.m_reentry, this);
+                    m_backtrackingState.append(op.m_jumps);
+                    break;
+                }
+
+                m_backtrackingState.append(op.m_jumps);
+                m_backtrackingState.link(this);
+                loadFromFrame(term->frameLocation, index);
+                m_backtrackingState.fallthrough();
+                break;
+            }
+            case OpParenthesesSubpatternFixedSizeEnd: {
+                PatternTerm* term = op.m_term;
+                YarrOp& beginOp = m_ops[op.m_previousOp];
+                unsigned parenthesesFrameLocation = term->frameLocation;
+                const RegisterID countRegister = regT0;
+
+                switch (term->quantityType) {
+                case QuantifierGreedy:
+                    m_backtrackingState.link(this);
+                    loadFromFrame(parenthesesFrameLocation + 1, countRegister);
+                    beginOp.m_jumps.append(branchTest32(Zero, countRegister));
+                    sub32(TrustedImm32(1), countRegister);
+                    storeToFrame(countRegister, parenthesesFrameLocation + 1);
+                    sub32(Imm32(term->parentheses.disjunction->m_minimumSize), index);
+                    jump(op.m_reentry);
+                    break;
+
+                case QuantifierFixedCount:
+                    m_backtrackingState.takeBacktracksToJumpList(beginOp.m_jumps, this);
+                    break;
+
+                case QuantifierNonGreedy:
+                    m_backtrackingState.link(this);
+                    if (term->quantityCount != quantifyInfinite) {
+                        loadFromFrame(parenthesesFrameLocation + 1, countRegister);
+                        beginOp.m_jumps.append(branch32(Equal, countRegister, Imm32(term->quantityCount.unsafeGet())));
+                    }
+                    jump(beginOp.m_reentry);
+                    break;
+                }
+                break;
+            }
+
             // OpParentheticalAssertionBegin/End
             case OpParentheticalAssertionBegin: {
                 PatternTerm* term = op.m_term;
@@ -2196,9 +2558,10 @@ class YarrGenerator : private MacroAssembler {
     // Emits ops for a subpattern (set of parentheses). These consist
     // of a set of alternatives wrapped in an outer set of nodes for
     // the parentheses.
-    // Supported types of parentheses are 'Once' (quantityCount == 1)
-    // and 'Terminal' (non-capturing parentheses quantified as greedy
-    // and infinite).
+    // Supported types of parentheses are 'Once' (quantityCount == 1),
+    // 'Terminal' (non-capturing parentheses quantified as greedy
+    // and infinite), and 'FixedSize' (non-capturing parentheses where
+    // every alternative matches the same number of characters).
     // Alternatives will use the 'Simple' set of ops if either the
     // subpattern is terminal (in which case we will never need to
     // backtrack), or if the subpattern only contains one alternative.
@@ -2232,6 +2595,10 @@ class YarrGenerator : private MacroAssembler {
             // Select the 'Terminal' nodes.
             parenthesesBeginOpCode = OpParenthesesSubpatternTerminalBegin;
             parenthesesEndOpCode = OpParenthesesSubpatternTerminalEnd;
+        } else if (term->parentheses.isFixedSizeRepeat) {
+            // Select the 'FixedSize' nodes.
+            parenthesesBeginOpCode = OpParenthesesSubpatternFixedSizeBegin;
+            parenthesesEndOpCode = OpParenthesesSubpatternFixedSizeEnd;
         } else {
             // This subpattern is not supported by the JIT.
             m_shouldFallBack = true;
@@ -2348,6 +2715,12 @@ class YarrGenerator : private MacroAssembler {
                 opCompileParentheticalAssertion(term);
                 break;
 
+#if !ENABLE(YARR_JIT_BACKREFERENCES)
+            case PatternTerm::TypeBackReference:
+                m_shouldFallBack = true;
+                return;
+#endif
+
             default:
                 m_ops.append(term);
             }
@@ -2501,17 +2874,25 @@ class YarrGenerator : private MacroAssembler {
         ret();
     }
 
+    // Backreferences read the subpatterns they refer to back out of the output,
+    // so match only code for a pattern containing them records them all anyway.
+    bool shouldRecordSubpatterns()
+    {
+        return m_compileMode == IncludeSubpatterns || m_pattern.m_containsBackreferences;
+    }
+
 public:
-    YarrGenerator(YarrPattern& pattern, YarrCharSize charSize)
+    YarrGenerator(YarrPattern& pattern, YarrCharSize charSize, YarrJITCompileMode compileMode)
         : m_pattern(pattern)
         , m_charSize(charSize)
         , m_charScale(m_charSize == Char8 ? TimesOne: TimesTwo)
+        , m_compileMode(compileMode)
         , m_shouldFallBack(false)
         , m_checked(0)
     {
     }
 
-    void compile(JSGlobalData* globalData, YarrCodeBlock& jitObject)
+    void compile(JSGlobalData* globalData, YarrCodeBlock& jitObject, const UString& patternString)
     {
         generateEnter();
 
@@ -2520,7 +2901,8 @@ public:
         generateReturn();
         hasInput.link(this);
 
-        for (unsigned i = 0; i < m_pattern.m_numSubpatterns + 1; ++i)
+        unsigned numSubpatternsToClear = shouldRecordSubpatterns() ? m_pattern.m_numSubpatterns : 0;
+        for (unsigned i = 0; i < numSubpatternsToClear + 1; ++i)
             store32(TrustedImm32(-1), Address(output, (i << 1) * sizeof(int)));
 
         if (!m_pattern.m_body->m_hasFixedSize)
@@ -2545,10 +2927,18 @@ public:
         // Link & finalize the code.
         LinkBuffer linkBuffer(*globalData, this, REGEXP_CODE_ID);
         m_backtrackingState.linkDataLabels(linkBuffer);
-        if (m_charSize == Char8)
-            jitObject.set8BitCode(linkBuffer.finalizeCode());
-        else
-            jitObject.set16BitCode(linkBuffer.finalizeCode());
+        MacroAssembler::CodeRef code = linkBuffer.finalizeCode(PerfMap::Description(PerfMap::Yarr, patternString));
+        if (m_compileMode == MatchOnly) {
+            if (m_charSize == Char8)
+                jitObject.set8BitCodeMatchOnly(code);
+            else
+                jitObject.set16BitCodeMatchOnly(code);
+        } else {
+            if (m_charSize == Char8)
+                jitObject.set8BitCode(code);
+            else
+                jitObject.set16BitCode(code);
+        }
         jitObject.setFallBack(m_shouldFallBack);
     }
 
@@ -2559,6 +2949,8 @@ private:
 
     Scale m_charScale;
 
+    YarrJITCompileMode m_compileMode;
+
     // Used to detect regular expression constructs that are not currently
     // supported in the JIT; fall back to the interpreter when this is detected.
     bool m_shouldFallBack;
@@ -2582,9 +2974,9 @@ private:
     BacktrackingState m_backtrackingState;
 };
 
-void jitCompile(YarrPattern& pattern, YarrCharSize charSize, JSGlobalData* globalData, YarrCodeBlock& jitObject)
+void jitCompile(YarrPattern& pattern, const UString& patternString, YarrCharSize charSize, JSGlobalData* globalData, YarrCodeBlock& jitObject, YarrJITCompileMode compileMode)
 {
-    YarrGenerator(pattern, charSize).compile(globalData, jitObject);
+    YarrGenerator(pattern, charSize, compileMode).compile(globalData, jitObject, patternString);
 }
 
 }}
@@ -68,6 +68,11 @@ public:
     void set8BitCode(MacroAssembler::CodeRef ref) { m_ref8 = ref; }
     void set16BitCode(MacroAssembler::CodeRef ref) { m_ref16 = ref; }
 
+    bool has8BitCodeMatchOnly() { return m_matchOnly8.size(); }
+    bool has16BitCodeMatchOnly() { return m_matchOnly16.size(); }
+    void set8BitCodeMatchOnly(MacroAssembler::CodeRef matchOnly) { m_matchOnly8 = matchOnly; }
+    void set16BitCodeMatchOnly(MacroAssembler::CodeRef matchOnly) { m_matchOnly16 = matchOnly; }
+
     int execute(const LChar* input, unsigned start, unsigned length, int* output)
     {
         ASSERT(has8BitCode());
@@ -79,6 +84,18 @@ public:
         ASSERT(has16BitCode());
         return reinterpret_cast<YarrJITCode16>(m_ref16.code().executableAddress())(input, start, length, output);
     }
+
+    int executeMatchOnly(const LChar* input, unsigned start, unsigned length, int* output)
+    {
+        ASSERT(has8BitCodeMatchOnly());
+        return reinterpret_cast<YarrJITCode8>(m_matchOnly8.code().executableAddress())(input, start, length, output);
+    }
+
+    int executeMatchOnly(const UChar* input, unsigned start, unsigned length, int* output)
+    {
+        ASSERT(has16BitCodeMatchOnly());
+        return reinterpret_cast<YarrJITCode16>(m_matchOnly16.code().executableAddress())(input, start, length, output);
+    }
 #if ENABLE(REGEXP_TRACING)
     void *getAddr() { return m_ref.code().executableAddress(); }
 #endif
@@ -86,10 +103,12 @@ public:
 private:
     MacroAssembler::CodeRef m_ref8;
     MacroAssembler::CodeRef m_ref16;
+    MacroAssembler::CodeRef m_matchOnly8;
+    MacroAssembler::CodeRef m_matchOnly16;
     bool m_needFallBack;
 };
 
-void jitCompile(YarrPattern&, YarrCharSize, JSGlobalData*, YarrCodeBlock& jitObject);
+void jitCompile(YarrPattern&, const UString& patternString, YarrCharSize, JSGlobalData*, YarrCodeBlock& jitObject, YarrJITCompileMode = IncludeSubpatterns);
 
 inline int execute(YarrCodeBlock& jitObject, const LChar* input, unsigned start, unsigned length, int* output)
 {
@@ -101,6 +120,16 @@ inline int execute(YarrCodeBlock& jitObject, const UChar* input, unsigned start,
     return jitObject.execute(input, start, length, output);
 }
 
+inline int executeMatchOnly(YarrCodeBlock& jitObject, const LChar* input, unsigned start, unsigned length, int* output)
+{
+    return jitObject.executeMatchOnly(input, start, length, output);
+}
+
+inline int executeMatchOnly(YarrCodeBlock& jitObject, const UChar* input, unsigned start, unsigned length, int* output)
+{
+    return jitObject.executeMatchOnly(input, start, length, output);
+}
+
 } } // namespace JSC::Yarr
 
 #endif
@@ -515,6 +515,25 @@ public:
         m_alternative = m_alternative->m_parent->addNewAlternative();
     }
 
+    // Repeated parentheses that capture nothing, and whose alternatives all match the
+    // same non-zero number of characters. Every way of matching an iteration leaves the
+    // same state behind, so there is never a reason to backtrack into one; the JIT can
+    // match these with a counted loop, giving back whole iterations when backtracking.
+    bool isFixedSizeRepeat(PatternTerm& term)
+    {
+        if (term.parentheses.lastSubpatternId >= term.parentheses.subpatternId)
+            return false;
+
+        PatternDisjunction* disjunction = term.parentheses.disjunction;
+        if (!disjunction->m_hasFixedSize || !disjunction->m_minimumSize)
+            return false;
+        for (unsigned alt = 0; alt < disjunction->m_alternatives.size(); ++alt) {
+            if (disjunction->m_alternatives[alt]->m_minimumSize != disjunction->m_minimumSize)
+                return false;
+        }
+        return true;
+    }
+
     unsigned setupAlternativeOffsets(PatternAlternative* alternative, unsigned currentCallFrameSize, unsigned initialInputPosition)
     {
         alternative->m_hasFixedSize = true;
@@ -579,6 +598,11 @@ public:
                     term.inputPosition = currentInputPosition.unsafeGet();
                     setupDisjunctionOffsets(term.parentheses.disjunction, 0, currentInputPosition.unsafeGet());
                     currentCallFrameSize += YarrStackSpaceForBackTrackInfoParentheses;
+                    // The JIT matches these parentheses in the caller's frame, so lay them out again there.
+                    if (isFixedSizeRepeat(term)) {
+                        term.parentheses.isFixedSizeRepeat = true;
+                        currentCallFrameSize = setupDisjunctionOffsets(term.parentheses.disjunction, currentCallFrameSize, currentInputPosition.unsafeGet());
+                    }
                 }
                 // Fixed count of 1 could be accepted, if they have a fixed size *AND* if all alternatives are of the same length.
                 alternative->m_hasFixedSize = false;
@@ -112,6 +112,7 @@ struct PatternTerm {
             unsigned lastSubpatternId;
             bool isCopy;
             bool isTerminal;
+            bool isFixedSizeRepeat;
         } parentheses;
         struct {
             bool bolAnchor : 1;
@@ -152,6 +153,7 @@ struct PatternTerm {
         parentheses.subpatternId = subpatternId;
         parentheses.isCopy = false;
         parentheses.isTerminal = false;
+        parentheses.isFixedSizeRepeat = false;
         quantityType = QuantifierFixedCount;
         quantityCount = 1;
     }